@@ -0,0 +1,40 @@
+#include <raygpu.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Headless startup benchmark: prints the InitWindow phase breakdown and the time to the first frame.
+// usage: benchmark_startup [budget_ms] [trace.json]
+// Exits with 1 if InitWindow plus the first frame took longer than budget_ms.
+int main(int argc, char** argv){
+    const double budgetMs = argc > 1 ? atof(argv[1]) : 0.0;
+
+    SetConfigFlags(FLAG_HEADLESS);
+    const uint64_t start = NanoTime();
+    InitWindow(800, 600, "Startup benchmark");
+    const uint64_t initialized = NanoTime();
+
+    BeginDrawing();
+    ClearBackground(BLACK);
+    DrawRectangle(100, 100, 200, 100, WHITE);
+    DrawText("Startup", 100, 250, 20, WHITE);
+    EndDrawing();
+    const uint64_t firstFrame = NanoTime();
+
+    uint32_t phaseCount = 0;
+    const StartupPhase* phases = GetStartupPhases(&phaseCount);
+    for(uint32_t i = 0;i < phaseCount;i++){
+        printf("%*s%-*s %8.2f ms\n", (int)(2 * phases[i].depth), "", 24 - (int)(2 * phases[i].depth), phases[i].name, (double)phases[i].durationNanos / 1e6);
+    }
+    const double initMs = (double)(initialized - start) / 1e6;
+    const double totalMs = (double)(firstFrame - start) / 1e6;
+    printf("InitWindow: %.2f ms, first frame: %.2f ms, total: %.2f ms\n", initMs, totalMs - initMs, totalMs);
+
+    if(argc > 2 && !ExportStartupTrace(argv[2])){
+        return 1;
+    }
+    if(budgetMs > 0.0 && totalMs > budgetMs){
+        printf("Startup exceeded the budget of %.2f ms\n", budgetMs);
+        return 1;
+    }
+    return 0;
+}
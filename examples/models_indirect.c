@@ -0,0 +1,76 @@
+#include <raygpu.h>
+#include <math.h>
+#ifdef __EMSCRIPTEN__
+#include <emscripten.h>
+#endif
+
+// A field of ~20000 meshes drawn through an indirect scene: frustum culling runs in a compute pass and every
+// mesh is one indirect draw. Hold SPACE to draw the same field with one DrawMesh call per object instead.
+#define GRID_SIZE 140
+
+Camera3D cam;
+Mesh meshes[3];
+Material material;
+IndirectScene* scene;
+Matrix transforms[GRID_SIZE * GRID_SIZE];
+float angle;
+
+void mainloop(void){
+    angle += GetFrameTime() * 0.2f;
+    cam.position = CLITERAL(Vector3){sinf(angle) * 60.0f, 25.0f, cosf(angle) * 60.0f};
+    const bool direct = IsKeyDown(KEY_SPACE);
+
+    BeginDrawing();
+    ClearBackground(BLACK);
+    if(!direct){
+        CullIndirectScene(scene, GetCameraMatrix3D(cam, (float)GetRenderWidth() / GetRenderHeight()));
+    }
+    BeginMode3D(cam);
+    if(direct){
+        for(int i = 0;i < GRID_SIZE * GRID_SIZE;i++){
+            DrawMesh(meshes[i % 3], material, transforms[i]);
+        }
+    }else{
+        DrawIndirectScene(scene);
+    }
+    EndMode3D();
+    DrawFPS(0, 0);
+    const IndirectSceneStats stats = GetIndirectSceneStats(scene);
+    DrawText(direct ? TextFormat("DrawMesh: %u draw calls", stats.drawCount)
+                    : TextFormat("Indirect: %u draw calls, %s culling", stats.drawCalls, stats.gpuCulling ? "GPU" : "CPU"), 0, 30, 20, WHITE);
+    EndDrawing();
+}
+
+int main(cwoid){
+    InitWindow(1200, 800, "Indirect scene");
+    cam = CLITERAL(Camera3D){
+        .position = CLITERAL(Vector3){0, 25, 60},
+        .target = CLITERAL(Vector3){0, 0, 0},
+        .up = CLITERAL(Vector3){0, 1, 0},
+        .fovy = 45.0f
+    };
+    meshes[0] = GenMeshCube(0.8f, 0.8f, 0.8f);
+    meshes[1] = GenMeshSphere(0.5f, 8, 12);
+    meshes[2] = GenMeshCylinder(0.4f, 0.9f, 12);
+    for(int i = 0;i < 3;i++){
+        UploadMeshToArena(GetDefaultMeshArena(), meshes + i);
+    }
+    material = LoadMaterialDefault();
+
+    scene = LoadIndirectScene(GRID_SIZE * GRID_SIZE);
+    for(int i = 0;i < GRID_SIZE * GRID_SIZE;i++){
+        const float x = (float)(i % GRID_SIZE) - GRID_SIZE * 0.5f;
+        const float z = (float)(i / GRID_SIZE) - GRID_SIZE * 0.5f;
+        transforms[i] = MatrixTranslate(x, 0.0f, z);
+        AddIndirectSceneMesh(scene, meshes[i % 3], material, transforms[i]);
+    }
+
+    #ifndef __EMSCRIPTEN__
+    while(!WindowShouldClose()){
+        mainloop();
+    }
+    #else
+    emscripten_set_main_loop(mainloop, 0, 0);
+    #endif
+    UnloadIndirectScene(scene);
+}
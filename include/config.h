@@ -83,10 +83,125 @@
 
 #define RENDERBATCH_SIZE (RENDERBATCH_SIZE_MULTIPLIER * 12)
 
-#ifndef VERTEX_BUFFER_CACHE_SIZE
-    #define VERTEX_BUFFER_CACHE_SIZE 128
+// Store batch vertices as float position, unorm16 uv, snorm8 normal and unorm8 color (24 bytes)
+// instead of all floats (48 bytes). Texture coordinates are clamped to [0, 1] in this mode.
+// The normal is kept because the built-in default shader, its embedded SPIR-V included, reads location 2.
+#ifndef RENDERBATCH_COMPACT_VERTICES
+    #define RENDERBATCH_COMPACT_VERTICES 0
 #endif
 
+// Upload every mesh as one interleaved vertex buffer: float position, unorm16 uv (float if the mesh's
+// uvs leave [0, 1]), snorm8 normal, unorm8 color and bone weights, uint8/uint16 bone ids.
+// Meshes without colors share a single white color buffer instead of getting their own.
+#ifndef MESH_PACKED_VERTICES
+    #define MESH_PACKED_VERTICES 0
+#endif
+
+// Let UploadMesh place static meshes without bone data into the default mesh arena (see LoadMeshArena)
+#ifndef MESH_ARENA_STATIC_MESHES
+    #define MESH_ARENA_STATIC_MESHES 0
+#endif
+
+// Initial size of a mesh arena's shared buffers, they grow by doubling
+#ifndef MESH_ARENA_INITIAL_VERTEX_BYTES
+    #define MESH_ARENA_INITIAL_VERTEX_BYTES (8 << 20)
+#endif
+#ifndef MESH_ARENA_INITIAL_INDICES
+    #define MESH_ARENA_INITIAL_INDICES (2 << 20)
+#endif
+
+// Let UpdateModelAnimation skin meshes in a compute pass. Skinned positions and normals then stay on the GPU,
+// animVertices and animNormals are no longer updated. Packed and arena meshes are always skinned on the CPU.
+// The dispatch is submitted while the frame's render pass is still recorded, so all draws of a mesh in one frame
+// show the last pose it was updated to in that frame
+#ifndef MESH_GPU_SKINNING
+    #define MESH_GPU_SKINNING 0
+#endif
+
+// Initial capacity of the shared skinning buffers, they grow when full
+#ifndef MESH_SKINNING_INITIAL_VERTICES
+    #define MESH_SKINNING_INITIAL_VERTICES (1 << 16)
+#endif
+#ifndef MESH_SKINNING_INITIAL_BONES
+    #define MESH_SKINNING_INITIAL_BONES 1024
+#endif
+
+// Initial transform capacity of the storage buffer that EndMeshInstancing draws from, grows by doubling
+#ifndef MESH_INSTANCING_INITIAL_TRANSFORMS
+    #define MESH_INSTANCING_INITIAL_TRANSFORMS 4096
+#endif
+
+// Add a texture array layer index to every batch vertex (see BeginTextureArrayMode),
+// so sprites from different layers of one Texture2DArray render in a single draw.
+#ifndef RENDERBATCH_TEXTURE_ARRAY
+    #define RENDERBATCH_TEXTURE_ARRAY 0
+#endif
+
+// Native bind groups are cached by content (see UpdateBindGroup).
+// Entries unused for BINDGROUP_CACHE_MAX_AGE frames are released at the end of a frame,
+// the least recently used eighth is released when the cache reaches BINDGROUP_CACHE_CAPACITY.
+// Unloading a buffer, texture or sampler releases the entries that use it right away.
+#ifndef BINDGROUP_CACHE_CAPACITY
+    #define BINDGROUP_CACHE_CAPACITY 1024
+#endif
+
+#ifndef BINDGROUP_CACHE_MAX_AGE
+    #define BINDGROUP_CACHE_MAX_AGE 120
+#endif
+
+// Small uniform and read-only storage uploads (SetUniformBufferData & co.) are sub-allocated from one ring
+// buffer per kind and frame in flight, bound through dynamic offsets instead of a fresh WGPUBuffer each.
+#ifndef UNIFORM_RING_SIZE
+    #define UNIFORM_RING_SIZE (1 << 20)
+#endif
+
+#define UNIFORM_RING_ALIGNMENT 256
+
+// Immediate-mode batch flushes are streamed into one vertex buffer per frame in flight
+#ifndef VERTEX_STREAM_SIZE
+    #define VERTEX_STREAM_SIZE (1 << 22)
+#endif
+
+#ifndef RING_FRAMES_IN_FLIGHT
+    #define RING_FRAMES_IN_FLIGHT 2
+#endif
+
+// Create the pipelines requested by PrewarmShaderVariants on a background thread.
+// Requires a backend whose device may create pipelines concurrently with rendering.
+#ifndef PIPELINE_BACKGROUND_CREATION
+    #define PIPELINE_BACKGROUND_CREATION 0
+#endif
+
+// Worker threads used by LoadShadersBatch, 0 means one per hardware thread
+#ifndef SHADER_BATCH_MAX_THREADS
+    #define SHADER_BATCH_MAX_THREADS 0
+#endif
+
+// Size of the per-shader diagnostics string returned by LoadShadersBatch
+#ifndef SHADER_BATCH_DIAGNOSTICS_LENGTH
+    #define SHADER_BATCH_DIAGNOSTICS_LENGTH 512
+#endif
+
+// Phases recorded by the InitWindow startup profiler, further phases are dropped
+#ifndef MAX_STARTUP_PHASES
+    #define MAX_STARTUP_PHASES 32
+#endif
+
+// Staging buffers available to RequestTextureReadback, i.e. readbacks that can be in flight at once
+#ifndef READBACK_POOL_SIZE
+    #define READBACK_POOL_SIZE 4
+#endif
+
+// Frames buffered between the frame capture stages (readback -> conversion -> writer)
+#ifndef CAPTURE_QUEUE_DEPTH
+    #define CAPTURE_QUEUE_DEPTH 3
+#endif
+
+// WebGPU default limits for maxDynamic{Uniform,Storage}BuffersPerPipelineLayout
+#define MAX_DYNAMIC_UNIFORM_BUFFERS 8
+#define MAX_DYNAMIC_STORAGE_BUFFERS 4
+#define MAX_DYNAMIC_OFFSETS (MAX_DYNAMIC_UNIFORM_BUFFERS + MAX_DYNAMIC_STORAGE_BUFFERS)
+
 #ifndef MAX_COLOR_ATTACHMENTS
     #define MAX_COLOR_ATTACHMENTS 4
 #endif
@@ -95,9 +210,16 @@
     #define MAX_VERTEX_ATTRIBUTES 8
 #endif
 
+// Vertex buffer slots whose binding a render pass remembers to skip redundant rebinds
+#ifndef MAX_VERTEX_BUFFERS
+    #define MAX_VERTEX_BUFFERS 8
+#endif
+
 #define MAX_VERTEX_ATTRIBUTE_NAME_LENGTH 15
 #define MAX_BINDING_NAME_LENGTH 23
 #define MAX_SHADER_ENTRYPOINT_NAME_LENGTH 31
+#define MAX_SHADER_PERMUTATION_FEATURES 63
+#define MAX_SHADER_FEATURE_NAME_LENGTH 31
 
 //#ifndef VULKAN_USE_DYNAMIC_RENDERING
 //    #define VULKAN_USE_DYNAMIC_RENDERING 1
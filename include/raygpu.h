@@ -262,12 +262,35 @@ typedef enum PrimitiveType{
     RL_POINTS
 }PrimitiveType;
 
+#if RENDERBATCH_COMPACT_VERTICES == 1
+typedef struct vertex{
+    Vector3 pos;
+    uint16_t uv[2];   // Unorm16x2
+    int8_t normal[4]; // Snorm8x4, w is padding
+    uint8_t col[4];   // Unorm8x4
+    #if RENDERBATCH_TEXTURE_ARRAY == 1
+    uint32_t texIndex;
+    #endif
+}vertex;
+#else
 typedef struct vertex{
     Vector3 pos;
     Vector2 uv ;
     Vector3 normal;
     Vector4 col;
+    #if RENDERBATCH_TEXTURE_ARRAY == 1
+    uint32_t texIndex;
+    #endif
 }vertex;
+#endif
+
+// Layer index of vertices drawn without a texture in texture array mode, they only use the vertex color
+#define RL_TEXTURE_INDEX_NONE 0xFFFFFFFFu
+#if RENDERBATCH_TEXTURE_ARRAY == 1 && RENDERBATCH_COMPACT_VERTICES == 0
+    #define RL_NEXT_TEXINDEX , nexttexindex
+#else
+    #define RL_NEXT_TEXINDEX
+#endif
 
 typedef struct RGBA8Color{
     uint8_t r, g, b, a;
@@ -328,8 +351,17 @@ typedef struct Texture2DArray{
     uint32_t width, height, layerCount;
     PixelFormat format;
     uint32_t sampleCount;
+    WGPUTextureView* layerAliases; // layerAliases[i]: view of a Texture2D that stands for layer i in texture array mode
 }Texture2DArray;
 
+// Zero width/height copy the rest of the source mip level from (srcX, srcY), zero layerCount copies one layer.
+// The extent is clamped to both mip levels, an origin outside of its mip level copies nothing
+typedef struct TextureCopyRegion{
+    uint32_t srcMipLevel, srcLayer, srcX, srcY;
+    uint32_t dstMipLevel, dstLayer, dstX, dstY;
+    uint32_t width, height, layerCount;
+}TextureCopyRegion;
+
 typedef struct Rectangle {
     float x, y, width, height;
 } Rectangle;
@@ -489,6 +521,7 @@ typedef struct DescribedBindGroupLayout{
     void* layout;
     uint32_t entryCount;
     ResourceTypeDescriptor* entries;
+    uint64_t dynamicOffsetMask; //Bit i set: binding i is a buffer with hasDynamicOffset
 }DescribedBindGroupLayout;
 
 typedef struct DescribedBindGroup{
@@ -500,9 +533,57 @@ typedef struct DescribedBindGroup{
     //Description: entryCount and actual entries
     uint32_t entryCount;
     ResourceDescriptor* entries;
-    uint64_t descriptorHash; //currently unused
+    uint64_t descriptorHash; //Key into the bind group cache together with layout and entries
+
+    //Passed to SetBindGroup, ordered by binding like layout->dynamicOffsetMask
+    uint32_t dynamicOffsets[MAX_DYNAMIC_OFFSETS];
+    struct DynamicUploadState* dynamicUploads; //CPU copies of ring uploads, re-pushed once the ring slot is recycled
 }DescribedBindGroup;
 
+typedef struct BindGroupCacheStats{
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+    uint32_t entryCount;
+}BindGroupCacheStats;
+
+typedef struct StreamingRingStats{
+    uint64_t bytesUploadedThisFrame;
+    uint64_t bytesUploadedLastFrame;
+    uint64_t wraparounds; //Number of times a frame's ring ran full and had to be replaced by a larger one
+    uint64_t recycles;    //Number of times a full ring moved on to a buffer the GPU was done with, without EndDrawing
+    uint64_t capacity;
+}StreamingRingStats;
+
+typedef struct MeshArenaStats{
+    uint64_t vertexBytesUsed;     // Including ranges of unloaded meshes that were not compacted yet
+    uint64_t vertexBytesCapacity;
+    uint64_t vertexBytesWasted;
+    uint32_t indicesUsed;
+    uint32_t indexCapacity;
+    uint32_t indicesWasted;
+    uint32_t meshCount;
+    uint32_t compactions;
+}MeshArenaStats;
+
+typedef struct IndirectSceneStats{
+    uint32_t drawCount;
+    uint32_t batchCount;       // Distinct mesh and texture pairs
+    uint32_t drawCalls;        // Issued by the last DrawIndirectScene
+    bool gpuCulling;           // False without indirect firstInstance support, the scene is culled on the CPU then
+}IndirectSceneStats;
+
+typedef struct MeshInstancingStats{
+    uint32_t recordedDraws;    // DrawMesh calls recorded by the block
+    uint32_t emittedDrawCalls; // One instanced draw per (shader, mesh, texture) group
+}MeshInstancingStats;
+
+typedef struct Deferred2DStats{
+    uint32_t recordedBatches;  // Draw calls the block would have issued in immediate mode
+    uint32_t emittedDrawCalls; // Draw calls issued after sorting and merging
+    uint32_t recordedVertices;
+}Deferred2DStats;
+
 typedef struct RGVertexAttribute {
     RGVertexFormat format;
     uint64_t offset;
@@ -535,6 +616,12 @@ typedef struct DescribedRenderpass{
     WGPUCommandEncoder cmdEncoder;
     WGPURenderPassEncoder rpEncoder;
     void* VkRenderPass;
+    // What rpEncoder currently has bound, reset by BeginRenderpassEx
+    WGPUBuffer boundVertexBuffers[MAX_VERTEX_BUFFERS];
+    uint64_t boundVertexOffsets[MAX_VERTEX_BUFFERS];
+    WGPUBuffer boundIndexBuffer;
+    uint64_t boundIndexOffset;
+    IndexFormat boundIndexFormat;
 }DescribedRenderpass;
 
 typedef struct DescribedComputePass{
@@ -593,6 +680,9 @@ typedef struct Font {
     GlyphInfo *glyphs;      // Glyphs info data
 } Font;
 
+typedef struct MeshArena MeshArena;
+typedef struct IndirectScene IndirectScene;
+
 typedef struct Mesh {
     int vertexCount;        // Number of vertices stored in arrays
     int triangleCount;      // Number of triangles stored (indexed or not)
@@ -620,6 +710,9 @@ typedef struct Mesh {
     DescribedBuffer* ibo; //Index buffer object, optional
     DescribedBuffer* boneMatrixBuffer; //Storage buffer
     RGVertexFormat boneIDFormat; //Either RGVertexFormat_Uint8 or Uint16;
+    MeshArena* arena;            // Set by UploadMeshToArena, vbos and ibo stay NULL
+    uint32_t arenaAllocation;
+    uint32_t skinningSlot;       // Set once UpdateModelAnimation skins the mesh on the GPU, 0 otherwise
 } Mesh;
 
 typedef struct BoneInfo {
@@ -638,6 +731,29 @@ typedef struct Shader {
     int *locs;              // Shader locations array (RL_MAX_SHADER_LOCATIONS)
 } Shader;
 
+// Returned by shader loaders that fail, 0 is a valid shader id
+#define SHADER_ID_INVALID 0xFFFFFFFFu
+
+// Interned uniform name, see GetUniformNameHandle. The RL_DEFAULT_SHADER_* names are interned up front
+typedef uint32_t UniformNameHandle;
+// Bit i enables feature i of a shader loaded with LoadShaderPermutations
+typedef uint64_t ShaderPermutationKey;
+typedef enum RGDefaultUniform{
+    RGDefaultUniform_Texture0,          // RL_DEFAULT_SHADER_SAMPLER2D_NAME_TEXTURE0
+    RGDefaultUniform_Texture1,          // RL_DEFAULT_SHADER_SAMPLER2D_NAME_TEXTURE1
+    RGDefaultUniform_Texture2,          // RL_DEFAULT_SHADER_SAMPLER2D_NAME_TEXTURE2
+    RGDefaultUniform_ProjectionView,    // RL_DEFAULT_SHADER_UNIFORM_NAME_PROJECTION_VIEW
+    RGDefaultUniform_InstanceTransform, // RL_DEFAULT_SHADER_UNIFORM_NAME_INSTANCE_TX
+    RGDefaultUniform_MVP,               // RL_DEFAULT_SHADER_UNIFORM_NAME_MVP
+    RGDefaultUniform_View,              // RL_DEFAULT_SHADER_UNIFORM_NAME_VIEW
+    RGDefaultUniform_Projection,        // RL_DEFAULT_SHADER_UNIFORM_NAME_PROJECTION
+    RGDefaultUniform_Model,             // RL_DEFAULT_SHADER_UNIFORM_NAME_MODEL
+    RGDefaultUniform_Normal,            // RL_DEFAULT_SHADER_UNIFORM_NAME_NORMAL
+    RGDefaultUniform_Color,             // RL_DEFAULT_SHADER_UNIFORM_NAME_COLOR
+    RGDefaultUniform_BoneMatrices,      // RL_DEFAULT_SHADER_UNIFORM_NAME_BONE_MATRICES
+    RGDefaultUniform_EnumCount
+}RGDefaultUniform;
+
 typedef struct Material{
     int id;
     MaterialMap* maps;
@@ -705,9 +821,16 @@ typedef struct VertexArray VertexArray;
 #else
 #define externcvar extern
 #endif
+#if RENDERBATCH_COMPACT_VERTICES == 1
+externcvar vertex nextvertex; // uv, normal and color of the next rlVertex, already packed
+#else
 externcvar Vector2 nextuv;
 externcvar Vector3 nextnormal;
 externcvar Vector4 nextcol;
+#if RENDERBATCH_TEXTURE_ARRAY == 1
+externcvar uint32_t nexttexindex;
+#endif
+#endif
 externcvar StagingBuffer vboStaging; //unused
 externcvar vertex* vboptr;
 externcvar vertex* vboptr_base;
@@ -1147,6 +1270,7 @@ typedef struct StageInModule{
 typedef struct DescribedShaderModule{
     StageInModule stages[16];
     ShaderReflectionInfo reflectionInfo;
+    uint64_t sourceHash; // Identifies the source across runs, see SavePipelineStates
 }DescribedShaderModule;
 
 typedef struct VertexBufferLayoutSet VertexBufferLayoutSet;
@@ -1162,6 +1286,13 @@ typedef struct DescribedComputePipeline{
 #endif
 }DescribedComputePipeline;
 
+typedef struct ShaderBatchResult{
+    Shader shader;                             // Set for vertex/fragment sources
+    DescribedComputePipeline* computePipeline; // Set for compute sources
+    bool success;
+    char diagnostics[SHADER_BATCH_DIAGNOSTICS_LENGTH]; // Empty on success, otherwise the first error for this item
+}ShaderBatchResult;
+
 #if SUPPORT_VULKAN_BACKEND == 1
 typedef struct DescribedRaytracingPipeline{
     WGPURaytracingPipeline pipeline;
@@ -1266,6 +1397,7 @@ RGAPI void requestAnimationFrameLoopWithJSPI(void (*callback)(void), int /* unus
 RGAPI void requestAnimationFrameLoopWithJSPIArg(void (*callback)(void*), void* userData, int/* unused */, int/* unused */);
 RGAPI void SetWindowShouldClose(cwoid);
 RGAPI bool WindowShouldClose(cwoid);
+RGAPI void CloseWindow(cwoid); // Finishes work that still needs the device, e.g. a running frame capture. Call it after the main loop
 RGAPI SubWindow OpenSubWindow (int width, int height, const char* title);
 RGAPI SubWindow InitWindow_SDL2 (int width, int height, const char* title);
 RGAPI SubWindow InitWindow_SDL3 (int width, int height, const char* title);
@@ -1358,6 +1490,17 @@ RGAPI void TraceLog(int logType, const char *text, ...);
  */
 RGAPI uint64_t NanoTime(cwoid);
 
+// One timed step of InitWindow, phases nest when depth > 0
+typedef struct StartupPhase{
+    const char* name;
+    uint64_t beginNanos; // NanoTime() at the start of the phase
+    uint64_t durationNanos;
+    uint32_t depth;
+}StartupPhase;
+
+RGAPI const StartupPhase* GetStartupPhases(uint32_t* count); // Phases of the last InitWindow in the order they began
+RGAPI bool ExportStartupTrace(const char* fileName); // Trace event JSON, viewable in chrome://tracing or Perfetto. Written automatically to $RAYGPU_STARTUP_TRACE
+
 /**
  * @brief This function exists to request limits that are higher than the default ones
  *
@@ -1408,6 +1551,10 @@ RGAPI void BindComputePipeline(DescribedComputePipeline* cpl);
 RGAPI void DispatchCompute(uint32_t x, uint32_t y, uint32_t z);
 RGAPI void CopyBufferToBuffer(DescribedBuffer* source, DescribedBuffer* dest, size_t count/* in bytes*/);
 RGAPI void CopyTextureToTexture(Texture source, Texture dest);
+RGAPI void CopyTextureRegion(Texture source, Texture dest, TextureCopyRegion region);
+RGAPI void CopyTextureArrayRegion(Texture2DArray source, Texture2DArray dest, TextureCopyRegion region);
+RGAPI void BeginTextureCopies(cwoid);
+RGAPI void EndTextureCopies(cwoid);
 RGAPI void ComputepassEndOnlyComputing(cwoid);
 RGAPI void EndComputepass(cwoid);
 RGAPI void BeginComputepassEx(DescribedComputepass* computePass);
@@ -1424,6 +1571,14 @@ RGAPI void BeginBlendMode(rlBlendMode blendMode);
 RGAPI void EndBlendMode(void);
 RGAPI void BeginMode2D(Camera2D camera);
 RGAPI void EndMode2D(cwoid);
+// Batches recorded between BeginDeferred2D and EndDeferred2D are sorted by (layer, shader, primitive, texture)
+// and merged. Layers are drawn in ascending order, within a layer textures keep the order of their first use
+// and only the submission order of batches sharing a texture is kept. Camera, blend, viewport or render target
+// changes inside the block draw what was recorded so far, layers are sorted within each of those segments.
+RGAPI void BeginDeferred2D(cwoid);
+RGAPI void SetDeferred2DLayer(int layer);
+RGAPI void EndDeferred2D(cwoid);
+RGAPI Deferred2DStats GetDeferred2DStats(cwoid); // Stats of the last EndDeferred2D
 RGAPI void BeginMode3D(Camera3D camera);
 RGAPI void EndMode3D(cwoid);
 RGAPI void LoadIdentity(cwoid);
@@ -1451,11 +1606,31 @@ RGAPI void UnloadSampler(DescribedSampler sampler);
 
 RGAPI WGPUTexture GetActiveColorTarget(cwoid);
 RGAPI Texture2DArray LoadTextureArray(uint32_t width, uint32_t height, uint32_t layerCount, PixelFormat format);
+RGAPI void UpdateTextureArrayLayer(Texture2DArray array, uint32_t layer, const void* data);
+RGAPI void SetTextureArrayLayerAlias(Texture2DArray array, uint32_t layer, Texture tex);
+RGAPI void UnloadTextureArray(Texture2DArray array);
+// Texture array mode: batches bind one Texture2DArray, UseTexture on an aliased texture only selects
+// the layer for the following vertices instead of flushing. Textures without a layer alias, such as the
+// default font, flush and are drawn through the default shader until an aliased texture is used again.
+// Requires RENDERBATCH_TEXTURE_ARRAY
+RGAPI void BeginTextureArrayMode(Texture2DArray array);
+RGAPI void EndTextureArrayMode(cwoid);
 RGAPI void* GetActiveWindowHandle(cwoid);
 RGAPI Texture LoadTextureFromImage(Image img);
 RGAPI void ImageFormat(Image* img, PixelFormat newFormat);
 RGAPI Image LoadImageFromTexture(Texture tex);
 RGAPI Image LoadImageFromTextureEx(WGPUTexture tex, uint32_t mipLevel);
+// image.data points into a mapped staging buffer and is only valid during the callback,
+// rows are image.rowStrideInBytes apart. image.data is NULL if the readback failed
+typedef void (*ReadbackCallback)(Image image, void* userdata);
+RGAPI bool RequestTextureReadback(Texture tex, uint32_t mipLevel, ReadbackCallback callback, void* userdata); // false if all READBACK_POOL_SIZE staging buffers are in flight
+RGAPI uint32_t PollReadbacks(cwoid); // Runs callbacks of finished readbacks without blocking, returns the number still pending
+RGAPI void FlushReadbacks(cwoid);    // Blocks until every pending readback has run its callback
+// Streams every frame as raw, tightly packed RGBA8 into sink (stdout, a file or a popen'd pipe).
+// Started automatically on stdout with FLAG_STDOUT_TO_FFMPEG, stopped by CloseWindow
+RGAPI bool StartFrameCapture(FILE* sink);
+RGAPI void StopFrameCapture(cwoid);
+RGAPI bool IsFrameCaptureActive(cwoid);
 RGAPI void TakeScreenshot(const char* filename);
 RGAPI Image LoadImage(const char* filename);
 RGAPI Image ImageFromImage(Image img, Rectangle rec);
@@ -1519,7 +1694,35 @@ static inline Color GetColor(unsigned int hexValue){
     color.a = (uint8_t)hexValue & 0xFF;
     return color;
 }
+// Packing helpers for the compact batch vertex and packed meshes
+static inline uint8_t rlPackUnorm8(float x){ return (uint8_t)(((x < 0.0f) ? 0.0f : ((x > 1.0f) ? 1.0f : x)) * 255.0f + 0.5f); }
+static inline int8_t rlPackSnorm8(float x){ x = (x < -1.0f) ? -1.0f : ((x > 1.0f) ? 1.0f : x); return (int8_t)(x * 127.0f + ((x < 0.0f) ? -0.5f : 0.5f)); }
+static inline uint16_t rlPackUnorm16(float x){ return (uint16_t)(((x < 0.0f) ? 0.0f : ((x > 1.0f) ? 1.0f : x)) * 65535.0f + 0.5f); }
 #if !defined(RAYGPU_NO_INLINE_FUNCTIONS) || RAYGPU_NO_INLINE_FUNCTIONS == 0
+#if RENDERBATCH_COMPACT_VERTICES == 1
+static void rlColor4f(float r, float g, float b, float alpha){
+    nextvertex.col[0] = rlPackUnorm8(r); nextvertex.col[1] = rlPackUnorm8(g); nextvertex.col[2] = rlPackUnorm8(b); nextvertex.col[3] = rlPackUnorm8(alpha);
+}
+static void rlColor4ub(uint8_t r, uint8_t g, uint8_t b, uint8_t a){
+    nextvertex.col[0] = r; nextvertex.col[1] = g; nextvertex.col[2] = b; nextvertex.col[3] = a;
+}
+static void rlTexCoord2f(float u, float v){
+    nextvertex.uv[0] = rlPackUnorm16(u); nextvertex.uv[1] = rlPackUnorm16(v);
+}
+static void rlNormal3f(float x, float y, float z){
+    nextvertex.normal[0] = rlPackSnorm8(x); nextvertex.normal[1] = rlPackSnorm8(y); nextvertex.normal[2] = rlPackSnorm8(z);
+}
+static void rlVertex3f(float x, float y, float z){
+    nextvertex.pos = CLITERAL(Vector3){x, y, z};
+    *(vboptr++) = nextvertex;
+    if(UNLIKELY(vboptr - vboptr_base >= RENDERBATCH_SIZE)){
+        drawCurrentBatch();
+    }
+}
+static void rlVertex2f(float x, float y){
+    rlVertex3f(x, y, 0);
+}
+#else
 static void rlColor4f(float r, float g, float b, float alpha){
     nextcol.x = r; nextcol.y = g; nextcol.z = b; nextcol.w = alpha;
 }
@@ -1529,14 +1732,11 @@ static void rlColor4ub(uint8_t r, uint8_t g, uint8_t b, uint8_t a){
     nextcol.z = ((float)((int)b)) / 255.0f;
     nextcol.w = ((float)((int)a)) / 255.0f;
 }
-static void rlColor3f(float r, float g, float b){
-    rlColor4f(r, g, b, 1.0f);
-}
 static void rlTexCoord2f(float u, float v){
     nextuv.x = u; nextuv.y = v;
 }
 static void rlVertex2f(float x, float y){
-    *(vboptr++) = CLITERAL(vertex){{x, y, 0}, nextuv, nextnormal, nextcol};
+    *(vboptr++) = CLITERAL(vertex){{x, y, 0}, nextuv, nextnormal, nextcol RL_NEXT_TEXINDEX};
     if(UNLIKELY(vboptr - vboptr_base >= RENDERBATCH_SIZE)){
         drawCurrentBatch();
     }
@@ -1545,11 +1745,15 @@ static void rlNormal3f(float x, float y, float z){
     nextnormal.x = x; nextnormal.y = y; nextnormal.z = z;
 }
 static void rlVertex3f(float x, float y, float z){
-    *(vboptr++) = CLITERAL(vertex){{x, y, z}, nextuv, nextnormal, nextcol};
+    *(vboptr++) = CLITERAL(vertex){{x, y, z}, nextuv, nextnormal, nextcol RL_NEXT_TEXINDEX};
     if(UNLIKELY(vboptr - vboptr_base >= RENDERBATCH_SIZE)){
         drawCurrentBatch();
     }
 }
+#endif
+static void rlColor3f(float r, float g, float b){
+    rlColor4f(r, g, b, 1.0f);
+}
 #else
 void rlColor4ub(uint8_t r, uint8_t g, uint8_t b, uint8_t a);
 void rlColor4f(float r, float g, float b, float alpha);
@@ -1559,6 +1763,7 @@ void rlNormal3f(float x, float y, float z);
 void rlVertex2f(float x, float y);
 void rlTexCoord2f(float u, float v);
 #endif
+RGAPI void rlTextureIndex(uint32_t layer);
 
 RGAPI void rlSetLineWidth(float lineWidth);
 RGAPI void rlBegin(PrimitiveType mode);
@@ -1590,6 +1795,11 @@ RGAPI DescribedShaderModule LoadShaderModuleWGSL (ShaderSources sourcesWGSL);
 RGAPI DescribedShaderModule LoadShaderModuleGLSL (ShaderSources sourcesGLSL);
 RGAPI DescribedShaderModule LoadShaderModuleSPIRV(ShaderSources sourcesSpirv);
 RGAPI DescribedShaderModule LoadShaderModule (ShaderSources source);
+RGAPI void SetShaderCacheDirectory(const char* directory); // NULL disables the on-disk shader cache. Defaults to $RAYGPU_SHADER_CACHE_DIR
+RGAPI void PrewarmShaderVariants(Shader shader, const RenderSettings* settings, const PrimitiveType* primitiveTypes, uint32_t count); // Uses the shader's current vertex layout
+RGAPI void PrewarmRecordedPipelineStates(Shader shader); // Called automatically for shaders loaded after LoadPipelineStates
+RGAPI bool SavePipelineStates(const char* path);
+RGAPI bool LoadPipelineStates(const char* path);
 RGAPI const char* GetStageEntryPointName (ShaderReflectionInfo reflectionInfo, RGShaderStageEnum stage);
 RGAPI uint32_t GetReflectionUniformLocation (ShaderReflectionInfo reflectionInfo, const char* name );
 RGAPI uint32_t GetReflectionAttributeLocation (ShaderReflectionInfo reflectionInfo, const char* name );
@@ -1598,6 +1808,10 @@ RGAPI Shader LoadShader (const char *vsFileName, const char *fsFileName); // Ass
 RGAPI Shader LoadShaderSingleSource (const char* shaderSource); // Assumes WGSL
 RGAPI Shader LoadShaderFromMemory (const char *vsCode , const char *fsCode ); // Assumes GLSL
 RGAPI Shader LoadShaderFromMemorySPIRV(ShaderSources sources); // Obviously assumes SPIRV
+RGAPI uint32_t LoadShadersBatch(const ShaderSources* sources, uint32_t count, ShaderBatchResult* results); // Returns the number of shaders that loaded successfully
+RGAPI Shader LoadShaderPermutations(ShaderSources sources, const char* const* featureNames, uint32_t featureCount); // GLSL or WGSL with #if/#ifdef blocks over the features, returns the variant with every feature off, id SHADER_ID_INVALID on failure
+RGAPI ShaderPermutationKey GetShaderFeatureKey(Shader shader, const char* featureName); // 0 if the shader has no such feature
+RGAPI Shader GetShaderPermutation(Shader shader, ShaderPermutationKey key); // Compiled on first request, afterwards a table lookup. id SHADER_ID_INVALID if the variant does not compile
 
 RGAPI DescribedBindGroupLayout LoadBindGroupLayout(const ResourceTypeDescriptor* uniforms, uint32_t uniformCount, bool compute);
 RGAPI DescribedBindGroupLayout LoadBindGroupLayoutMod(const DescribedShaderModule* shaderModule);
@@ -1612,9 +1826,14 @@ RGAPI WGPUBindGroup UpdateAndGetNativeBindGroup(DescribedBindGroup* bg);
 RGAPI void UpdateBindGroupEntry(DescribedBindGroup* bg, size_t index, ResourceDescriptor entry);
 RGAPI void UpdateBindGroup(DescribedBindGroup* bg);
 RGAPI void UnloadBindGroup(DescribedBindGroup* bg);
+RGAPI BindGroupCacheStats GetBindGroupCacheStats(cwoid);
+RGAPI void ClearBindGroupCache(cwoid);
+RGAPI StreamingRingStats GetUniformRingStats(cwoid);
+RGAPI StreamingRingStats GetVertexStreamStats(cwoid);
 RGAPI DescribedPipeline* Relayout(DescribedPipeline* pl, VertexArray* vao);
 RGAPI DescribedComputePipeline* LoadComputePipeline(const char* shaderCode);
 RGAPI DescribedComputePipeline* LoadComputePipelineEx(const char* shaderCode, const ResourceTypeDescriptor* uniforms, uint32_t uniformCount);
+RGAPI DescribedComputePipeline* LoadComputePipelineFromModule(DescribedShaderModule module, const ResourceTypeDescriptor* uniforms, uint32_t uniformCount);
 RGAPI DescribedRaytracingPipeline* LoadRaytracingPipeline(const DescribedShaderModule* shaderModule);
 RGAPI Shader DefaultShader(cwoid);
 RGAPI RenderSettings GetDefaultSettings(cwoid);
@@ -1645,6 +1864,7 @@ RGAPI DescribedBuffer* GenVertexBuffer(const void* data, size_t size);
 RGAPI DescribedBuffer* GenBufferEx(const void* data, size_t size, RGBufferUsage usage);
 RGAPI void UnloadBuffer(DescribedBuffer* buffer);
 RGAPI void BufferData(DescribedBuffer* buffer, const void* data, size_t size);
+RGAPI void BufferSubData(DescribedBuffer* buffer, uint64_t offset, const void* data, size_t size); // Never resizes, offset and size must be multiples of 4
 RGAPI void ResizeBuffer(DescribedBuffer* buffer, size_t newSize);
 RGAPI void ResizeBufferAndConserve(DescribedBuffer* buffer, size_t newSize);
 RGAPI void BindVertexBuffer(const DescribedBuffer* buffer);
@@ -1656,7 +1876,11 @@ RGAPI void RenderPassSetBindGroup (DescribedRenderpass* drp, uint32_t group, Des
 RGAPI void ComputePassSetBindGroup (DescribedComputepass* drp, uint32_t group, DescribedBindGroup* buffer);
 RGAPI void RenderPassDraw (DescribedRenderpass* drp, uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance);
 RGAPI void RenderPassDrawIndexed (DescribedRenderpass* drp, uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t baseVertex, uint32_t firstInstance);
+RGAPI void RenderPassDrawIndirect (DescribedRenderpass* drp, DescribedBuffer* indirectBuffer, uint64_t indirectOffset);
+RGAPI void RenderPassDrawIndexedIndirect (DescribedRenderpass* drp, DescribedBuffer* indirectBuffer, uint64_t indirectOffset);
 RGAPI uint32_t GetUniformLocation (Shader shader, const char* uniformName);
+RGAPI UniformNameHandle GetUniformNameHandle(const char* uniformName); // Resolve once and keep, handles are valid for the whole program
+RGAPI uint32_t GetUniformLocationByHandle(Shader shader, UniformNameHandle name); // No string hashing, cheap enough for per draw use
 RGAPI uint32_t GetComputeShaderLocation (DescribedComputePipeline* shader, const char* uniformName);
 RGAPI uint32_t GetUniformLocationCompute(Shader shader, const char* uniformName);
 RGAPI uint32_t rlGetLocationUniform (const uint32_t shaderID, const char* uniformName);
@@ -1695,6 +1919,7 @@ RGAPI void SetBindgroupSampler (DescribedBindGroup* bg, uint32_t index, Describe
  * aim to replicate the behaviour of OpenGL as closely as possible.
  */
 RGAPI VertexArray* LoadVertexArray (cwoid);
+RGAPI void UnloadVertexArray (VertexArray* array);
 RGAPI void VertexAttribPointer (VertexArray* array, DescribedBuffer* buffer, uint32_t attribLocation, RGVertexFormat format, uint32_t offset, RGVertexStepMode stepmode);
 RGAPI void EnableVertexAttribArray (VertexArray* array, uint32_t attribLocation);
 RGAPI void DisableVertexAttribArray (VertexArray* array, uint32_t attribLocation);
@@ -1706,11 +1931,15 @@ RGAPI void DrawArrays (PrimitiveType drawMode, uint32_t vertexCount);
 RGAPI void DrawArraysInstanced (PrimitiveType drawMode, uint32_t vertexCount, uint32_t instanceCount);
 RGAPI void DrawArraysIndexed (PrimitiveType drawMode, DescribedBuffer indexBuffer, uint32_t vertexCount);
 RGAPI void DrawArraysIndexedInstanced(PrimitiveType drawMode, DescribedBuffer indexBuffer, uint32_t vertexCount, uint32_t instanceCount);
+RGAPI void DrawArraysIndexedRange (PrimitiveType drawMode, DescribedBuffer* indexBuffer, uint32_t firstIndex, uint32_t indexCount, int32_t baseVertex, uint32_t instanceCount, uint32_t firstInstance);
+RGAPI void DrawArraysRange (PrimitiveType drawMode, uint32_t firstVertex, uint32_t vertexCount, uint32_t instanceCount, uint32_t firstInstance);
+RGAPI void DrawArraysIndirect (PrimitiveType drawMode, DescribedBuffer* indirectBuffer, uint64_t indirectOffset);
+RGAPI void DrawArraysIndexedIndirect (PrimitiveType drawMode, DescribedBuffer* indexBuffer, DescribedBuffer* indirectBuffer, uint64_t indirectOffset);
 
 RGAPI Material LoadMaterialDefault(cwoid);
 RGAPI ModelAnimation *LoadModelAnimations(const char *fileName, int *animCount);
 RGAPI void UpdateModelAnimationBones(Model model, ModelAnimation anim, int frame);
-RGAPI void UpdateModelAnimation(Model model, ModelAnimation anim, int frame);
+RGAPI void UpdateModelAnimation(Model model, ModelAnimation anim, int frame); // Skins in a compute pass with MESH_GPU_SKINNING, batched into one dispatch before the next mesh draw. Draws of a frame then all show the mesh's last pose of that frame
 RGAPI Model LoadModel(const char *fileName);                    // Load model from files (meshes and materials)
 RGAPI Model LoadModelFromMesh(Mesh mesh);                       // Load model from generated mesh (default material)
 RGAPI bool IsModelValid(Model model);                           // Check if a model is valid (loaded in GPU, VAO/VBOs)
@@ -1736,6 +1965,30 @@ RGAPI void UnloadMesh(Mesh mesh);                       // Unload mesh data from
 RGAPI void DrawMesh(Mesh mesh, Material material, Matrix transform); // Draw a 3d mesh with material and transform
 RGAPI void DrawMeshInstanced(Mesh mesh, Material material, const Matrix *transforms, int instances); // Draw multiple mesh instances with material and different transforms
 RGAPI BoundingBox GetMeshBoundingBox(Mesh mesh);        // Compute mesh bounding box limits
+// DrawMesh and DrawModel calls between BeginMeshInstancing and EndMeshInstancing are grouped by (shader, mesh, texture)
+// and every group is drawn as one instanced draw. Groups are drawn in sorted order, keep transparent meshes outside of the block.
+RGAPI void BeginMeshInstancing(cwoid);
+RGAPI void EndMeshInstancing(cwoid);
+RGAPI MeshInstancingStats GetMeshInstancingStats(cwoid); // Stats of the last EndMeshInstancing
+
+// Mesh arenas hold the vertices and indices of many meshes in two shared buffers, meshes are drawn with baseVertex and firstIndex
+RGAPI MeshArena* LoadMeshArena(uint64_t vertexBytes, uint32_t indexCount);
+RGAPI void UnloadMeshArena(MeshArena* arena);           // Meshes still in the arena become invalid
+RGAPI MeshArena* GetDefaultMeshArena(cwoid);            // Created on first use, see MESH_ARENA_STATIC_MESHES
+RGAPI void UploadMeshToArena(MeshArena* arena, Mesh* mesh); // Like UploadMesh, later UploadMesh calls update the mesh in place. Moves meshes that have their own buffers
+RGAPI void CompactMeshArena(MeshArena* arena);          // Closes the gaps left by unloaded meshes, also done by UnloadMesh
+RGAPI MeshArenaStats GetMeshArenaStats(const MeshArena* arena);
+
+// Indirect scenes draw arena meshes with frustum culling in a compute pass and one indirect draw per mesh and texture
+RGAPI IndirectScene* LoadIndirectScene(uint32_t maxDraws);
+RGAPI void UnloadIndirectScene(IndirectScene* scene);
+RGAPI void ClearIndirectScene(IndirectScene* scene);
+RGAPI uint32_t AddIndirectSceneMesh(IndirectScene* scene, Mesh mesh, Material material, Matrix transform); // Returns the draw id, UINT32_MAX if the scene is full or the mesh is not in an arena
+RGAPI uint32_t AddIndirectSceneModel(IndirectScene* scene, Model model, Matrix transform); // Returns the draw id of the first mesh, the others follow
+RGAPI void SetIndirectSceneTransform(IndirectScene* scene, uint32_t draw, Matrix transform);
+RGAPI void CullIndirectScene(IndirectScene* scene, Matrix viewProjection); // Once per frame, before DrawIndirectScene
+RGAPI void DrawIndirectScene(IndirectScene* scene);     // Draws with the active shader, which reads the transforms like the default one
+RGAPI IndirectSceneStats GetIndirectSceneStats(const IndirectScene* scene);
 RGAPI void GenMeshTangents(Mesh *mesh);                 // Compute mesh tangents
 RGAPI Mesh GenMeshCube(float width, float height, float length);
 RGAPI Mesh GenMeshPoly(int sides, float radius);
@@ -1810,13 +2063,17 @@ RGAPI void* GetSurface (cwoid);
 static inline uint32_t attributeSize(const RGVertexFormat fmt){
     switch(fmt){
         case RGVertexFormat_Uint8x4:
+        case RGVertexFormat_Sint8x4:
         case RGVertexFormat_Unorm8x4:
+        case RGVertexFormat_Snorm8x4:
         case RGVertexFormat_Float32:
         case RGVertexFormat_Uint32:
         case RGVertexFormat_Sint32:
         case RGVertexFormat_Float16x2:
         case RGVertexFormat_Uint16x2:
         case RGVertexFormat_Sint16x2:
+        case RGVertexFormat_Unorm16x2:
+        case RGVertexFormat_Snorm16x2:
             return 4;
         case RGVertexFormat_Float32x2:
         case RGVertexFormat_Uint32x2:
@@ -1824,6 +2081,8 @@ static inline uint32_t attributeSize(const RGVertexFormat fmt){
         case RGVertexFormat_Float16x4:
         case RGVertexFormat_Uint16x4:
         case RGVertexFormat_Sint16x4:
+        case RGVertexFormat_Unorm16x4:
+        case RGVertexFormat_Snorm16x4:
             return 8;
         case RGVertexFormat_Float32x3:
         case RGVertexFormat_Uint32x3:
@@ -1836,6 +2095,10 @@ static inline uint32_t attributeSize(const RGVertexFormat fmt){
         case RGVertexFormat_Float16:
         case RGVertexFormat_Uint16:
         case RGVertexFormat_Sint16:
+        case RGVertexFormat_Uint8x2:
+        case RGVertexFormat_Sint8x2:
+        case RGVertexFormat_Unorm8x2:
+        case RGVertexFormat_Snorm8x2:
             return 2;
         //case RGVertexFormat_Uint8: // This is not a real format
         //    return 1;
@@ -94,52 +94,81 @@ const char fragmentSourceGLSL[] = "#version 450\n"
 "    outColor = texColor * frag_color;\n"
 "}\n";
 
-const uint32_t default_vert_spv_data[] = {
-
-    0x07230203, 0x00010000, 0x0008000b, 0x0000003e, 0x00000000, 0x00020011, 0x00000001, 0x0006000b, 0x00000001, 0x4c534c47, 0x6474732e, 0x3035342e, 0x00000000, 0x0003000e, 0x00000000, 0x00000001, 0x000e000f, 0x00000000, 0x00000004, 0x6e69616d,
-    0x00000000, 0x0000000d, 0x00000020, 0x00000027, 0x00000032, 0x00000034, 0x00000036, 0x00000038, 0x0000003b, 0x0000003c, 0x00030003, 0x00000002, 0x000001c2, 0x00040005, 0x00000004, 0x6e69616d, 0x00000000, 0x00060005, 0x0000000b, 0x505f6c67,
-    0x65567265, 0x78657472, 0x00000000, 0x00060006, 0x0000000b, 0x00000000, 0x505f6c67, 0x7469736f, 0x006e6f69, 0x00070006, 0x0000000b, 0x00000001, 0x505f6c67, 0x746e696f, 0x657a6953, 0x00000000, 0x00070006, 0x0000000b, 0x00000002, 0x435f6c67,
-    0x4470696c, 0x61747369, 0x0065636e, 0x00070006, 0x0000000b, 0x00000003, 0x435f6c67, 0x446c6c75, 0x61747369, 0x0065636e, 0x00030005, 0x0000000d, 0x00000000, 0x00070005, 0x00000015, 0x73726550, 0x74636570, 0x5f657669, 0x77656956, 0x00000000,
-    0x00060006, 0x00000015, 0x00000000, 0x616d7670, 0x78697274, 0x00000000, 0x00030005, 0x00000017, 0x00000000, 0x00050005, 0x0000001c, 0x65646f6d, 0x74614d6c, 0x00786972, 0x00070006, 0x0000001c, 0x00000000, 0x65646f6d, 0x74614d6c, 0x65636972,
-    0x00000073, 0x00030005, 0x0000001e, 0x00000000, 0x00070005, 0x00000020, 0x495f6c67, 0x6174736e, 0x4965636e, 0x7865646e, 0x00000000, 0x00050005, 0x00000027, 0x705f6e69, 0x7469736f, 0x006e6f69, 0x00040005, 0x00000032, 0x67617266, 0x0076755f,
-    0x00040005, 0x00000034, 0x755f6e69, 0x00000076, 0x00050005, 0x00000036, 0x67617266, 0x6c6f635f, 0x0000726f, 0x00050005, 0x00000038, 0x635f6e69, 0x726f6c6f, 0x00000000, 0x00050005, 0x0000003b, 0x5f74756f, 0x6d726f6e, 0x00006c61, 0x00050005,
-    0x0000003c, 0x6e5f6e69, 0x616d726f, 0x0000006c, 0x00030047, 0x0000000b, 0x00000002, 0x00050048, 0x0000000b, 0x00000000, 0x0000000b, 0x00000000, 0x00050048, 0x0000000b, 0x00000001, 0x0000000b, 0x00000001, 0x00050048, 0x0000000b, 0x00000002,
-    0x0000000b, 0x00000003, 0x00050048, 0x0000000b, 0x00000003, 0x0000000b, 0x00000004, 0x00030047, 0x00000015, 0x00000002, 0x00040048, 0x00000015, 0x00000000, 0x00000005, 0x00050048, 0x00000015, 0x00000000, 0x00000007, 0x00000010, 0x00050048,
-    0x00000015, 0x00000000, 0x00000023, 0x00000000, 0x00040047, 0x00000017, 0x00000021, 0x00000000, 0x00040047, 0x00000017, 0x00000022, 0x00000000, 0x00040047, 0x0000001b, 0x00000006, 0x00000040, 0x00030047, 0x0000001c, 0x00000003, 0x00040048,
-    0x0000001c, 0x00000000, 0x00000005, 0x00050048, 0x0000001c, 0x00000000, 0x00000007, 0x00000010, 0x00040048, 0x0000001c, 0x00000000, 0x00000018, 0x00050048, 0x0000001c, 0x00000000, 0x00000023, 0x00000000, 0x00030047, 0x0000001e, 0x00000018,
-    0x00040047, 0x0000001e, 0x00000021, 0x00000003, 0x00040047, 0x0000001e, 0x00000022, 0x00000000, 0x00040047, 0x00000020, 0x0000000b, 0x0000002b, 0x00040047, 0x00000027, 0x0000001e, 0x00000000, 0x00040047, 0x00000032, 0x0000001e, 0x00000000,
-    0x00040047, 0x00000034, 0x0000001e, 0x00000001, 0x00040047, 0x00000036, 0x0000001e, 0x00000001, 0x00040047, 0x00000038, 0x0000001e, 0x00000003, 0x00040047, 0x0000003b, 0x0000001e, 0x00000002, 0x00040047, 0x0000003c, 0x0000001e, 0x00000002,
-    0x00020013, 0x00000002, 0x00030021, 0x00000003, 0x00000002, 0x00030016, 0x00000006, 0x00000020, 0x00040017, 0x00000007, 0x00000006, 0x00000004, 0x00040015, 0x00000008, 0x00000020, 0x00000000, 0x0004002b, 0x00000008, 0x00000009, 0x00000001,
-    0x0004001c, 0x0000000a, 0x00000006, 0x00000009, 0x0006001e, 0x0000000b, 0x00000007, 0x00000006, 0x0000000a, 0x0000000a, 0x00040020, 0x0000000c, 0x00000003, 0x0000000b, 0x0004003b, 0x0000000c, 0x0000000d, 0x00000003, 0x00040015, 0x0000000e,
-    0x00000020, 0x00000001, 0x0004002b, 0x0000000e, 0x0000000f, 0x00000001, 0x0004002b, 0x00000006, 0x00000010, 0x3f800000, 0x00040020, 0x00000011, 0x00000003, 0x00000006, 0x0004002b, 0x0000000e, 0x00000013, 0x00000000, 0x00040018, 0x00000014,
-    0x00000007, 0x00000004, 0x0003001e, 0x00000015, 0x00000014, 0x00040020, 0x00000016, 0x00000002, 0x00000015, 0x0004003b, 0x00000016, 0x00000017, 0x00000002, 0x00040020, 0x00000018, 0x00000002, 0x00000014, 0x0003001d, 0x0000001b, 0x00000014,
-    0x0003001e, 0x0000001c, 0x0000001b, 0x00040020, 0x0000001d, 0x00000002, 0x0000001c, 0x0004003b, 0x0000001d, 0x0000001e, 0x00000002, 0x00040020, 0x0000001f, 0x00000001, 0x0000000e, 0x0004003b, 0x0000001f, 0x00000020, 0x00000001, 0x00040017,
-    0x00000025, 0x00000006, 0x00000003, 0x00040020, 0x00000026, 0x00000001, 0x00000025, 0x0004003b, 0x00000026, 0x00000027, 0x00000001, 0x00040020, 0x0000002e, 0x00000003, 0x00000007, 0x00040017, 0x00000030, 0x00000006, 0x00000002, 0x00040020,
-    0x00000031, 0x00000003, 0x00000030, 0x0004003b, 0x00000031, 0x00000032, 0x00000003, 0x00040020, 0x00000033, 0x00000001, 0x00000030, 0x0004003b, 0x00000033, 0x00000034, 0x00000001, 0x0004003b, 0x0000002e, 0x00000036, 0x00000003, 0x00040020,
-    0x00000037, 0x00000001, 0x00000007, 0x0004003b, 0x00000037, 0x00000038, 0x00000001, 0x00040020, 0x0000003a, 0x00000003, 0x00000025, 0x0004003b, 0x0000003a, 0x0000003b, 0x00000003, 0x0004003b, 0x00000026, 0x0000003c, 0x00000001, 0x00050036,
-    0x00000002, 0x00000004, 0x00000000, 0x00000003, 0x000200f8, 0x00000005, 0x00050041, 0x00000011, 0x00000012, 0x0000000d, 0x0000000f, 0x0003003e, 0x00000012, 0x00000010, 0x00050041, 0x00000018, 0x00000019, 0x00000017, 0x00000013, 0x0004003d,
-    0x00000014, 0x0000001a, 0x00000019, 0x0004003d, 0x0000000e, 0x00000021, 0x00000020, 0x00060041, 0x00000018, 0x00000022, 0x0000001e, 0x00000013, 0x00000021, 0x0004003d, 0x00000014, 0x00000023, 0x00000022, 0x00050092, 0x00000014, 0x00000024,
-    0x0000001a, 0x00000023, 0x0004003d, 0x00000025, 0x00000028, 0x00000027, 0x00050051, 0x00000006, 0x00000029, 0x00000028, 0x00000000, 0x00050051, 0x00000006, 0x0000002a, 0x00000028, 0x00000001, 0x00050051, 0x00000006, 0x0000002b, 0x00000028,
-    0x00000002, 0x00070050, 0x00000007, 0x0000002c, 0x00000029, 0x0000002a, 0x0000002b, 0x00000010, 0x00050091, 0x00000007, 0x0000002d, 0x00000024, 0x0000002c, 0x00050041, 0x0000002e, 0x0000002f, 0x0000000d, 0x00000013, 0x0003003e, 0x0000002f,
-    0x0000002d, 0x0004003d, 0x00000030, 0x00000035, 0x00000034, 0x0003003e, 0x00000032, 0x00000035, 0x0004003d, 0x00000007, 0x00000039, 0x00000038, 0x0003003e, 0x00000036, 0x00000039, 0x0004003d, 0x00000025, 0x0000003d, 0x0000003c, 0x0003003e,
-    0x0000003b, 0x0000003d, 0x000100fd, 0x00010038
-};
-const size_t default_vert_spv_data_len = 2096;
-const uint32_t default_frag_spv_data[] = {
-    0x07230203, 0x00010000, 0x0008000b, 0x00000020, 0x00000000, 0x00020011, 0x00000001, 0x0006000b, 0x00000001, 0x4c534c47, 0x6474732e, 0x3035342e, 0x00000000, 0x0003000e, 0x00000000, 0x00000001, 0x0008000f, 0x00000004, 0x00000004, 0x6e69616d,
-    0x00000000, 0x00000016, 0x0000001a, 0x0000001d, 0x00030010, 0x00000004, 0x00000007, 0x00030003, 0x00000002, 0x000001c2, 0x00090004, 0x415f4c47, 0x735f4252, 0x72617065, 0x5f657461, 0x64616873, 0x6f5f7265, 0x63656a62, 0x00007374, 0x00040005,
-    0x00000004, 0x6e69616d, 0x00000000, 0x00050005, 0x00000009, 0x43786574, 0x726f6c6f, 0x00000000, 0x00050005, 0x0000000c, 0x74786574, 0x30657275, 0x00000000, 0x00050005, 0x00000010, 0x53786574, 0x6c706d61, 0x00007265, 0x00040005, 0x00000016,
-    0x67617266, 0x0076755f, 0x00050005, 0x0000001a, 0x4374756f, 0x726f6c6f, 0x00000000, 0x00050005, 0x0000001d, 0x67617266, 0x6c6f635f, 0x0000726f, 0x00040047, 0x0000000c, 0x00000021, 0x00000001, 0x00040047, 0x0000000c, 0x00000022, 0x00000000,
-    0x00040047, 0x00000010, 0x00000021, 0x00000002, 0x00040047, 0x00000010, 0x00000022, 0x00000000, 0x00040047, 0x00000016, 0x0000001e, 0x00000000, 0x00040047, 0x0000001a, 0x0000001e, 0x00000000, 0x00040047, 0x0000001d, 0x0000001e, 0x00000001,
-    0x00020013, 0x00000002, 0x00030021, 0x00000003, 0x00000002, 0x00030016, 0x00000006, 0x00000020, 0x00040017, 0x00000007, 0x00000006, 0x00000004, 0x00040020, 0x00000008, 0x00000007, 0x00000007, 0x00090019, 0x0000000a, 0x00000006, 0x00000001,
-    0x00000000, 0x00000000, 0x00000000, 0x00000001, 0x00000000, 0x00040020, 0x0000000b, 0x00000000, 0x0000000a, 0x0004003b, 0x0000000b, 0x0000000c, 0x00000000, 0x0002001a, 0x0000000e, 0x00040020, 0x0000000f, 0x00000000, 0x0000000e, 0x0004003b,
-    0x0000000f, 0x00000010, 0x00000000, 0x0003001b, 0x00000012, 0x0000000a, 0x00040017, 0x00000014, 0x00000006, 0x00000002, 0x00040020, 0x00000015, 0x00000001, 0x00000014, 0x0004003b, 0x00000015, 0x00000016, 0x00000001, 0x00040020, 0x00000019,
-    0x00000003, 0x00000007, 0x0004003b, 0x00000019, 0x0000001a, 0x00000003, 0x00040020, 0x0000001c, 0x00000001, 0x00000007, 0x0004003b, 0x0000001c, 0x0000001d, 0x00000001, 0x00050036, 0x00000002, 0x00000004, 0x00000000, 0x00000003, 0x000200f8,
-    0x00000005, 0x0004003b, 0x00000008, 0x00000009, 0x00000007, 0x0004003d, 0x0000000a, 0x0000000d, 0x0000000c, 0x0004003d, 0x0000000e, 0x00000011, 0x00000010, 0x00050056, 0x00000012, 0x00000013, 0x0000000d, 0x00000011, 0x0004003d, 0x00000014,
-    0x00000017, 0x00000016, 0x00050057, 0x00000007, 0x00000018, 0x00000013, 0x00000017, 0x0003003e, 0x00000009, 0x00000018, 0x0004003d, 0x00000007, 0x0000001b, 0x00000009, 0x0004003d, 0x00000007, 0x0000001e, 0x0000001d, 0x00050085, 0x00000007,
-    0x0000001f, 0x0000001b, 0x0000001e, 0x0003003e, 0x0000001a, 0x0000001f, 0x000100fd, 0x00010038
-};
-const size_t default_frag_spv_data_len = 912;
+#if RENDERBATCH_TEXTURE_ARRAY == 1
+// Texture array variants of the default shader, layer RL_TEXTURE_INDEX_NONE draws untextured
+const char textureArrayShaderSource[] = "struct VertexInput {\n"
+"    @location(0) position: vec3f,\n"
+"    @location(1) uv: vec2f,\n"
+"    @location(2) normal: vec3f,\n"
+"    @location(3) color: vec4f,\n"
+"    @location(4) texIndex: u32,\n"
+"};\n"
+"\n"
+"struct VertexOutput {\n"
+"    @builtin(position) position: vec4f,\n"
+"    @location(0) uv: vec2f,\n"
+"    @location(1) color: vec4f,\n"
+"    @location(2) @interpolate(flat) texIndex: u32,\n"
+"};\n"
+"\n"
+"@group(0) @binding(0) var<uniform> Perspective_View: mat4x4f;\n"
+"@group(0) @binding(1) var texture0: texture_2d_array<f32>;\n"
+"@group(0) @binding(2) var texSampler: sampler;\n"
+"@group(0) @binding(3) var<storage, read> modelMatrix: array<mat4x4f>;\n"
+"\n"
+"@vertex\n"
+"fn vs_main(@builtin(instance_index) instanceIdx : u32, in: VertexInput) -> VertexOutput {\n"
+"    var out: VertexOutput;\n"
+"    out.position = Perspective_View * modelMatrix[instanceIdx] * vec4f(in.position.xyz, 1.0f);\n"
+"    out.color = in.color;\n"
+"    out.uv = in.uv;\n"
+"    out.texIndex = in.texIndex;\n"
+"    return out;\n"
+"}\n"
+"\n"
+"@fragment\n"
+"fn fs_main(in: VertexOutput) -> @location(0) vec4f {\n"
+"    let layer = min(in.texIndex, textureNumLayers(texture0) - 1u);\n"
+"    let texColor = textureSample(texture0, texSampler, in.uv, layer);\n"
+"    return select(texColor, vec4f(1.0f), in.texIndex == 0xFFFFFFFFu) * in.color;\n"
+"}\n";
+
+const char textureArrayVertexSourceGLSL[] = "#version 450\n"
+"layout(location = 0) in vec3 in_position;\n"
+"layout(location = 1) in vec2 in_uv;\n"
+"layout(location = 2) in vec3 in_normal;\n"
+"layout(location = 3) in vec4 in_color;\n"
+"layout(location = 4) in uint in_texIndex;\n"
+"layout(location = 0) out vec2 frag_uv;\n"
+"layout(location = 1) out vec4 frag_color;\n"
+"layout(location = 2) flat out uint frag_texIndex;\n"
+"layout(binding = 0) uniform Perspective_View {\n"
+"    mat4 pvmatrix;\n"
+"};\n"
+"layout(binding = 3) readonly buffer modelMatrix {\n"
+"    mat4 modelMatrices[];\n"
+"};\n"
+"void main() {\n"
+"    gl_Position = pvmatrix * modelMatrices[gl_InstanceIndex] * vec4(in_position, 1.0);\n"
+"    frag_uv = in_uv;\n"
+"    frag_color = in_color;\n"
+"    frag_texIndex = in_texIndex;\n"
+"}\n";
+
+const char textureArrayFragmentSourceGLSL[] = "#version 450\n"
+"layout(location = 0) in vec2 frag_uv;\n"
+"layout(location = 1) in vec4 frag_color;\n"
+"layout(location = 2) flat in uint frag_texIndex;\n"
+"layout(location = 0) out vec4 outColor;\n"
+"layout(binding = 1) uniform texture2DArray texture0;\n"
+"layout(binding = 2) uniform sampler texSampler;\n"
+"\n"
+"void main() {\n"
+"    uint layer = min(frag_texIndex, uint(textureSize(sampler2DArray(texture0, texSampler), 0).z) - 1u);\n"
+"    vec4 texColor = texture(sampler2DArray(texture0, texSampler), vec3(frag_uv, float(layer)));\n"
+"    outColor = (frag_texIndex == 0xFFFFFFFFu ? vec4(1.0) : texColor) * frag_color;\n"
+"}\n";
+#endif
 
 struct full_renderstate;
 #include "internal_include/renderstate.h"
@@ -194,6 +223,8 @@ RGAPI void* InitWindowEx(InitContext_Impl _ctx){
     g_renderstate.frameBufferFormat = PIXELFORMAT_UNCOMPRESSED_B8G8R8A8;
     #endif
     ctx->continuationPoint = InitWindowEx_ContinuationPoint;
+    ResetStartupPhases();
+    BeginStartupPhase("InitWindow");
     InitBackend(_ctx);
     
     return NULL;
@@ -207,6 +238,7 @@ void* InitWindowEx_ContinuationPoint(InitContext_Impl _ctx){
             exit(1);
         }
         SetTraceLogFile(stderr);
+        StartFrameCapture(stdout);
     }
     TRACELOG(LOG_INFO, "Hello!");
     cfs_path workingDirectory = {0};
@@ -220,22 +252,25 @@ void* InitWindowEx_ContinuationPoint(InitContext_Impl _ctx){
     g_renderstate.width  = ctx->windowWidth;
     g_renderstate.height = ctx->windowHeight;
     
+    BeginStartupPhase("WhitePixel");
     g_renderstate.whitePixel = LoadTextureFromImage(GenImageChecker(CLITERAL(Color){255,255,255,255}, CLITERAL(Color){255,255,255,255}, 1, 1, 0));
     texShapes = g_renderstate.whitePixel;
     TraceLog(LOG_INFO, "Loaded whitepixel texture");
+    EndStartupPhase();
 
     //DescribedShaderModule tShader = LoadShaderModuleFromMemory(shaderSource);
     
     Matrix identity = MatrixIdentity();
     g_renderstate.identityMatrix = GenStorageBuffer(&identity, sizeof(Matrix));
 
-    g_renderstate.grst = (GIFRecordState*)RL_CALLOC(1, 160);
+    // The default font, the quad index buffer and the GIF recording state are created on first use
 
 
 
     
     
     //void* window = nullptr;
+    BeginStartupPhase("Surface");
     if(!(g_renderstate.windowFlags & FLAG_HEADLESS)){
         #if SUPPORT_GLFW == 1 || SUPPORT_SDL2 == 1 || SUPPORT_SDL3 == 1 || SUPPORT_RGFW == 1
         #ifdef MAIN_WINDOW_GLFW
@@ -263,6 +298,7 @@ void* InitWindowEx_ContinuationPoint(InitContext_Impl _ctx){
         CreatedWindowMap_put(&g_renderstate.createdSubwindows, NULL, CLITERAL(RGWindowImpl){0});
         CreatedWindowMap_get(&g_renderstate.createdSubwindows, NULL)->surface = CreateHeadlessSurface(ctx->windowWidth, ctx->windowHeight, g_renderstate.frameBufferFormat);
     }
+    EndStartupPhase();
     
 
 
@@ -282,6 +318,7 @@ void* InitWindowEx_ContinuationPoint(InitContext_Impl _ctx){
     
     const RGTextureUsage renderAttachmentUsage = RGTextureUsage_RenderAttachment | RGTextureUsage_TextureBinding | RGTextureUsage_CopySrc;
 
+    BeginStartupPhase("RenderTargets");
     Texture2D colorTexture = LoadTextureEx(ctx->windowWidth, ctx->windowHeight, g_renderstate.frameBufferFormat, true);
     //g_wgpustate.mainWindowRenderTarget.texture = colorTexture;
     if(g_renderstate.windowFlags & FLAG_MSAA_4X_HINT)
@@ -294,26 +331,35 @@ void* InitWindowEx_ContinuationPoint(InitContext_Impl _ctx){
                                   1
     );
     g_renderstate.mainWindowRenderTarget.depth = depthTexture;
+    EndStartupPhase();
     
     TRACELOG(LOG_INFO, "Renderstate inited");
     g_renderstate.renderExtentX = ctx->windowWidth;
     g_renderstate.renderExtentY = ctx->windowHeight;
     
 
-    LoadFontDefault();
-    for(size_t i = 0;i < 4;i++){
-        DescribedBufferVector_push_back(&g_renderstate.smallBufferPool, GenVertexBuffer(NULL, sizeof(vertex) * VERTEX_BUFFER_CACHE_SIZE));
-    }
-
+    BeginStartupPhase("RenderBatch");
     vboptr = (vertex*)RL_CALLOC(10000, sizeof(vertex));
     vboptr_base = vboptr;
     renderBatchVBO = GenVertexBuffer(NULL, ((size_t)(RENDERBATCH_SIZE) * sizeof(vertex)));
     
     renderBatchVAO = LoadVertexArray();
+    #if RENDERBATCH_COMPACT_VERTICES == 1
+    // Normalized formats arrive as floats, so the default shaders are the same for both layouts
+    VertexAttribPointer(renderBatchVAO, renderBatchVBO, 0, RGVertexFormat_Float32x3, offsetof(vertex, pos)   , RGVertexStepMode_Vertex);
+    VertexAttribPointer(renderBatchVAO, renderBatchVBO, 1, RGVertexFormat_Unorm16x2, offsetof(vertex, uv)    , RGVertexStepMode_Vertex);
+    VertexAttribPointer(renderBatchVAO, renderBatchVBO, 2, RGVertexFormat_Snorm8x4 , offsetof(vertex, normal), RGVertexStepMode_Vertex);
+    VertexAttribPointer(renderBatchVAO, renderBatchVBO, 3, RGVertexFormat_Unorm8x4 , offsetof(vertex, col)   , RGVertexStepMode_Vertex);
+    #else
     VertexAttribPointer(renderBatchVAO, renderBatchVBO, 0, RGVertexFormat_Float32x3, 0 * sizeof(float), RGVertexStepMode_Vertex);
     VertexAttribPointer(renderBatchVAO, renderBatchVBO, 1, RGVertexFormat_Float32x2, 3 * sizeof(float), RGVertexStepMode_Vertex);
     VertexAttribPointer(renderBatchVAO, renderBatchVBO, 2, RGVertexFormat_Float32x3, 5 * sizeof(float), RGVertexStepMode_Vertex);
     VertexAttribPointer(renderBatchVAO, renderBatchVBO, 3, RGVertexFormat_Float32x4, 8 * sizeof(float), RGVertexStepMode_Vertex);
+    #endif
+    #if RENDERBATCH_TEXTURE_ARRAY == 1
+    // Only read by the texture array shader, other pipelines ignore the extra attribute
+    VertexAttribPointer(renderBatchVAO, renderBatchVBO, 4, RGVertexFormat_Uint32, offsetof(vertex, texIndex), RGVertexStepMode_Vertex);
+    #endif
 
     const RGColor opaqueBlack = {
         .r = 0.0,
@@ -324,55 +370,22 @@ void* InitWindowEx_ContinuationPoint(InitContext_Impl _ctx){
 
     g_renderstate.renderpass = LoadRenderpassEx(GetDefaultSettings(), false, opaqueBlack, false, 0.0f);
     g_renderstate.clearPass = LoadRenderpassEx(GetDefaultSettings(), true, opaqueBlack, true, 1.0f);
+    EndStartupPhase();
 
-    #if SUPPORT_GLSL_PARSER == 1
-    ShaderSources defaultGLSLSource = {0};
-    defaultGLSLSource.sourceCount = 2;
-    defaultGLSLSource.sources[0].data = vertexSourceGLSL;
-    defaultGLSLSource.sources[0].sizeInBytes = strlen(vertexSourceGLSL);
-    defaultGLSLSource.sources[0].stageMask = RGShaderStage_Vertex;
-    defaultGLSLSource.sources[1].data = fragmentSourceGLSL;
-    defaultGLSLSource.sources[1].sizeInBytes = strlen(fragmentSourceGLSL);
-    defaultGLSLSource.sources[1].stageMask = RGShaderStage_Fragment;
-    //g_renderstate.defaultShader = LoadPipelineForVAOEx(defaultGLSLSource, renderBatchVAO, uniforms, sizeof(uniforms) / sizeof(ResourceTypeDescriptor), GetDefaultSettings());
-    g_renderstate.defaultShader = LoadShaderFromMemory(vertexSourceGLSL, fragmentSourceGLSL);
-    #elif SUPPORT_WGSL_PARSER == 1
-    ShaderSources defaultWGSLSource = {0};
-    defaultWGSLSource.sourceCount = 1;
-    defaultWGSLSource.sources[0].data = shaderSource;
-    defaultWGSLSource.sources[0].sizeInBytes = strlen(shaderSource);
-    defaultWGSLSource.sources[0].stageMask = WGPUShaderStage_Vertex | WGPUShaderStage_Fragment;
-    //g_renderstate.defaultShader = LoadPipeline(shaderSource);
-    g_renderstate.defaultShader = LoadShaderSingleSource(shaderSource);
-
-    #else
-    ShaderSources defaultSPIRVSource = {0};
-    defaultSPIRVSource.sourceCount = 2;
-    defaultSPIRVSource.sources[0].data = default_vert_spv_data;
-    defaultSPIRVSource.sources[0].sizeInBytes = default_vert_spv_data_len;
-    defaultSPIRVSource.sources[0].stageMask = WGPUShaderStage_Vertex;
-    defaultSPIRVSource.sources[1].data = default_frag_spv_data;
-    defaultSPIRVSource.sources[1].sizeInBytes = default_frag_spv_data_len;
-    defaultSPIRVSource.sources[1].stageMask = WGPUShaderStage_Fragment;
-    g_renderstate.defaultShader = LoadShaderFromMemorySPIRV(defaultSPIRVSource);
-    #endif
-    g_renderstate.activeShader = g_renderstate.defaultShader;
-    size_t quadCount = 2000;
-    g_renderstate.quadindicesCache = GenBufferEx(NULL, quadCount * 6 * sizeof(uint32_t), WGPUBufferUsage_CopyDst | WGPUBufferUsage_Index);//allocnew(DescribedBuffer);    //WGPUBufferDescriptor vbmdesc{};
-    uint32_t* indices = (uint32_t*)RL_CALLOC(6 * quadCount, sizeof(uint32_t));
-    for(size_t i = 0;i < quadCount;i++){
-        indices[i * 6 + 0] = (i * 4 + 0);
-        indices[i * 6 + 1] = (i * 4 + 1);
-        indices[i * 6 + 2] = (i * 4 + 3);
-        indices[i * 6 + 3] = (i * 4 + 1);
-        indices[i * 6 + 4] = (i * 4 + 2);
-        indices[i * 6 + 5] = (i * 4 + 3);
+    BeginStartupPhase("DefaultShader");
+    // Precompiled, see src/builtin_shaders.c
+    ShaderBatchResult defaultShader;
+    if(!LoadBuiltinShader(BuiltinShader_Default, &defaultShader)){
+        TRACELOG(LOG_FATAL, "Default shader failed to load: %s", defaultShader.diagnostics);
     }
-    BufferData(g_renderstate.quadindicesCache, indices, 6 * quadCount * sizeof(uint32_t));
-    RL_FREE(indices);
+    g_renderstate.defaultShader = defaultShader.shader;
+    g_renderstate.activeShader = g_renderstate.defaultShader;
+    EndStartupPhase();
+
     Matrix m = ScreenMatrix(ctx->windowWidth, ctx->windowHeight);
     //static_assert(sizeof(Matrix) == 64, "non 4 byte floats? or what");
 
+    BeginStartupPhase("DefaultBindings");
     MatrixBufferPair_stack_push(&g_renderstate.matrixStack, CLITERAL(MatrixBufferPair){0});
     SetTexture(1, g_renderstate.whitePixel);
     Matrix iden = MatrixIdentity();
@@ -381,6 +394,7 @@ void* InitWindowEx_ContinuationPoint(InitContext_Impl _ctx){
     DescribedSampler sampler = LoadSampler(TEXTURE_WRAP_REPEAT, TEXTURE_FILTER_BILINEAR);
     g_renderstate.defaultSampler = sampler;
     SetSampler(2, sampler);
+    EndStartupPhase();
     g_renderstate.init_timestamp = NanoTime();
     g_renderstate.currentSettings = GetDefaultSettings();
     #ifndef __EMSCRIPTEN__
@@ -391,6 +405,7 @@ void* InitWindowEx_ContinuationPoint(InitContext_Impl _ctx){
         SetTargetFPS(0);
     
     #endif
+    FinishStartupProfile();
 
     if(ctx->finalContinuationPoint){
         ctx->finalContinuationPoint(ctx->setupFunction, ctx->renderFunction);
@@ -424,6 +439,7 @@ static void InitProgram_continuationPoint(SetupFunction x, RenderFunction y){
     while(!WindowShouldClose()){
         y();
     }
+    CloseWindow();
     #endif
 }
 
@@ -578,6 +594,11 @@ int GetMonitorHeight(cwoid){
     #endif
     return 0;
 }
+// The window and the device live until the process exits, this only finishes what still needs them
+void CloseWindow(){
+    StopFrameCapture();
+}
+
 void SetWindowShouldClose(){
     #ifdef MAIN_WINDOW_GLFW
     return SetWindowShouldClose_GLFW(g_renderstate.window);
@@ -68,55 +68,167 @@ void CopyBufferToBuffer(DescribedBuffer *source, DescribedBuffer *dest, size_t c
                                          0,
                                          count);
 }
-WGPUBuffer intermediary = 0;
-void CopyTextureToTexture(Texture source, Texture dest) {
-    size_t rowBytes = RoundUpToNextMultipleOf256(source.width) * GetPixelSizeInBytes(source.format);
-    WGPUBufferDescriptor bdesc = {
-        .size = rowBytes * source.height,
-        .usage =  WGPUBufferUsage_CopyDst | WGPUBufferUsage_CopySrc
-    };
+// Copies are recorded into an explicit copy batch if one is open, otherwise into the compute encoder
+// after ComputepassEndOnlyComputing, otherwise into a one-shot encoder that is submitted right away.
+static WGPUCommandEncoder g_copyBatchEncoder = NULL;
+static uint32_t g_copyBatchCount = 0;
+// Staging buffer for copies between formats that WebGPU cannot copy directly but that share a texel size
+static WGPUBuffer g_copyStaging = NULL;
+// Texture to texture copies were found not to work on WGVK, it keeps staging every copy through the buffer
+#if SUPPORT_VULKAN_BACKEND == 1
+    #define DIRECT_TEXTURE_COPY 0
+#else
+    #define DIRECT_TEXTURE_COPY 1
+#endif
 
-    if (!intermediary) {
-        intermediary = wgpuDeviceCreateBuffer((WGPUDevice)GetDevice(), &bdesc);
-    } else if (wgpuBufferGetSize(intermediary) < bdesc.size) {
-        wgpuBufferRelease(intermediary);
-        intermediary = wgpuDeviceCreateBuffer((WGPUDevice)GetDevice(), &bdesc);
+static WGPUCommandEncoder beginCopyCommands(bool* oneShot){
+    *oneShot = false;
+    if(g_copyBatchEncoder){
+        ++g_copyBatchCount;
+        return g_copyBatchEncoder;
+    }
+    if(g_renderstate.computepass.cmdEncoder && g_renderstate.computepass.cpEncoder == NULL){
+        return (WGPUCommandEncoder)g_renderstate.computepass.cmdEncoder;
     }
+    *oneShot = true;
+    return wgpuDeviceCreateCommandEncoder((WGPUDevice)GetDevice(), NULL);
+}
+
+static void submitCommands(WGPUCommandEncoder encoder){
+    WGPUCommandBufferDescriptor cmdBufferDescriptor = {0};
+    cmdBufferDescriptor.label = STRVIEW("CopyCB");
+    WGPUCommandBuffer command = wgpuCommandEncoderFinish(encoder, &cmdBufferDescriptor);
+    wgpuQueueSubmit(GetQueue(), 1, &command);
+    wgpuCommandBufferRelease(command);
+    wgpuCommandEncoderRelease(encoder);
+}
 
+static PixelFormat stripSRGB(PixelFormat format){
+    switch(format){
+        case PIXELFORMAT_UNCOMPRESSED_R8G8B8A8_SRGB: return PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+        case PIXELFORMAT_UNCOMPRESSED_B8G8R8A8_SRGB: return PIXELFORMAT_UNCOMPRESSED_B8G8R8A8;
+        default: return format;
+    }
+}
+
+static uint32_t mipExtent(uint32_t size, uint32_t mipLevel){
+    return mipLevel < 32 && (size >> mipLevel) ? size >> mipLevel : 1;
+}
+
+static void copyTextureRegion(WGPUTexture source, PixelFormat srcFormat, uint32_t srcWidth, uint32_t srcHeight, uint32_t srcSamples,
+                              WGPUTexture dest, PixelFormat dstFormat, uint32_t dstWidth, uint32_t dstHeight, uint32_t dstSamples, TextureCopyRegion region){
+    // Not every loader fills in sampleCount, treat 0 as single sampled
+    srcSamples = srcSamples ? srcSamples : 1;
+    dstSamples = dstSamples ? dstSamples : 1;
+    if(srcSamples != dstSamples){
+        TRACELOG(LOG_ERROR, "Cannot copy between textures with different sample counts (%u and %u)", srcSamples, dstSamples);
+        return;
+    }
+    const uint32_t srcMipWidth = mipExtent(srcWidth, region.srcMipLevel);
+    const uint32_t srcMipHeight = mipExtent(srcHeight, region.srcMipLevel);
+    const uint32_t dstMipWidth = mipExtent(dstWidth, region.dstMipLevel);
+    const uint32_t dstMipHeight = mipExtent(dstHeight, region.dstMipLevel);
+    if(region.srcX >= srcMipWidth || region.srcY >= srcMipHeight || region.dstX >= dstMipWidth || region.dstY >= dstMipHeight){
+        TRACELOG(LOG_ERROR, "Texture copy origin lies outside of the mip level");
+        return;
+    }
+    // Clamp the region to what is left of both mip levels from the origins
+    uint32_t width = srcMipWidth - region.srcX;
+    uint32_t height = srcMipHeight - region.srcY;
+    if(region.width && region.width < width)width = region.width;
+    if(region.height && region.height < height)height = region.height;
+    if(dstMipWidth - region.dstX < width)width = dstMipWidth - region.dstX;
+    if(dstMipHeight - region.dstY < height)height = dstMipHeight - region.dstY;
+    const WGPUExtent3D copySize = {
+        .width = width,
+        .height = height,
+        .depthOrArrayLayers = region.layerCount ? region.layerCount : 1,
+    };
     const WGPUTexelCopyTextureInfo src = {
-        .texture = (WGPUTexture)source.id,
+        .texture = source,
         .aspect = WGPUTextureAspect_All,
-        .mipLevel = 0,
-        .origin = {0, 0, 0},
-    };
-
-    const WGPUTexelCopyBufferInfo bdst = {
-        .buffer = intermediary,
-        .layout.rowsPerImage = source.height,
-        .layout.bytesPerRow = rowBytes,
-        .layout.offset = 0,
+        .mipLevel = region.srcMipLevel,
+        .origin = {region.srcX, region.srcY, region.srcLayer},
     };
-
-    const WGPUTexelCopyTextureInfo tdst = {
-        .texture = (WGPUTexture)dest.id,
+    const WGPUTexelCopyTextureInfo dst = {
+        .texture = dest,
         .aspect = WGPUTextureAspect_All,
-        .mipLevel = 0,
-        .origin = {0, 0, 0},
+        .mipLevel = region.dstMipLevel,
+        .origin = {region.dstX, region.dstY, region.dstLayer},
     };
 
-    const WGPUExtent3D copySize = {
-        .width = source.width,
-        .height = source.height,
-        .depthOrArrayLayers = 1,
-    };
+    bool oneShot;
+    WGPUCommandEncoder encoder = beginCopyCommands(&oneShot);
+    if(DIRECT_TEXTURE_COPY && stripSRGB(srcFormat) == stripSRGB(dstFormat)){
+        wgpuCommandEncoderCopyTextureToTexture(encoder, &src, &dst, &copySize);
+    }
+    else if(GetPixelSizeInBytes(srcFormat) == GetPixelSizeInBytes(dstFormat)){
+        const size_t rowBytes = RoundUpToNextMultipleOf256((uint64_t)copySize.width * GetPixelSizeInBytes(srcFormat));
+        const size_t size = rowBytes * copySize.height * copySize.depthOrArrayLayers;
+        if(g_copyStaging && wgpuBufferGetSize(g_copyStaging) < size){
+            // Buffers are refcounted, copies already recorded keep the old one alive
+            wgpuBufferRelease(g_copyStaging);
+            g_copyStaging = NULL;
+        }
+        if(g_copyStaging == NULL){
+            WGPUBufferDescriptor bdesc = {
+                .size = size,
+                .usage = WGPUBufferUsage_CopyDst | WGPUBufferUsage_CopySrc
+            };
+            g_copyStaging = wgpuDeviceCreateBuffer((WGPUDevice)GetDevice(), &bdesc);
+        }
+        const WGPUTexelCopyBufferInfo staging = {
+            .buffer = g_copyStaging,
+            .layout.rowsPerImage = copySize.height,
+            .layout.bytesPerRow = rowBytes,
+            .layout.offset = 0,
+        };
+        wgpuCommandEncoderCopyTextureToBuffer(encoder, &src, &staging, &copySize);
+        wgpuCommandEncoderCopyBufferToTexture(encoder, &staging, &dst, &copySize);
+    }
+    else{
+        TRACELOG(LOG_ERROR, "Cannot copy between pixel formats of different sizes");
+    }
+    if(oneShot){
+        submitCommands(encoder);
+    }
+}
+
+void BeginTextureCopies(cwoid){
+    if(g_copyBatchEncoder){
+        TRACELOG(LOG_WARNING, "BeginTextureCopies called twice");
+        return;
+    }
+    g_copyBatchEncoder = wgpuDeviceCreateCommandEncoder((WGPUDevice)GetDevice(), NULL);
+    g_copyBatchCount = 0;
+}
+
+void EndTextureCopies(cwoid){
+    if(g_copyBatchEncoder == NULL){
+        TRACELOG(LOG_WARNING, "EndTextureCopies called without BeginTextureCopies");
+        return;
+    }
+    if(g_copyBatchCount > 0){
+        submitCommands(g_copyBatchEncoder);
+    }
+    else{
+        wgpuCommandEncoderRelease(g_copyBatchEncoder);
+    }
+    g_copyBatchEncoder = NULL;
+}
 
-    wgpuCommandEncoderCopyTextureToBuffer((WGPUCommandEncoder)g_renderstate.computepass.cmdEncoder, &src, &bdst, &copySize);
-    wgpuCommandEncoderCopyBufferToTexture((WGPUCommandEncoder)g_renderstate.computepass.cmdEncoder, &bdst, &tdst, &copySize);
+void CopyTextureRegion(Texture source, Texture dest, TextureCopyRegion region){
+    copyTextureRegion((WGPUTexture)source.id, source.format, source.width, source.height, source.sampleCount,
+                      (WGPUTexture)dest.id, dest.format, dest.width, dest.height, dest.sampleCount, region);
+}
 
-    // Doesnt work unfortunately:
-    // wgpuCommandEncoderCopyTextureToTexture(g_renderstate.computepass.cmdEncoder, &src, &dst, &copySize);
+void CopyTextureArrayRegion(Texture2DArray source, Texture2DArray dest, TextureCopyRegion region){
+    copyTextureRegion((WGPUTexture)source.id, source.format, source.width, source.height, source.sampleCount,
+                      (WGPUTexture)dest.id, dest.format, dest.width, dest.height, dest.sampleCount, region);
+}
 
-    // wgpuBufferRelease(intermediary);
+void CopyTextureToTexture(Texture source, Texture dest) {
+    CopyTextureRegion(source, dest, CLITERAL(TextureCopyRegion){0});
 }
 
 void DispatchCompute(uint32_t x, uint32_t y, uint32_t z) {
@@ -212,9 +324,15 @@ void EndComputepassEx(DescribedComputepass *computePass) {
     wgpuQueueSubmit(GetQueue(), 1, &command);
     wgpuCommandBufferRelease(command);
     wgpuCommandEncoderRelease((WGPUCommandEncoder)computePass->cmdEncoder);
+    computePass->cmdEncoder = NULL;
 }
 
 void UnloadTexture(Texture tex) {
+    const void *views[MAX_MIP_LEVELS + 1] = {tex.view};
+    for (uint32_t i = 0; i < tex.mipmaps && i < MAX_MIP_LEVELS; i++) {
+        views[i + 1] = tex.mipViews[i];
+    }
+    BindGroupCachePurge(views, MAX_MIP_LEVELS + 1);
     for (uint32_t i = 0; i < tex.mipmaps; i++) {
         if (tex.mipViews[i]) {
             wgpuTextureViewRelease((WGPUTextureView)tex.mipViews[i]);
@@ -234,6 +352,17 @@ void PresentSurface(FullSurface *fsurface) {
     wgpuSurfacePresent((WGPUSurface)fsurface->surface); 
 }
 
+static inline size_t dynamicOffsetCount(const DescribedBindGroup *bg) {
+    return bg->layout ? bitcount64(bg->layout->dynamicOffsetMask) : 0;
+}
+// Position of a binding's offset inside DescribedBindGroup::dynamicOffsets, or -1
+static inline int dynamicOffsetIndex(const DescribedBindGroup *bg, uint32_t binding) {
+    if (!bg->layout || binding >= 64 || !(bg->layout->dynamicOffsetMask & (1ull << binding))) {
+        return -1;
+    }
+    return (int)bitcount64(bg->layout->dynamicOffsetMask & ((1ull << binding) - 1));
+}
+
 static inline uint64_t bgEntryHash(WGPUBindGroupEntry bge) {
     const uint32_t rotation = (bge.binding * 7) & 63;
     uint64_t value = ROT_BYTES((uint64_t)bge.buffer, rotation);
@@ -248,9 +377,9 @@ void BindShaderWithSettings(Shader shader, PrimitiveType drawMode, RenderSetting
     ShaderImpl *impl = allocatedShaderIDs_shc + shader.id;
     impl->state.primitiveType = drawMode;
     impl->state.settings = settings;
-    WGPURenderPipeline activePipeline = PipelineHashMap_getOrCreate(&impl->pipelineCache, &impl->state, &impl->shaderModule, &impl->bglayout, &impl->layout);
+    WGPURenderPipeline activePipeline = GetOrCreateRenderPipeline(shader.id);
     wgpuRenderPassEncoderSetPipeline(g_renderstate.activeRenderpass->rpEncoder, activePipeline);
-    wgpuRenderPassEncoderSetBindGroup(g_renderstate.activeRenderpass->rpEncoder, 0, UpdateAndGetNativeBindGroup(&impl->bindGroup), 0, NULL);
+    wgpuRenderPassEncoderSetBindGroup(g_renderstate.activeRenderpass->rpEncoder, 0, UpdateAndGetNativeBindGroup(&impl->bindGroup), dynamicOffsetCount(&impl->bindGroup), impl->bindGroup.dynamicOffsets);
 }
 
 void BindShader(Shader shader, PrimitiveType drawMode) {
@@ -302,7 +431,11 @@ WGPURenderPassDepthStencilAttachment *defaultDSA(WGPUTextureView depth) {
     dsa->stencilReadOnly = true;
     return dsa;
 }
-void UnloadSampler(DescribedSampler sampler) { wgpuSamplerRelease((WGPUSampler)sampler.sampler); }
+void UnloadSampler(DescribedSampler sampler) {
+    const void *resource = sampler.sampler;
+    BindGroupCachePurge(&resource, 1);
+    wgpuSamplerRelease((WGPUSampler)sampler.sampler);
+}
 void ResizeBufferAndConserve(DescribedBuffer *buffer, size_t newSize) {
     if (newSize == buffer->size)
         return;
@@ -460,8 +593,26 @@ DescribedBindGroupLayout LoadBindGroupLayout(const ResourceTypeDescriptor *unifo
     memset(blayouts, 0, (size_t)uniformCount * sizeof(WGPUBindGroupLayoutEntry));
     
     
+    // Render layouts get dynamic offsets on their buffer bindings so that SetUniformBufferData & co.
+    // can sub-allocate from the uniform ring without creating a new bind group per draw.
+    uint32_t dynamicUniforms = 0, dynamicStorages = 0;
     for(uint32_t i = 0;i < uniformCount;i++){
         blayouts[i] = toWGPUBindGroupLayoutEntry(uniforms + i, compute ? RGShaderStage_Compute : (RGShaderStage_Vertex | RGShaderStage_Fragment));
+        if(compute || uniforms[i].location >= 64){
+            continue;
+        }
+        if(uniforms[i].type == uniform_buffer && dynamicUniforms < MAX_DYNAMIC_UNIFORM_BUFFERS){
+            ++dynamicUniforms;
+        }
+        // Writable storage may not share a buffer with read-only bindings in one usage scope, it keeps dedicated buffers
+        else if(uniforms[i].type == storage_buffer && uniforms[i].access == access_type_readonly && dynamicStorages < MAX_DYNAMIC_STORAGE_BUFFERS){
+            ++dynamicStorages;
+        }
+        else{
+            continue;
+        }
+        blayouts[i].buffer.hasDynamicOffset = true;
+        ret.dynamicOffsetMask |= (1ull << uniforms[i].location);
     }
     const WGPUBindGroupLayoutDescriptor bglayoutdesc = {
         .entryCount = uniformCount,
@@ -620,10 +771,31 @@ const char mipmapComputerSource2[] =
 "    ) * 0.25;\n"
 "    textureStore(nextMipLevel, id.xy, color);\n"
 "}\n";
+// Same shader for glslang, the embedded SPIR-V of the mipmap built-in is generated from it
+const char mipmapComputeSourceGLSL[] = "#version 450\n"
+"#extension GL_EXT_samplerless_texture_functions : require\n"
+"layout(local_size_x = 8, local_size_y = 8) in;\n"
+"layout(binding = 0) uniform texture2D previousMipLevel;\n"
+"layout(binding = 1, rgba8) uniform writeonly image2D nextMipLevel;\n"
+"void main() {\n"
+"    ivec2 id = ivec2(gl_GlobalInvocationID.xy);\n"
+"    vec4 color = (\n"
+"        texelFetch(previousMipLevel, 2 * id + ivec2(0, 0), 0) +\n"
+"        texelFetch(previousMipLevel, 2 * id + ivec2(0, 1), 0) +\n"
+"        texelFetch(previousMipLevel, 2 * id + ivec2(1, 0), 0) +\n"
+"        texelFetch(previousMipLevel, 2 * id + ivec2(1, 1), 0)\n"
+"    ) * 0.25;\n"
+"    imageStore(nextMipLevel, id, color);\n"
+"}\n";
 DescribedComputePipeline *mipmap__cpl = 0;
 void GenTextureMipmaps(Texture2D *tex) {
     if(mipmap__cpl == NULL){
-        mipmap__cpl = LoadComputePipeline(mipmapComputerSource2);
+        ShaderBatchResult loaded;
+        if(!LoadBuiltinShader(BuiltinShader_Mipmap, &loaded)){
+            TRACELOG(LOG_ERROR, "Mipmap shader failed to load: %s", loaded.diagnostics);
+            return;
+        }
+        mipmap__cpl = loaded.computePipeline;
     }
     BeginComputepass();
 
@@ -640,30 +812,289 @@ void GenTextureMipmaps(Texture2D *tex) {
     EndComputepass();
 }
 
+// Device-level bind group cache, keyed by (layout, descriptorHash, entries).
+// Every DescribedBindGroup that resolves to the same resources shares one native bind group,
+// so switching back and forth between a handful of textures costs a lookup instead of a
+// wgpuDeviceCreateBindGroup. The cache holds one reference per native bind group; entries that
+// were not used for BINDGROUP_CACHE_MAX_AGE frames are dropped, a full cache drops its least
+// recently used eighth, and unloading a buffer, texture or sampler drops the entries that use it.
+typedef struct BindGroupCacheKey {
+    WGPUBindGroupLayout layout;
+    uint64_t descriptorHash;
+    uint32_t entryCount;
+    ResourceDescriptor *entries;
+} BindGroupCacheKey;
+
+typedef struct BindGroupCacheValue {
+    WGPUBindGroup bindGroup;
+    uint64_t lastUsedFrame;
+    uint64_t lastUse;       // Ticks on every lookup, orders entries used within the same frame
+} BindGroupCacheValue;
+
+static inline bool ResourceDescriptor_eq(const ResourceDescriptor *a, const ResourceDescriptor *b) {
+    return a->binding == b->binding && a->buffer == b->buffer && a->offset == b->offset && a->size == b->size &&
+           a->sampler == b->sampler && a->textureView == b->textureView
+#if SUPPORT_VULKAN_BACKEND == 1
+           && a->accelerationStructure == b->accelerationStructure
+#endif
+        ;
+}
+static inline uint64_t BindGroupCacheKey_hash(const BindGroupCacheKey key) {
+    return key.descriptorHash ^ ROT_BYTES((uint64_t)key.layout, 29) ^ ((uint64_t)key.entryCount * 0x9E3779B97F4A7C15ull);
+}
+static inline bool BindGroupCacheKey_eq(const BindGroupCacheKey a, const BindGroupCacheKey b) {
+    if (a.layout != b.layout || a.descriptorHash != b.descriptorHash || a.entryCount != b.entryCount) {
+        return false;
+    }
+    for (uint32_t i = 0; i < a.entryCount; i++) {
+        if (!ResourceDescriptor_eq(a.entries + i, b.entries + i)) {
+            return false;
+        }
+    }
+    return true;
+}
+static BindGroupCacheKey BindGroupCacheKey_copy(const BindGroupCacheKey key) {
+    BindGroupCacheKey ret = key;
+    if (key.entryCount > 0) {
+        ret.entries = (ResourceDescriptor *)RL_CALLOC(key.entryCount, sizeof(ResourceDescriptor));
+        memcpy(ret.entries, key.entries, key.entryCount * sizeof(ResourceDescriptor));
+    }
+    return ret;
+}
+static void BindGroupCacheKey_free(BindGroupCacheKey key) { RL_FREE(key.entries); }
+static BindGroupCacheValue BindGroupCacheValue_copy(const BindGroupCacheValue value) {
+    wgpuBindGroupAddRef(value.bindGroup);
+    return value;
+}
+static void BindGroupCacheValue_free(BindGroupCacheValue value) { wgpuBindGroupRelease(value.bindGroup); }
+
+RG_DEFINE_GENERIC_HASH_MAP(static inline, BindGroupCache, BindGroupCacheKey, BindGroupCacheValue, BindGroupCacheKey_hash, BindGroupCacheKey_eq, CLITERAL(BindGroupCacheKey){0}, BindGroupCacheKey_copy, BindGroupCacheValue_copy, BindGroupCacheKey_free, BindGroupCacheValue_free)
+
+static BindGroupCache g_bindGroupCache = {0};
+static BindGroupCacheStats g_bindGroupCacheStats = {0};
+static uint64_t g_bindGroupCacheTick = 0;
+
+typedef bool (*BindGroupCacheDropFunc)(const BindGroupCache_kv_pair *kv, const void *userdata);
+
+// Lower bound of lastUsedFrame over all entries, UINT64_MAX while empty. Hits and inserts only
+// make entries newer, so it stays valid until the next rebuild recomputes it
+static uint64_t g_bindGroupCacheOldestFrame = UINT64_MAX;
+
+typedef bool (*BindGroupCacheDropFunc)(const BindGroupCache_kv_pair *kv, const void *userdata);
+
+// The generic map has no tombstones, so dropping several entries rebuilds the table from the survivors
+static void bindGroupCacheDropIf(BindGroupCacheDropFunc drop, const void *userdata) {
+    bool any = false;
+    uint64_t oldest = UINT64_MAX;
+    for (uint64_t i = 0; !any && i < g_bindGroupCache.current_capacity; i++) {
+        const BindGroupCache_kv_pair *kv = g_bindGroupCache.table + i;
+        if (kv->key.layout == NULL) {
+            continue;
+        }
+        any = drop(kv, userdata);
+        if (kv->value.lastUsedFrame < oldest) {
+            oldest = kv->value.lastUsedFrame;
+        }
+    }
+    if (!any) {
+        // Hits may have refreshed the oldest entry since the bound was computed
+        g_bindGroupCacheOldestFrame = oldest;
+        return;
+    }
+    BindGroupCache survivors;
+    BindGroupCache_init(&survivors);
+    g_bindGroupCacheOldestFrame = UINT64_MAX;
+    for (uint64_t i = 0; i < g_bindGroupCache.current_capacity; i++) {
+        BindGroupCache_kv_pair *kv = g_bindGroupCache.table + i;
+        if (kv->key.layout == NULL) {
+            continue;
+        }
+        if (!drop(kv, userdata)) {
+            BindGroupCache_put(&survivors, kv->key, kv->value);
+            if (kv->value.lastUsedFrame < g_bindGroupCacheOldestFrame) {
+                g_bindGroupCacheOldestFrame = kv->value.lastUsedFrame;
+            }
+        } else {
+            ++g_bindGroupCacheStats.evictions;
+        }
+    }
+    BindGroupCache_free(&g_bindGroupCache);
+    BindGroupCache_move(&g_bindGroupCache, &survivors);
+}
+
+// Returns the k-th smallest value (0-based), reorders values
+static uint64_t selectNthSmallest(uint64_t *values, uint64_t count, uint64_t k) {
+    uint64_t lo = 0, hi = count - 1;
+    while (lo < hi) {
+        const uint64_t pivot = values[lo + (hi - lo) / 2];
+        uint64_t i = lo, j = hi;
+        while (i <= j) {
+            while (values[i] < pivot) ++i;
+            while (values[j] > pivot) --j;
+            if (i <= j) {
+                const uint64_t tmp = values[i];
+                values[i] = values[j];
+                values[j] = tmp;
+                ++i;
+                if (j == 0) break;
+                --j;
+            }
+        }
+        if (k <= j) {
+            hi = j;
+        } else if (k >= i) {
+            lo = i;
+        } else {
+            break;
+        }
+    }
+    return values[k];
+}
+
+static bool bindGroupCacheUsedBefore(const BindGroupCache_kv_pair *kv, const void *tick) {
+    return kv->value.lastUse <= *(const uint64_t *)tick;
+}
+
+// A full cache drops its least recently used eighth in one rebuild, so misses are O(1) amortized
+static void bindGroupCacheEvictLRU() {
+    const uint64_t count = g_bindGroupCache.current_size;
+    if (count == 0) {
+        return;
+    }
+    uint64_t *lastUses = (uint64_t *)RL_MALLOC(count * sizeof(uint64_t));
+    if (lastUses == NULL) {
+        ClearBindGroupCache();
+        return;
+    }
+    uint64_t n = 0;
+    for (uint64_t i = 0; i < g_bindGroupCache.current_capacity; i++) {
+        const BindGroupCache_kv_pair *kv = g_bindGroupCache.table + i;
+        if (kv->key.layout != NULL) {
+            lastUses[n++] = kv->value.lastUse;
+        }
+    }
+    const uint64_t batch = count >= 8 ? count / 8 : 1;
+    const uint64_t threshold = selectNthSmallest(lastUses, n, batch - 1);
+    RL_FREE(lastUses);
+    bindGroupCacheDropIf(bindGroupCacheUsedBefore, &threshold);
+}
+
+static bool bindGroupCacheOlderThan(const BindGroupCache_kv_pair *kv, const void *frame) {
+    return kv->value.lastUsedFrame < *(const uint64_t *)frame;
+}
+
+// Only walks the table when its oldest entry can have aged out
+void BindGroupCacheEndFrame(cwoid) {
+    const uint64_t frame = g_renderstate.total_frames;
+    if (frame < BINDGROUP_CACHE_MAX_AGE) {
+        return;
+    }
+    const uint64_t oldestKept = frame - BINDGROUP_CACHE_MAX_AGE;
+    if (g_bindGroupCacheOldestFrame >= oldestKept) {
+        return;
+    }
+    bindGroupCacheDropIf(bindGroupCacheOlderThan, &oldestKept);
+}
+
+typedef struct BindGroupCacheResources {
+    const void *const *resources;
+    uint32_t count;
+} BindGroupCacheResources;
+
+static bool bindGroupCacheUsesResource(const BindGroupCache_kv_pair *kv, const void *userdata) {
+    const BindGroupCacheResources *set = (const BindGroupCacheResources *)userdata;
+    for (uint32_t i = 0; i < kv->key.entryCount; i++) {
+        const ResourceDescriptor *entry = kv->key.entries + i;
+        for (uint32_t j = 0; j < set->count; j++) {
+            const void *resource = set->resources[j];
+            if (resource != NULL && (entry->buffer == resource || entry->textureView == resource || entry->sampler == resource)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// Cached bind groups hold references to their resources, without this an unloaded resource
+// would stay alive until its entries age out
+void BindGroupCachePurge(const void *const *resources, uint32_t count) {
+    if (g_bindGroupCache.current_size == 0) {
+        return;
+    }
+    const BindGroupCacheResources set = {resources, count};
+    bindGroupCacheDropIf(bindGroupCacheUsesResource, &set);
+}
+
+RGAPI BindGroupCacheStats GetBindGroupCacheStats(cwoid) {
+    BindGroupCacheStats ret = g_bindGroupCacheStats;
+    ret.entryCount = (uint32_t)g_bindGroupCache.current_size;
+    return ret;
+}
+
+RGAPI void ClearBindGroupCache(cwoid) {
+    g_bindGroupCacheStats.evictions += g_bindGroupCache.current_size;
+    BindGroupCache_free(&g_bindGroupCache);
+    g_bindGroupCacheOldestFrame = UINT64_MAX;
+}
+
+static WGPUBindGroup createNativeBindGroup(const DescribedBindGroup *bg) {
+    WGPUBindGroupDescriptor desc = {0};
+    WGPUBindGroupEntry *aswgpu = (WGPUBindGroupEntry *)VLAStack_alloc(&g_vlastack, bg->entryCount * sizeof(WGPUBindGroupEntry));
+    for (uint32_t i = 0; i < bg->entryCount; i++) {
+        WGPUBindGroupEntry *to = aswgpu + i;
+        const ResourceDescriptor *from = bg->entries + i;
+        *to = CLITERAL(WGPUBindGroupEntry){0};
+        to->binding = from->binding;
+        to->buffer = from->buffer;
+        to->offset = from->offset;
+        to->size = from->size;
+        to->sampler = from->sampler;
+        to->textureView = from->textureView;
+    }
+
+    desc.entries = aswgpu;
+    desc.entryCount = bg->entryCount;
+    desc.layout = bg->layout->layout;
+    WGPUBindGroup ret = wgpuDeviceCreateBindGroup(GetDevice(), &desc);
+    VLAStack_free(&g_vlastack, aswgpu);
+    return ret;
+}
+
 void UpdateBindGroup(DescribedBindGroup *bg) {
-    // std::cout << "Updating bindgroup with " << bg->desc.entryCount << " entries" << std::endl;
-    // std::cout << "Updating bindgroup with " << bg->desc.entries[1].binding << " entries" << std::endl;
-    if (bg->needsUpdate) {
-        WGPUBindGroupDescriptor desc  = {0};
-        WGPUBindGroupEntry* aswgpu = (WGPUBindGroupEntry*)RL_CALLOC(bg->entryCount, sizeof(WGPUBindGroupEntry));
-        for (uint32_t i = 0; i < bg->entryCount; i++) {
-            WGPUBindGroupEntry* to = aswgpu + i;
-            const ResourceDescriptor* from = bg->entries + i;
-            to->binding = from->binding;
-            to->buffer = from->buffer;
-            to->offset = from->offset;
-            to->size = from->size;
-            to->sampler = from->sampler;
-            to->textureView = from->textureView;
-        }
-
-        desc.entries = aswgpu;
-        desc.entryCount = bg->entryCount;
-        desc.layout = bg->layout->layout;
-        bg->bindGroup = wgpuDeviceCreateBindGroup(GetDevice(), &desc);
-        bg->needsUpdate = false;
-        RL_FREE(aswgpu);
+    if (!bg->needsUpdate) {
+        return;
     }
+    if (bg->bindGroup) {
+        wgpuBindGroupRelease((WGPUBindGroup)bg->bindGroup);
+        bg->bindGroup = NULL;
+    }
+    const BindGroupCacheKey key = {
+        .layout = (WGPUBindGroupLayout)bg->layout->layout,
+        .descriptorHash = bg->descriptorHash,
+        .entryCount = bg->entryCount,
+        .entries = bg->entries,
+    };
+    BindGroupCacheValue *cached = key.layout ? BindGroupCache_get(&g_bindGroupCache, key) : NULL;
+    if (cached) {
+        ++g_bindGroupCacheStats.hits;
+        cached->lastUsedFrame = g_renderstate.total_frames;
+        cached->lastUse = ++g_bindGroupCacheTick;
+        wgpuBindGroupAddRef(cached->bindGroup);
+        bg->bindGroup = cached->bindGroup;
+    } else {
+        ++g_bindGroupCacheStats.misses;
+        bg->bindGroup = createNativeBindGroup(bg);
+        if (key.layout && bg->bindGroup) {
+            if (g_bindGroupCache.current_size >= BINDGROUP_CACHE_CAPACITY) {
+                bindGroupCacheEvictLRU();
+            }
+            BindGroupCache_put(&g_bindGroupCache, key, CLITERAL(BindGroupCacheValue){bg->bindGroup, g_renderstate.total_frames, ++g_bindGroupCacheTick});
+            if (g_renderstate.total_frames < g_bindGroupCacheOldestFrame) {
+                g_bindGroupCacheOldestFrame = g_renderstate.total_frames;
+            }
+        }
+    }
+    bg->needsUpdate = false;
 }
 
 static inline uint64_t bgEntryHashRD(const ResourceDescriptor bge) {
@@ -686,8 +1117,6 @@ void UpdateBindGroupEntry(DescribedBindGroup *bg, size_t index, ResourceDescript
     if (newtexture && bg->entries[index].textureView == newtexture) {
         // return;
     }
-    uint64_t oldHash = bg->descriptorHash;
-    
     bg->descriptorHash ^= bgEntryHashRD(bg->entries[index]);
     if (entry.buffer) {
         wgpuBufferAddRef((WGPUBuffer)entry.buffer);
@@ -708,16 +1137,20 @@ void UpdateBindGroupEntry(DescribedBindGroup *bg, size_t index, ResourceDescript
     bg->entries[index] = entry;
     bg->descriptorHash ^= bgEntryHashRD(bg->entries[index]);
 
-    // TODO don't release and recreate here or find something better
-    if (true /*|| donotcache*/) {
-        if (bg->bindGroup)
-            wgpuBindGroupRelease((WGPUBindGroup)bg->bindGroup);
-        bg->bindGroup = NULL;
+    const int dynamicIndex = dynamicOffsetIndex(bg, entry.binding);
+    if (dynamicIndex >= 0) {
+        bg->dynamicOffsets[dynamicIndex] = 0;
+        if (bg->dynamicUploads) {
+            // No longer backed by a ring upload; bindgroupRingUpload restores this after the call
+            bg->dynamicUploads->size[dynamicIndex] = 0;
+        }
     }
-    // else if(!bg->needsUpdate && bg->bindGroup){
-    //     g_wgpustate.bindGroupPool[oldHash] = bg->bindGroup;
-    //     bg->bindGroup = NULL;
-    // }
+
+    // Only drops this bind group's reference, the native object stays alive in the bind group cache
+    // and is picked up again by UpdateBindGroup if the same set of resources comes back.
+    if (bg->bindGroup)
+        wgpuBindGroupRelease((WGPUBindGroup)bg->bindGroup);
+    bg->bindGroup = NULL;
     bg->needsUpdate = true;
 
     // bg->bindGroup = wgpuDeviceCreateBindGroup((WGPUDevice)GetDevice(), &(bg->desc));
@@ -1162,6 +1595,7 @@ static bool initAdapterAndDevice(InitContext_Impl _ctx){
 
     wgpustate* state = (wgpustate*)(ctx->wgpustate);
 
+    BeginStartupPhase("RequestAdapter");
     WGPUFuture arfuture = wgpuInstanceRequestAdapter(state->instance, &requestAdapterOptions, requestAdapterCallbackInfo);
 
 #if defined(__EMSCRIPTEN__) && !defined(ASSUME_EM_ASYNCIFY)
@@ -1184,15 +1618,25 @@ static bool initAdapterAndDevice(InitContext_Impl _ctx){
 
 static bool initResumeEntry(InitContext_Impl _ctx){
     InitContext_Impl* ctx = &_ctx;
+    EndStartupPhase();
 
-    WGPUFeatureName fnames[2] = {
+    wgpustate* state = (wgpustate*)(ctx->wgpustate);
+    WGPUFeatureName fnames[3] = {
         WGPUFeatureName_ClipDistances,
         WGPUFeatureName_Float32Filterable,
     };
+    uint32_t featureCount = 2;
+    #ifndef __EMSCRIPTEN__
+    // Optional, without it indirect scenes cull on the CPU
+    state->indirectFirstInstance = wgpuAdapterHasFeature(state->adapter, WGPUFeatureName_IndirectFirstInstance);
+    if(state->indirectFirstInstance){
+        fnames[featureCount++] = WGPUFeatureName_IndirectFirstInstance;
+    }
+    #endif
 
     WGPUDeviceDescriptor deviceDesc = {
     #ifndef __EMSCRIPTEN__
-        .requiredFeatureCount = 2,
+        .requiredFeatureCount = featureCount,
         .requiredFeatures = fnames,
     #endif
         .deviceLostCallbackInfo = {
@@ -1214,7 +1658,7 @@ static bool initResumeEntry(InitContext_Impl _ctx){
         .userdata1 = ctx->wgpustate
     };
 
-    wgpustate* state = (wgpustate*)(ctx->wgpustate);
+    BeginStartupPhase("RequestDevice");
     WGPUFuture rdFuture = wgpuAdapterRequestDevice(state->adapter, &deviceDesc, rdCallback);
 
 #if defined(__EMSCRIPTEN__) && !defined(ASSUME_EM_ASYNCIFY)
@@ -1259,13 +1703,17 @@ void InitBackend(InitContext_Impl _ctx) {
         #endif
     };
 
+    BeginStartupPhase("InitBackend");
+    BeginStartupPhase("CreateInstance");
     state->instance = wgpuCreateInstance(&idesc);
+    EndStartupPhase();
     _ctx.wgpustate = (void*)state;
     initAdapterAndDevice(_ctx);
 
 }
 static bool InitBackend_DoTheRest(InitContext_Impl _ctx){
     InitContext_Impl* ctx = &_ctx;
+    EndStartupPhase();
 
     wgpustate* state = (wgpustate*)(ctx->wgpustate);
     if (state->adapter == NULL) {
@@ -1326,6 +1774,7 @@ static bool InitBackend_DoTheRest(InitContext_Impl _ctx){
     TraceLog(LOG_INFO, "Device supports %u VBO slots", (unsigned)slimits.maxVertexBuffers);
 
     state->queue = wgpuDeviceGetQueue(state->device);
+    EndStartupPhase();
     ctx->continuationPoint(_ctx);
     return true;
 }
@@ -1338,6 +1787,7 @@ void negotiateSurfaceFormatAndPresentMode(const void *SurfaceHandle) {
     if (negotiateSurfaceFormatAndPresentMode_called)
         return;
     negotiateSurfaceFormatAndPresentMode_called = true;
+    BeginStartupPhase("NegotiateSurface");
     WGPUSurfaceCapabilities capabilities;
     wgpuSurfaceGetCapabilities(surf, (WGPUAdapter)GetAdapter(), &capabilities);
     {
@@ -1419,6 +1869,7 @@ found:
     }
 
     TRACELOG(LOG_INFO, "Selected surface format %s", TextureFormatName(toWGPUPixelFormat(g_renderstate.frameBufferFormat)));
+    EndStartupPhase();
 
     // TRACELOG(LOG_INFO, "Selected present mode %s",
     // presentModeSpellingTable.at((WGPUPresentMode)g_renderstate.throttled_PresentMode).c_str());
@@ -1452,7 +1903,7 @@ void ComputePassSetBindGroup(DescribedComputepass *drp, uint32_t group, Describe
 // }
 Texture2DArray LoadTextureArray(uint32_t width, uint32_t height, uint32_t layerCount, PixelFormat format) {
     const WGPUTextureDescriptor tDesc = {
-        .usage = WGPUTextureUsage_StorageBinding | WGPUTextureUsage_CopySrc | WGPUTextureUsage_CopyDst,
+        .usage = WGPUTextureUsage_StorageBinding | WGPUTextureUsage_TextureBinding | WGPUTextureUsage_CopySrc | WGPUTextureUsage_CopyDst,
         .dimension = WGPUTextureDimension_2D,
         .size = {width, height, layerCount},
         .format = toWGPUPixelFormat(format),
@@ -1477,9 +1928,64 @@ Texture2DArray LoadTextureArray(uint32_t width, uint32_t height, uint32_t layerC
     WGPUTexture id = wgpuDeviceCreateTexture(GetDevice(), &tDesc);
     WGPUTextureView view = wgpuTextureCreateView(id, &vDesc);
 
-    Texture2DArray ret = {.id = id, .view = view, .layerCount = layerCount, .format = format, .sampleCount = 1};
+    Texture2DArray ret = {
+        .id = id,
+        .view = view,
+        .width = width,
+        .height = height,
+        .layerCount = layerCount,
+        .format = format,
+        .sampleCount = 1,
+        .layerAliases = (WGPUTextureView*)RL_CALLOC(layerCount, sizeof(WGPUTextureView)),
+    };
     return ret;
 }
+void UpdateTextureArrayLayer(Texture2DArray array, uint32_t layer, const void *data) {
+    if (layer >= array.layerCount) {
+        TRACELOG(LOG_ERROR, "Texture array layer %u out of range (%u layers)", layer, array.layerCount);
+        return;
+    }
+    const WGPUTexelCopyTextureInfo destination = {
+        .texture = (WGPUTexture)array.id,
+        .aspect = WGPUTextureAspect_All,
+        .mipLevel = 0,
+        .origin = {0, 0, layer},
+    };
+    const WGPUTexelCopyBufferLayout source = {
+        .offset = 0,
+        .bytesPerRow = GetPixelSizeInBytes(array.format) * array.width,
+        .rowsPerImage = array.height,
+    };
+    const WGPUExtent3D writeSize = {
+        .width = array.width,
+        .height = array.height,
+        .depthOrArrayLayers = 1,
+    };
+    wgpuQueueWriteTexture(GetQueue(),
+                          &destination,
+                          data,
+                          (uint64_t)array.width * (uint64_t)array.height * (uint64_t)GetPixelSizeInBytes(array.format),
+                          &source,
+                          &writeSize);
+}
+void SetTextureArrayLayerAlias(Texture2DArray array, uint32_t layer, Texture tex) {
+    if (layer >= array.layerCount || array.layerAliases == NULL) {
+        TRACELOG(LOG_ERROR, "Texture array layer %u out of range (%u layers)", layer, array.layerCount);
+        return;
+    }
+    array.layerAliases[layer] = tex.view;
+}
+void UnloadTextureArray(Texture2DArray array) {
+    const void *view = array.view;
+    BindGroupCachePurge(&view, 1);
+    RL_FREE(array.layerAliases);
+    if (array.view) {
+        wgpuTextureViewRelease((WGPUTextureView)array.view);
+    }
+    if (array.id) {
+        wgpuTextureRelease((WGPUTexture)array.id);
+    }
+}
 Texture LoadTexturePro(uint32_t width, uint32_t height, PixelFormat format, RGTextureUsage usage, uint32_t sampleCount, uint32_t mipmaps) {
     WGPUTextureDescriptor tDesc = {
         .usage = usage,
@@ -1558,45 +2064,260 @@ DescribedSampler LoadSamplerEx(TextureWrap amode, TextureFilter fmode, TextureFi
     ret.sampler = wgpuDeviceCreateSampler(GetDevice(), &sdesc);
     return ret;
 }
-void SetBindgroupUniformBufferData(DescribedBindGroup *bg, uint32_t index, const void *data, size_t size) {
-    
-    const WGPUBufferDescriptor bufferDesc = {
-        .size = size,
-        .usage = WGPUBufferUsage_CopySrc | WGPUBufferUsage_CopyDst | WGPUBufferUsage_Uniform,
-        .mappedAtCreation = false,
-    };
-    WGPUBuffer uniformBuffer = wgpuDeviceCreateBuffer((WGPUDevice)GetDevice(), &bufferDesc);
-    wgpuQueueWriteBuffer((WGPUQueue)GetQueue(), uniformBuffer, 0, data, size);
-    const ResourceDescriptor entry = {
-        .binding = index,
-        .buffer = uniformBuffer,
-        .size = size,
+// Per-frame linear allocator backing SetBindgroup{Uniform,Storage}BufferData and the immediate-mode batch.
+// Each frame in flight owns one buffer, allocations are aligned and written with wgpuQueueWriteBuffer,
+// so the commands of earlier frames never see their data overwritten and a push is a copy plus an offset.
+// A ring that runs full within a frame first moves on to the next buffer if no pass is recording and the
+// GPU finished everything that used it, so applications that never call EndDrawing stay bounded.
+// Otherwise it is replaced by one twice as large; commands recorded earlier keep the old buffer alive.
+typedef struct StreamingRing {
+    const char *label;
+    WGPUBufferUsage usage;
+    uint64_t initialSize;
+    uint64_t alignment;
+    DescribedBuffer buffers[RING_FRAMES_IN_FLIGHT];
+    WGPUFuture retired[RING_FRAMES_IN_FLIGHT]; // Submitted work done, requested when the buffer was left early
+    bool inFlight[RING_FRAMES_IN_FLIGHT];
+    uint32_t frameIndex;
+    uint64_t head;
+    StreamingRingStats stats;
+} StreamingRing;
+
+// Uniform and storage uploads live in separate buffers, a buffer's usage flags then match how it is bound
+static StreamingRing g_uniformRing = {
+    .label = "Uniform ring",
+    .usage = WGPUBufferUsage_CopyDst | WGPUBufferUsage_Uniform,
+    .initialSize = UNIFORM_RING_SIZE,
+    .alignment = UNIFORM_RING_ALIGNMENT,
+};
+
+static StreamingRing g_storageRing = {
+    .label = "Storage ring",
+    .usage = WGPUBufferUsage_CopyDst | WGPUBufferUsage_Storage,
+    .initialSize = UNIFORM_RING_SIZE,
+    .alignment = UNIFORM_RING_ALIGNMENT,
+};
+
+static StreamingRing g_vertexStream = {
+    .label = "Vertex stream",
+    .usage = WGPUBufferUsage_CopyDst | WGPUBufferUsage_Vertex,
+    .initialSize = VERTEX_STREAM_SIZE,
+    .alignment = 4,
+};
+
+static void onRingBufferRetired(WGPUQueueWorkDoneStatus status, WGPUStringView message, WGPU_NULLABLE void *userdata1, WGPU_NULLABLE void *userdata2) {
+    (void)status;
+    (void)message;
+    (void)userdata2;
+    *(bool *)userdata1 = false;
+}
+
+// Moves to the next buffer ahead of EndDrawing once the GPU is done with it. Everything that referenced the
+// buffer being left has been submitted when no pass is recording, so the queue's work done future covers it.
+static bool streamingRingRecycle(StreamingRing *ring) {
+    if (g_renderstate.activeRenderpass != NULL || g_renderstate.activeComputepass != NULL) {
+        return false;
+    }
+    const uint32_t next = (ring->frameIndex + 1) % RING_FRAMES_IN_FLIGHT;
+    if (ring->inFlight[next]) {
+        WGPUFutureWaitInfo waitInfo = {.future = ring->retired[next]};
+        wgpuInstanceWaitAny((WGPUInstance)GetInstance(), 1, &waitInfo, 0);
+        if (ring->inFlight[next]) {
+            return false;
+        }
+    }
+    const WGPUQueueWorkDoneCallbackInfo doneInfo = {
+        .mode = WGPUCallbackMode_WaitAnyOnly,
+        .callback = onRingBufferRetired,
+        .userdata1 = ring->inFlight + ring->frameIndex,
     };
+    ring->inFlight[ring->frameIndex] = true;
+    ring->retired[ring->frameIndex] = wgpuQueueOnSubmittedWorkDone(GetQueue(), doneInfo);
+    ring->frameIndex = next;
+    ring->head = 0;
+    ++ring->stats.recycles;
+    return true;
+}
 
-    UpdateBindGroupEntry(bg, index, entry);
-    wgpuBufferRelease(uniformBuffer);
-    // bg->releaseOnClear |= (1 << index);
+// Returns the ring buffer of the current frame and writes the allocation's offset to *offset
+static DescribedBuffer *streamingRingPush(StreamingRing *ring, const void *data, size_t size, uint64_t *offset) {
+    DescribedBuffer *current = ring->buffers + ring->frameIndex;
+    uint64_t alignedHead = (ring->head + ring->alignment - 1) & ~(ring->alignment - 1);
+
+    if (current->buffer != NULL && alignedHead + size > current->size && size <= current->size && streamingRingRecycle(ring)) {
+        current = ring->buffers + ring->frameIndex;
+        alignedHead = 0;
+    }
+    if (current->buffer == NULL || alignedHead + size > current->size) {
+        uint64_t newCapacity = current->size ? current->size : ring->initialSize;
+        if (current->buffer) {
+            ++ring->stats.wraparounds;
+            TRACELOG(LOG_DEBUG, "%s full after %llu bytes, growing to %llu",
+                     ring->label, (unsigned long long)ring->head, (unsigned long long)(newCapacity * 2));
+            newCapacity *= 2;
+            wgpuBufferRelease(current->buffer);
+        }
+        while (newCapacity < size) {
+            newCapacity *= 2;
+        }
+        const WGPUBufferDescriptor desc = {
+            .label = {ring->label, strlen(ring->label)},
+            .size = newCapacity,
+            .usage = ring->usage,
+            .mappedAtCreation = false,
+        };
+        current->buffer = wgpuDeviceCreateBuffer((WGPUDevice)GetDevice(), &desc);
+        current->size = newCapacity;
+        current->usage = ring->usage;
+        *offset = 0;
+    } else {
+        *offset = alignedHead;
+    }
+    wgpuQueueWriteBuffer(GetQueue(), current->buffer, *offset, data, size);
+    ring->head = *offset + size;
+    ring->stats.bytesUploadedThisFrame += size;
+    return current;
 }
 
-void SetBindgroupStorageBufferData(DescribedBindGroup *bg, uint32_t index, const void *data, size_t size) {
+static void streamingRingEndFrame(StreamingRing *ring) {
+    ring->frameIndex = (ring->frameIndex + 1) % RING_FRAMES_IN_FLIGHT;
+    ring->head = 0;
+    ring->stats.bytesUploadedLastFrame = ring->stats.bytesUploadedThisFrame;
+    ring->stats.bytesUploadedThisFrame = 0;
+}
+
+static StreamingRingStats streamingRingGetStats(const StreamingRing *ring) {
+    StreamingRingStats ret = ring->stats;
+    ret.capacity = 0;
+    for (uint32_t i = 0; i < RING_FRAMES_IN_FLIGHT; i++) {
+        ret.capacity += ring->buffers[i].size;
+    }
+    return ret;
+}
+
+void StreamingRingsEndFrame(cwoid) {
+    streamingRingEndFrame(&g_uniformRing);
+    streamingRingEndFrame(&g_storageRing);
+    streamingRingEndFrame(&g_vertexStream);
+}
+
+RGAPI StreamingRingStats GetUniformRingStats(cwoid) {
+    StreamingRingStats ret = streamingRingGetStats(&g_uniformRing);
+    const StreamingRingStats storage = streamingRingGetStats(&g_storageRing);
+    ret.bytesUploadedThisFrame += storage.bytesUploadedThisFrame;
+    ret.bytesUploadedLastFrame += storage.bytesUploadedLastFrame;
+    ret.wraparounds += storage.wraparounds;
+    ret.recycles += storage.recycles;
+    ret.capacity += storage.capacity;
+    return ret;
+}
+RGAPI StreamingRingStats GetVertexStreamStats(cwoid) { return streamingRingGetStats(&g_vertexStream); }
+
+DescribedBuffer *VertexStreamPush(const void *data, size_t size, uint64_t *offset) {
+    return streamingRingPush(&g_vertexStream, data, size, offset);
+}
+
+// Data set once through SetUniformBufferData must outlive the frame it was pushed in,
+// so every ring upload keeps a CPU copy that is pushed again when its ring slot comes around.
+typedef struct DynamicUploadState {
+    void *data[MAX_DYNAMIC_OFFSETS];
+    uint32_t size[MAX_DYNAMIC_OFFSETS];
+    uint32_t capacity[MAX_DYNAMIC_OFFSETS];
+    uint32_t entryIndex[MAX_DYNAMIC_OFFSETS];
+    uint64_t frame[MAX_DYNAMIC_OFFSETS];
+} DynamicUploadState;
+
+static StreamingRing *ringForBinding(const DescribedBindGroup *bg, uint32_t binding) {
+    for (uint32_t i = 0; i < bg->layout->entryCount; i++) {
+        if (bg->layout->entries[i].location == binding) {
+            return bg->layout->entries[i].type == uniform_buffer ? &g_uniformRing : &g_storageRing;
+        }
+    }
+    return &g_uniformRing;
+}
+
+static void bindgroupRingUpload(DescribedBindGroup *bg, uint32_t index, int dynamicIndex, const void *data, size_t size) {
+    uint64_t offset = 0;
+    WGPUBuffer ringBuffer = streamingRingPush(ringForBinding(bg, index), data, size, &offset)->buffer;
+    const ResourceDescriptor *current = bg->entries + index;
+    if (current->buffer != ringBuffer || current->size != size || current->offset != 0) {
+        const ResourceDescriptor entry = {
+            .binding = index,
+            .buffer = ringBuffer,
+            .size = size,
+        };
+        UpdateBindGroupEntry(bg, index, entry);
+    }
+    bg->dynamicOffsets[dynamicIndex] = (uint32_t)offset;
+    bg->dynamicUploads->size[dynamicIndex] = (uint32_t)size;
+    bg->dynamicUploads->frame[dynamicIndex] = g_renderstate.total_frames;
+}
+
+static void setBindgroupBufferData(DescribedBindGroup *bg, uint32_t index, const void *data, size_t size, WGPUBufferUsage usage) {
+    const int dynamicIndex = index < bg->entryCount ? dynamicOffsetIndex(bg, index) : -1;
+    const bool fitsRing = size <= UNIFORM_RING_SIZE / 4 && (!(usage & WGPUBufferUsage_Uniform) || size <= 65536);
+
+    if (dynamicIndex >= 0 && fitsRing) {
+        if (bg->dynamicUploads == NULL) {
+            bg->dynamicUploads = callocnew(DynamicUploadState);
+        }
+        DynamicUploadState *uploads = bg->dynamicUploads;
+        if (uploads->capacity[dynamicIndex] < size) {
+            uploads->data[dynamicIndex] = RL_REALLOC(uploads->data[dynamicIndex], size);
+            uploads->capacity[dynamicIndex] = (uint32_t)size;
+        }
+        memcpy(uploads->data[dynamicIndex], data, size);
+        uploads->entryIndex[dynamicIndex] = index;
+        bindgroupRingUpload(bg, index, dynamicIndex, data, size);
+        return;
+    }
+
+    // Compute bind groups and oversized uploads get a dedicated buffer
     const WGPUBufferDescriptor bufferDesc = {
         .size = size,
-        .usage = WGPUBufferUsage_CopySrc | WGPUBufferUsage_CopyDst | WGPUBufferUsage_Storage,
+        .usage = WGPUBufferUsage_CopySrc | WGPUBufferUsage_CopyDst | usage,
         .mappedAtCreation = false,
     };
-    WGPUBuffer storageBuffer = wgpuDeviceCreateBuffer((WGPUDevice)GetDevice(), &bufferDesc);
-    wgpuQueueWriteBuffer((WGPUQueue)GetQueue(), storageBuffer, 0, data, size);
+    WGPUBuffer buffer = wgpuDeviceCreateBuffer((WGPUDevice)GetDevice(), &bufferDesc);
+    wgpuQueueWriteBuffer((WGPUQueue)GetQueue(), buffer, 0, data, size);
     const ResourceDescriptor entry = {
         .binding = index,
-        .buffer = storageBuffer,
+        .buffer = buffer,
         .size = size,
     };
 
     UpdateBindGroupEntry(bg, index, entry);
+    wgpuBufferRelease(buffer);
+}
 
-    wgpuBufferRelease(storageBuffer);
+void SetBindgroupUniformBufferData(DescribedBindGroup *bg, uint32_t index, const void *data, size_t size) {
+    setBindgroupBufferData(bg, index, data, size, WGPUBufferUsage_Uniform);
+}
+
+void SetBindgroupStorageBufferData(DescribedBindGroup *bg, uint32_t index, const void *data, size_t size) {
+    setBindgroupBufferData(bg, index, data, size, WGPUBufferUsage_Storage);
+}
+
+void RefreshDynamicUploads(DescribedBindGroup *bg) {
+    DynamicUploadState *uploads = bg->dynamicUploads;
+    if (uploads == NULL) {
+        return;
+    }
+    const size_t count = dynamicOffsetCount(bg);
+    for (size_t i = 0; i < count; i++) {
+        const uint32_t index = uploads->entryIndex[i];
+        if (uploads->size[i] == 0) {
+            continue;
+        }
+        // Only stale once the ring slot it lives in has been handed out again
+        if (uploads->frame[i] + RING_FRAMES_IN_FLIGHT <= g_renderstate.total_frames) {
+            bindgroupRingUpload(bg, index, (int)i, uploads->data[i], uploads->size[i]);
+        }
+    }
 }
 void UnloadBuffer(DescribedBuffer *buffer) {
+    const void *resource = buffer->buffer;
+    BindGroupCachePurge(&resource, 1);
     wgpuBufferRelease((WGPUBuffer)buffer->buffer);
     RL_FREE(buffer);
 }
@@ -1767,6 +2488,8 @@ void BeginRenderpassEx(DescribedRenderpass *renderPass) {
     renderPassDesc.depthStencilAttachment = &depthAttachment;
 
     renderPass->rpEncoder = wgpuCommandEncoderBeginRenderPass((WGPUCommandEncoder)renderPass->cmdEncoder, &renderPassDesc);
+    memset(renderPass->boundVertexBuffers, 0, sizeof(renderPass->boundVertexBuffers));
+    renderPass->boundIndexBuffer = NULL;
     g_renderstate.activeRenderpass = renderPass;
 }
 
@@ -1864,6 +2587,158 @@ Image LoadImageFromTextureEx(WGPUTexture tex, uint32_t miplevel) {
     return ret;
 }
 
+typedef struct ReadbackSlot {
+    WGPUBuffer buffer;
+    uint64_t capacity;
+    bool pending;
+    bool mapped;
+    uint64_t sequence;
+    WGPUMapAsyncStatus status;
+    WGPUFuture future;
+    Image image;
+    ReadbackCallback callback;
+    void *userdata;
+} ReadbackSlot;
+
+static ReadbackSlot g_readbacks[READBACK_POOL_SIZE];
+static uint64_t g_readbackSequence = 0;
+
+static void onReadbackMapped(WGPUMapAsyncStatus status, WGPUStringView message, WGPU_NULLABLE void *userdata1, WGPU_NULLABLE void *userdata2) {
+    (void)message;
+    (void)userdata2;
+    ReadbackSlot *slot = (ReadbackSlot *)userdata1;
+    slot->status = status;
+    slot->mapped = true;
+}
+
+bool RequestTextureReadback(Texture tex, uint32_t mipLevel, ReadbackCallback callback, void *userdata) {
+    ReadbackSlot *slot = NULL;
+    for (uint32_t i = 0; i < READBACK_POOL_SIZE; i++) {
+        if (!g_readbacks[i].pending) {
+            slot = g_readbacks + i;
+            break;
+        }
+    }
+    if (slot == NULL) {
+        TRACELOG(LOG_WARNING, "All %d readback staging buffers are in flight", READBACK_POOL_SIZE);
+        return false;
+    }
+
+    const uint32_t width = (tex.width >> mipLevel) ? (tex.width >> mipLevel) : 1;
+    const uint32_t height = (tex.height >> mipLevel) ? (tex.height >> mipLevel) : 1;
+    const size_t rowStrideInBytes = RoundUpToNextMultipleOf256((uint64_t)width * GetPixelSizeInBytes(tex.format));
+    const uint64_t size = rowStrideInBytes * height;
+
+    if (slot->capacity < size) {
+        if (slot->buffer)
+            wgpuBufferRelease(slot->buffer);
+        WGPUBufferDescriptor desc = {
+            .label = STRVIEW("Readback staging buffer"),
+            .usage = WGPUBufferUsage_MapRead | WGPUBufferUsage_CopyDst,
+            .size = size,
+            .mappedAtCreation = false,
+        };
+        slot->buffer = wgpuDeviceCreateBuffer((WGPUDevice)GetDevice(), &desc);
+        slot->capacity = size;
+    }
+
+    WGPUCommandEncoder encoder = wgpuDeviceCreateCommandEncoder((WGPUDevice)GetDevice(), NULL);
+    const WGPUTexelCopyTextureInfo source = {
+        .texture = (WGPUTexture)tex.id,
+        .mipLevel = mipLevel,
+        .origin = {0, 0, 0},
+        .aspect = WGPUTextureAspect_All,
+    };
+    const WGPUTexelCopyBufferInfo destination = {
+        .layout = {
+            .offset = 0,
+            .bytesPerRow = (uint32_t)rowStrideInBytes,
+            .rowsPerImage = height,
+        },
+        .buffer = slot->buffer,
+    };
+    const WGPUExtent3D copySize = {width, height, 1};
+    wgpuCommandEncoderCopyTextureToBuffer(encoder, &source, &destination, &copySize);
+    WGPUCommandBuffer command = wgpuCommandEncoderFinish(encoder, NULL);
+    wgpuQueueSubmit(GetQueue(), 1, &command);
+    wgpuCommandEncoderRelease(encoder);
+    wgpuCommandBufferRelease(command);
+
+    slot->image = CLITERAL(Image){
+        .data = NULL,
+        .width = width,
+        .height = height,
+        .mipmaps = 1,
+        .format = tex.format,
+        .rowStrideInBytes = rowStrideInBytes,
+    };
+    slot->callback = callback;
+    slot->userdata = userdata;
+    slot->pending = true;
+    slot->mapped = false;
+    slot->sequence = g_readbackSequence++;
+
+    WGPUBufferMapCallbackInfo mapCallbackInfo = {
+        .mode = WGPUCallbackMode_WaitAnyOnly,
+        .callback = onReadbackMapped,
+        .userdata1 = slot,
+    };
+    slot->future = wgpuBufferMapAsync(slot->buffer, WGPUMapMode_Read, 0, size, mapCallbackInfo);
+    return true;
+}
+
+static uint32_t dispatchReadbacks(uint64_t timeoutNS) {
+    WGPUFutureWaitInfo waitInfos[READBACK_POOL_SIZE];
+    uint32_t waitCount = 0;
+    for (uint32_t i = 0; i < READBACK_POOL_SIZE; i++) {
+        if (g_readbacks[i].pending && !g_readbacks[i].mapped) {
+            waitInfos[waitCount++] = CLITERAL(WGPUFutureWaitInfo){.future = g_readbacks[i].future};
+        }
+    }
+    if (waitCount > 0) {
+        wgpuInstanceWaitAny((WGPUInstance)GetInstance(), waitCount, waitInfos, timeoutNS);
+    }
+
+    // Callbacks run in request order, a finished readback waits for all older ones
+    for (;;) {
+        ReadbackSlot *slot = NULL;
+        for (uint32_t i = 0; i < READBACK_POOL_SIZE; i++) {
+            if (g_readbacks[i].pending && (slot == NULL || g_readbacks[i].sequence < slot->sequence)) {
+                slot = g_readbacks + i;
+            }
+        }
+        if (slot == NULL || !slot->mapped)
+            break;
+        Image image = slot->image;
+        const bool success = slot->status == WGPUMapAsyncStatus_Success;
+        if (success) {
+            image.data = (void *)wgpuBufferGetConstMappedRange(slot->buffer, 0, image.rowStrideInBytes * image.height);
+        } else {
+            TRACELOG(LOG_ERROR, "Texture readback failed with status: %d", slot->status);
+        }
+        if (slot->callback)
+            slot->callback(image, slot->userdata);
+        if (success)
+            wgpuBufferUnmap(slot->buffer);
+        slot->pending = false;
+        slot->mapped = false;
+    }
+
+    uint32_t stillPending = 0;
+    for (uint32_t i = 0; i < READBACK_POOL_SIZE; i++) {
+        stillPending += g_readbacks[i].pending;
+    }
+    return stillPending;
+}
+
+uint32_t PollReadbacks() {
+    return dispatchReadbacks(0);
+}
+
+void FlushReadbacks() {
+    while (dispatchReadbacks(UINT64_MAX) > 0) {}
+}
+
 void BufferData(DescribedBuffer *buffer, const void *data, size_t size) {
     if (buffer->size >= size) {
         wgpuQueueWriteBuffer(GetQueue(), buffer->buffer, 0, data, size);
@@ -1881,15 +2756,51 @@ void BufferData(DescribedBuffer *buffer, const void *data, size_t size) {
 }
 void ResetSyncState() {}
 
+void BufferSubData(DescribedBuffer *buffer, uint64_t offset, const void *data, size_t size) {
+    if (offset + size > buffer->size) {
+        TRACELOG(LOG_ERROR, "BufferSubData: %llu bytes at offset %llu exceed the buffer size %llu", (unsigned long long)size, (unsigned long long)offset, (unsigned long long)buffer->size);
+        return;
+    }
+    wgpuQueueWriteBuffer(GetQueue(), buffer->buffer, offset, data, size);
+}
+
+void CopyBufferRanges(DescribedBuffer *source, DescribedBuffer *dest, const BufferCopyRange *ranges, uint32_t rangeCount) {
+    WGPUCommandEncoderDescriptor edesc = {0};
+    WGPUCommandBufferDescriptor bdesc = {0};
+    WGPUCommandEncoder enc = wgpuDeviceCreateCommandEncoder((WGPUDevice)GetDevice(), &edesc);
+    for (uint32_t i = 0; i < rangeCount; i++) {
+        if (ranges[i].size > 0) {
+            wgpuCommandEncoderCopyBufferToBuffer(enc, (WGPUBuffer)source->buffer, ranges[i].srcOffset, (WGPUBuffer)dest->buffer, ranges[i].dstOffset, ranges[i].size);
+        }
+    }
+    WGPUCommandBuffer buf = wgpuCommandEncoderFinish(enc, &bdesc);
+    wgpuQueueSubmit(GetQueue(), 1, &buf);
+    wgpuCommandEncoderRelease(enc);
+    wgpuCommandBufferRelease(buf);
+}
+
 void
 RenderPassSetIndexBuffer(DescribedRenderpass *drp, DescribedBuffer *buffer, IndexFormat format, uint64_t offset) {
+    if (drp->boundIndexBuffer == buffer->buffer && drp->boundIndexOffset == offset && drp->boundIndexFormat == format) {
+        return;
+    }
+    drp->boundIndexBuffer = buffer->buffer;
+    drp->boundIndexOffset = offset;
+    drp->boundIndexFormat = format;
     wgpuRenderPassEncoderSetIndexBuffer((WGPURenderPassEncoder)drp->rpEncoder, (WGPUBuffer)buffer->buffer, RG_to_WGPU_IndexFormat(format), offset, buffer->size);
 }
 void RenderPassSetVertexBuffer(DescribedRenderpass *drp, uint32_t slot, DescribedBuffer *buffer, uint64_t offset) {
-    wgpuRenderPassEncoderSetVertexBuffer((WGPURenderPassEncoder)drp->rpEncoder, slot, (WGPUBuffer)buffer->buffer, offset, buffer->size);
+    if (slot < MAX_VERTEX_BUFFERS) {
+        if (drp->boundVertexBuffers[slot] == buffer->buffer && drp->boundVertexOffsets[slot] == offset) {
+            return;
+        }
+        drp->boundVertexBuffers[slot] = buffer->buffer;
+        drp->boundVertexOffsets[slot] = offset;
+    }
+    wgpuRenderPassEncoderSetVertexBuffer((WGPURenderPassEncoder)drp->rpEncoder, slot, (WGPUBuffer)buffer->buffer, offset, buffer->size - offset);
 }
 void RenderPassSetBindGroup(DescribedRenderpass *drp, uint32_t group, DescribedBindGroup *bindgroup) {
-    wgpuRenderPassEncoderSetBindGroup((WGPURenderPassEncoder)drp->rpEncoder, group, (WGPUBindGroup)UpdateAndGetNativeBindGroup(bindgroup), 0, NULL);
+    wgpuRenderPassEncoderSetBindGroup((WGPURenderPassEncoder)drp->rpEncoder, group, (WGPUBindGroup)UpdateAndGetNativeBindGroup(bindgroup), dynamicOffsetCount(bindgroup), bindgroup->dynamicOffsets);
 }
 void RenderPassDraw(DescribedRenderpass *drp, uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance) {
     wgpuRenderPassEncoderDraw((WGPURenderPassEncoder)drp->rpEncoder, vertexCount, instanceCount, firstVertex, firstInstance);
@@ -1897,6 +2808,15 @@ void RenderPassDraw(DescribedRenderpass *drp, uint32_t vertexCount, uint32_t ins
 void RenderPassDrawIndexed(DescribedRenderpass *drp, uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t baseVertex, uint32_t firstInstance) {
     wgpuRenderPassEncoderDrawIndexed((WGPURenderPassEncoder)drp->rpEncoder, indexCount, instanceCount, firstIndex, baseVertex, firstInstance);
 }
+void RenderPassDrawIndirect(DescribedRenderpass *drp, DescribedBuffer *indirectBuffer, uint64_t indirectOffset) {
+    wgpuRenderPassEncoderDrawIndirect((WGPURenderPassEncoder)drp->rpEncoder, (WGPUBuffer)indirectBuffer->buffer, indirectOffset);
+}
+void RenderPassDrawIndexedIndirect(DescribedRenderpass *drp, DescribedBuffer *indirectBuffer, uint64_t indirectOffset) {
+    wgpuRenderPassEncoderDrawIndexedIndirect((WGPURenderPassEncoder)drp->rpEncoder, (WGPUBuffer)indirectBuffer->buffer, indirectOffset);
+}
+bool SupportsIndirectFirstInstance(cwoid) {
+    return g_wgpustate.indirectFirstInstance;
+}
 void EndRenderpassEx(DescribedRenderpass *renderPass) {
     drawCurrentBatch();
     wgpuRenderPassEncoderEnd((WGPURenderPassEncoder)renderPass->rpEncoder);
@@ -1980,6 +2900,46 @@ DescribedShaderModule LoadShaderModuleSPIRV(ShaderSources sourcesSpirv) {
     }
     }
 #endif
+    ret.sourceHash = ShaderSourcesHash(sourcesSpirv);
+    return ret;
+}
+
+// Cache hits and prepared shaders already know their entry points, SPIRV-Reflect only runs if one is missing
+DescribedShaderModule LoadShaderModuleSPIRVReflected(ShaderSources sourcesSpirv, const ShaderReflectionInfo* reflection) {
+    bool complete = sourcesSpirv.sourceCount > 0;
+    for (uint32_t i = 0; complete && i < sourcesSpirv.sourceCount; i++) {
+        for (uint32_t stage = 0; stage < RGShaderStageEnum_EnumCount; stage++) {
+            if (((uint32_t)sourcesSpirv.sources[i].stageMask & (1u << stage)) && reflection->ep[stage].name[0] == '\0') {
+                complete = false;
+            }
+        }
+    }
+    if (!complete) {
+        DescribedShaderModule ret = LoadShaderModuleSPIRV(sourcesSpirv);
+        ret.reflectionInfo.uniforms = reflection->uniforms;
+        ret.reflectionInfo.attributes = reflection->attributes;
+        return ret;
+    }
+    DescribedShaderModule ret = {0};
+#ifndef __EMSCRIPTEN__
+    for (uint32_t i = 0; i < sourcesSpirv.sourceCount; i++) {
+        WGPUShaderSourceSPIRV shaderCodeDesc = {
+            .chain = {.sType = WGPUSType_ShaderSourceSPIRV},
+            .codeSize = (uint32_t)(sourcesSpirv.sources[i].sizeInBytes / sizeof(uint32_t)),
+            .code = (const uint32_t *)sourcesSpirv.sources[i].data,
+        };
+        rassert(*shaderCodeDesc.code == 0x07230203, "Invalid SPIRV magic");
+        WGPUShaderModuleDescriptor shaderDesc = {.nextInChain = &shaderCodeDesc.chain};
+        WGPUShaderModule sh = wgpuDeviceCreateShaderModule((WGPUDevice)GetDevice(), &shaderDesc);
+        for (uint32_t stage = 0; stage < RGShaderStageEnum_EnumCount; stage++) {
+            if ((uint32_t)sourcesSpirv.sources[i].stageMask & (1u << stage)) {
+                ret.stages[stage].module = sh;
+            }
+        }
+    }
+#endif
+    ret.reflectionInfo = *reflection;
+    ret.sourceHash = ShaderSourcesHash(sourcesSpirv);
     return ret;
 }
 
@@ -2032,12 +2992,16 @@ WGPURenderPipeline createSingleRenderPipe(const ModifiablePipelineState* mst,
 
     WGPUVertexBufferLayout layouts_converted[16] = {0};
     size_t insertIndex = 0;
-    WGPUVertexAttribute** wgpuAttributeHeap = (WGPUVertexAttribute**)VLAStack_alloc(&g_vlastack, vlayout_complete.number_of_buffers * sizeof(WGPUVertexAttribute*));
+    // Stack storage instead of g_vlastack: this function also runs on the pipeline creation thread
+    WGPUVertexAttribute wgpuAttributePool[MAX_VERTEX_ATTRIBUTES];
+    uint32_t attributePoolUsed = 0;
     for (uint32_t i = 0; i < vlayout_complete.number_of_buffers; i++) {
-        wgpuAttributeHeap[i] = (WGPUVertexAttribute*)VLAStack_alloc(&g_vlastack, vlayout_complete.layouts[i].attributeCount * sizeof(WGPUVertexAttribute));
+        WGPUVertexAttribute* wgpuAttributes = wgpuAttributePool + attributePoolUsed;
+        rassert(attributePoolUsed + vlayout_complete.layouts[i].attributeCount <= MAX_VERTEX_ATTRIBUTES, "Too many vertex attributes");
+        attributePoolUsed += vlayout_complete.layouts[i].attributeCount;
         for(uint32_t j = 0;j < vlayout_complete.layouts[i].attributeCount;j++){
             const RGVertexAttribute* attrJ = vlayout_complete.layouts[i].attributes + j;
-            wgpuAttributeHeap[i][j] = (WGPUVertexAttribute){
+            wgpuAttributes[j] = (WGPUVertexAttribute){
                 .format = RG_to_WGPU_VertexFormat(attrJ->format),
                 .offset = attrJ->offset,
                 .shaderLocation = attrJ->shaderLocation,
@@ -2048,7 +3012,7 @@ WGPURenderPipeline createSingleRenderPipe(const ModifiablePipelineState* mst,
             .stepMode = RG_to_WGPU_VertexStepMode(vlayout_complete.layouts[i].stepMode),
             .arrayStride = vlayout_complete.layouts[i].arrayStride,
             .attributeCount = vlayout_complete.layouts[i].attributeCount,
-            .attributes = wgpuAttributeHeap[i],
+            .attributes = wgpuAttributes,
         };
         
     }
@@ -2114,11 +3078,8 @@ WGPURenderPipeline createSingleRenderPipe(const ModifiablePipelineState* mst,
             rg_unreachable();
     }
     WGPURenderPipeline ret = wgpuDeviceCreateRenderPipeline((WGPUDevice)GetDevice(), &pipelineDesc);
-
-    for(uint32_t i = vlayout_complete.number_of_buffers;i > 0;i--){
-        VLAStack_free(&g_vlastack, wgpuAttributeHeap[i - 1]);
-    }
-    VLAStack_free(&g_vlastack, (void*)wgpuAttributeHeap);
+    RL_FREE(vlayout_complete.layouts);
+    RL_FREE(vlayout_complete.attributePool);
     return ret;
 }
 
@@ -2129,7 +3090,8 @@ RGAPI Shader LoadPipelineEx(const char *shaderSource, const AttributeAndResidenc
 }
 RGAPI Shader LoadPipeline(const char *shaderSource) {
     ShaderSources sources = dualStage(shaderSource, sourceTypeWGSL, RGShaderStageEnum_Vertex, RGShaderStageEnum_Fragment);
-    InOutAttributeInfo attribs = getAttributesWGSL(sources);
+    DescribedShaderModule module = LoadShaderModule(sources);
+    const InOutAttributeInfo attribs = module.reflectionInfo.attributes;
     AttributeAndResidence allAttribsInOneBuffer[MAX_VERTEX_ATTRIBUTES];
     const uint32_t attributeCount = attribs.vertexAttributeCount;
     uint32_t offset = 0;
@@ -2149,21 +3111,10 @@ RGAPI Shader LoadPipeline(const char *shaderSource) {
         offset += attributeSize(format);
     }
 
-    StringToUniformMap *bindings = getBindingsWGSL(sources);
-    ResourceTypeDescriptor *values = (ResourceTypeDescriptor *)RL_CALLOC(bindings->current_size, sizeof(ResourceTypeDescriptor));
-    uint32_t insertIndex = 0;
-    for (uint32_t i = 0; i < bindings->current_capacity; i++) {
-        if (bindings->table[i].key.length != 0) {
-            values[insertIndex++] = bindings->table[i].value;
-        }
-    }
-
-    quickSort_ResourceTypeDescriptor(values, values + bindings->current_size);
-
-    Shader ret = LoadPipelineEx(shaderSource, allAttribsInOneBuffer, attributeCount, values, bindings->current_size, GetDefaultSettings());
+    uint32_t uniformCount = 0;
+    ResourceTypeDescriptor *values = flattenUniformMap(module.reflectionInfo.uniforms, &uniformCount);
+    Shader ret = LoadPipelineFromModule(module, allAttribsInOneBuffer, attributeCount, values, uniformCount, GetDefaultSettings());
     RL_FREE(values);
-    StringToUniformMap_free(bindings);
-    RL_FREE(bindings);
     return ret;
 }
 
@@ -2171,10 +3122,14 @@ RGAPI Shader LoadPipelineFromModule(DescribedShaderModule mod, const AttributeAn
     Shader retS = {.id = getNextShaderID_shc()};
     ShaderImpl *ret = GetShaderImpl(retS);
     ret->state.settings = settings;
-    ret->state.vertexAttributes = (AttributeAndResidence *)attribs;
+    // Owned copy, callers commonly pass a stack array and PrewarmShaderVariants may read it later
+    ret->ownedVertexAttributes = (AttributeAndResidence *)RL_CALLOC(attribCount ? attribCount : 1, sizeof(AttributeAndResidence));
+    memcpy(ret->ownedVertexAttributes, attribs, attribCount * sizeof(AttributeAndResidence));
+    ret->state.vertexAttributes = ret->ownedVertexAttributes;
     ret->state.vertexAttributeCount = attribCount;
     ret->bglayout = LoadBindGroupLayout(uniforms, uniformCount, false);
     ret->shaderModule = mod;
+    ResolveDefaultUniformLocations(ret);
     ret->state.colorAttachmentState.colorAttachmentCount = mod.reflectionInfo.attributes.attachmentCount;
 
     for(uint32_t i = 0; i < MAX_COLOR_ATTACHMENTS;i++) ret->state.colorAttachmentState.attachmentFormats[i] = PIXELFORMAT_UNCOMPRESSED_B8G8R8A8;
@@ -2193,6 +3148,7 @@ RGAPI Shader LoadPipelineFromModule(DescribedShaderModule mod, const AttributeAn
     }
     ret->bindGroup = LoadBindGroup(&ret->bglayout, bge, uniformCount);
     RL_FREE((void*)bge);
+    PrewarmRecordedPipelineStates(retS);
     return retS;
 }
 
@@ -2209,49 +3165,20 @@ WGPUBuffer cloneBuffer(WGPUBuffer b, WGPUBufferUsage usage) {
     return ret;
 }
 
-DescribedComputePipeline *LoadComputePipeline(const char *shaderCode) {
-    ShaderSources sources = singleStage(shaderCode, detectShaderLanguageSingle(shaderCode, strlen(shaderCode)), RGShaderStageEnum_Compute);
-
-    StringToUniformMap *bindings = getBindings(sources);
-
-    ResourceTypeDescriptor *udesc = (ResourceTypeDescriptor *)RL_CALLOC(bindings->current_size, sizeof(ResourceTypeDescriptor));
-    uint32_t insertIndex = 0;
-    for (uint32_t i = 0; i < bindings->current_capacity; i++) {
-        StringToUniformMap_kv_pair *entry = bindings->table + i;
-        if (bindings->table[i].key.length == 0) {
-            continue;
-        }
-        udesc[insertIndex++] = entry->value;
-    }
-
-    quickSort_ResourceTypeDescriptor(udesc, udesc + insertIndex);
-
-    DescribedComputePipeline *ret = LoadComputePipelineEx(shaderCode, udesc, insertIndex);
-    RL_FREE(udesc);
-    StringToUniformMap_free(bindings);
-    RL_FREE(bindings);
-    return ret;
-}
-
-RGAPI DescribedComputePipeline *
-LoadComputePipelineEx(const char *shaderCode, const ResourceTypeDescriptor *uniforms, uint32_t uniformCount) {
-    ShaderSources sources = singleStage(shaderCode, detectShaderLanguageSingle(shaderCode, strlen(shaderCode)), RGShaderStageEnum_Compute);
-
-    StringToUniformMap* bindmap = getBindings(sources);
+// The module already carries the reflection, nothing is parsed here
+DescribedComputePipeline *LoadComputePipelineFromModule(DescribedShaderModule module, const ResourceTypeDescriptor *uniforms, uint32_t uniformCount) {
     DescribedComputePipeline *ret = callocnew(DescribedComputePipeline);
     WGPUComputePipelineDescriptor desc  = {0};
     WGPUPipelineLayoutDescriptor pldesc = {0};
-    pldesc.bindGroupLayoutCount = 1;
     ret->bglayout = LoadBindGroupLayout(uniforms, uniformCount, true);
     pldesc.bindGroupLayoutCount = 1;
     pldesc.bindGroupLayouts = (WGPUBindGroupLayout *)&ret->bglayout.layout;
-    WGPUPipelineLayout playout = wgpuDeviceCreatePipelineLayout((WGPUDevice)GetDevice(), &pldesc);
-    ret->shaderModule = LoadShaderModule(sources);
+    ret->layout = wgpuDeviceCreatePipelineLayout((WGPUDevice)GetDevice(), &pldesc);
+    ret->shaderModule = module;
     desc.compute.module = (WGPUShaderModule)ret->shaderModule.stages[RGShaderStageEnum_Compute].module;
 
     desc.compute.entryPoint = CLITERAL(WGPUStringView){ret->shaderModule.reflectionInfo.ep[RGShaderStageEnum_Compute].name, strlen(ret->shaderModule.reflectionInfo.ep[RGShaderStageEnum_Compute].name)};
-    desc.layout = playout;
-    WGPUDevice device = (WGPUDevice)GetDevice();
+    desc.layout = ret->layout;
     ret->pipeline = wgpuDeviceCreateComputePipeline((WGPUDevice)GetDevice(), &desc);
     ResourceDescriptor* bge = (ResourceDescriptor*)RL_CALLOC(uniformCount, sizeof(ResourceDescriptor));
     for (uint32_t i = 0; i < uniformCount; i++) {
@@ -2263,6 +3190,22 @@ LoadComputePipelineEx(const char *shaderCode, const ResourceTypeDescriptor *unif
     return ret;
 }
 
+DescribedComputePipeline *LoadComputePipeline(const char *shaderCode) {
+    ShaderSources sources = singleStage(shaderCode, detectShaderLanguageSingle(shaderCode, strlen(shaderCode)), RGShaderStageEnum_Compute);
+    DescribedShaderModule module = LoadShaderModule(sources);
+    uint32_t uniformCount = 0;
+    ResourceTypeDescriptor *udesc = flattenUniformMap(module.reflectionInfo.uniforms, &uniformCount);
+    DescribedComputePipeline *ret = LoadComputePipelineFromModule(module, udesc, uniformCount);
+    RL_FREE(udesc);
+    return ret;
+}
+
+RGAPI DescribedComputePipeline *
+LoadComputePipelineEx(const char *shaderCode, const ResourceTypeDescriptor *uniforms, uint32_t uniformCount) {
+    ShaderSources sources = singleStage(shaderCode, detectShaderLanguageSingle(shaderCode, strlen(shaderCode)), RGShaderStageEnum_Compute);
+    return LoadComputePipelineFromModule(LoadShaderModule(sources), uniforms, uniformCount);
+}
+
 Shader LoadShaderFromMemoryOld(const char *vertexSource, const char *fragmentSource) {
     Shader shader  = {0};
 
@@ -2761,10 +3704,18 @@ EntryPointSet getEntryPointsSPIRV(const uint32_t *shaderSourceSPIRV, uint32_t wo
             }
         }
     }
+    spvReflectDestroyShaderModule(&mod);
     return eps;
 }
 
 void UnloadBindGroup(DescribedBindGroup *bg) {
+    if (bg->dynamicUploads) {
+        for (uint32_t i = 0; i < MAX_DYNAMIC_OFFSETS; i++) {
+            RL_FREE(bg->dynamicUploads->data[i]);
+        }
+        RL_FREE(bg->dynamicUploads);
+        bg->dynamicUploads = NULL;
+    }
     free(bg->entries);
     wgpuBindGroupRelease((WGPUBindGroup)bg->bindGroup);
 }
@@ -0,0 +1,201 @@
+// begin file src/builtin_shaders.c
+// Shaders the library uses itself. tools/embed_builtin_shaders.c (build the raygpu_builtin_shaders target)
+// generates two tables into src/builtin_shaders_embedded.c, so loading them runs neither glslang, the WGSL
+// frontend nor a reflection parser:
+//  - g_builtinShaderData: SPIR-V and reflection of GetBuiltinShaderSources, for backends that accept SPIR-V
+//  - g_builtinShaderWGSLData: reflection of GetBuiltinShaderWGSLSources, whose WGSL the WebGPU backends consume natively
+// An entry whose recorded source hash no longer matches its source is compiled at runtime instead, unless
+// the build has no parser for it. Outdated SPIR-V is still better than no shader.
+
+#include <raygpu.h>
+#include <string.h>
+#include <stdio.h>
+#include "internal_include/internals.h"
+
+extern const char shaderSource[];
+extern const char vertexSourceGLSL[];
+extern const char fragmentSourceGLSL[];
+extern const char mipmapComputerSource2[];
+extern const char mipmapComputeSourceGLSL[];
+extern const char indirectCullComputeSource[];
+extern const char meshSkinningComputeSource[];
+
+static ShaderSources singleSource(const char* source, ShaderSourceType language, RGShaderStage stageMask){
+    ShaderSources ret = {0};
+    ret.language = language;
+    ret.sourceCount = 1;
+    ret.sources[0].data = source;
+    ret.sources[0].sizeInBytes = (uint32_t)strlen(source);
+    ret.sources[0].stageMask = stageMask;
+    return ret;
+}
+
+static ShaderSources glslPair(const char* vertex, const char* fragment){
+    ShaderSources ret = singleSource(vertex, sourceTypeGLSL, RGShaderStage_Vertex);
+    ret.sourceCount = 2;
+    ret.sources[1].data = fragment;
+    ret.sources[1].sizeInBytes = (uint32_t)strlen(fragment);
+    ret.sources[1].stageMask = RGShaderStage_Fragment;
+    return ret;
+}
+
+// The sources the embedded SPIR-V is generated from, independent of the build configuration
+ShaderSources GetBuiltinShaderSources(BuiltinShaderID id){
+    switch(id){
+        case BuiltinShader_Default:
+        return glslPair(vertexSourceGLSL, fragmentSourceGLSL);
+        case BuiltinShader_TextureArray:
+        #if RENDERBATCH_TEXTURE_ARRAY == 1
+        return glslPair(textureArrayVertexSourceGLSL, textureArrayFragmentSourceGLSL);
+        #else
+        break;
+        #endif
+        case BuiltinShader_Mipmap:
+        return singleSource(mipmapComputeSourceGLSL, sourceTypeGLSL, RGShaderStage_Compute);
+        case BuiltinShader_IndirectCull:
+        return singleSource(indirectCullComputeSource, sourceTypeWGSL, RGShaderStage_Compute);
+        case BuiltinShader_MeshSkinning:
+        return singleSource(meshSkinningComputeSource, sourceTypeWGSL, RGShaderStage_Compute);
+        default:
+        break;
+    }
+    return CLITERAL(ShaderSources){0};
+}
+
+// The same shaders in WGSL, identical to GetBuiltinShaderSources for the built-ins written in WGSL
+ShaderSources GetBuiltinShaderWGSLSources(BuiltinShaderID id){
+    switch(id){
+        case BuiltinShader_Default:
+        return singleSource(shaderSource, sourceTypeWGSL, RGShaderStage_Vertex | RGShaderStage_Fragment);
+        case BuiltinShader_TextureArray:
+        #if RENDERBATCH_TEXTURE_ARRAY == 1
+        return singleSource(textureArrayShaderSource, sourceTypeWGSL, RGShaderStage_Vertex | RGShaderStage_Fragment);
+        #else
+        break;
+        #endif
+        case BuiltinShader_Mipmap:
+        return singleSource(mipmapComputerSource2, sourceTypeWGSL, RGShaderStage_Compute);
+        default:
+        return GetBuiltinShaderSources(id);
+    }
+    return CLITERAL(ShaderSources){0};
+}
+
+#if SUPPORT_GLSL_PARSER == 1
+    #define BUILTIN_GLSL_COMPILABLE 1
+#else
+    #define BUILTIN_GLSL_COMPILABLE 0
+#endif
+#if SUPPORT_WGSL_PARSER == 1
+    #define BUILTIN_WGSL_COMPILABLE 1
+#else
+    #define BUILTIN_WGSL_COMPILABLE 0
+#endif
+
+static bool runtimeCompilable(ShaderSources sources){
+    return (sources.language == sourceTypeGLSL && BUILTIN_GLSL_COMPILABLE) ||
+           (sources.language == sourceTypeWGSL && BUILTIN_WGSL_COMPILABLE);
+}
+
+// What to compile at runtime when the embedded data is outdated, in the language this build can parse
+static ShaderSources runtimeSources(BuiltinShaderID id){
+    const ShaderSources sources = GetBuiltinShaderSources(id);
+    return runtimeCompilable(sources) ? sources : GetBuiltinShaderWGSLSources(id);
+}
+
+static uint64_t fnv1a(uint64_t h, const void* data, size_t size){
+    const uint8_t* bytes = (const uint8_t*)data;
+    for(size_t i = 0;i < size;i++){
+        h ^= bytes[i];
+        h *= 0x100000001b3ull;
+    }
+    return h;
+}
+
+// Unlike ShaderSourcesHash this does not depend on the backend, the embedded file is shared by all of them
+uint64_t BuiltinShaderSourceHash(ShaderSources sources){
+    uint64_t h = 0xcbf29ce484222325ull;
+    const uint32_t language = (uint32_t)sources.language;
+    h = fnv1a(h, &language, sizeof(language));
+    for(uint32_t i = 0;i < sources.sourceCount;i++){
+        const uint32_t stageMask = (uint32_t)sources.sources[i].stageMask;
+        h = fnv1a(h, &stageMask, sizeof(stageMask));
+        h = fnv1a(h, &sources.sources[i].sizeInBytes, sizeof(uint32_t));
+        h = fnv1a(h, sources.sources[i].data, sources.sources[i].sizeInBytes);
+    }
+    return h;
+}
+
+// Dawn only reads SPIR-V with Tint's SPIR-V reader, which CMakeLists.txt enables together with SUPPORT_GLSL_PARSER,
+// and the browser never does. LoadShaderModuleSPIRV is compiled out there.
+#if defined(__EMSCRIPTEN__)
+    #define BUILTIN_SPIRV_ACCEPTED 0
+#elif SUPPORT_WGPU_BACKEND == 1
+    #define BUILTIN_SPIRV_ACCEPTED (SUPPORT_GLSL_PARSER == 1)
+#else
+    #define BUILTIN_SPIRV_ACCEPTED 1
+#endif
+
+static bool embeddedUpToDate(const BuiltinShaderData* data, ShaderSources sources){
+    return data->sourceHash != 0 && data->sourceHash == BuiltinShaderSourceHash(sources);
+}
+
+// With useSPIRV the embedded SPIR-V is loaded, otherwise sources are consumed natively with the embedded reflection
+static bool loadEmbedded(const BuiltinShaderData* data, ShaderSources sources, bool useSPIRV, ShaderBatchResult* result){
+    ShaderSources spirv = {0};
+    if(useSPIRV){
+        spirv.language = sourceTypeSPIRV;
+        spirv.sourceCount = data->spirvCount;
+        memcpy(spirv.sources, data->spirv, sizeof(data->spirv));
+    }
+
+    ShaderReflectionInfo reflection = {0};
+    memcpy(reflection.ep, data->ep, sizeof(data->ep));
+    reflection.attributes = data->attributes;
+    reflection.uniforms = callocnew(StringToUniformMap);
+    StringToUniformMap_init(reflection.uniforms);
+    for(uint32_t i = 0;i < data->uniformCount;i++){
+        StringToUniformMap_put(reflection.uniforms, BIfromCString(data->uniforms[i].name), data->uniforms[i].desc);
+    }
+    result->success = CreateShaderFromPrepared(useSPIRV ? spirv : sources, spirv, reflection, result);
+    return result->success;
+}
+
+bool LoadBuiltinShader(BuiltinShaderID id, ShaderBatchResult* result){
+    *result = CLITERAL(ShaderBatchResult){0};
+    const BuiltinShaderData* data = g_builtinShaderData + id;
+    ShaderSources sources = GetBuiltinShaderSources(id);
+    if(sources.sourceCount == 0){
+        snprintf(result->diagnostics, sizeof(result->diagnostics), "Built-in shader %s is not part of this build", data->name);
+        return false;
+    }
+
+    const bool upToDate = embeddedUpToDate(data, sources);
+    #if BUILTIN_SPIRV_ACCEPTED
+    if(data->spirvCount > 0 && (upToDate || !runtimeCompilable(runtimeSources(id)))){
+        if(!upToDate){
+            TRACELOG(LOG_WARNING, "Embedded %s shader is outdated and this build cannot compile it, loading it anyway", data->name);
+        }
+        return loadEmbedded(data, sources, true, result);
+    }
+    #endif
+    #if SUPPORT_WGPU_BACKEND == 1 || SUPPORT_WGPU_BACKEND == 0
+    const ShaderSources wgslSources = GetBuiltinShaderWGSLSources(id);
+    if(embeddedUpToDate(g_builtinShaderWGSLData + id, wgslSources)){
+        return loadEmbedded(g_builtinShaderWGSLData + id, wgslSources, false, result);
+    }
+    #endif
+
+    if(data->sourceHash != 0 && !upToDate){
+        TRACELOG(LOG_WARNING, "Embedded %s shader is outdated, rebuild the raygpu_builtin_shaders target", data->name);
+    }
+    sources = runtimeSources(id);
+    ShaderSources spirv = {0};
+    ShaderReflectionInfo reflection = {0};
+    result->success = PrepareShaderSources(&sources, NULL, &spirv, &reflection, result) &&
+                      CreateShaderFromPrepared(sources, spirv, reflection, result);
+    ShaderCacheFreeSources(&spirv);
+    return result->success;
+}
+
+// end file src/builtin_shaders.c
@@ -0,0 +1,440 @@
+// begin file src/builtin_shaders_embedded.c
+// Generated by tools/embed_builtin_shaders.c, do not edit. See src/builtin_shaders.c
+
+#include <raygpu.h>
+#include "internal_include/internals.h"
+
+static const uint32_t builtin_default_spirv0[] = {
+    0x07230203, 0x00010300, 0x0008000b, 0x0000003f, 0x00000000, 0x00020011, 0x00000001, 0x0006000b,
+    0x00000001, 0x4c534c47, 0x6474732e, 0x3035342e, 0x00000000, 0x0003000e, 0x00000000, 0x00000001,
+    0x000e000f, 0x00000000, 0x00000004, 0x6e69616d, 0x00000000, 0x0000000d, 0x00000020, 0x00000028,
+    0x00000033, 0x00000035, 0x00000037, 0x00000039, 0x0000003c, 0x0000003d, 0x00030003, 0x00000002,
+    0x000001c2, 0x00040005, 0x00000004, 0x6e69616d, 0x00000000, 0x00060005, 0x0000000b, 0x505f6c67,
+    0x65567265, 0x78657472, 0x00000000, 0x00060006, 0x0000000b, 0x00000000, 0x505f6c67, 0x7469736f,
+    0x006e6f69, 0x00070006, 0x0000000b, 0x00000001, 0x505f6c67, 0x746e696f, 0x657a6953, 0x00000000,
+    0x00070006, 0x0000000b, 0x00000002, 0x435f6c67, 0x4470696c, 0x61747369, 0x0065636e, 0x00070006,
+    0x0000000b, 0x00000003, 0x435f6c67, 0x446c6c75, 0x61747369, 0x0065636e, 0x00030005, 0x0000000d,
+    0x00000000, 0x00070005, 0x00000015, 0x73726550, 0x74636570, 0x5f657669, 0x77656956, 0x00000000,
+    0x00060006, 0x00000015, 0x00000000, 0x616d7670, 0x78697274, 0x00000000, 0x00030005, 0x00000017,
+    0x00000000, 0x00050005, 0x0000001c, 0x65646f6d, 0x74614d6c, 0x00786972, 0x00070006, 0x0000001c,
+    0x00000000, 0x65646f6d, 0x74614d6c, 0x65636972, 0x00000073, 0x00030005, 0x0000001e, 0x00000000,
+    0x00070005, 0x00000020, 0x495f6c67, 0x6174736e, 0x4965636e, 0x7865646e, 0x00000000, 0x00050005,
+    0x00000028, 0x705f6e69, 0x7469736f, 0x006e6f69, 0x00040005, 0x00000033, 0x67617266, 0x0076755f,
+    0x00040005, 0x00000035, 0x755f6e69, 0x00000076, 0x00050005, 0x00000037, 0x67617266, 0x6c6f635f,
+    0x0000726f, 0x00050005, 0x00000039, 0x635f6e69, 0x726f6c6f, 0x00000000, 0x00050005, 0x0000003c,
+    0x5f74756f, 0x6d726f6e, 0x00006c61, 0x00050005, 0x0000003d, 0x6e5f6e69, 0x616d726f, 0x0000006c,
+    0x00030047, 0x0000000b, 0x00000002, 0x00050048, 0x0000000b, 0x00000000, 0x0000000b, 0x00000000,
+    0x00050048, 0x0000000b, 0x00000001, 0x0000000b, 0x00000001, 0x00050048, 0x0000000b, 0x00000002,
+    0x0000000b, 0x00000003, 0x00050048, 0x0000000b, 0x00000003, 0x0000000b, 0x00000004, 0x00030047,
+    0x00000015, 0x00000002, 0x00040048, 0x00000015, 0x00000000, 0x00000005, 0x00050048, 0x00000015,
+    0x00000000, 0x00000007, 0x00000010, 0x00050048, 0x00000015, 0x00000000, 0x00000023, 0x00000000,
+    0x00040047, 0x00000017, 0x00000021, 0x00000000, 0x00040047, 0x00000017, 0x00000022, 0x00000000,
+    0x00040047, 0x0000001b, 0x00000006, 0x00000040, 0x00030047, 0x0000001c, 0x00000002, 0x00040048,
+    0x0000001c, 0x00000000, 0x00000005, 0x00050048, 0x0000001c, 0x00000000, 0x00000007, 0x00000010,
+    0x00040048, 0x0000001c, 0x00000000, 0x00000018, 0x00050048, 0x0000001c, 0x00000000, 0x00000023,
+    0x00000000, 0x00030047, 0x0000001e, 0x00000018, 0x00040047, 0x0000001e, 0x00000021, 0x00000003,
+    0x00040047, 0x0000001e, 0x00000022, 0x00000000, 0x00040047, 0x00000020, 0x0000000b, 0x0000002b,
+    0x00040047, 0x00000028, 0x0000001e, 0x00000000, 0x00040047, 0x00000033, 0x0000001e, 0x00000000,
+    0x00040047, 0x00000035, 0x0000001e, 0x00000001, 0x00040047, 0x00000037, 0x0000001e, 0x00000001,
+    0x00040047, 0x00000039, 0x0000001e, 0x00000003, 0x00040047, 0x0000003c, 0x0000001e, 0x00000002,
+    0x00040047, 0x0000003d, 0x0000001e, 0x00000002, 0x00020013, 0x00000002, 0x00030021, 0x00000003,
+    0x00000002, 0x00030016, 0x00000006, 0x00000020, 0x00040017, 0x00000007, 0x00000006, 0x00000004,
+    0x00040015, 0x00000008, 0x00000020, 0x00000000, 0x0004002b, 0x00000008, 0x00000009, 0x00000001,
+    0x0004001c, 0x0000000a, 0x00000006, 0x00000009, 0x0006001e, 0x0000000b, 0x00000007, 0x00000006,
+    0x0000000a, 0x0000000a, 0x00040020, 0x0000000c, 0x00000003, 0x0000000b, 0x0004003b, 0x0000000c,
+    0x0000000d, 0x00000003, 0x00040015, 0x0000000e, 0x00000020, 0x00000001, 0x0004002b, 0x0000000e,
+    0x0000000f, 0x00000001, 0x0004002b, 0x00000006, 0x00000010, 0x3f800000, 0x00040020, 0x00000011,
+    0x00000003, 0x00000006, 0x0004002b, 0x0000000e, 0x00000013, 0x00000000, 0x00040018, 0x00000014,
+    0x00000007, 0x00000004, 0x0003001e, 0x00000015, 0x00000014, 0x00040020, 0x00000016, 0x00000002,
+    0x00000015, 0x0004003b, 0x00000016, 0x00000017, 0x00000002, 0x00040020, 0x00000018, 0x00000002,
+    0x00000014, 0x0003001d, 0x0000001b, 0x00000014, 0x0003001e, 0x0000001c, 0x0000001b, 0x00040020,
+    0x0000001d, 0x0000000c, 0x0000001c, 0x0004003b, 0x0000001d, 0x0000001e, 0x0000000c, 0x00040020,
+    0x0000001f, 0x00000001, 0x0000000e, 0x0004003b, 0x0000001f, 0x00000020, 0x00000001, 0x00040020,
+    0x00000022, 0x0000000c, 0x00000014, 0x00040017, 0x00000026, 0x00000006, 0x00000003, 0x00040020,
+    0x00000027, 0x00000001, 0x00000026, 0x0004003b, 0x00000027, 0x00000028, 0x00000001, 0x00040020,
+    0x0000002f, 0x00000003, 0x00000007, 0x00040017, 0x00000031, 0x00000006, 0x00000002, 0x00040020,
+    0x00000032, 0x00000003, 0x00000031, 0x0004003b, 0x00000032, 0x00000033, 0x00000003, 0x00040020,
+    0x00000034, 0x00000001, 0x00000031, 0x0004003b, 0x00000034, 0x00000035, 0x00000001, 0x0004003b,
+    0x0000002f, 0x00000037, 0x00000003, 0x00040020, 0x00000038, 0x00000001, 0x00000007, 0x0004003b,
+    0x00000038, 0x00000039, 0x00000001, 0x00040020, 0x0000003b, 0x00000003, 0x00000026, 0x0004003b,
+    0x0000003b, 0x0000003c, 0x00000003, 0x0004003b, 0x00000027, 0x0000003d, 0x00000001, 0x00050036,
+    0x00000002, 0x00000004, 0x00000000, 0x00000003, 0x000200f8, 0x00000005, 0x00050041, 0x00000011,
+    0x00000012, 0x0000000d, 0x0000000f, 0x0003003e, 0x00000012, 0x00000010, 0x00050041, 0x00000018,
+    0x00000019, 0x00000017, 0x00000013, 0x0004003d, 0x00000014, 0x0000001a, 0x00000019, 0x0004003d,
+    0x0000000e, 0x00000021, 0x00000020, 0x00060041, 0x00000022, 0x00000023, 0x0000001e, 0x00000013,
+    0x00000021, 0x0004003d, 0x00000014, 0x00000024, 0x00000023, 0x00050092, 0x00000014, 0x00000025,
+    0x0000001a, 0x00000024, 0x0004003d, 0x00000026, 0x00000029, 0x00000028, 0x00050051, 0x00000006,
+    0x0000002a, 0x00000029, 0x00000000, 0x00050051, 0x00000006, 0x0000002b, 0x00000029, 0x00000001,
+    0x00050051, 0x00000006, 0x0000002c, 0x00000029, 0x00000002, 0x00070050, 0x00000007, 0x0000002d,
+    0x0000002a, 0x0000002b, 0x0000002c, 0x00000010, 0x00050091, 0x00000007, 0x0000002e, 0x00000025,
+    0x0000002d, 0x00050041, 0x0000002f, 0x00000030, 0x0000000d, 0x00000013, 0x0003003e, 0x00000030,
+    0x0000002e, 0x0004003d, 0x00000031, 0x00000036, 0x00000035, 0x0003003e, 0x00000033, 0x00000036,
+    0x0004003d, 0x00000007, 0x0000003a, 0x00000039, 0x0003003e, 0x00000037, 0x0000003a, 0x0004003d,
+    0x00000026, 0x0000003e, 0x0000003d, 0x0003003e, 0x0000003c, 0x0000003e, 0x000100fd, 0x00010038,
+};
+static const uint32_t builtin_default_spirv1[] = {
+    0x07230203, 0x00010300, 0x0008000b, 0x00000020, 0x00000000, 0x00020011, 0x00000001, 0x0006000b,
+    0x00000001, 0x4c534c47, 0x6474732e, 0x3035342e, 0x00000000, 0x0003000e, 0x00000000, 0x00000001,
+    0x0008000f, 0x00000004, 0x00000004, 0x6e69616d, 0x00000000, 0x00000016, 0x0000001a, 0x0000001d,
+    0x00030010, 0x00000004, 0x00000007, 0x00030003, 0x00000002, 0x000001c2, 0x00040005, 0x00000004,
+    0x6e69616d, 0x00000000, 0x00050005, 0x00000009, 0x43786574, 0x726f6c6f, 0x00000000, 0x00050005,
+    0x0000000c, 0x74786574, 0x30657275, 0x00000000, 0x00050005, 0x00000010, 0x53786574, 0x6c706d61,
+    0x00007265, 0x00040005, 0x00000016, 0x67617266, 0x0076755f, 0x00050005, 0x0000001a, 0x4374756f,
+    0x726f6c6f, 0x00000000, 0x00050005, 0x0000001d, 0x67617266, 0x6c6f635f, 0x0000726f, 0x00040047,
+    0x0000000c, 0x00000021, 0x00000001, 0x00040047, 0x0000000c, 0x00000022, 0x00000000, 0x00040047,
+    0x00000010, 0x00000021, 0x00000002, 0x00040047, 0x00000010, 0x00000022, 0x00000000, 0x00040047,
+    0x00000016, 0x0000001e, 0x00000000, 0x00040047, 0x0000001a, 0x0000001e, 0x00000000, 0x00040047,
+    0x0000001d, 0x0000001e, 0x00000001, 0x00020013, 0x00000002, 0x00030021, 0x00000003, 0x00000002,
+    0x00030016, 0x00000006, 0x00000020, 0x00040017, 0x00000007, 0x00000006, 0x00000004, 0x00040020,
+    0x00000008, 0x00000007, 0x00000007, 0x00090019, 0x0000000a, 0x00000006, 0x00000001, 0x00000000,
+    0x00000000, 0x00000000, 0x00000001, 0x00000000, 0x00040020, 0x0000000b, 0x00000000, 0x0000000a,
+    0x0004003b, 0x0000000b, 0x0000000c, 0x00000000, 0x0002001a, 0x0000000e, 0x00040020, 0x0000000f,
+    0x00000000, 0x0000000e, 0x0004003b, 0x0000000f, 0x00000010, 0x00000000, 0x0003001b, 0x00000012,
+    0x0000000a, 0x00040017, 0x00000014, 0x00000006, 0x00000002, 0x00040020, 0x00000015, 0x00000001,
+    0x00000014, 0x0004003b, 0x00000015, 0x00000016, 0x00000001, 0x00040020, 0x00000019, 0x00000003,
+    0x00000007, 0x0004003b, 0x00000019, 0x0000001a, 0x00000003, 0x00040020, 0x0000001c, 0x00000001,
+    0x00000007, 0x0004003b, 0x0000001c, 0x0000001d, 0x00000001, 0x00050036, 0x00000002, 0x00000004,
+    0x00000000, 0x00000003, 0x000200f8, 0x00000005, 0x0004003b, 0x00000008, 0x00000009, 0x00000007,
+    0x0004003d, 0x0000000a, 0x0000000d, 0x0000000c, 0x0004003d, 0x0000000e, 0x00000011, 0x00000010,
+    0x00050056, 0x00000012, 0x00000013, 0x0000000d, 0x00000011, 0x0004003d, 0x00000014, 0x00000017,
+    0x00000016, 0x00050057, 0x00000007, 0x00000018, 0x00000013, 0x00000017, 0x0003003e, 0x00000009,
+    0x00000018, 0x0004003d, 0x00000007, 0x0000001b, 0x00000009, 0x0004003d, 0x00000007, 0x0000001e,
+    0x0000001d, 0x00050085, 0x00000007, 0x0000001f, 0x0000001b, 0x0000001e, 0x0003003e, 0x0000001a,
+    0x0000001f, 0x000100fd, 0x00010038,
+};
+static const BuiltinShaderUniform builtin_default_uniforms[] = {
+    {"Perspective_View", {.type = (uniform_type)1, .minBindingSize = 64, .location = 0, .access = (access_type)1, .fstype = (format_or_sample_type)0, .visibility = 0x1}},
+    {"texture0", {.type = (uniform_type)3, .minBindingSize = 0, .location = 1, .access = (access_type)0, .fstype = (format_or_sample_type)1, .visibility = 0x10}},
+    {"texSampler", {.type = (uniform_type)6, .minBindingSize = 0, .location = 2, .access = (access_type)0, .fstype = (format_or_sample_type)0, .visibility = 0x10}},
+    {"modelMatrix", {.type = (uniform_type)2, .minBindingSize = 64, .location = 3, .access = (access_type)0, .fstype = (format_or_sample_type)0, .visibility = 0x1}},
+};
+#define builtin_default_data { \
+    .name = "default", \
+    .sourceHash = 0x83b4732a7b34f1c3ull, \
+    .spirvCount = 2, \
+    .spirv[0] = {builtin_default_spirv0, sizeof(builtin_default_spirv0), 0x1}, \
+    .spirv[1] = {builtin_default_spirv1, sizeof(builtin_default_spirv1), 0x2}, \
+    .ep[0] = {(RGShaderStageEnum)0, "main"}, \
+    .ep[1] = {(RGShaderStageEnum)1, "main"}, \
+    .attributes.vertexAttributeCount = 4, \
+    .attributes.vertexAttributes = {{"in_position", (RGVertexFormat)0x15, 0}, {"in_uv", (RGVertexFormat)0x14, 1}, {"in_color", (RGVertexFormat)0x16, 3}, {"in_normal", (RGVertexFormat)0x15, 2}}, \
+    .attributes.attachmentCount = 1, \
+    .attributes.attachments = {{4, (format_or_sample_type)1}}, \
+    .uniformCount = 4, \
+    .uniforms = builtin_default_uniforms, \
+}
+
+static const BuiltinShaderUniform builtin_default_wgsl_uniforms[] = {
+    {"Perspective_View", {.type = (uniform_type)1, .minBindingSize = 0, .location = 0, .access = (access_type)0, .fstype = (format_or_sample_type)0, .visibility = 0x0}},
+    {"texture0", {.type = (uniform_type)3, .minBindingSize = 0, .location = 1, .access = (access_type)0, .fstype = (format_or_sample_type)1, .visibility = 0x0}},
+    {"texSampler", {.type = (uniform_type)6, .minBindingSize = 0, .location = 2, .access = (access_type)0, .fstype = (format_or_sample_type)0, .visibility = 0x0}},
+    {"modelMatrix", {.type = (uniform_type)2, .minBindingSize = 0, .location = 3, .access = (access_type)0, .fstype = (format_or_sample_type)0, .visibility = 0x0}},
+};
+#define builtin_default_wgsl_data { \
+    .name = "default", \
+    .sourceHash = 0xb5a621f0aba40c3dull, \
+    .spirvCount = 0, \
+    .ep[0] = {(RGShaderStageEnum)0, "vs_main"}, \
+    .ep[1] = {(RGShaderStageEnum)1, "fs_main"}, \
+    .attributes.vertexAttributeCount = 4, \
+    .attributes.vertexAttributes = {{"", (RGVertexFormat)0x15, 0}, {"", (RGVertexFormat)0x14, 1}, {"", (RGVertexFormat)0x15, 2}, {"", (RGVertexFormat)0x16, 3}}, \
+    .uniformCount = 4, \
+    .uniforms = builtin_default_wgsl_uniforms, \
+}
+
+static const uint32_t builtin_texture_array_spirv0[] = {
+    0x07230203, 0x00010300, 0x0008000b, 0x0000003e, 0x00000000, 0x00020011, 0x00000001, 0x0006000b,
+    0x00000001, 0x4c534c47, 0x6474732e, 0x3035342e, 0x00000000, 0x0003000e, 0x00000000, 0x00000001,
+    0x000f000f, 0x00000000, 0x00000004, 0x6e69616d, 0x00000000, 0x0000000d, 0x0000001c, 0x00000024,
+    0x00000030, 0x00000032, 0x00000034, 0x00000036, 0x00000039, 0x0000003b, 0x0000003d, 0x00030003,
+    0x00000002, 0x000001c2, 0x00040005, 0x00000004, 0x6e69616d, 0x00000000, 0x00060005, 0x0000000b,
+    0x505f6c67, 0x65567265, 0x78657472, 0x00000000, 0x00060006, 0x0000000b, 0x00000000, 0x505f6c67,
+    0x7469736f, 0x006e6f69, 0x00070006, 0x0000000b, 0x00000001, 0x505f6c67, 0x746e696f, 0x657a6953,
+    0x00000000, 0x00070006, 0x0000000b, 0x00000002, 0x435f6c67, 0x4470696c, 0x61747369, 0x0065636e,
+    0x00070006, 0x0000000b, 0x00000003, 0x435f6c67, 0x446c6c75, 0x61747369, 0x0065636e, 0x00030005,
+    0x0000000d, 0x00000000, 0x00070005, 0x00000011, 0x73726550, 0x74636570, 0x5f657669, 0x77656956,
+    0x00000000, 0x00060006, 0x00000011, 0x00000000, 0x616d7670, 0x78697274, 0x00000000, 0x00030005,
+    0x00000013, 0x00000000, 0x00050005, 0x00000018, 0x65646f6d, 0x74614d6c, 0x00786972, 0x00070006,
+    0x00000018, 0x00000000, 0x65646f6d, 0x74614d6c, 0x65636972, 0x00000073, 0x00030005, 0x0000001a,
+    0x00000000, 0x00070005, 0x0000001c, 0x495f6c67, 0x6174736e, 0x4965636e, 0x7865646e, 0x00000000,
+    0x00050005, 0x00000024, 0x705f6e69, 0x7469736f, 0x006e6f69, 0x00040005, 0x00000030, 0x67617266,
+    0x0076755f, 0x00040005, 0x00000032, 0x755f6e69, 0x00000076, 0x00050005, 0x00000034, 0x67617266,
+    0x6c6f635f, 0x0000726f, 0x00050005, 0x00000036, 0x635f6e69, 0x726f6c6f, 0x00000000, 0x00060005,
+    0x00000039, 0x67617266, 0x7865745f, 0x65646e49, 0x00000078, 0x00050005, 0x0000003b, 0x745f6e69,
+    0x6e497865, 0x00786564, 0x00050005, 0x0000003d, 0x6e5f6e69, 0x616d726f, 0x0000006c, 0x00030047,
+    0x0000000b, 0x00000002, 0x00050048, 0x0000000b, 0x00000000, 0x0000000b, 0x00000000, 0x00050048,
+    0x0000000b, 0x00000001, 0x0000000b, 0x00000001, 0x00050048, 0x0000000b, 0x00000002, 0x0000000b,
+    0x00000003, 0x00050048, 0x0000000b, 0x00000003, 0x0000000b, 0x00000004, 0x00030047, 0x00000011,
+    0x00000002, 0x00040048, 0x00000011, 0x00000000, 0x00000005, 0x00050048, 0x00000011, 0x00000000,
+    0x00000007, 0x00000010, 0x00050048, 0x00000011, 0x00000000, 0x00000023, 0x00000000, 0x00040047,
+    0x00000013, 0x00000021, 0x00000000, 0x00040047, 0x00000013, 0x00000022, 0x00000000, 0x00040047,
+    0x00000017, 0x00000006, 0x00000040, 0x00030047, 0x00000018, 0x00000002, 0x00040048, 0x00000018,
+    0x00000000, 0x00000005, 0x00050048, 0x00000018, 0x00000000, 0x00000007, 0x00000010, 0x00040048,
+    0x00000018, 0x00000000, 0x00000018, 0x00050048, 0x00000018, 0x00000000, 0x00000023, 0x00000000,
+    0x00030047, 0x0000001a, 0x00000018, 0x00040047, 0x0000001a, 0x00000021, 0x00000003, 0x00040047,
+    0x0000001a, 0x00000022, 0x00000000, 0x00040047, 0x0000001c, 0x0000000b, 0x0000002b, 0x00040047,
+    0x00000024, 0x0000001e, 0x00000000, 0x00040047, 0x00000030, 0x0000001e, 0x00000000, 0x00040047,
+    0x00000032, 0x0000001e, 0x00000001, 0x00040047, 0x00000034, 0x0000001e, 0x00000001, 0x00040047,
+    0x00000036, 0x0000001e, 0x00000003, 0x00030047, 0x00000039, 0x0000000e, 0x00040047, 0x00000039,
+    0x0000001e, 0x00000002, 0x00040047, 0x0000003b, 0x0000001e, 0x00000004, 0x00040047, 0x0000003d,
+    0x0000001e, 0x00000002, 0x00020013, 0x00000002, 0x00030021, 0x00000003, 0x00000002, 0x00030016,
+    0x00000006, 0x00000020, 0x00040017, 0x00000007, 0x00000006, 0x00000004, 0x00040015, 0x00000008,
+    0x00000020, 0x00000000, 0x0004002b, 0x00000008, 0x00000009, 0x00000001, 0x0004001c, 0x0000000a,
+    0x00000006, 0x00000009, 0x0006001e, 0x0000000b, 0x00000007, 0x00000006, 0x0000000a, 0x0000000a,
+    0x00040020, 0x0000000c, 0x00000003, 0x0000000b, 0x0004003b, 0x0000000c, 0x0000000d, 0x00000003,
+    0x00040015, 0x0000000e, 0x00000020, 0x00000001, 0x0004002b, 0x0000000e, 0x0000000f, 0x00000000,
+    0x00040018, 0x00000010, 0x00000007, 0x00000004, 0x0003001e, 0x00000011, 0x00000010, 0x00040020,
+    0x00000012, 0x00000002, 0x00000011, 0x0004003b, 0x00000012, 0x00000013, 0x00000002, 0x00040020,
+    0x00000014, 0x00000002, 0x00000010, 0x0003001d, 0x00000017, 0x00000010, 0x0003001e, 0x00000018,
+    0x00000017, 0x00040020, 0x00000019, 0x0000000c, 0x00000018, 0x0004003b, 0x00000019, 0x0000001a,
+    0x0000000c, 0x00040020, 0x0000001b, 0x00000001, 0x0000000e, 0x0004003b, 0x0000001b, 0x0000001c,
+    0x00000001, 0x00040020, 0x0000001e, 0x0000000c, 0x00000010, 0x00040017, 0x00000022, 0x00000006,
+    0x00000003, 0x00040020, 0x00000023, 0x00000001, 0x00000022, 0x0004003b, 0x00000023, 0x00000024,
+    0x00000001, 0x0004002b, 0x00000006, 0x00000026, 0x3f800000, 0x00040020, 0x0000002c, 0x00000003,
+    0x00000007, 0x00040017, 0x0000002e, 0x00000006, 0x00000002, 0x00040020, 0x0000002f, 0x00000003,
+    0x0000002e, 0x0004003b, 0x0000002f, 0x00000030, 0x00000003, 0x00040020, 0x00000031, 0x00000001,
+    0x0000002e, 0x0004003b, 0x00000031, 0x00000032, 0x00000001, 0x0004003b, 0x0000002c, 0x00000034,
+    0x00000003, 0x00040020, 0x00000035, 0x00000001, 0x00000007, 0x0004003b, 0x00000035, 0x00000036,
+    0x00000001, 0x00040020, 0x00000038, 0x00000003, 0x00000008, 0x0004003b, 0x00000038, 0x00000039,
+    0x00000003, 0x00040020, 0x0000003a, 0x00000001, 0x00000008, 0x0004003b, 0x0000003a, 0x0000003b,
+    0x00000001, 0x0004003b, 0x00000023, 0x0000003d, 0x00000001, 0x00050036, 0x00000002, 0x00000004,
+    0x00000000, 0x00000003, 0x000200f8, 0x00000005, 0x00050041, 0x00000014, 0x00000015, 0x00000013,
+    0x0000000f, 0x0004003d, 0x00000010, 0x00000016, 0x00000015, 0x0004003d, 0x0000000e, 0x0000001d,
+    0x0000001c, 0x00060041, 0x0000001e, 0x0000001f, 0x0000001a, 0x0000000f, 0x0000001d, 0x0004003d,
+    0x00000010, 0x00000020, 0x0000001f, 0x00050092, 0x00000010, 0x00000021, 0x00000016, 0x00000020,
+    0x0004003d, 0x00000022, 0x00000025, 0x00000024, 0x00050051, 0x00000006, 0x00000027, 0x00000025,
+    0x00000000, 0x00050051, 0x00000006, 0x00000028, 0x00000025, 0x00000001, 0x00050051, 0x00000006,
+    0x00000029, 0x00000025, 0x00000002, 0x00070050, 0x00000007, 0x0000002a, 0x00000027, 0x00000028,
+    0x00000029, 0x00000026, 0x00050091, 0x00000007, 0x0000002b, 0x00000021, 0x0000002a, 0x00050041,
+    0x0000002c, 0x0000002d, 0x0000000d, 0x0000000f, 0x0003003e, 0x0000002d, 0x0000002b, 0x0004003d,
+    0x0000002e, 0x00000033, 0x00000032, 0x0003003e, 0x00000030, 0x00000033, 0x0004003d, 0x00000007,
+    0x00000037, 0x00000036, 0x0003003e, 0x00000034, 0x00000037, 0x0004003d, 0x00000008, 0x0000003c,
+    0x0000003b, 0x0003003e, 0x00000039, 0x0000003c, 0x000100fd, 0x00010038,
+};
+static const uint32_t builtin_texture_array_spirv1[] = {
+    0x07230203, 0x00010300, 0x0008000b, 0x00000043, 0x00000000, 0x00020011, 0x00000001, 0x00020011,
+    0x00000032, 0x0006000b, 0x00000001, 0x4c534c47, 0x6474732e, 0x3035342e, 0x00000000, 0x0003000e,
+    0x00000000, 0x00000001, 0x0009000f, 0x00000004, 0x00000004, 0x6e69616d, 0x00000000, 0x0000000a,
+    0x0000002a, 0x00000034, 0x00000040, 0x00030010, 0x00000004, 0x00000007, 0x00030003, 0x00000002,
+    0x000001c2, 0x00040005, 0x00000004, 0x6e69616d, 0x00000000, 0x00040005, 0x00000008, 0x6579616c,
+    0x00000072, 0x00060005, 0x0000000a, 0x67617266, 0x7865745f, 0x65646e49, 0x00000078, 0x00050005,
+    0x0000000f, 0x74786574, 0x30657275, 0x00000000, 0x00050005, 0x00000013, 0x53786574, 0x6c706d61,
+    0x00007265, 0x00050005, 0x00000024, 0x43786574, 0x726f6c6f, 0x00000000, 0x00040005, 0x0000002a,
+    0x67617266, 0x0076755f, 0x00050005, 0x00000034, 0x4374756f, 0x726f6c6f, 0x00000000, 0x00050005,
+    0x00000040, 0x67617266, 0x6c6f635f, 0x0000726f, 0x00030047, 0x0000000a, 0x0000000e, 0x00040047,
+    0x0000000a, 0x0000001e, 0x00000002, 0x00040047, 0x0000000f, 0x00000021, 0x00000001, 0x00040047,
+    0x0000000f, 0x00000022, 0x00000000, 0x00040047, 0x00000013, 0x00000021, 0x00000002, 0x00040047,
+    0x00000013, 0x00000022, 0x00000000, 0x00040047, 0x0000002a, 0x0000001e, 0x00000000, 0x00040047,
+    0x00000034, 0x0000001e, 0x00000000, 0x00040047, 0x00000040, 0x0000001e, 0x00000001, 0x00020013,
+    0x00000002, 0x00030021, 0x00000003, 0x00000002, 0x00040015, 0x00000006, 0x00000020, 0x00000000,
+    0x00040020, 0x00000007, 0x00000007, 0x00000006, 0x00040020, 0x00000009, 0x00000001, 0x00000006,
+    0x0004003b, 0x00000009, 0x0000000a, 0x00000001, 0x00030016, 0x0000000c, 0x00000020, 0x00090019,
+    0x0000000d, 0x0000000c, 0x00000001, 0x00000000, 0x00000001, 0x00000000, 0x00000001, 0x00000000,
+    0x00040020, 0x0000000e, 0x00000000, 0x0000000d, 0x0004003b, 0x0000000e, 0x0000000f, 0x00000000,
+    0x0002001a, 0x00000011, 0x00040020, 0x00000012, 0x00000000, 0x00000011, 0x0004003b, 0x00000012,
+    0x00000013, 0x00000000, 0x0003001b, 0x00000015, 0x0000000d, 0x00040015, 0x00000017, 0x00000020,
+    0x00000001, 0x0004002b, 0x00000017, 0x00000018, 0x00000000, 0x00040017, 0x0000001a, 0x00000017,
+    0x00000003, 0x0004002b, 0x00000006, 0x0000001c, 0x00000002, 0x0004002b, 0x00000006, 0x0000001f,
+    0x00000001, 0x00040017, 0x00000022, 0x0000000c, 0x00000004, 0x00040020, 0x00000023, 0x00000007,
+    0x00000022, 0x00040017, 0x00000028, 0x0000000c, 0x00000002, 0x00040020, 0x00000029, 0x00000001,
+    0x00000028, 0x0004003b, 0x00000029, 0x0000002a, 0x00000001, 0x00040017, 0x0000002e, 0x0000000c,
+    0x00000003, 0x00040020, 0x00000033, 0x00000003, 0x00000022, 0x0004003b, 0x00000033, 0x00000034,
+    0x00000003, 0x0004002b, 0x00000006, 0x00000036, 0xffffffff, 0x00020014, 0x00000037, 0x0004002b,
+    0x0000000c, 0x00000039, 0x3f800000, 0x0007002c, 0x00000022, 0x0000003a, 0x00000039, 0x00000039,
+    0x00000039, 0x00000039, 0x00040017, 0x0000003c, 0x00000037, 0x00000004, 0x00040020, 0x0000003f,
+    0x00000001, 0x00000022, 0x0004003b, 0x0000003f, 0x00000040, 0x00000001, 0x00050036, 0x00000002,
+    0x00000004, 0x00000000, 0x00000003, 0x000200f8, 0x00000005, 0x0004003b, 0x00000007, 0x00000008,
+    0x00000007, 0x0004003b, 0x00000023, 0x00000024, 0x00000007, 0x0004003d, 0x00000006, 0x0000000b,
+    0x0000000a, 0x0004003d, 0x0000000d, 0x00000010, 0x0000000f, 0x0004003d, 0x00000011, 0x00000014,
+    0x00000013, 0x00050056, 0x00000015, 0x00000016, 0x00000010, 0x00000014, 0x00040064, 0x0000000d,
+    0x00000019, 0x00000016, 0x00050067, 0x0000001a, 0x0000001b, 0x00000019, 0x00000018, 0x00050051,
+    0x00000017, 0x0000001d, 0x0000001b, 0x00000002, 0x0004007c, 0x00000006, 0x0000001e, 0x0000001d,
+    0x00050082, 0x00000006, 0x00000020, 0x0000001e, 0x0000001f, 0x0007000c, 0x00000006, 0x00000021,
+    0x00000001, 0x00000026, 0x0000000b, 0x00000020, 0x0003003e, 0x00000008, 0x00000021, 0x0004003d,
+    0x0000000d, 0x00000025, 0x0000000f, 0x0004003d, 0x00000011, 0x00000026, 0x00000013, 0x00050056,
+    0x00000015, 0x00000027, 0x00000025, 0x00000026, 0x0004003d, 0x00000028, 0x0000002b, 0x0000002a,
+    0x0004003d, 0x00000006, 0x0000002c, 0x00000008, 0x00040070, 0x0000000c, 0x0000002d, 0x0000002c,
+    0x00050051, 0x0000000c, 0x0000002f, 0x0000002b, 0x00000000, 0x00050051, 0x0000000c, 0x00000030,
+    0x0000002b, 0x00000001, 0x00060050, 0x0000002e, 0x00000031, 0x0000002f, 0x00000030, 0x0000002d,
+    0x00050057, 0x00000022, 0x00000032, 0x00000027, 0x00000031, 0x0003003e, 0x00000024, 0x00000032,
+    0x0004003d, 0x00000006, 0x00000035, 0x0000000a, 0x000500aa, 0x00000037, 0x00000038, 0x00000035,
+    0x00000036, 0x0004003d, 0x00000022, 0x0000003b, 0x00000024, 0x00070050, 0x0000003c, 0x0000003d,
+    0x00000038, 0x00000038, 0x00000038, 0x00000038, 0x000600a9, 0x00000022, 0x0000003e, 0x0000003d,
+    0x0000003a, 0x0000003b, 0x0004003d, 0x00000022, 0x00000041, 0x00000040, 0x00050085, 0x00000022,
+    0x00000042, 0x0000003e, 0x00000041, 0x0003003e, 0x00000034, 0x00000042, 0x000100fd, 0x00010038,
+};
+static const BuiltinShaderUniform builtin_texture_array_uniforms[] = {
+    {"Perspective_View", {.type = (uniform_type)1, .minBindingSize = 64, .location = 0, .access = (access_type)1, .fstype = (format_or_sample_type)0, .visibility = 0x1}},
+    {"texture0", {.type = (uniform_type)3, .minBindingSize = 0, .location = 1, .access = (access_type)0, .fstype = (format_or_sample_type)1, .visibility = 0x10}},
+    {"texSampler", {.type = (uniform_type)6, .minBindingSize = 0, .location = 2, .access = (access_type)0, .fstype = (format_or_sample_type)0, .visibility = 0x10}},
+    {"modelMatrix", {.type = (uniform_type)2, .minBindingSize = 64, .location = 3, .access = (access_type)0, .fstype = (format_or_sample_type)0, .visibility = 0x1}},
+};
+#define builtin_texture_array_data { \
+    .name = "texture_array", \
+    .sourceHash = 0x719439be49bc1b0full, \
+    .spirvCount = 2, \
+    .spirv[0] = {builtin_texture_array_spirv0, sizeof(builtin_texture_array_spirv0), 0x1}, \
+    .spirv[1] = {builtin_texture_array_spirv1, sizeof(builtin_texture_array_spirv1), 0x2}, \
+    .ep[0] = {(RGShaderStageEnum)0, "main"}, \
+    .ep[1] = {(RGShaderStageEnum)1, "main"}, \
+    .attributes.vertexAttributeCount = 4, \
+    .attributes.vertexAttributes = {{"in_position", (RGVertexFormat)0x15, 0}, {"in_uv", (RGVertexFormat)0x14, 1}, {"in_color", (RGVertexFormat)0x16, 3}, {"in_texIndex", (RGVertexFormat)0x17, 4}}, \
+    .attributes.attachmentCount = 1, \
+    .attributes.attachments = {{4, (format_or_sample_type)1}}, \
+    .uniformCount = 4, \
+    .uniforms = builtin_texture_array_uniforms, \
+}
+
+static const BuiltinShaderUniform builtin_texture_array_wgsl_uniforms[] = {
+    {"Perspective_View", {.type = (uniform_type)1, .minBindingSize = 0, .location = 0, .access = (access_type)0, .fstype = (format_or_sample_type)0, .visibility = 0x0}},
+    {"texture0", {.type = (uniform_type)4, .minBindingSize = 0, .location = 1, .access = (access_type)0, .fstype = (format_or_sample_type)1, .visibility = 0x0}},
+    {"texSampler", {.type = (uniform_type)6, .minBindingSize = 0, .location = 2, .access = (access_type)0, .fstype = (format_or_sample_type)0, .visibility = 0x0}},
+    {"modelMatrix", {.type = (uniform_type)2, .minBindingSize = 0, .location = 3, .access = (access_type)0, .fstype = (format_or_sample_type)0, .visibility = 0x0}},
+};
+#define builtin_texture_array_wgsl_data { \
+    .name = "texture_array", \
+    .sourceHash = 0x9893b86bbdaf0adcull, \
+    .spirvCount = 0, \
+    .ep[0] = {(RGShaderStageEnum)0, "vs_main"}, \
+    .ep[1] = {(RGShaderStageEnum)1, "fs_main"}, \
+    .attributes.vertexAttributeCount = 5, \
+    .attributes.vertexAttributes = {{"", (RGVertexFormat)0x15, 0}, {"", (RGVertexFormat)0x14, 1}, {"", (RGVertexFormat)0x15, 2}, {"", (RGVertexFormat)0x16, 3}, {"", (RGVertexFormat)0x17, 4}}, \
+    .uniformCount = 4, \
+    .uniforms = builtin_texture_array_wgsl_uniforms, \
+}
+
+static const uint32_t builtin_mipmap_spirv0[] = {
+    0x07230203, 0x00010300, 0x0008000b, 0x00000046, 0x00000000, 0x00020011, 0x00000001, 0x0006000b,
+    0x00000001, 0x4c534c47, 0x6474732e, 0x3035342e, 0x00000000, 0x0003000e, 0x00000000, 0x00000001,
+    0x0006000f, 0x00000005, 0x00000004, 0x6e69616d, 0x00000000, 0x0000000d, 0x00060010, 0x00000004,
+    0x00000011, 0x00000008, 0x00000008, 0x00000001, 0x00030003, 0x00000002, 0x000001c2, 0x000b0004,
+    0x455f4c47, 0x735f5458, 0x6c706d61, 0x656c7265, 0x745f7373, 0x75747865, 0x665f6572, 0x74636e75,
+    0x736e6f69, 0x00000000, 0x00040005, 0x00000004, 0x6e69616d, 0x00000000, 0x00030005, 0x00000009,
+    0x00006469, 0x00080005, 0x0000000d, 0x475f6c67, 0x61626f6c, 0x766e496c, 0x7461636f, 0x496e6f69,
+    0x00000044, 0x00040005, 0x00000015, 0x6f6c6f63, 0x00000072, 0x00070005, 0x00000018, 0x76657270,
+    0x73756f69, 0x4c70694d, 0x6c657665, 0x00000000, 0x00060005, 0x0000003f, 0x7478656e, 0x4c70694d,
+    0x6c657665, 0x00000000, 0x00040047, 0x0000000d, 0x0000000b, 0x0000001c, 0x00040047, 0x00000018,
+    0x00000021, 0x00000000, 0x00040047, 0x00000018, 0x00000022, 0x00000000, 0x00030047, 0x0000003f,
+    0x00000019, 0x00040047, 0x0000003f, 0x00000021, 0x00000001, 0x00040047, 0x0000003f, 0x00000022,
+    0x00000000, 0x00040047, 0x00000045, 0x0000000b, 0x00000019, 0x00020013, 0x00000002, 0x00030021,
+    0x00000003, 0x00000002, 0x00040015, 0x00000006, 0x00000020, 0x00000001, 0x00040017, 0x00000007,
+    0x00000006, 0x00000002, 0x00040020, 0x00000008, 0x00000007, 0x00000007, 0x00040015, 0x0000000a,
+    0x00000020, 0x00000000, 0x00040017, 0x0000000b, 0x0000000a, 0x00000003, 0x00040020, 0x0000000c,
+    0x00000001, 0x0000000b, 0x0004003b, 0x0000000c, 0x0000000d, 0x00000001, 0x00040017, 0x0000000e,
+    0x0000000a, 0x00000002, 0x00030016, 0x00000012, 0x00000020, 0x00040017, 0x00000013, 0x00000012,
+    0x00000004, 0x00040020, 0x00000014, 0x00000007, 0x00000013, 0x00090019, 0x00000016, 0x00000012,
+    0x00000001, 0x00000000, 0x00000000, 0x00000000, 0x00000001, 0x00000000, 0x00040020, 0x00000017,
+    0x00000000, 0x00000016, 0x0004003b, 0x00000017, 0x00000018, 0x00000000, 0x0004002b, 0x00000006,
+    0x0000001a, 0x00000002, 0x0004002b, 0x00000006, 0x0000001e, 0x00000000, 0x0005002c, 0x00000007,
+    0x0000001f, 0x0000001e, 0x0000001e, 0x0004002b, 0x00000006, 0x00000026, 0x00000001, 0x0005002c,
+    0x00000007, 0x00000027, 0x0000001e, 0x00000026, 0x0005002c, 0x00000007, 0x0000002f, 0x00000026,
+    0x0000001e, 0x0005002c, 0x00000007, 0x00000037, 0x00000026, 0x00000026, 0x0004002b, 0x00000012,
+    0x0000003b, 0x3e800000, 0x00090019, 0x0000003d, 0x00000012, 0x00000001, 0x00000000, 0x00000000,
+    0x00000000, 0x00000002, 0x00000004, 0x00040020, 0x0000003e, 0x00000000, 0x0000003d, 0x0004003b,
+    0x0000003e, 0x0000003f, 0x00000000, 0x0004002b, 0x0000000a, 0x00000043, 0x00000008, 0x0004002b,
+    0x0000000a, 0x00000044, 0x00000001, 0x0006002c, 0x0000000b, 0x00000045, 0x00000043, 0x00000043,
+    0x00000044, 0x00050036, 0x00000002, 0x00000004, 0x00000000, 0x00000003, 0x000200f8, 0x00000005,
+    0x0004003b, 0x00000008, 0x00000009, 0x00000007, 0x0004003b, 0x00000014, 0x00000015, 0x00000007,
+    0x0004003d, 0x0000000b, 0x0000000f, 0x0000000d, 0x0007004f, 0x0000000e, 0x00000010, 0x0000000f,
+    0x0000000f, 0x00000000, 0x00000001, 0x0004007c, 0x00000007, 0x00000011, 0x00000010, 0x0003003e,
+    0x00000009, 0x00000011, 0x0004003d, 0x00000016, 0x00000019, 0x00000018, 0x0004003d, 0x00000007,
+    0x0000001b, 0x00000009, 0x00050050, 0x00000007, 0x0000001c, 0x0000001a, 0x0000001a, 0x00050084,
+    0x00000007, 0x0000001d, 0x0000001c, 0x0000001b, 0x00050080, 0x00000007, 0x00000020, 0x0000001d,
+    0x0000001f, 0x0007005f, 0x00000013, 0x00000021, 0x00000019, 0x00000020, 0x00000002, 0x0000001e,
+    0x0004003d, 0x00000016, 0x00000022, 0x00000018, 0x0004003d, 0x00000007, 0x00000023, 0x00000009,
+    0x00050050, 0x00000007, 0x00000024, 0x0000001a, 0x0000001a, 0x00050084, 0x00000007, 0x00000025,
+    0x00000024, 0x00000023, 0x00050080, 0x00000007, 0x00000028, 0x00000025, 0x00000027, 0x0007005f,
+    0x00000013, 0x00000029, 0x00000022, 0x00000028, 0x00000002, 0x0000001e, 0x00050081, 0x00000013,
+    0x0000002a, 0x00000021, 0x00000029, 0x0004003d, 0x00000016, 0x0000002b, 0x00000018, 0x0004003d,
+    0x00000007, 0x0000002c, 0x00000009, 0x00050050, 0x00000007, 0x0000002d, 0x0000001a, 0x0000001a,
+    0x00050084, 0x00000007, 0x0000002e, 0x0000002d, 0x0000002c, 0x00050080, 0x00000007, 0x00000030,
+    0x0000002e, 0x0000002f, 0x0007005f, 0x00000013, 0x00000031, 0x0000002b, 0x00000030, 0x00000002,
+    0x0000001e, 0x00050081, 0x00000013, 0x00000032, 0x0000002a, 0x00000031, 0x0004003d, 0x00000016,
+    0x00000033, 0x00000018, 0x0004003d, 0x00000007, 0x00000034, 0x00000009, 0x00050050, 0x00000007,
+    0x00000035, 0x0000001a, 0x0000001a, 0x00050084, 0x00000007, 0x00000036, 0x00000035, 0x00000034,
+    0x00050080, 0x00000007, 0x00000038, 0x00000036, 0x00000037, 0x0007005f, 0x00000013, 0x00000039,
+    0x00000033, 0x00000038, 0x00000002, 0x0000001e, 0x00050081, 0x00000013, 0x0000003a, 0x00000032,
+    0x00000039, 0x0005008e, 0x00000013, 0x0000003c, 0x0000003a, 0x0000003b, 0x0003003e, 0x00000015,
+    0x0000003c, 0x0004003d, 0x0000003d, 0x00000040, 0x0000003f, 0x0004003d, 0x00000007, 0x00000041,
+    0x00000009, 0x0004003d, 0x00000013, 0x00000042, 0x00000015, 0x00040063, 0x00000040, 0x00000041,
+    0x00000042, 0x000100fd, 0x00010038,
+};
+static const BuiltinShaderUniform builtin_mipmap_uniforms[] = {
+    {"previousMipLevel", {.type = (uniform_type)3, .minBindingSize = 0, .location = 0, .access = (access_type)0, .fstype = (format_or_sample_type)1, .visibility = 0x20}},
+    {"nextMipLevel", {.type = (uniform_type)5, .minBindingSize = 0, .location = 1, .access = (access_type)2, .fstype = (format_or_sample_type)6, .visibility = 0x20}},
+};
+#define builtin_mipmap_data { \
+    .name = "mipmap", \
+    .sourceHash = 0xff2e9953d0e33261ull, \
+    .spirvCount = 1, \
+    .spirv[0] = {builtin_mipmap_spirv0, sizeof(builtin_mipmap_spirv0), 0x4}, \
+    .ep[2] = {(RGShaderStageEnum)2, "main"}, \
+    .uniformCount = 2, \
+    .uniforms = builtin_mipmap_uniforms, \
+}
+
+static const BuiltinShaderUniform builtin_mipmap_wgsl_uniforms[] = {
+    {"previousMipLevel", {.type = (uniform_type)3, .minBindingSize = 0, .location = 0, .access = (access_type)0, .fstype = (format_or_sample_type)1, .visibility = 0x0}},
+    {"nextMipLevel", {.type = (uniform_type)5, .minBindingSize = 0, .location = 1, .access = (access_type)2, .fstype = (format_or_sample_type)6, .visibility = 0x0}},
+};
+#define builtin_mipmap_wgsl_data { \
+    .name = "mipmap", \
+    .sourceHash = 0x334d8432d3641258ull, \
+    .spirvCount = 0, \
+    .ep[2] = {(RGShaderStageEnum)2, "compute_main"}, \
+    .uniformCount = 2, \
+    .uniforms = builtin_mipmap_wgsl_uniforms, \
+}
+
+static const BuiltinShaderUniform builtin_indirect_cull_uniforms[] = {
+    {"params", {.type = (uniform_type)1, .minBindingSize = 100, .location = 0, .access = (access_type)0, .fstype = (format_or_sample_type)0, .visibility = 0x0}},
+    {"records", {.type = (uniform_type)2, .minBindingSize = 0, .location = 1, .access = (access_type)0, .fstype = (format_or_sample_type)0, .visibility = 0x0}},
+    {"drawArgs", {.type = (uniform_type)2, .minBindingSize = 0, .location = 2, .access = (access_type)1, .fstype = (format_or_sample_type)0, .visibility = 0x0}},
+    {"visibleTransforms", {.type = (uniform_type)2, .minBindingSize = 0, .location = 3, .access = (access_type)1, .fstype = (format_or_sample_type)0, .visibility = 0x0}},
+};
+#define builtin_indirect_cull_data { \
+    .name = "indirect_cull", \
+    .sourceHash = 0x59f27268b4024cbeull, \
+    .spirvCount = 0, \
+    .ep[2] = {(RGShaderStageEnum)2, "compute_main"}, \
+    .uniformCount = 4, \
+    .uniforms = builtin_indirect_cull_uniforms, \
+}
+
+#define builtin_indirect_cull_wgsl_data builtin_indirect_cull_data
+
+static const BuiltinShaderUniform builtin_mesh_skinning_uniforms[] = {
+    {"params", {.type = (uniform_type)1, .minBindingSize = 16, .location = 0, .access = (access_type)0, .fstype = (format_or_sample_type)0, .visibility = 0x0}},
+    {"vertices", {.type = (uniform_type)2, .minBindingSize = 0, .location = 1, .access = (access_type)0, .fstype = (format_or_sample_type)0, .visibility = 0x0}},
+    {"bones", {.type = (uniform_type)2, .minBindingSize = 0, .location = 2, .access = (access_type)0, .fstype = (format_or_sample_type)0, .visibility = 0x0}},
+    {"slotBoneBase", {.type = (uniform_type)2, .minBindingSize = 0, .location = 3, .access = (access_type)0, .fstype = (format_or_sample_type)0, .visibility = 0x0}},
+    {"skinned", {.type = (uniform_type)2, .minBindingSize = 0, .location = 4, .access = (access_type)1, .fstype = (format_or_sample_type)0, .visibility = 0x0}},
+};
+#define builtin_mesh_skinning_data { \
+    .name = "mesh_skinning", \
+    .sourceHash = 0x3f6d2c61e89b6734ull, \
+    .spirvCount = 0, \
+    .ep[2] = {(RGShaderStageEnum)2, "compute_main"}, \
+    .uniformCount = 5, \
+    .uniforms = builtin_mesh_skinning_uniforms, \
+}
+
+#define builtin_mesh_skinning_wgsl_data builtin_mesh_skinning_data
+
+const BuiltinShaderData g_builtinShaderData[BuiltinShader_EnumCount] = {
+    builtin_default_data,
+    builtin_texture_array_data,
+    builtin_mipmap_data,
+    builtin_indirect_cull_data,
+    builtin_mesh_skinning_data,
+};
+
+const BuiltinShaderData g_builtinShaderWGSLData[BuiltinShader_EnumCount] = {
+    builtin_default_wgsl_data,
+    builtin_texture_array_wgsl_data,
+    builtin_mipmap_wgsl_data,
+    builtin_indirect_cull_wgsl_data,
+    builtin_mesh_skinning_wgsl_data,
+};
+
+// end file src/builtin_shaders_embedded.c
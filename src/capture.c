@@ -0,0 +1,192 @@
+// begin file src/capture.c
+// Pipelined frame capture: the render thread only copies finished readbacks out of the staging buffers,
+// stride removal and channel swizzling happen on a converter thread and a writer thread drains the
+// packed frames into the sink. Both hand-offs are bounded queues, so a slow sink throttles rendering
+// instead of growing memory.
+
+#include <raygpu.h>
+#include <string.h>
+#include "internal_include/internals.h"
+#include "internal_include/rg_thread.h"
+
+typedef struct CapturedFrame{
+    uint8_t* data;
+    size_t capacity;
+    uint32_t width, height;
+    size_t rowStrideInBytes;
+    PixelFormat format;
+}CapturedFrame;
+
+typedef struct FrameCaptureState{
+    bool active;
+    bool threaded;
+    FILE* sink;
+    rg_queue freeFrames;   // Recycled frame buffers
+    rg_queue rawFrames;    // Padded readback rows, waiting for conversion
+    rg_queue packedFrames; // Tightly packed RGBA8, waiting to be written
+    rg_thread converter;
+    rg_thread writer;
+}FrameCaptureState;
+
+static FrameCaptureState g_capture;
+
+static CapturedFrame* acquireFrame(size_t size){
+    CapturedFrame* frame = g_capture.threaded ? (CapturedFrame*)rg_queue_try_pop(&g_capture.freeFrames) : NULL;
+    if(frame == NULL){
+        frame = callocnew(CapturedFrame);
+    }
+    if(frame->capacity < size){
+        RL_FREE(frame->data);
+        frame->data = (uint8_t*)RL_MALLOC(size);
+        frame->capacity = size;
+    }
+    return frame;
+}
+
+static void releaseFrame(CapturedFrame* frame){
+    if(g_capture.threaded && rg_queue_try_push(&g_capture.freeFrames, frame))
+        return;
+    RL_FREE(frame->data);
+    RL_FREE(frame);
+}
+
+// Removes the 256 byte row padding in place and converts BGRA to RGBA
+static void packFrame(CapturedFrame* frame){
+    const size_t packedRow = (size_t)frame->width * 4;
+    const bool swizzle = frame->format == PIXELFORMAT_UNCOMPRESSED_B8G8R8A8 || frame->format == PIXELFORMAT_UNCOMPRESSED_B8G8R8A8_SRGB;
+    for(uint32_t y = 0;y < frame->height;y++){
+        uint8_t* dst = frame->data + y * packedRow;
+        if(frame->rowStrideInBytes != packedRow){
+            memmove(dst, frame->data + y * frame->rowStrideInBytes, packedRow);
+        }
+        if(swizzle){
+            for(uint32_t x = 0;x < frame->width;x++){
+                uint8_t b = dst[x * 4 + 0];
+                dst[x * 4 + 0] = dst[x * 4 + 2];
+                dst[x * 4 + 2] = b;
+            }
+        }
+    }
+    frame->rowStrideInBytes = packedRow;
+}
+
+static void writeFrame(CapturedFrame* frame){
+    fwrite(frame->data, 1, frame->rowStrideInBytes * frame->height, g_capture.sink);
+    fflush(g_capture.sink);
+}
+
+static void converterMain(void* arg){
+    (void)arg;
+    CapturedFrame* frame;
+    while((frame = (CapturedFrame*)rg_queue_pop(&g_capture.rawFrames)) != NULL){
+        packFrame(frame);
+        rg_queue_push(&g_capture.packedFrames, frame);
+    }
+    rg_queue_close(&g_capture.packedFrames);
+}
+
+static void writerMain(void* arg){
+    (void)arg;
+    CapturedFrame* frame;
+    while((frame = (CapturedFrame*)rg_queue_pop(&g_capture.packedFrames)) != NULL){
+        writeFrame(frame);
+        releaseFrame(frame);
+    }
+}
+
+static void onCaptureReadback(Image image, void* userdata){
+    (void)userdata;
+    if(image.data == NULL || !g_capture.active)
+        return;
+    const size_t size = image.rowStrideInBytes * image.height;
+    CapturedFrame* frame = acquireFrame(size);
+    memcpy(frame->data, image.data, size);
+    frame->width = image.width;
+    frame->height = image.height;
+    frame->rowStrideInBytes = image.rowStrideInBytes;
+    frame->format = image.format;
+    if(g_capture.threaded){
+        rg_queue_push(&g_capture.rawFrames, frame);
+    }
+    else{
+        packFrame(frame);
+        writeFrame(frame);
+        releaseFrame(frame);
+    }
+}
+
+bool StartFrameCapture(FILE* sink){
+    if(g_capture.active){
+        TRACELOG(LOG_WARNING, "Frame capture already running");
+        return false;
+    }
+    g_capture.sink = sink;
+    g_capture.threaded = false;
+    #if RG_HAS_THREADS == 1
+    rg_queue_init(&g_capture.freeFrames, 2 * CAPTURE_QUEUE_DEPTH + 2);
+    rg_queue_init(&g_capture.rawFrames, CAPTURE_QUEUE_DEPTH);
+    rg_queue_init(&g_capture.packedFrames, CAPTURE_QUEUE_DEPTH);
+    g_capture.threaded = true;
+    if(!rg_thread_create(&g_capture.converter, converterMain, NULL)){
+        TRACELOG(LOG_WARNING, "Failed to start the capture converter thread, capturing synchronously");
+        g_capture.threaded = false;
+    }
+    else if(!rg_thread_create(&g_capture.writer, writerMain, NULL)){
+        TRACELOG(LOG_WARNING, "Failed to start the capture writer thread, capturing synchronously");
+        rg_queue_close(&g_capture.rawFrames);
+        rg_thread_join(g_capture.converter);
+        g_capture.threaded = false;
+    }
+    if(!g_capture.threaded){
+        rg_queue_destroy(&g_capture.freeFrames);
+        rg_queue_destroy(&g_capture.rawFrames);
+        rg_queue_destroy(&g_capture.packedFrames);
+    }
+    #endif
+    g_capture.active = true;
+    return true;
+}
+
+void StopFrameCapture(){
+    if(!g_capture.active)
+        return;
+    FlushReadbacks();
+    g_capture.active = false;
+    if(g_capture.threaded){
+        rg_queue_close(&g_capture.rawFrames);
+        rg_thread_join(g_capture.converter);
+        rg_thread_join(g_capture.writer);
+        g_capture.threaded = false;
+        CapturedFrame* frame;
+        while((frame = (CapturedFrame*)rg_queue_try_pop(&g_capture.freeFrames)) != NULL){
+            releaseFrame(frame);
+        }
+        rg_queue_destroy(&g_capture.freeFrames);
+        rg_queue_destroy(&g_capture.rawFrames);
+        rg_queue_destroy(&g_capture.packedFrames);
+    }
+    fflush(g_capture.sink);
+}
+
+bool IsFrameCaptureActive(){
+    return g_capture.active;
+}
+
+void CaptureFrame(Texture colorTarget, PixelFormat format){
+    if(!g_capture.active)
+        return;
+    colorTarget.format = format;
+    if(colorTarget.format != PIXELFORMAT_UNCOMPRESSED_B8G8R8A8 && colorTarget.format != PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 &&
+       colorTarget.format != PIXELFORMAT_UNCOMPRESSED_B8G8R8A8_SRGB && colorTarget.format != PIXELFORMAT_UNCOMPRESSED_R8G8B8A8_SRGB){
+        TRACELOG(LOG_ERROR, "Unsupported pixel format for frame capture, stopping");
+        StopFrameCapture();
+        return;
+    }
+    if(!RequestTextureReadback(colorTarget, 0, onCaptureReadback, NULL)){
+        // Every staging buffer is in flight, the GPU is the bottleneck
+        FlushReadbacks();
+        RequestTextureReadback(colorTarget, 0, onCaptureReadback, NULL);
+    }
+}
+
+// end file src/capture.c
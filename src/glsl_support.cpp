@@ -188,7 +188,7 @@ const TBuiltInResource DefaultTBuiltInResource_RG = {
 
 extern std::unordered_map<uint32_t, std::string> uniformTypeNames;
 bool glslang_initialized = false;
-std::vector<uint32_t> glsl_to_spirv_single(const char* cs, EShLanguage stage){
+std::vector<uint32_t> glsl_to_spirv_single(const char* cs, EShLanguage stage, std::string* log = nullptr){
     glslang::TShader shader(stage);
     shader.setEnvInput (glslang::EShSourceGlsl, stage, glslang::EShClientVulkan, glslang::EShTargetVulkan_1_4);
     shader.setEnvClient(glslang::EShClientVulkan, glslang::EShTargetVulkan_1_4);
@@ -201,6 +201,7 @@ std::vector<uint32_t> glsl_to_spirv_single(const char* cs, EShLanguage stage){
 
     if(!shader.parse(&Resources, kGLSLVersion, ECoreProfile, false, false, messages)){
         TRACELOG(LOG_ERROR, "GLSL parsing failed: %s", shader.getInfoLog());
+        if(log)*log = shader.getInfoLog();
         return {};
     }
 
@@ -208,12 +209,14 @@ std::vector<uint32_t> glsl_to_spirv_single(const char* cs, EShLanguage stage){
     program.addShader(&shader);
     if(!program.link(messages)){
         TRACELOG(LOG_ERROR, "Program link failed: %s", program.getInfoLog());
+        if(log)*log = program.getInfoLog();
         return {};
     }
 
     glslang::TIntermediate* intermediate = program.getIntermediate(stage);
     if(!intermediate){
         TRACELOG(LOG_ERROR, "Null intermediate");
+        if(log)*log = "Null intermediate";
         return {};
     }
 
@@ -540,6 +543,9 @@ StringToUniformMap* getBindingsGLSL(ShaderSources sources){
                     if(insert.type == storage_texture2d){
                         SpvReflectDescriptorBinding* bindingi = set->bindings[i];
                         insert.fstype = spirvToFormatOrSampleType(bindingi->image.image_format);
+                        // writeonly/readonly images carry NonReadable/NonWritable, the layout needs the same access
+                        insert.access = (bindingi->decoration_flags & SPV_REFLECT_DECORATION_NON_READABLE) ? access_type_writeonly :
+                                        (bindingi->decoration_flags & SPV_REFLECT_DECORATION_NON_WRITABLE) ? access_type_readonly : access_type_readwrite;
                     }
                     else{
                         insert.fstype = traverser.sampleTypes[set->bindings[i]->name];
@@ -604,14 +610,59 @@ ShaderSources glsl_to_spirv(ShaderSources sources){
     return ret;
 }
 
+void glsl_initialize_process(){
+    if (!glslang_initialized){
+        glslang::InitializeProcess();
+        glslang_initialized = true;
+    }
+}
+
+uint32_t glsl_compiler_version(){
+    const glslang::Version version = glslang::GetVersion();
+    return ((uint32_t)version.major << 20) | ((uint32_t)version.minor << 10) | (uint32_t)version.patch;
+}
+
+bool glsl_to_spirv_checked(ShaderSources sources, ShaderSources* out, char* diagnostics, size_t diagnosticsSize){
+    rassert(sources.language == sourceTypeGLSL, "Must be GLSL here");
+    *out = ShaderSources{};
+    out->language = sourceTypeSPIRV;
+    for(uint32_t i = 0;i < sources.sourceCount;i++){
+        WGPUShaderStageEnum stage = (WGPUShaderStageEnum)countr_zero_u32((uint32_t)sources.sources[i].stageMask);
+        std::string log;
+        std::vector<uint32_t> stageToSpirv = glsl_to_spirv_single((const char*)sources.sources[i].data, ShaderStageToGlslanguage(stage), &log);
+        if(stageToSpirv.empty()){
+            std::snprintf(diagnostics, diagnosticsSize, "Stage %u: %s", (unsigned)stage, log.c_str());
+            ShaderCacheFreeSources(out);
+            return false;
+        }
+        uint32_t* odata = (uint32_t*)RL_MALLOC(stageToSpirv.size() * sizeof(uint32_t));
+        std::copy(stageToSpirv.begin(), stageToSpirv.end(), odata);
+        out->sources[i].data = odata;
+        out->sources[i].sizeInBytes = stageToSpirv.size() * sizeof(uint32_t);
+        out->sources[i].stageMask = sources.sources[i].stageMask;
+        out->sourceCount = i + 1;
+    }
+    return true;
+}
+
 DescribedShaderModule LoadShaderModuleGLSL(ShaderSources sourcesGLSL){
-    ShaderSources spirv = glsl_to_spirv(sourcesGLSL);
+    ShaderSources spirv{};
+    ShaderReflectionInfo cached{};
+    if(ShaderCacheLoad(sourcesGLSL, &spirv, &cached)){
+        DescribedShaderModule ret = LoadShaderModuleSPIRVReflected(spirv, &cached);
+        ShaderCacheFreeSources(&spirv);
+        ret.sourceHash = ShaderSourcesHash(sourcesGLSL);
+        return ret;
+    }
+    spirv = glsl_to_spirv(sourcesGLSL);
     DescribedShaderModule ret = LoadShaderModuleSPIRV(spirv);
-    ret.reflectionInfo.uniforms = callocnewpp(StringToUniformMap);
     ret.reflectionInfo.uniforms = getBindingsGLSL(sourcesGLSL);
-    
-    InOutAttributeInfo attribs = getAttributesGLSL(sourcesGLSL);
-    ret.reflectionInfo.attributes = attribs;
+    ret.reflectionInfo.attributes = getAttributesGLSL(sourcesGLSL);
+    ShaderCacheStore(sourcesGLSL, spirv, &ret.reflectionInfo);
+    for(uint32_t i = 0;i < spirv.sourceCount;i++){
+        std::free((void*)spirv.sources[i].data);
+    }
+    ret.sourceHash = ShaderSourcesHash(sourcesGLSL);
     return ret;
 }
 Shader LoadShaderGLSL(const char* vs, const char* fs){
@@ -0,0 +1,411 @@
+// begin file src/indirect_scene.c
+// GPU driven drawing of many arena meshes. Every draw is a record with its transform, world space bounding
+// sphere and batch, a batch being one mesh and texture pair. A compute pass tests the spheres against the
+// frustum, appends the transforms of visible draws to their batch's range of the instance transform buffer and
+// counts them in the batch's indirect arguments. Drawing then binds that buffer where the default shader reads
+// its model matrices and issues one indirect draw per batch, with firstInstance selecting the range.
+
+#include <raygpu.h>
+#include <stdlib.h>
+#include <math.h>
+#include "internal_include/internals.h"
+
+const char indirectCullComputeSource[] =
+"struct DrawRecord {\n"
+"    transform: mat4x4f,\n"
+"    sphere: vec4f,\n"
+"    batch: u32,\n"
+"    firstInstance: u32,\n"
+"    padding0: u32,\n"
+"    padding1: u32,\n"
+"};\n"
+"struct DrawArgs {\n"
+"    count: u32,\n"
+"    instanceCount: atomic<u32>,\n"
+"    first: u32,\n"
+"    base: u32,\n"
+"    extra: u32,\n"
+"};\n"
+"struct CullParams {\n"
+"    left: vec4f,\n"
+"    right: vec4f,\n"
+"    bottom: vec4f,\n"
+"    top: vec4f,\n"
+"    near: vec4f,\n"
+"    far: vec4f,\n"
+"    drawCount: u32,\n"
+"};\n"
+"@group(0) @binding(0) var<uniform> params: CullParams;\n"
+"@group(0) @binding(1) var<storage, read> records: array<DrawRecord>;\n"
+"@group(0) @binding(2) var<storage, read_write> drawArgs: array<DrawArgs>;\n"
+"@group(0) @binding(3) var<storage, read_write> visibleTransforms: array<mat4x4f>;\n"
+"fn outside(plane: vec4f, sphere: vec4f) -> bool {\n"
+"    return dot(plane.xyz, sphere.xyz) + plane.w + sphere.w < 0.0;\n"
+"}\n"
+"@compute @workgroup_size(64)\n"
+"fn compute_main(@builtin(global_invocation_id) id: vec3<u32>) {\n"
+"    if (id.x >= params.drawCount) {\n"
+"        return;\n"
+"    }\n"
+"    let sphere = records[id.x].sphere;\n"
+"    if (outside(params.left, sphere) || outside(params.right, sphere) || outside(params.bottom, sphere) ||\n"
+"        outside(params.top, sphere) || outside(params.near, sphere) || outside(params.far, sphere)) {\n"
+"        return;\n"
+"    }\n"
+"    let batch = records[id.x].batch;\n"
+"    let slot = atomicAdd(&drawArgs[batch].instanceCount, 1u);\n"
+"    visibleTransforms[records[id.x].firstInstance + slot] = records[id.x].transform;\n"
+"}\n";
+
+// DrawRecord in the cull shader
+typedef struct IndirectDrawRecord{
+    Matrix transform;
+    Vector4 sphere;
+    uint32_t batch;
+    uint32_t firstInstance;
+    uint32_t padding[2];
+}IndirectDrawRecord;
+
+// Indexed: indexCount, instanceCount, firstIndex, baseVertex, firstInstance
+// Not indexed: vertexCount, instanceCount, firstVertex, firstInstance and one unused word
+typedef struct IndirectDrawArgs{
+    uint32_t words[5];
+}IndirectDrawArgs;
+
+// CullParams in the cull shader, planes in the order left, right, bottom, top, near, far
+typedef struct IndirectCullParams{
+    Vector4 planes[6];
+    uint32_t drawCount;
+    uint32_t padding[3];
+}IndirectCullParams;
+
+typedef struct IndirectBatch{
+    Mesh mesh;
+    Texture texture;
+    Vector4 localSphere;
+    uint32_t drawCount;
+    uint32_t firstInstance;
+    uint32_t visibleCount;  // Only maintained when culling on the CPU
+}IndirectBatch;
+
+struct IndirectScene{
+    IndirectDrawRecord* records;
+    uint32_t drawCount;
+    uint32_t maxDraws;
+    IndirectBatch* batches;
+    uint32_t batchCount;
+    uint32_t batchCapacity;
+    IndirectDrawArgs* args;
+    Matrix* visibleTransforms; // CPU culling only
+
+    DescribedBuffer* recordBuffer;
+    DescribedBuffer* argsBuffer;
+    DescribedBuffer* transformBuffer;
+    bool layoutDirty;          // Batch ranges moved, every record needs its firstInstance again
+    uint32_t dirtyBegin;
+    uint32_t dirtyEnd;
+    bool gpuCulling;
+    uint32_t drawCalls;
+};
+
+static DescribedComputePipeline* g_indirectCullPipeline = NULL;
+
+static DescribedComputePipeline* getCullPipeline(cwoid){
+    if(g_indirectCullPipeline == NULL){
+        ShaderBatchResult loaded;
+        if(!LoadBuiltinShader(BuiltinShader_IndirectCull, &loaded)){
+            TRACELOG(LOG_WARNING, "Indirect cull shader failed to load, culling on the CPU: %s", loaded.diagnostics);
+            return NULL;
+        }
+        g_indirectCullPipeline = loaded.computePipeline;
+    }
+    return g_indirectCullPipeline;
+}
+
+IndirectScene* LoadIndirectScene(uint32_t maxDraws){
+    IndirectScene* scene = callocnew(IndirectScene);
+    scene->maxDraws = maxDraws;
+    scene->records = (IndirectDrawRecord*)RL_CALLOC(maxDraws, sizeof(IndirectDrawRecord));
+    scene->args = (IndirectDrawArgs*)RL_CALLOC(maxDraws, sizeof(IndirectDrawArgs));
+    scene->gpuCulling = SupportsIndirectFirstInstance() && getCullPipeline() != NULL;
+    if(scene->gpuCulling){
+        scene->recordBuffer = GenBufferEx(NULL, (size_t)maxDraws * sizeof(IndirectDrawRecord), RGBufferUsage_Storage | RGBufferUsage_CopyDst);
+        scene->argsBuffer = GenBufferEx(NULL, (size_t)maxDraws * sizeof(IndirectDrawArgs), RGBufferUsage_Storage | RGBufferUsage_Indirect | RGBufferUsage_CopyDst);
+    }else{
+        scene->visibleTransforms = (Matrix*)RL_CALLOC(maxDraws, sizeof(Matrix));
+    }
+    scene->transformBuffer = GenBufferEx(NULL, (size_t)maxDraws * sizeof(Matrix), RGBufferUsage_Storage | RGBufferUsage_CopyDst);
+    return scene;
+}
+
+void UnloadIndirectScene(IndirectScene* scene){
+    if(scene == NULL){
+        return;
+    }
+    if(scene->recordBuffer){
+        UnloadBuffer(scene->recordBuffer);
+        UnloadBuffer(scene->argsBuffer);
+    }
+    UnloadBuffer(scene->transformBuffer);
+    RL_FREE(scene->records);
+    RL_FREE(scene->args);
+    RL_FREE(scene->batches);
+    RL_FREE(scene->visibleTransforms);
+    RL_FREE(scene);
+}
+
+void ClearIndirectScene(IndirectScene* scene){
+    scene->drawCount = 0;
+    scene->batchCount = 0;
+    scene->layoutDirty = true;
+}
+
+static uint32_t findOrAddBatch(IndirectScene* scene, Mesh mesh, Texture texture){
+    for(uint32_t i = scene->batchCount;i > 0;i--){
+        const IndirectBatch* batch = scene->batches + i - 1;
+        if(batch->mesh.arena == mesh.arena && batch->mesh.arenaAllocation == mesh.arenaAllocation && batch->texture.id == texture.id){
+            return i - 1;
+        }
+    }
+    if(scene->batchCount == scene->batchCapacity){
+        scene->batchCapacity = scene->batchCapacity ? scene->batchCapacity * 2 : 16;
+        scene->batches = (IndirectBatch*)RL_REALLOC(scene->batches, scene->batchCapacity * sizeof(IndirectBatch));
+    }
+    IndirectBatch* batch = scene->batches + scene->batchCount;
+    *batch = CLITERAL(IndirectBatch){0};
+    batch->mesh = mesh;
+    batch->texture = texture;
+    if(mesh.vertices != NULL){
+        const BoundingBox box = GetMeshBoundingBox(mesh);
+        const Vector3 extent = Vector3Subtract(box.max, box.min);
+        batch->localSphere = CLITERAL(Vector4){(box.min.x + box.max.x) * 0.5f, (box.min.y + box.max.y) * 0.5f, (box.min.z + box.max.z) * 0.5f,
+                                               0.5f * sqrtf(extent.x * extent.x + extent.y * extent.y + extent.z * extent.z)};
+    }else{
+        // Vertices not kept on the CPU, never culled
+        batch->localSphere = CLITERAL(Vector4){0, 0, 0, 1e30f};
+    }
+    return scene->batchCount++;
+}
+
+static Vector4 worldSphere(Vector4 local, Matrix transform){
+    const Vector3 center = Vector3Transform(CLITERAL(Vector3){local.x, local.y, local.z}, transform);
+    float maxScale = 0.0f;
+    for(int column = 0;column < 3;column++){
+        const float* c = transform.data + 4 * column;
+        maxScale = fmaxf(maxScale, c[0] * c[0] + c[1] * c[1] + c[2] * c[2]);
+    }
+    return CLITERAL(Vector4){center.x, center.y, center.z, local.w * sqrtf(maxScale)};
+}
+
+static void markDirty(IndirectScene* scene, uint32_t draw){
+    if(scene->dirtyBegin >= scene->dirtyEnd){
+        scene->dirtyBegin = draw;
+        scene->dirtyEnd = draw + 1;
+    }else{
+        scene->dirtyBegin = draw < scene->dirtyBegin ? draw : scene->dirtyBegin;
+        scene->dirtyEnd = draw + 1 > scene->dirtyEnd ? draw + 1 : scene->dirtyEnd;
+    }
+}
+
+uint32_t AddIndirectSceneMesh(IndirectScene* scene, Mesh mesh, Material material, Matrix transform){
+    if(mesh.arena == NULL){
+        TRACELOG(LOG_WARNING, "Indirect scenes only draw meshes uploaded to a mesh arena");
+        return UINT32_MAX;
+    }
+    if(scene->drawCount == scene->maxDraws){
+        TRACELOG(LOG_WARNING, "Indirect scene is full (%u draws)", scene->maxDraws);
+        return UINT32_MAX;
+    }
+    const uint32_t batch = findOrAddBatch(scene, mesh, material.maps[MATERIAL_MAP_DIFFUSE].texture);
+    ++scene->batches[batch].drawCount;
+    IndirectDrawRecord* record = scene->records + scene->drawCount;
+    record->transform = transform;
+    record->sphere = worldSphere(scene->batches[batch].localSphere, transform);
+    record->batch = batch;
+    scene->layoutDirty = true;
+    return scene->drawCount++;
+}
+
+uint32_t AddIndirectSceneModel(IndirectScene* scene, Model model, Matrix transform){
+    if(scene->drawCount + (uint32_t)model.meshCount > scene->maxDraws){
+        TRACELOG(LOG_WARNING, "Indirect scene is full (%u draws)", scene->maxDraws);
+        return UINT32_MAX;
+    }
+    for(int i = 0;i < model.meshCount;i++){
+        if(model.meshes[i].arena == NULL){
+            TRACELOG(LOG_WARNING, "Indirect scenes only draw meshes uploaded to a mesh arena");
+            return UINT32_MAX;
+        }
+    }
+    const uint32_t first = scene->drawCount;
+    for(int i = 0;i < model.meshCount;i++){
+        AddIndirectSceneMesh(scene, model.meshes[i], model.materials[model.meshMaterial[i]], transform);
+    }
+    return first;
+}
+
+void SetIndirectSceneTransform(IndirectScene* scene, uint32_t draw, Matrix transform){
+    if(draw >= scene->drawCount){
+        return;
+    }
+    IndirectDrawRecord* record = scene->records + draw;
+    record->transform = transform;
+    record->sphere = worldSphere(scene->batches[record->batch].localSphere, transform);
+    markDirty(scene, draw);
+}
+
+// Every batch gets a range of the transform buffer as large as its draw count
+static void layoutBatches(IndirectScene* scene){
+    uint32_t firstInstance = 0;
+    for(uint32_t i = 0;i < scene->batchCount;i++){
+        scene->batches[i].firstInstance = firstInstance;
+        firstInstance += scene->batches[i].drawCount;
+    }
+    for(uint32_t i = 0;i < scene->drawCount;i++){
+        scene->records[i].firstInstance = scene->batches[scene->records[i].batch].firstInstance;
+    }
+    scene->layoutDirty = false;
+    scene->dirtyBegin = 0;
+    scene->dirtyEnd = scene->drawCount;
+}
+
+// Gribb and Hartmann, rows of the view projection matrix, normalized so distances come out in world units
+static void extractFrustumPlanes(Matrix viewProjection, Vector4* planes){
+    const float* m = viewProjection.data;
+    for(int i = 0;i < 6;i++){
+        const int row = i / 2;
+        const float sign = (i % 2) ? -1.0f : 1.0f;
+        Vector4 plane = {
+            m[3] + sign * m[row],
+            m[7] + sign * m[row + 4],
+            m[11] + sign * m[row + 8],
+            m[15] + sign * m[row + 12],
+        };
+        const float length = sqrtf(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+        if(length > 0.0f){
+            plane.x /= length;
+            plane.y /= length;
+            plane.z /= length;
+            plane.w /= length;
+        }
+        planes[i] = plane;
+    }
+}
+
+static bool sphereVisible(const Vector4* planes, Vector4 sphere){
+    for(int i = 0;i < 6;i++){
+        if(planes[i].x * sphere.x + planes[i].y * sphere.y + planes[i].z * sphere.z + planes[i].w < -sphere.w){
+            return false;
+        }
+    }
+    return true;
+}
+
+static void cullOnCPU(IndirectScene* scene, const Vector4* planes){
+    for(uint32_t i = 0;i < scene->batchCount;i++){
+        scene->batches[i].visibleCount = 0;
+    }
+    uint32_t end = 0;
+    for(uint32_t i = 0;i < scene->drawCount;i++){
+        const IndirectDrawRecord* record = scene->records + i;
+        if(sphereVisible(planes, record->sphere)){
+            const uint32_t instance = record->firstInstance + scene->batches[record->batch].visibleCount++;
+            scene->visibleTransforms[instance] = record->transform;
+            end = instance + 1 > end ? instance + 1 : end;
+        }
+    }
+    if(end > 0){
+        BufferSubData(scene->transformBuffer, 0, scene->visibleTransforms, (size_t)end * sizeof(Matrix));
+    }
+}
+
+void CullIndirectScene(IndirectScene* scene, Matrix viewProjection){
+    if(scene->layoutDirty){
+        layoutBatches(scene);
+    }
+    IndirectCullParams params = {0};
+    extractFrustumPlanes(viewProjection, params.planes);
+    params.drawCount = scene->drawCount;
+    if(!scene->gpuCulling){
+        scene->dirtyBegin = scene->dirtyEnd = 0;
+        cullOnCPU(scene, params.planes);
+        return;
+    }
+    if(scene->drawCount == 0){
+        return;
+    }
+    if(scene->dirtyBegin < scene->dirtyEnd){
+        BufferSubData(scene->recordBuffer, (uint64_t)scene->dirtyBegin * sizeof(IndirectDrawRecord), scene->records + scene->dirtyBegin,
+                      (size_t)(scene->dirtyEnd - scene->dirtyBegin) * sizeof(IndirectDrawRecord));
+        scene->dirtyBegin = scene->dirtyEnd = 0;
+    }
+    // Rebuilt every frame: resets the instance counts and follows arena compactions
+    for(uint32_t i = 0;i < scene->batchCount;i++){
+        const IndirectBatch* batch = scene->batches + i;
+        const MeshArenaAllocation* allocation = batch->mesh.arena->allocations + batch->mesh.arenaAllocation;
+        const uint32_t baseVertex = (uint32_t)(allocation->vertexOffset / allocation->stride);
+        if(allocation->indexCount > 0){
+            scene->args[i] = CLITERAL(IndirectDrawArgs){{allocation->indexCount, 0, allocation->firstIndex, baseVertex, batch->firstInstance}};
+        }else{
+            scene->args[i] = CLITERAL(IndirectDrawArgs){{(uint32_t)batch->mesh.vertexCount, 0, baseVertex, batch->firstInstance, 0}};
+        }
+    }
+    BufferSubData(scene->argsBuffer, 0, scene->args, (size_t)scene->batchCount * sizeof(IndirectDrawArgs));
+
+    DescribedComputePipeline* pipeline = g_indirectCullPipeline;
+    SetBindgroupUniformBufferData(&pipeline->bindGroup, 0, &params, sizeof(params));
+    SetBindgroupStorageBuffer(&pipeline->bindGroup, 1, scene->recordBuffer);
+    SetBindgroupStorageBuffer(&pipeline->bindGroup, 2, scene->argsBuffer);
+    SetBindgroupStorageBuffer(&pipeline->bindGroup, 3, scene->transformBuffer);
+    BeginComputepass();
+    BindComputePipeline(pipeline);
+    DispatchCompute((scene->drawCount + 63) / 64, 1, 1);
+    EndComputepass();
+}
+
+void DrawIndirectScene(IndirectScene* scene){
+    scene->drawCalls = 0;
+    if(scene->drawCount == 0){
+        return;
+    }
+    Shader shader = GetActiveShader();
+    SetShaderStorageBuffer(shader, GetUniformLocationByHandle(shader, RGDefaultUniform_InstanceTransform), scene->transformBuffer);
+    const uint32_t textureLocation = GetUniformLocationByHandle(shader, RGDefaultUniform_Texture0);
+    for(uint32_t i = 0;i < scene->batchCount;i++){
+        const IndirectBatch* batch = scene->batches + i;
+        if(batch->drawCount == 0 || (!scene->gpuCulling && batch->visibleCount == 0)){
+            continue;
+        }
+        SetTexture(textureLocation, batch->texture);
+        BindShaderVertexArray(shader, batch->mesh.vao);
+        MeshArena* arena = batch->mesh.arena;
+        const MeshArenaAllocation* allocation = arena->allocations + batch->mesh.arenaAllocation;
+        if(scene->gpuCulling){
+            const uint64_t offset = (uint64_t)i * sizeof(IndirectDrawArgs);
+            if(allocation->indexCount > 0){
+                DrawArraysIndexedIndirect(RL_TRIANGLES, arena->indexBuffer, scene->argsBuffer, offset);
+            }else{
+                DrawArraysIndirect(RL_TRIANGLES, scene->argsBuffer, offset);
+            }
+        }else{
+            const uint32_t baseVertex = (uint32_t)(allocation->vertexOffset / allocation->stride);
+            if(allocation->indexCount > 0){
+                DrawArraysIndexedRange(RL_TRIANGLES, arena->indexBuffer, allocation->firstIndex, allocation->indexCount, (int32_t)baseVertex, batch->visibleCount, batch->firstInstance);
+            }else{
+                DrawArraysRange(RL_TRIANGLES, baseVertex, (uint32_t)batch->mesh.vertexCount, batch->visibleCount, batch->firstInstance);
+            }
+        }
+        ++scene->drawCalls;
+    }
+}
+
+IndirectSceneStats GetIndirectSceneStats(const IndirectScene* scene){
+    IndirectSceneStats stats = {0};
+    stats.drawCount = scene->drawCount;
+    stats.batchCount = scene->batchCount;
+    stats.drawCalls = scene->drawCalls;
+    stats.gpuCulling = scene->gpuCulling;
+    return stats;
+}
+
+// end file src/indirect_scene.c
@@ -16,7 +16,9 @@
     #define DrawTextEx w__DrawTextEx
     #define ShowCursor w__ShowCursor
     #define AdapterType w__AdapterType
+    #define CloseWindow w__CloseWindow
     #include <windows.h>
+    #undef CloseWindow
     #undef AdapterType
     #undef ShowCursor
     #undef LoadImage
@@ -317,8 +317,116 @@ RGAPI StringToUniformMap* getBindings    (ShaderSources source);
 RGAPI InOutAttributeInfo getAttributesWGSL(ShaderSources sources);
 RGAPI InOutAttributeInfo getAttributesGLSL(ShaderSources sources);
 RGAPI InOutAttributeInfo getAttributes    (ShaderSources sources);
+RGAPI ShaderReflectionInfo getReflectionInfoWGSL(ShaderSources sources); // Entry points, attributes and bindings from one parse
 
 RGAPI DescribedBuffer* UpdateVulkanRenderbatch();
+void BindGroupCacheEndFrame(cwoid);
+void BindGroupCachePurge(const void* const* resources, uint32_t count); // Drops cached bind groups that use any of the resources
+void StreamingRingsEndFrame(cwoid);
+void RefreshDynamicUploads(DescribedBindGroup* bg);
+DescribedBuffer* VertexStreamPush(const void* data, size_t size, uint64_t* offset);
+
+typedef struct BufferCopyRange{
+    uint64_t srcOffset;
+    uint64_t dstOffset;
+    uint64_t size;
+}BufferCopyRange;
+void CopyBufferRanges(DescribedBuffer* source, DescribedBuffer* dest, const BufferCopyRange* ranges, uint32_t rangeCount); // Submitted immediately
+
+typedef struct MeshArenaAllocation{
+    uint64_t vertexOffset; // Bytes, a multiple of stride so baseVertex = vertexOffset / stride
+    uint64_t vertexBytes;
+    uint32_t stride;
+    uint32_t firstIndex;
+    uint32_t indexCount;
+    bool live;
+}MeshArenaAllocation;
+
+struct MeshArena{
+    DescribedBuffer* vertexBuffer;
+    DescribedBuffer* indexBuffer;
+    uint64_t vertexHead;
+    uint32_t indexHead;
+    MeshArenaAllocation* allocations; // Indexed by Mesh::arenaAllocation, slots of unloaded meshes are reused
+    uint32_t allocationCount;
+    uint32_t allocationCapacity;
+    uint64_t wastedVertexBytes;
+    uint32_t wastedIndices;
+    uint32_t compactions;
+};
+
+uint32_t MeshArenaAllocate(MeshArena* arena, uint32_t vertexCount, uint32_t stride, uint32_t indexCount); // UINT32_MAX on failure
+void MeshArenaFree(MeshArena* arena, uint32_t allocation);
+bool SupportsIndirectFirstInstance(cwoid); // Whether indirect draws can use firstInstance, the device feature is optional
+bool CanSkinMeshOnGPU(const Mesh* mesh);
+void UpdateSkinnedMeshBones(Mesh* mesh, const Matrix* boneMatrices, const Matrix* normalMatrices); // Registers the mesh on first use
+void UnloadSkinnedMesh(Mesh* mesh);
+void FlushMeshSkinning(cwoid); // Skins every mesh updated since the last flush in one dispatch
+// Bone id of the i-th influence, boneIds holds 8 or 16 bit ids depending on boneIDFormat
+static inline uint32_t MeshBoneId(const Mesh* mesh, size_t i){
+    if(mesh->boneIDFormat == RGVertexFormat_Uint16x4){
+        return ((const uint16_t*)mesh->boneIds)[i];
+    }
+    return mesh->boneIds[i];
+}
+void CaptureFrame(Texture colorTarget, PixelFormat format); // format overrides colorTarget.format, e.g. the surface format
+GIFRecordState* LoadGIFRecordState(cwoid);
+RGAPI bool ShaderCacheLoad(ShaderSources sources, ShaderSources* spirvOut, ShaderReflectionInfo* reflectionOut);
+RGAPI void ShaderCacheStore(ShaderSources sources, ShaderSources spirv, const ShaderReflectionInfo* reflection);
+RGAPI void ShaderCacheFreeSources(ShaderSources* spirv);
+RGAPI uint64_t ShaderSourcesHash(ShaderSources sources);
+RGAPI bool ShaderCacheEnabled(cwoid);
+RGAPI void ResetStartupPhases(cwoid);
+RGAPI void BeginStartupPhase(const char* name); // name must outlive the profile, usually a literal
+RGAPI void EndStartupPhase(cwoid);
+RGAPI void FinishStartupProfile(cwoid);
+RGAPI void glsl_initialize_process(cwoid); // glslang must be initialized before compiling on multiple threads
+RGAPI bool glsl_to_spirv_checked(ShaderSources sources, ShaderSources* out, char* diagnostics, size_t diagnosticsSize); // Frees with ShaderCacheFreeSources
+RGAPI uint32_t glsl_compiler_version(cwoid); // glslang major << 20 | minor << 10 | patch, part of the shader cache key
+RGAPI DescribedShaderModule LoadShaderModulePrepared(ShaderSources sources, ShaderSources spirv, ShaderReflectionInfo reflection);
+RGAPI DescribedShaderModule LoadShaderModuleSPIRVReflected(ShaderSources spirv, const ShaderReflectionInfo* reflection); // Skips SPIRV-Reflect when reflection names every entry point
+RGAPI bool PrepareShaderSources(ShaderSources* sourcesInOut, const ShaderReflectionInfo* knownReflection, ShaderSources* spirv, ShaderReflectionInfo* reflection, ShaderBatchResult* result);
+RGAPI bool CreateShaderFromPrepared(ShaderSources sources, ShaderSources spirv, ShaderReflectionInfo reflection, ShaderBatchResult* result);
+
+// Shaders the library uses itself, precompiled into src/builtin_shaders_embedded.c
+typedef enum BuiltinShaderID{
+    BuiltinShader_Default,
+    BuiltinShader_TextureArray,
+    BuiltinShader_Mipmap,
+    BuiltinShader_IndirectCull,
+    BuiltinShader_MeshSkinning,
+    BuiltinShader_EnumCount
+}BuiltinShaderID;
+
+typedef struct BuiltinShaderUniform{
+    const char* name;
+    ResourceTypeDescriptor desc;
+}BuiltinShaderUniform;
+
+typedef struct BuiltinShaderData{
+    const char* name;
+    uint64_t sourceHash;            // BuiltinShaderSourceHash of the sources it was generated from, 0 if nothing is embedded
+    uint32_t spirvCount;            // 0 if the source is consumed natively and only the reflection is embedded
+    ShaderStageSource spirv[RGShaderStageEnum_EnumCount];
+    ShaderEntryPoint ep[RGShaderStageEnum_EnumCount];
+    InOutAttributeInfo attributes;
+    uint32_t uniformCount;
+    const BuiltinShaderUniform* uniforms;
+}BuiltinShaderData;
+
+extern const BuiltinShaderData g_builtinShaderData[BuiltinShader_EnumCount];
+extern const BuiltinShaderData g_builtinShaderWGSLData[BuiltinShader_EnumCount]; // Reflection only, for backends that consume WGSL natively
+RGAPI ShaderSources GetBuiltinShaderSources(BuiltinShaderID id);
+RGAPI ShaderSources GetBuiltinShaderWGSLSources(BuiltinShaderID id);
+RGAPI uint64_t BuiltinShaderSourceHash(ShaderSources sources);
+RGAPI bool LoadBuiltinShader(BuiltinShaderID id, ShaderBatchResult* result);
+RGAPI WGPURenderPipeline GetOrCreateRenderPipeline(uint32_t shaderID);
+void PollPipelineCreation(cwoid);
+#if RENDERBATCH_TEXTURE_ARRAY == 1
+extern const char textureArrayShaderSource[];
+extern const char textureArrayVertexSourceGLSL[];
+extern const char textureArrayFragmentSourceGLSL[];
+#endif
 void PushUsedBuffer(void* nativeBuffer);
 
 typedef struct VertexBufferLayout{
@@ -899,18 +1007,29 @@ static WGPURenderPipeline PipelineHashMap_getOrCreate(PipelineHashMap* cacheMap,
         return toEmplace;
     }
 }
+typedef struct ShaderPermutationTable ShaderPermutationTable;
 typedef struct ShaderImpl{
     PipelineHashMap pipelineCache;
     DescribedShaderModule shaderModule;
     ModifiablePipelineState state;
+    AttributeAndResidence* ownedVertexAttributes;          // LoadPipelineFromModule's copy of its attributes, freed once a vertex array replaces it
     DescribedBindGroup bindGroup;
     DescribedPipelineLayout layout;
     DescribedBindGroupLayout bglayout;
+    uint32_t defaultLocations[RGDefaultUniform_EnumCount]; // Indexed by RGDefaultUniform, resolved at creation
+    uint32_t* namedLocations;                              // Indexed by handle - RGDefaultUniform_EnumCount, resolved on first use
+    uint32_t namedLocationCount;
+    ShaderPermutationTable* permutations;                  // Shared by all variants of LoadShaderPermutations, NULL otherwise
+    ShaderPermutationKey permutationKey;
 }ShaderImpl;
 externcvar ShaderImpl* allocatedShaderIDs_shc;
 RGAPI uint32_t getNextShaderID_shc();
 RGAPI ShaderImpl* GetShaderImpl(Shader shader);
 RGAPI ShaderImpl* GetShaderImplByID(uint32_t id);
+void ResolveDefaultUniformLocations(ShaderImpl* impl);
+// Permutation expansion and interface analysis on their own, used by src/test/shader_permutation_test.c
+RGAPI char* ExpandShaderPermutationSource(const char* const* featureNames, uint32_t featureCount, const char* source, ShaderPermutationKey key, char* diag, size_t diagSize);
+RGAPI ShaderPermutationKey AnalyzeShaderPermutationInterface(const char* const* featureNames, uint32_t featureCount, const char* source);
 typedef struct DescribedPipeline{
     WGPURenderPipeline activePipeline;
     
@@ -1109,6 +1228,7 @@ static inline VertexBufferLayoutSet getBufferLayoutRepresentation(const Attribut
 typedef struct BufferEntry{
     DescribedBuffer* buffer;
     RGVertexStepMode stepMode;
+    uint64_t offset; //Byte offset the buffer is bound at, used for streamed vertex data
 } BufferEntry;
 
 typedef struct VertexArray{
@@ -1201,6 +1321,7 @@ static void VertexArray_add(VertexArray* vao, DescribedBuffer* buffer, uint32_t
                 if (!is_slot_used_by_others) {
                     vao->buffers[it->bufferSlot].buffer = buffer;
                     vao->buffers[it->bufferSlot].stepMode = stepmode;
+                    vao->buffers[it->bufferSlot].offset = 0;
                 } else {
                     // Add new buffer
                     it->bufferSlot = vao->buffers_count;
@@ -1211,6 +1332,7 @@ static void VertexArray_add(VertexArray* vao, DescribedBuffer* buffer, uint32_t
                     }
                     vao->buffers[vao->buffers_count].buffer = buffer;
                     vao->buffers[vao->buffers_count].stepMode = stepmode;
+                    vao->buffers[vao->buffers_count].offset = 0;
                     vao->buffers_count++;
                 }
             }
@@ -1253,6 +1375,7 @@ static void VertexArray_add(VertexArray* vao, DescribedBuffer* buffer, uint32_t
             }
             vao->buffers[vao->buffers_count].buffer = buffer;
             vao->buffers[vao->buffers_count].stepMode = stepmode;
+            vao->buffers[vao->buffers_count].offset = 0;
             vao->buffers_count++;
         }
 
@@ -1547,6 +1670,20 @@ RG_DEFINE_GENERIC_HASH_MAP(
     deleteResourceType
 )
 
+// Reflected uniforms as an array sorted by binding location, the caller frees it
+static inline ResourceTypeDescriptor* flattenUniformMap(const StringToUniformMap* map, uint32_t* count){
+    ResourceTypeDescriptor* flat = (ResourceTypeDescriptor*)RL_CALLOC(map->current_size ? map->current_size : 1, sizeof(ResourceTypeDescriptor));
+    uint32_t insertIndex = 0;
+    for(uint32_t i = 0;i < map->current_capacity;i++){
+        if(map->table[i].key.length != 0){
+            flat[insertIndex++] = map->table[i].value;
+        }
+    }
+    quickSort_ResourceTypeDescriptor(flat, flat + insertIndex);
+    *count = insertIndex;
+    return flat;
+}
+
 
 static inline size_t hashVertexArray(const VertexArray va){
     size_t hashValue = 0;
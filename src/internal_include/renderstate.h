@@ -334,6 +334,36 @@ DEFINE_ARRAY_STACK(RenderTexture, static inline, 8);
 DEFINE_PTR_HASH_MAP_R(static inline, CreatedWindowMap, RGWindowImpl)
 DEFINE_VECTOR_IW(static inline, DescribedBuffer*, DescribedBufferVector)
 
+typedef struct Deferred2DCommand{
+    int layer;
+    Shader shader;
+    PrimitiveType mode;
+    WGPUTextureView texture;
+    uint32_t textureOrder; // First use of the texture within the layer, assigned before sorting
+    uint32_t sequence;     // Submission order, keeps the sort stable
+    uint32_t firstVertex;
+    uint32_t vertexCount;
+}Deferred2DCommand;
+
+typedef struct Deferred2DTextureSlot{
+    uint32_t layerRun; // Layer run that assigned the ordinal, stale entries are reassigned
+    uint32_t order;
+}Deferred2DTextureSlot;
+
+DEFINE_VECTOR_IW(static inline, Deferred2DCommand, Deferred2DCommandVector)
+DEFINE_VECTOR_IW(static inline, vertex, VertexVector)
+DEFINE_PTR_HASH_MAP_R(static inline, Deferred2DTextureOrderMap, Deferred2DTextureSlot)
+
+typedef struct Deferred2DState{
+    bool active;
+    int layer;
+    Deferred2DCommandVector commands;
+    VertexVector vertices;
+    Deferred2DTextureOrderMap textureOrder;
+    uint32_t layerRuns;
+    Deferred2DStats lastStats;
+}Deferred2DState;
+
 
 typedef struct renderstate {
     WGPUPresentMode unthrottled_PresentMode;
@@ -357,9 +387,6 @@ typedef struct renderstate {
     uint32_t renderExtentX;
     uint32_t renderExtentY;
 
-    DescribedBufferVector smallBufferPool;
-    DescribedBufferVector smallBufferRecyclingBin;
-
     DescribedBuffer *identityMatrix;
     DescribedSampler defaultSampler;
 
@@ -386,6 +413,15 @@ typedef struct renderstate {
 
     GIFRecordState *grst;
 
+    Deferred2DState deferred2D;
+
+    Shader textureArrayShader; // Loaded on the first BeginTextureArrayMode
+    bool textureArrayShaderLoaded;
+    Texture2DArray whitePixelArray; // whitePixel as a one layer array, bound for lines in texture array mode
+    bool textureArrayMode;
+    bool textureArraySuspended; // Inside BeginTextureArrayMode, drawing an unaliased texture with the default shader
+    Texture2DArray activeTextureArray;
+
     SubWindow mainWindow;
     CreatedWindowMap createdSubwindows;
     SubWindow activeSubWindow;
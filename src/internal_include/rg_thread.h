@@ -0,0 +1,222 @@
+// begin file src/internal_include/rg_thread.h
+#ifndef RG_THREAD_H
+#define RG_THREAD_H
+
+// Minimal thread, mutex and condition variable wrappers over Win32 and pthreads.
+// RG_HAS_THREADS is 0 on emscripten builds without pthread support, callers fall back to doing the work inline.
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+#if defined(_WIN32) || defined(_WIN64)
+    #define RG_HAS_THREADS 1
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #define Rectangle w__Rectangle
+    #define LoadImage w__LoadImage
+    #define DrawText w__DrawText
+    #define DrawTextEx w__DrawTextEx
+    #define ShowCursor w__ShowCursor
+    #define AdapterType w__AdapterType
+    #define CloseWindow w__CloseWindow
+    #include <windows.h>
+    #undef CloseWindow
+    #undef AdapterType
+    #undef ShowCursor
+    #undef LoadImage
+    #undef DrawTextEx
+    #undef DrawText
+    #undef Rectangle
+    typedef HANDLE rg_thread;
+    typedef SRWLOCK rg_mutex;
+    typedef CONDITION_VARIABLE rg_cond;
+#elif defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+    #define RG_HAS_THREADS 0
+    typedef int rg_thread;
+    typedef int rg_mutex;
+    typedef int rg_cond;
+#else
+    #define RG_HAS_THREADS 1
+    #include <pthread.h>
+    typedef pthread_t rg_thread;
+    typedef pthread_mutex_t rg_mutex;
+    typedef pthread_cond_t rg_cond;
+#endif
+
+typedef void (*rg_thread_func)(void* arg);
+
+#if defined(_WIN32) || defined(_WIN64)
+typedef struct rg_thread_start{ rg_thread_func func; void* arg; }rg_thread_start;
+static DWORD WINAPI rg_thread_trampoline(LPVOID p){
+    rg_thread_start start = *(rg_thread_start*)p;
+    HeapFree(GetProcessHeap(), 0, p);
+    start.func(start.arg);
+    return 0;
+}
+static inline bool rg_thread_create(rg_thread* t, rg_thread_func func, void* arg){
+    rg_thread_start* start = (rg_thread_start*)HeapAlloc(GetProcessHeap(), 0, sizeof(rg_thread_start));
+    if(!start)return false;
+    start->func = func;
+    start->arg = arg;
+    *t = CreateThread(NULL, 0, rg_thread_trampoline, start, 0, NULL);
+    if(*t == NULL){
+        HeapFree(GetProcessHeap(), 0, start);
+        return false;
+    }
+    return true;
+}
+static inline void rg_thread_join(rg_thread t){ WaitForSingleObject(t, INFINITE); CloseHandle(t); }
+static inline void rg_mutex_init(rg_mutex* m){ InitializeSRWLock(m); }
+static inline void rg_mutex_destroy(rg_mutex* m){ (void)m; }
+static inline void rg_mutex_lock(rg_mutex* m){ AcquireSRWLockExclusive(m); }
+static inline void rg_mutex_unlock(rg_mutex* m){ ReleaseSRWLockExclusive(m); }
+static inline void rg_cond_init(rg_cond* c){ InitializeConditionVariable(c); }
+static inline void rg_cond_destroy(rg_cond* c){ (void)c; }
+static inline void rg_cond_wait(rg_cond* c, rg_mutex* m){ SleepConditionVariableSRW(c, m, INFINITE, 0); }
+static inline void rg_cond_signal(rg_cond* c){ WakeConditionVariable(c); }
+static inline void rg_cond_broadcast(rg_cond* c){ WakeAllConditionVariable(c); }
+static inline unsigned rg_hardware_concurrency(void){ SYSTEM_INFO info; GetSystemInfo(&info); return info.dwNumberOfProcessors; }
+#elif RG_HAS_THREADS == 1
+#include <unistd.h>
+typedef struct rg_thread_start{ rg_thread_func func; void* arg; }rg_thread_start;
+static void* rg_thread_trampoline(void* p){
+    rg_thread_start start = *(rg_thread_start*)p;
+    free(p);
+    start.func(start.arg);
+    return NULL;
+}
+static inline bool rg_thread_create(rg_thread* t, rg_thread_func func, void* arg){
+    rg_thread_start* start = (rg_thread_start*)malloc(sizeof(rg_thread_start));
+    if(!start)return false;
+    start->func = func;
+    start->arg = arg;
+    if(pthread_create(t, NULL, rg_thread_trampoline, start) != 0){
+        free(start);
+        return false;
+    }
+    return true;
+}
+static inline void rg_thread_join(rg_thread t){ pthread_join(t, NULL); }
+static inline void rg_mutex_init(rg_mutex* m){ pthread_mutex_init(m, NULL); }
+static inline void rg_mutex_destroy(rg_mutex* m){ pthread_mutex_destroy(m); }
+static inline void rg_mutex_lock(rg_mutex* m){ pthread_mutex_lock(m); }
+static inline void rg_mutex_unlock(rg_mutex* m){ pthread_mutex_unlock(m); }
+static inline void rg_cond_init(rg_cond* c){ pthread_cond_init(c, NULL); }
+static inline void rg_cond_destroy(rg_cond* c){ pthread_cond_destroy(c); }
+static inline void rg_cond_wait(rg_cond* c, rg_mutex* m){ pthread_cond_wait(c, m); }
+static inline void rg_cond_signal(rg_cond* c){ pthread_cond_signal(c); }
+static inline void rg_cond_broadcast(rg_cond* c){ pthread_cond_broadcast(c); }
+static inline unsigned rg_hardware_concurrency(void){ long n = sysconf(_SC_NPROCESSORS_ONLN); return n > 0 ? (unsigned)n : 1u; }
+#else
+static inline bool rg_thread_create(rg_thread* t, rg_thread_func func, void* arg){ (void)t; (void)func; (void)arg; return false; }
+static inline void rg_thread_join(rg_thread t){ (void)t; }
+static inline void rg_mutex_init(rg_mutex* m){ (void)m; }
+static inline void rg_mutex_destroy(rg_mutex* m){ (void)m; }
+static inline void rg_mutex_lock(rg_mutex* m){ (void)m; }
+static inline void rg_mutex_unlock(rg_mutex* m){ (void)m; }
+static inline void rg_cond_init(rg_cond* c){ (void)c; }
+static inline void rg_cond_destroy(rg_cond* c){ (void)c; }
+static inline void rg_cond_wait(rg_cond* c, rg_mutex* m){ (void)c; (void)m; }
+static inline void rg_cond_signal(rg_cond* c){ (void)c; }
+static inline void rg_cond_broadcast(rg_cond* c){ (void)c; }
+static inline unsigned rg_hardware_concurrency(void){ return 1u; }
+#endif
+
+// Bounded blocking FIFO of pointers. Push blocks while full, pop blocks while empty
+// and returns NULL once the queue is closed and drained.
+typedef struct rg_queue{
+    void** items;
+    unsigned capacity;
+    unsigned head;
+    unsigned count;
+    bool closed;
+    rg_mutex mutex;
+    rg_cond notEmpty;
+    rg_cond notFull;
+}rg_queue;
+
+static inline bool rg_queue_init(rg_queue* q, unsigned capacity){
+    q->items = (void**)calloc(capacity, sizeof(void*));
+    q->capacity = capacity;
+    q->head = 0;
+    q->count = 0;
+    q->closed = false;
+    rg_mutex_init(&q->mutex);
+    rg_cond_init(&q->notEmpty);
+    rg_cond_init(&q->notFull);
+    return q->items != NULL;
+}
+static inline void rg_queue_destroy(rg_queue* q){
+    free(q->items);
+    q->items = NULL;
+    rg_mutex_destroy(&q->mutex);
+    rg_cond_destroy(&q->notEmpty);
+    rg_cond_destroy(&q->notFull);
+}
+static inline bool rg_queue_push(rg_queue* q, void* item){
+    rg_mutex_lock(&q->mutex);
+    while(q->count == q->capacity && !q->closed){
+        rg_cond_wait(&q->notFull, &q->mutex);
+    }
+    if(q->closed){
+        rg_mutex_unlock(&q->mutex);
+        return false;
+    }
+    q->items[(q->head + q->count) % q->capacity] = item;
+    ++q->count;
+    rg_cond_signal(&q->notEmpty);
+    rg_mutex_unlock(&q->mutex);
+    return true;
+}
+// Non-blocking variant of rg_queue_push, returns false if the queue is full or closed
+static inline bool rg_queue_try_push(rg_queue* q, void* item){
+    bool pushed = false;
+    rg_mutex_lock(&q->mutex);
+    if(q->count < q->capacity && !q->closed){
+        q->items[(q->head + q->count) % q->capacity] = item;
+        ++q->count;
+        rg_cond_signal(&q->notEmpty);
+        pushed = true;
+    }
+    rg_mutex_unlock(&q->mutex);
+    return pushed;
+}
+// Non-blocking variant of rg_queue_pop, returns NULL if nothing is queued
+static inline void* rg_queue_try_pop(rg_queue* q){
+    void* item = NULL;
+    rg_mutex_lock(&q->mutex);
+    if(q->count > 0){
+        item = q->items[q->head];
+        q->head = (q->head + 1) % q->capacity;
+        --q->count;
+        rg_cond_signal(&q->notFull);
+    }
+    rg_mutex_unlock(&q->mutex);
+    return item;
+}
+static inline void* rg_queue_pop(rg_queue* q){
+    void* item = NULL;
+    rg_mutex_lock(&q->mutex);
+    while(q->count == 0 && !q->closed){
+        rg_cond_wait(&q->notEmpty, &q->mutex);
+    }
+    if(q->count > 0){
+        item = q->items[q->head];
+        q->head = (q->head + 1) % q->capacity;
+        --q->count;
+        rg_cond_signal(&q->notFull);
+    }
+    rg_mutex_unlock(&q->mutex);
+    return item;
+}
+static inline void rg_queue_close(rg_queue* q){
+    rg_mutex_lock(&q->mutex);
+    q->closed = true;
+    rg_cond_broadcast(&q->notEmpty);
+    rg_cond_broadcast(&q->notFull);
+    rg_mutex_unlock(&q->mutex);
+}
+
+#endif // RG_THREAD_H
+// end file src/internal_include/rg_thread.h
@@ -0,0 +1,209 @@
+// begin file src/mesh_arena.c
+// Shared vertex and index buffers for static meshes. Every mesh is one allocation: a vertex range aligned
+// to the mesh's own stride, drawn with baseVertex = offset / stride, and an index range drawn with firstIndex.
+// Consecutive arena draws therefore keep the same buffers bound. Allocation bumps a head pointer, unloading
+// leaves a gap until CompactMeshArena copies the live ranges together into fresh buffers.
+
+#include <raygpu.h>
+#include <stdlib.h>
+#include <string.h>
+#include "internal_include/internals.h"
+
+#define MESH_ARENA_VERTEX_USAGE (RGBufferUsage_CopySrc | RGBufferUsage_CopyDst | RGBufferUsage_Vertex)
+#define MESH_ARENA_INDEX_USAGE  (RGBufferUsage_CopySrc | RGBufferUsage_CopyDst | RGBufferUsage_Index)
+
+static MeshArena* g_defaultMeshArena = NULL;
+
+static uint64_t alignUp(uint64_t x, uint64_t alignment){
+    return (x + alignment - 1) / alignment * alignment;
+}
+
+MeshArena* LoadMeshArena(uint64_t vertexBytes, uint32_t indexCount){
+    MeshArena* arena = callocnew(MeshArena);
+    vertexBytes = alignUp(vertexBytes ? vertexBytes : MESH_ARENA_INITIAL_VERTEX_BYTES, 4);
+    indexCount = indexCount ? indexCount : MESH_ARENA_INITIAL_INDICES;
+    arena->vertexBuffer = GenBufferEx(NULL, vertexBytes, MESH_ARENA_VERTEX_USAGE);
+    arena->indexBuffer = GenBufferEx(NULL, (size_t)indexCount * sizeof(uint32_t), MESH_ARENA_INDEX_USAGE);
+    return arena;
+}
+
+void UnloadMeshArena(MeshArena* arena){
+    if(arena == NULL){
+        return;
+    }
+    if(arena == g_defaultMeshArena){
+        g_defaultMeshArena = NULL;
+    }
+    UnloadBuffer(arena->vertexBuffer);
+    UnloadBuffer(arena->indexBuffer);
+    RL_FREE(arena->allocations);
+    RL_FREE(arena);
+}
+
+MeshArena* GetDefaultMeshArena(cwoid){
+    if(g_defaultMeshArena == NULL){
+        g_defaultMeshArena = LoadMeshArena(0, 0);
+    }
+    return g_defaultMeshArena;
+}
+
+typedef struct RangeOrder{
+    uint64_t offset;
+    uint32_t allocation;
+}RangeOrder;
+
+static int compareRangeOrder(const void* a, const void* b){
+    const RangeOrder* ra = (const RangeOrder*)a;
+    const RangeOrder* rb = (const RangeOrder*)b;
+    return (ra->offset > rb->offset) - (ra->offset < rb->offset);
+}
+
+// Copies the ranges into a new buffer of the same size and swaps it in, so the DescribedBuffer pointers
+// that VertexArrays hold stay valid. Draws already recorded keep reading the old buffer.
+static void moveIntoFreshBuffer(DescribedBuffer* buffer, const BufferCopyRange* ranges, uint32_t rangeCount){
+    DescribedBuffer* fresh = GenBufferEx(NULL, buffer->size, buffer->usage);
+    CopyBufferRanges(buffer, fresh, ranges, rangeCount);
+    DescribedBuffer old = *buffer;
+    *buffer = *fresh;
+    *fresh = old;
+    UnloadBuffer(fresh);
+}
+
+void CompactMeshArena(MeshArena* arena){
+    if(arena->wastedVertexBytes == 0 && arena->wastedIndices == 0){
+        return;
+    }
+    RangeOrder* order = (RangeOrder*)RL_CALLOC(arena->allocationCount + 1, sizeof(RangeOrder));
+    BufferCopyRange* ranges = (BufferCopyRange*)RL_CALLOC(arena->allocationCount + 1, sizeof(BufferCopyRange));
+
+    uint32_t liveCount = 0;
+    for(uint32_t i = 0;i < arena->allocationCount;i++){
+        if(arena->allocations[i].live){
+            order[liveCount++] = CLITERAL(RangeOrder){arena->allocations[i].vertexOffset, i};
+        }
+    }
+    qsort(order, liveCount, sizeof(RangeOrder), compareRangeOrder);
+    uint64_t vertexHead = 0;
+    for(uint32_t i = 0;i < liveCount;i++){
+        MeshArenaAllocation* allocation = arena->allocations + order[i].allocation;
+        const uint64_t dstOffset = alignUp(vertexHead, allocation->stride);
+        ranges[i] = CLITERAL(BufferCopyRange){allocation->vertexOffset, dstOffset, allocation->vertexBytes};
+        allocation->vertexOffset = dstOffset;
+        vertexHead = dstOffset + allocation->vertexBytes;
+    }
+    moveIntoFreshBuffer(arena->vertexBuffer, ranges, liveCount);
+
+    uint32_t indexedCount = 0;
+    for(uint32_t i = 0;i < arena->allocationCount;i++){
+        if(arena->allocations[i].live && arena->allocations[i].indexCount > 0){
+            order[indexedCount++] = CLITERAL(RangeOrder){arena->allocations[i].firstIndex, i};
+        }
+    }
+    qsort(order, indexedCount, sizeof(RangeOrder), compareRangeOrder);
+    uint32_t indexHead = 0;
+    for(uint32_t i = 0;i < indexedCount;i++){
+        MeshArenaAllocation* allocation = arena->allocations + order[i].allocation;
+        ranges[i] = CLITERAL(BufferCopyRange){(uint64_t)allocation->firstIndex * sizeof(uint32_t), (uint64_t)indexHead * sizeof(uint32_t), (uint64_t)allocation->indexCount * sizeof(uint32_t)};
+        allocation->firstIndex = indexHead;
+        indexHead += allocation->indexCount;
+    }
+    moveIntoFreshBuffer(arena->indexBuffer, ranges, indexedCount);
+
+    TRACELOG(LOG_DEBUG, "Compacted mesh arena: %llu -> %llu vertex bytes, %u -> %u indices",
+        (unsigned long long)arena->vertexHead, (unsigned long long)vertexHead, arena->indexHead, indexHead);
+    arena->vertexHead = vertexHead;
+    arena->indexHead = indexHead;
+    arena->wastedVertexBytes = 0;
+    arena->wastedIndices = 0;
+    ++arena->compactions;
+    RL_FREE(order);
+    RL_FREE(ranges);
+}
+
+// Amortized: every compaction at least halves the used part of the buffers
+static bool worthCompacting(const MeshArena* arena){
+    return arena->wastedVertexBytes * 2 > arena->vertexHead || (uint64_t)arena->wastedIndices * 2 > arena->indexHead;
+}
+
+static bool fits(const MeshArena* arena, uint64_t vertexBytes, uint32_t stride, uint32_t indexCount){
+    return alignUp(arena->vertexHead, stride) + vertexBytes <= arena->vertexBuffer->size &&
+           ((uint64_t)arena->indexHead + indexCount) * sizeof(uint32_t) <= arena->indexBuffer->size;
+}
+
+uint32_t MeshArenaAllocate(MeshArena* arena, uint32_t vertexCount, uint32_t stride, uint32_t indexCount){
+    if(stride == 0 || stride % 4 != 0){
+        TRACELOG(LOG_ERROR, "Mesh arena strides must be multiples of 4, got %u", stride);
+        return UINT32_MAX;
+    }
+    const uint64_t vertexBytes = (uint64_t)vertexCount * stride;
+    if(!fits(arena, vertexBytes, stride, indexCount) && worthCompacting(arena)){
+        CompactMeshArena(arena);
+    }
+    const uint64_t vertexEnd = alignUp(arena->vertexHead, stride) + vertexBytes;
+    if(vertexEnd > arena->vertexBuffer->size){
+        uint64_t size = arena->vertexBuffer->size;
+        while(size < vertexEnd){
+            size *= 2;
+        }
+        ResizeBufferAndConserve(arena->vertexBuffer, size);
+    }
+    const uint64_t indexEnd = ((uint64_t)arena->indexHead + indexCount) * sizeof(uint32_t);
+    if(indexEnd > arena->indexBuffer->size){
+        uint64_t size = arena->indexBuffer->size;
+        while(size < indexEnd){
+            size *= 2;
+        }
+        ResizeBufferAndConserve(arena->indexBuffer, size);
+    }
+
+    uint32_t id = 0;
+    while(id < arena->allocationCount && arena->allocations[id].live){
+        ++id;
+    }
+    if(id == arena->allocationCapacity){
+        arena->allocationCapacity = arena->allocationCapacity ? arena->allocationCapacity * 2 : 64;
+        arena->allocations = (MeshArenaAllocation*)RL_REALLOC(arena->allocations, arena->allocationCapacity * sizeof(MeshArenaAllocation));
+    }
+    if(id == arena->allocationCount){
+        ++arena->allocationCount;
+    }
+    MeshArenaAllocation* allocation = arena->allocations + id;
+    allocation->vertexOffset = alignUp(arena->vertexHead, stride);
+    allocation->vertexBytes = vertexBytes;
+    allocation->stride = stride;
+    allocation->firstIndex = arena->indexHead;
+    allocation->indexCount = indexCount;
+    allocation->live = true;
+    arena->vertexHead = allocation->vertexOffset + vertexBytes;
+    arena->indexHead += indexCount;
+    return id;
+}
+
+void MeshArenaFree(MeshArena* arena, uint32_t allocation){
+    if(allocation >= arena->allocationCount || !arena->allocations[allocation].live){
+        return;
+    }
+    arena->allocations[allocation].live = false;
+    arena->wastedVertexBytes += arena->allocations[allocation].vertexBytes;
+    arena->wastedIndices += arena->allocations[allocation].indexCount;
+    if(worthCompacting(arena)){
+        CompactMeshArena(arena);
+    }
+}
+
+MeshArenaStats GetMeshArenaStats(const MeshArena* arena){
+    MeshArenaStats stats = {0};
+    stats.vertexBytesUsed = arena->vertexHead;
+    stats.vertexBytesCapacity = arena->vertexBuffer->size;
+    stats.vertexBytesWasted = arena->wastedVertexBytes;
+    stats.indicesUsed = arena->indexHead;
+    stats.indexCapacity = (uint32_t)(arena->indexBuffer->size / sizeof(uint32_t));
+    stats.indicesWasted = arena->wastedIndices;
+    for(uint32_t i = 0;i < arena->allocationCount;i++){
+        stats.meshCount += arena->allocations[i].live;
+    }
+    stats.compactions = arena->compactions;
+    return stats;
+}
+
+// end file src/mesh_arena.c
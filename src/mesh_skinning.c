@@ -0,0 +1,354 @@
+// begin file src/mesh_skinning.c
+// Compute skinning for all animated meshes in one dispatch. Skinned meshes share their bind pose vertices with
+// bone weights, their bone and normal matrices and their skinned positions and normals in three buffers, plus
+// a table of each mesh's first bone. A skinned mesh's vertex array reads positions and normals from its range
+// of the skinned buffer. UpdateModelAnimation only uploads bones, the dispatch runs before the next mesh draw.
+//
+// FlushMeshSkinning submits its compute pass right away, while the render pass of the frame is still being recorded
+// and submitted at EndDrawing. Draws recorded before a flush therefore read the vertices of a later flush too: a
+// mesh updated twice in one frame shows its second pose in both places. Load the model twice to draw two poses.
+
+#include <raygpu.h>
+#include <stdlib.h>
+#include <string.h>
+#include "internal_include/internals.h"
+
+const char meshSkinningComputeSource[] =
+"struct SkinVertex {\n"
+"    position: vec3f,\n"
+"    slot: u32,\n"
+"    normal: vec3f,\n"
+"    padding: u32,\n"
+"    weights: vec4f,\n"
+"    joints: vec4u,\n"
+"};\n"
+"struct SkinBone {\n"
+"    transform: mat4x4f,\n"
+"    normal: mat4x4f,\n"
+"};\n"
+"struct SkinParams {\n"
+"    firstVertex: u32,\n"
+"    vertexCount: u32,\n"
+"    padding0: u32,\n"
+"    padding1: u32,\n"
+"};\n"
+"@group(0) @binding(0) var<uniform> params: SkinParams;\n"
+"@group(0) @binding(1) var<storage, read> vertices: array<SkinVertex>;\n"
+"@group(0) @binding(2) var<storage, read> bones: array<SkinBone>;\n"
+"@group(0) @binding(3) var<storage, read> slotBoneBase: array<u32>;\n"
+"@group(0) @binding(4) var<storage, read_write> skinned: array<f32>;\n"
+"@compute @workgroup_size(64)\n"
+"fn compute_main(@builtin(global_invocation_id) id: vec3<u32>) {\n"
+"    if (id.x >= params.vertexCount) {\n"
+"        return;\n"
+"    }\n"
+"    let index = params.firstVertex + id.x;\n"
+"    let v = vertices[index];\n"
+"    let boneBase = slotBoneBase[v.slot];\n"
+"    var position = vec3f(0.0, 0.0, 0.0);\n"
+"    var normal = vec3f(0.0, 0.0, 0.0);\n"
+"    for (var j = 0u; j < 4u; j = j + 1u) {\n"
+"        let weight = v.weights[j];\n"
+"        if (weight != 0.0) {\n"
+"            let bone = bones[boneBase + v.joints[j]];\n"
+"            position = position + (bone.transform * vec4f(v.position, 1.0)).xyz * weight;\n"
+"            normal = normal + (bone.normal * vec4f(v.normal, 0.0)).xyz * weight;\n"
+"        }\n"
+"    }\n"
+"    let dst = index * 6u;\n"
+"    skinned[dst + 0u] = position.x;\n"
+"    skinned[dst + 1u] = position.y;\n"
+"    skinned[dst + 2u] = position.z;\n"
+"    skinned[dst + 3u] = normal.x;\n"
+"    skinned[dst + 4u] = normal.y;\n"
+"    skinned[dst + 5u] = normal.z;\n"
+"}\n";
+
+#define SKINNING_SOURCE_USAGE (RGBufferUsage_CopySrc | RGBufferUsage_CopyDst | RGBufferUsage_Storage)
+#define SKINNING_OUTPUT_USAGE (RGBufferUsage_CopySrc | RGBufferUsage_CopyDst | RGBufferUsage_Storage | RGBufferUsage_Vertex)
+// Skinned position and normal, interleaved
+#define SKINNED_VERTEX_SIZE (6 * sizeof(float))
+
+// SkinVertex in the skinning shader
+typedef struct SkinningVertex{
+    float position[3];
+    uint32_t slot;
+    float normal[3];
+    uint32_t padding;
+    float weights[4];
+    uint32_t joints[4];
+}SkinningVertex;
+
+// SkinBone in the skinning shader
+typedef struct SkinningBone{
+    Matrix transform;
+    Matrix normal;
+}SkinningBone;
+
+typedef struct SkinningParams{
+    uint32_t firstVertex;
+    uint32_t vertexCount;
+    uint32_t padding[2];
+}SkinningParams;
+
+typedef struct SkinningSlot{
+    VertexArray* vao;
+    uint32_t vertexBase;
+    uint32_t vertexCount;
+    uint32_t boneBase;
+    uint32_t boneCount;
+    bool live;
+}SkinningSlot;
+
+static struct{
+    DescribedComputePipeline* pipeline;
+    bool pipelineFailed;
+    DescribedBuffer* vertexBuffer;
+    DescribedBuffer* boneBuffer;
+    DescribedBuffer* slotBuffer;
+    DescribedBuffer* skinnedBuffer;
+    uint32_t vertexHead;
+    uint32_t vertexCapacity;
+    uint32_t boneHead;
+    uint32_t boneCapacity;
+    SkinningSlot* slots;       // Indexed by Mesh::skinningSlot - 1, slots of unloaded meshes are reused
+    uint32_t* slotBoneBases;   // Uploaded to slotBuffer
+    uint32_t slotCount;
+    uint32_t slotCapacity;
+    bool slotTableDirty;
+    SkinningBone* boneScratch;
+    uint32_t boneScratchCapacity;
+    uint32_t dirtyBegin;       // Vertex range updated since the last dispatch
+    uint32_t dirtyEnd;
+}g_skinning;
+
+static DescribedComputePipeline* getSkinningPipeline(cwoid){
+    if(g_skinning.pipeline == NULL && !g_skinning.pipelineFailed){
+        ShaderBatchResult loaded;
+        if(!LoadBuiltinShader(BuiltinShader_MeshSkinning, &loaded)){
+            TRACELOG(LOG_WARNING, "Skinning shader failed to load, skinning on the CPU: %s", loaded.diagnostics);
+            g_skinning.pipelineFailed = true;
+            return NULL;
+        }
+        g_skinning.pipeline = loaded.computePipeline;
+    }
+    return g_skinning.pipeline;
+}
+
+bool CanSkinMeshOnGPU(const Mesh* mesh){
+    #if MESH_GPU_SKINNING == 1 && MESH_PACKED_VERTICES == 0
+    if(mesh->arena != NULL || mesh->vbos == NULL || mesh->vao == NULL || mesh->vertices == NULL ||
+       mesh->boneWeights == NULL || mesh->boneIds == NULL || mesh->boneCount <= 0){
+        return false;
+    }
+    return mesh->skinningSlot != 0 || getSkinningPipeline() != NULL;
+    #else
+    (void)mesh;
+    return false;
+    #endif
+}
+
+// Points the positions and normals of the slot's vertex array at its range of the skinned buffer
+static void bindSkinnedVertices(const SkinningSlot* slot){
+    VertexArray* vao = slot->vao;
+    VertexAttribPointer(vao, g_skinning.skinnedBuffer, 0, RGVertexFormat_Float32x3, 0, RGVertexStepMode_Vertex);
+    VertexAttribPointer(vao, g_skinning.skinnedBuffer, 2, RGVertexFormat_Float32x3, 3 * sizeof(float), RGVertexStepMode_Vertex);
+    for(size_t i = 0;i < vao->attributes_count;i++){
+        if(vao->attributes[i].attr.shaderLocation == 0){
+            vao->buffers[vao->attributes[i].bufferSlot].offset = (uint64_t)slot->vertexBase * SKINNED_VERTEX_SIZE;
+        }
+    }
+}
+
+// Copies the ranges into a new buffer and swaps it in, so the DescribedBuffer pointers vertex arrays hold stay valid
+static void repackBuffer(DescribedBuffer** buffer, uint64_t size, RGBufferUsage usage, const BufferCopyRange* ranges, uint32_t rangeCount){
+    DescribedBuffer* fresh = GenBufferEx(NULL, size, usage);
+    if(*buffer == NULL){
+        *buffer = fresh;
+        return;
+    }
+    if(rangeCount > 0){
+        CopyBufferRanges(*buffer, fresh, ranges, rangeCount);
+    }
+    DescribedBuffer old = **buffer;
+    **buffer = *fresh;
+    *fresh = old;
+    UnloadBuffer(fresh);
+}
+
+// Moves the live slots together into buffers of the given capacities, dropping the ranges of unloaded meshes
+static void repack(uint32_t vertexCapacity, uint32_t boneCapacity){
+    BufferCopyRange* vertexRanges = (BufferCopyRange*)RL_CALLOC(g_skinning.slotCount + 1, sizeof(BufferCopyRange));
+    BufferCopyRange* skinnedRanges = (BufferCopyRange*)RL_CALLOC(g_skinning.slotCount + 1, sizeof(BufferCopyRange));
+    BufferCopyRange* boneRanges = (BufferCopyRange*)RL_CALLOC(g_skinning.slotCount + 1, sizeof(BufferCopyRange));
+    uint32_t rangeCount = 0;
+    uint32_t vertexHead = 0;
+    uint32_t boneHead = 0;
+    for(uint32_t i = 0;i < g_skinning.slotCount;i++){
+        SkinningSlot* slot = g_skinning.slots + i;
+        if(!slot->live){
+            continue;
+        }
+        vertexRanges[rangeCount] = CLITERAL(BufferCopyRange){(uint64_t)slot->vertexBase * sizeof(SkinningVertex), (uint64_t)vertexHead * sizeof(SkinningVertex), (uint64_t)slot->vertexCount * sizeof(SkinningVertex)};
+        skinnedRanges[rangeCount] = CLITERAL(BufferCopyRange){(uint64_t)slot->vertexBase * SKINNED_VERTEX_SIZE, (uint64_t)vertexHead * SKINNED_VERTEX_SIZE, (uint64_t)slot->vertexCount * SKINNED_VERTEX_SIZE};
+        boneRanges[rangeCount] = CLITERAL(BufferCopyRange){(uint64_t)slot->boneBase * sizeof(SkinningBone), (uint64_t)boneHead * sizeof(SkinningBone), (uint64_t)slot->boneCount * sizeof(SkinningBone)};
+        ++rangeCount;
+        slot->vertexBase = vertexHead;
+        slot->boneBase = boneHead;
+        g_skinning.slotBoneBases[i] = boneHead;
+        vertexHead += slot->vertexCount;
+        boneHead += slot->boneCount;
+    }
+    repackBuffer(&g_skinning.vertexBuffer, (uint64_t)vertexCapacity * sizeof(SkinningVertex), SKINNING_SOURCE_USAGE, vertexRanges, rangeCount);
+    repackBuffer(&g_skinning.skinnedBuffer, (uint64_t)vertexCapacity * SKINNED_VERTEX_SIZE, SKINNING_OUTPUT_USAGE, skinnedRanges, rangeCount);
+    repackBuffer(&g_skinning.boneBuffer, (uint64_t)boneCapacity * sizeof(SkinningBone), SKINNING_SOURCE_USAGE, boneRanges, rangeCount);
+    for(uint32_t i = 0;i < g_skinning.slotCount;i++){
+        if(g_skinning.slots[i].live){
+            bindSkinnedVertices(g_skinning.slots + i);
+        }
+    }
+    TRACELOG(LOG_DEBUG, "Repacked skinning buffers: %u -> %u vertices, %u -> %u bones", g_skinning.vertexHead, vertexHead, g_skinning.boneHead, boneHead);
+    g_skinning.vertexHead = vertexHead;
+    g_skinning.vertexCapacity = vertexCapacity;
+    g_skinning.boneHead = boneHead;
+    g_skinning.boneCapacity = boneCapacity;
+    g_skinning.slotTableDirty = true;
+    if(g_skinning.dirtyBegin < g_skinning.dirtyEnd){
+        g_skinning.dirtyBegin = 0;
+        g_skinning.dirtyEnd = vertexHead;
+    }
+    RL_FREE(vertexRanges);
+    RL_FREE(skinnedRanges);
+    RL_FREE(boneRanges);
+}
+
+static uint32_t registerSkinnedMesh(Mesh* mesh){
+    const uint32_t vertexCount = (uint32_t)mesh->vertexCount;
+    const uint32_t boneCount = (uint32_t)mesh->boneCount;
+    if(g_skinning.vertexHead + vertexCount > g_skinning.vertexCapacity || g_skinning.boneHead + boneCount > g_skinning.boneCapacity){
+        uint32_t liveVertices = vertexCount, liveBones = boneCount;
+        for(uint32_t i = 0;i < g_skinning.slotCount;i++){
+            if(g_skinning.slots[i].live){
+                liveVertices += g_skinning.slots[i].vertexCount;
+                liveBones += g_skinning.slots[i].boneCount;
+            }
+        }
+        uint32_t vertexCapacity = g_skinning.vertexCapacity ? g_skinning.vertexCapacity : MESH_SKINNING_INITIAL_VERTICES;
+        uint32_t boneCapacity = g_skinning.boneCapacity ? g_skinning.boneCapacity : MESH_SKINNING_INITIAL_BONES;
+        while(vertexCapacity < liveVertices){
+            vertexCapacity *= 2;
+        }
+        while(boneCapacity < liveBones){
+            boneCapacity *= 2;
+        }
+        repack(vertexCapacity, boneCapacity);
+    }
+
+    uint32_t id = 0;
+    while(id < g_skinning.slotCount && g_skinning.slots[id].live){
+        ++id;
+    }
+    if(id == g_skinning.slotCapacity){
+        g_skinning.slotCapacity = g_skinning.slotCapacity ? g_skinning.slotCapacity * 2 : 16;
+        g_skinning.slots = (SkinningSlot*)RL_REALLOC(g_skinning.slots, g_skinning.slotCapacity * sizeof(SkinningSlot));
+        g_skinning.slotBoneBases = (uint32_t*)RL_REALLOC(g_skinning.slotBoneBases, g_skinning.slotCapacity * sizeof(uint32_t));
+    }
+    if(id == g_skinning.slotCount){
+        ++g_skinning.slotCount;
+    }
+    SkinningSlot* slot = g_skinning.slots + id;
+    slot->vao = mesh->vao;
+    slot->vertexBase = g_skinning.vertexHead;
+    slot->vertexCount = vertexCount;
+    slot->boneBase = g_skinning.boneHead;
+    slot->boneCount = boneCount;
+    slot->live = true;
+    g_skinning.vertexHead += vertexCount;
+    g_skinning.boneHead += boneCount;
+    g_skinning.slotBoneBases[id] = slot->boneBase;
+    g_skinning.slotTableDirty = true;
+
+    SkinningVertex* vertices = (SkinningVertex*)RL_CALLOC(vertexCount, sizeof(SkinningVertex));
+    for(uint32_t i = 0;i < vertexCount;i++){
+        memcpy(vertices[i].position, mesh->vertices + i * 3, 3 * sizeof(float));
+        if(mesh->normals){
+            memcpy(vertices[i].normal, mesh->normals + i * 3, 3 * sizeof(float));
+        }
+        memcpy(vertices[i].weights, mesh->boneWeights + i * 4, 4 * sizeof(float));
+        for(uint32_t j = 0;j < 4;j++){
+            vertices[i].joints[j] = MeshBoneId(mesh, i * 4 + j);
+        }
+        vertices[i].slot = id;
+    }
+    BufferSubData(g_skinning.vertexBuffer, (uint64_t)slot->vertexBase * sizeof(SkinningVertex), vertices, (size_t)vertexCount * sizeof(SkinningVertex));
+    RL_FREE(vertices);
+    bindSkinnedVertices(slot);
+    return id + 1;
+}
+
+void UpdateSkinnedMeshBones(Mesh* mesh, const Matrix* boneMatrices, const Matrix* normalMatrices){
+    if(mesh->skinningSlot == 0){
+        mesh->skinningSlot = registerSkinnedMesh(mesh);
+    }
+    const SkinningSlot* slot = g_skinning.slots + mesh->skinningSlot - 1;
+    if(slot->boneCount > g_skinning.boneScratchCapacity){
+        g_skinning.boneScratchCapacity = slot->boneCount;
+        g_skinning.boneScratch = (SkinningBone*)RL_REALLOC(g_skinning.boneScratch, slot->boneCount * sizeof(SkinningBone));
+    }
+    for(uint32_t i = 0;i < slot->boneCount;i++){
+        g_skinning.boneScratch[i].transform = boneMatrices[i];
+        g_skinning.boneScratch[i].normal = normalMatrices[i];
+    }
+    BufferSubData(g_skinning.boneBuffer, (uint64_t)slot->boneBase * sizeof(SkinningBone), g_skinning.boneScratch, (size_t)slot->boneCount * sizeof(SkinningBone));
+    if(g_skinning.dirtyBegin >= g_skinning.dirtyEnd){
+        g_skinning.dirtyBegin = slot->vertexBase;
+        g_skinning.dirtyEnd = slot->vertexBase + slot->vertexCount;
+    }else{
+        g_skinning.dirtyBegin = slot->vertexBase < g_skinning.dirtyBegin ? slot->vertexBase : g_skinning.dirtyBegin;
+        g_skinning.dirtyEnd = slot->vertexBase + slot->vertexCount > g_skinning.dirtyEnd ? slot->vertexBase + slot->vertexCount : g_skinning.dirtyEnd;
+    }
+}
+
+// The range stays in the buffers until the next repack
+void UnloadSkinnedMesh(Mesh* mesh){
+    if(mesh->skinningSlot == 0){
+        return;
+    }
+    g_skinning.slots[mesh->skinningSlot - 1].live = false;
+    mesh->skinningSlot = 0;
+}
+
+void FlushMeshSkinning(){
+    if(g_skinning.dirtyBegin >= g_skinning.dirtyEnd){
+        return;
+    }
+    if(g_skinning.slotTableDirty){
+        const size_t tableSize = (size_t)g_skinning.slotCapacity * sizeof(uint32_t);
+        if(g_skinning.slotBuffer == NULL || g_skinning.slotBuffer->size < tableSize){
+            if(g_skinning.slotBuffer){
+                UnloadBuffer(g_skinning.slotBuffer);
+            }
+            g_skinning.slotBuffer = GenStorageBuffer(g_skinning.slotBoneBases, tableSize);
+        }else{
+            BufferSubData(g_skinning.slotBuffer, 0, g_skinning.slotBoneBases, (size_t)g_skinning.slotCount * sizeof(uint32_t));
+        }
+        g_skinning.slotTableDirty = false;
+    }
+    const SkinningParams params = {
+        .firstVertex = g_skinning.dirtyBegin,
+        .vertexCount = g_skinning.dirtyEnd - g_skinning.dirtyBegin,
+    };
+    DescribedComputePipeline* pipeline = g_skinning.pipeline;
+    SetBindgroupUniformBufferData(&pipeline->bindGroup, 0, &params, sizeof(params));
+    SetBindgroupStorageBuffer(&pipeline->bindGroup, 1, g_skinning.vertexBuffer);
+    SetBindgroupStorageBuffer(&pipeline->bindGroup, 2, g_skinning.boneBuffer);
+    SetBindgroupStorageBuffer(&pipeline->bindGroup, 3, g_skinning.slotBuffer);
+    SetBindgroupStorageBuffer(&pipeline->bindGroup, 4, g_skinning.skinnedBuffer);
+    BeginComputepass();
+    BindComputePipeline(pipeline);
+    DispatchCompute((params.vertexCount + 63) / 64, 1, 1);
+    EndComputepass();
+    g_skinning.dirtyBegin = g_skinning.dirtyEnd = 0;
+}
+
+// end file src/mesh_skinning.c
@@ -1,7 +1,9 @@
 // begin file src/models.c
 #include "mathutils.h"
 #include <stdio.h>
+#include <string.h>
 #include <raygpu.h>
+#include "internal_include/internals.h"
 #ifndef RL_CALLOC
 #define RL_CALLOC calloc
 #endif
@@ -55,7 +57,308 @@ static void ReleaseFileGLTFCallback(const struct cgltf_memory_options *memoryOpt
     UnloadFileData(data);
 }
 
+#define VERTEX_ATTRIBUTE_ABSENT 0xFFFFFFFFu
+// One interleaved vertex, used by MESH_PACKED_VERTICES and by meshes in a MeshArena
+typedef struct MeshVertexLayout{
+    uint32_t stride;
+    uint32_t uvOffset, normalOffset, colorOffset, weightOffset, boneIdOffset; // VERTEX_ATTRIBUTE_ABSENT if not stored
+    RGVertexFormat uvFormat, normalFormat, weightFormat, boneIdFormat;
+}MeshVertexLayout;
+
+static MeshVertexLayout GetMeshVertexLayout(const Mesh* mesh, bool storeColors){
+    MeshVertexLayout layout = {0};
+    #if MESH_PACKED_VERTICES == 1
+    layout.uvFormat = RGVertexFormat_Unorm16x2;
+    layout.normalFormat = RGVertexFormat_Snorm8x4;
+    layout.weightFormat = RGVertexFormat_Unorm8x4;
+    if(mesh->texcoords){
+        for(int i = 0;i < mesh->vertexCount * 2;i++){
+            if(mesh->texcoords[i] < 0.0f || mesh->texcoords[i] > 1.0f){
+                // Tiled uvs would be clamped by unorm16
+                layout.uvFormat = RGVertexFormat_Float32x2;
+                break;
+            }
+        }
+    }
+    #else
+    layout.uvFormat = RGVertexFormat_Float32x2;
+    layout.normalFormat = RGVertexFormat_Float32x3;
+    layout.weightFormat = RGVertexFormat_Float32x4;
+    #endif
+    layout.boneIdFormat = (mesh->boneIDFormat == RGVertexFormat_Uint16x4) ? RGVertexFormat_Uint16x4 : RGVertexFormat_Uint8x4;
+
+    layout.stride = 3 * sizeof(float);
+    layout.uvOffset = layout.stride;
+    layout.stride += attributeSize(layout.uvFormat);
+    layout.normalOffset = layout.stride;
+    layout.stride += attributeSize(layout.normalFormat);
+    layout.colorOffset = layout.weightOffset = layout.boneIdOffset = VERTEX_ATTRIBUTE_ABSENT;
+    if(storeColors){
+        layout.colorOffset = layout.stride;
+        layout.stride += 4;
+    }
+    if(mesh->boneWeights){
+        layout.weightOffset = layout.stride;
+        layout.stride += attributeSize(layout.weightFormat);
+    }
+    if(mesh->boneIds){
+        layout.boneIdOffset = layout.stride;
+        layout.stride += attributeSize(layout.boneIdFormat);
+    }
+    return layout;
+}
+
+// positions and normals are separate so animated meshes can pass animVertices and animNormals
+static uint8_t* InterleaveMeshVertices(const Mesh* mesh, const MeshVertexLayout* layout, const float* positions, const float* normals){
+    uint8_t* packed = (uint8_t*)RL_CALLOC(mesh->vertexCount, layout->stride);
+    if(packed == NULL){
+        return NULL;
+    }
+    for(int i = 0;i < mesh->vertexCount;i++){
+        uint8_t* v = packed + (size_t)i * layout->stride;
+        if(positions){
+            memcpy(v, positions + i * 3, 3 * sizeof(float));
+        }
+        if(mesh->texcoords){
+            if(layout->uvFormat == RGVertexFormat_Float32x2){
+                memcpy(v + layout->uvOffset, mesh->texcoords + i * 2, 2 * sizeof(float));
+            }else{
+                uint16_t uv[2] = {rlPackUnorm16(mesh->texcoords[i * 2]), rlPackUnorm16(mesh->texcoords[i * 2 + 1])};
+                memcpy(v + layout->uvOffset, uv, sizeof(uv));
+            }
+        }
+        if(normals){
+            if(layout->normalFormat == RGVertexFormat_Float32x3){
+                memcpy(v + layout->normalOffset, normals + i * 3, 3 * sizeof(float));
+            }else{
+                int8_t* n = (int8_t*)(v + layout->normalOffset);
+                n[0] = rlPackSnorm8(normals[i * 3 + 0]);
+                n[1] = rlPackSnorm8(normals[i * 3 + 1]);
+                n[2] = rlPackSnorm8(normals[i * 3 + 2]);
+            }
+        }
+        if(layout->colorOffset != VERTEX_ATTRIBUTE_ABSENT){
+            if(mesh->colors){
+                memcpy(v + layout->colorOffset, mesh->colors + i * 4, 4);
+            }else{
+                memset(v + layout->colorOffset, 255, 4);
+            }
+        }
+        if(layout->weightOffset != VERTEX_ATTRIBUTE_ABSENT){
+            if(layout->weightFormat == RGVertexFormat_Float32x4){
+                memcpy(v + layout->weightOffset, mesh->boneWeights + i * 4, 4 * sizeof(float));
+            }else{
+                uint8_t* w = v + layout->weightOffset;
+                int sum = 0, largest = 0;
+                for(int j = 0;j < 4;j++){
+                    w[j] = rlPackUnorm8(mesh->boneWeights[i * 4 + j]);
+                    sum += w[j];
+                    largest = (w[j] > w[largest]) ? j : largest;
+                }
+                // Rounding must not change the total weight of a normalized vertex, its largest weight absorbs the error
+                const int error = 255 - sum;
+                if(error != 0 && error >= -4 && error <= 4){
+                    w[largest] = (uint8_t)(w[largest] + error);
+                }
+            }
+        }
+        if(layout->boneIdOffset != VERTEX_ATTRIBUTE_ABSENT){
+            const size_t idSize = attributeSize(layout->boneIdFormat);
+            memcpy(v + layout->boneIdOffset, mesh->boneIds + i * idSize, idSize);
+        }
+    }
+    return packed;
+}
+
+// Bound in place of a color stream for packed meshes that have none, grown to the largest of those meshes
+static DescribedBuffer* whiteVertexColors = NULL;
+
+static DescribedBuffer* GetWhiteVertexColors(int vertexCount){
+    const size_t required = (size_t)vertexCount * sizeof(RGBA8Color);
+    if(whiteVertexColors == NULL || whiteVertexColors->size < required){
+        const size_t size = (whiteVertexColors && whiteVertexColors->size * 2 > required) ? whiteVertexColors->size * 2 : required;
+        uint8_t* white = (uint8_t*)RL_MALLOC(size);
+        memset(white, 255, size);
+        if(whiteVertexColors == NULL){
+            whiteVertexColors = GenVertexBuffer(white, size);
+        }else{
+            BufferData(whiteVertexColors, white, size);
+        }
+        RL_FREE(white);
+    }
+    return whiteVertexColors;
+}
+
+static void SetMeshVertexAttributes(Mesh* mesh, DescribedBuffer* buffer, const MeshVertexLayout* layout){
+    if(mesh->vao == NULL){
+        mesh->vao = LoadVertexArray();
+    }
+    VertexAttribPointer(mesh->vao, buffer, 0, RGVertexFormat_Float32x3, 0                   , RGVertexStepMode_Vertex);
+    VertexAttribPointer(mesh->vao, buffer, 1, layout->uvFormat       , layout->uvOffset    , RGVertexStepMode_Vertex);
+    VertexAttribPointer(mesh->vao, buffer, 2, layout->normalFormat   , layout->normalOffset, RGVertexStepMode_Vertex);
+    if(layout->colorOffset != VERTEX_ATTRIBUTE_ABSENT){
+        VertexAttribPointer(mesh->vao, buffer, 3, RGVertexFormat_Unorm8x4, layout->colorOffset, RGVertexStepMode_Vertex);
+    }else{
+        VertexAttribPointer(mesh->vao, GetWhiteVertexColors(mesh->vertexCount), 3, RGVertexFormat_Unorm8x4, 0, RGVertexStepMode_Vertex);
+    }
+    for(uint32_t location = 0;location < 4;location++){
+        EnableVertexAttribArray(mesh->vao, location);
+    }
+    if(layout->weightOffset != VERTEX_ATTRIBUTE_ABSENT){
+        VertexAttribPointer(mesh->vao, buffer, 4, layout->weightFormat, layout->weightOffset, RGVertexStepMode_Vertex);
+        EnableVertexAttribArray(mesh->vao, 4);
+    }
+    if(layout->boneIdOffset != VERTEX_ATTRIBUTE_ABSENT){
+        VertexAttribPointer(mesh->vao, buffer, 5, layout->boneIdFormat, layout->boneIdOffset, RGVertexStepMode_Vertex);
+        EnableVertexAttribArray(mesh->vao, 5);
+    }
+}
+
+// Makes sure the mesh owns a range of arena that matches layout and its vertex and index counts, reallocating it
+// if one of them changed. Returns true if the range is new, its indices then have to be uploaded again.
+static bool ReserveMeshArenaRange(MeshArena* arena, Mesh* mesh, const MeshVertexLayout* layout){
+    const uint32_t indexCount = mesh->indices ? (uint32_t)mesh->triangleCount * 3 : 0;
+    if(mesh->arena != NULL){
+        const MeshArenaAllocation* allocation = mesh->arena->allocations + mesh->arenaAllocation;
+        if(mesh->arena == arena && allocation->stride == layout->stride && allocation->vertexBytes == (uint64_t)mesh->vertexCount * layout->stride && allocation->indexCount == indexCount){
+            return false;
+        }
+        MeshArenaFree(mesh->arena, mesh->arenaAllocation);
+        mesh->arena = NULL;
+    }
+    const uint32_t allocation = MeshArenaAllocate(arena, (uint32_t)mesh->vertexCount, layout->stride, indexCount);
+    if(allocation == UINT32_MAX){
+        return false;
+    }
+    mesh->arena = arena;
+    mesh->arenaAllocation = allocation;
+    SetMeshVertexAttributes(mesh, arena->vertexBuffer, layout);
+    return true;
+}
+
+static void UploadArenaIndices(Mesh* mesh){
+    const MeshArenaAllocation* allocation = mesh->arena->allocations + mesh->arenaAllocation;
+    if(allocation->indexCount > 0){
+        BufferSubData(mesh->arena->indexBuffer, (uint64_t)allocation->firstIndex * sizeof(uint32_t), mesh->indices, allocation->indexCount * sizeof(uint32_t));
+    }
+}
+
+// Writes positions and normals into the mesh's interleaved vertices, in its own buffer or its arena range
+static void UploadInterleavedMesh(Mesh *mesh, const float* positions, const float* normals){
+    const MeshVertexLayout layout = GetMeshVertexLayout(mesh, mesh->colors != NULL || mesh->arena != NULL);
+    uint8_t* packed = InterleaveMeshVertices(mesh, &layout, positions, normals);
+    if(packed == NULL){
+        TRACELOG(LOG_ERROR, "Failed to allocate %d packed vertices", mesh->vertexCount);
+        return;
+    }
+    const size_t size = (size_t)mesh->vertexCount * layout.stride;
+    if(mesh->arena != NULL){
+        // The layout depends on the data, e.g. uvs that leave [0, 1] switch to floats and widen the stride
+        if(ReserveMeshArenaRange(mesh->arena, mesh, &layout)){
+            UploadArenaIndices(mesh);
+        }
+        if(mesh->arena != NULL){
+            const MeshArenaAllocation* allocation = mesh->arena->allocations + mesh->arenaAllocation;
+            BufferSubData(mesh->arena->vertexBuffer, allocation->vertexOffset, packed, size);
+        }
+    }else if(mesh->vbos != NULL){
+        BufferData(mesh->vbos[0], packed, size);
+    }else{
+        mesh->vbos = (DescribedBuffer**)RL_CALLOC(MAX_MESH_VERTEX_BUFFERS, sizeof(DescribedBuffer*));
+        mesh->vbos[0] = GenVertexBuffer(packed, size);
+        SetMeshVertexAttributes(mesh, mesh->vbos[0], &layout);
+    }
+    RL_FREE(packed);
+}
+
+// The vertex buffers, index buffer and vertex array UploadMesh creates for a mesh outside an arena, and its
+// range of the skinning buffers that its vertex array reads from
+static void UnloadMeshBuffers(Mesh* mesh){
+    UnloadSkinnedMesh(mesh);
+    if(mesh->vbos != NULL){
+        for(int i = 0;i < MAX_MESH_VERTEX_BUFFERS;i++){
+            if(mesh->vbos[i] != NULL){
+                UnloadBuffer(mesh->vbos[i]);
+            }
+        }
+        RL_FREE(mesh->vbos);
+        mesh->vbos = NULL;
+    }
+    if(mesh->ibo != NULL){
+        UnloadBuffer(mesh->ibo);
+        mesh->ibo = NULL;
+    }
+    if(mesh->vao != NULL){
+        UnloadVertexArray(mesh->vao);
+        mesh->vao = NULL;
+    }
+}
+
+void UploadMeshToArena(MeshArena* arena, Mesh* mesh){
+    const MeshVertexLayout layout = GetMeshVertexLayout(mesh, true);
+    const bool firstUpload = (mesh->arena == NULL && mesh->vbos == NULL);
+    if(mesh->arena == NULL && mesh->vbos != NULL){
+        // Moves into the arena, GenMesh* functions upload to the mesh's own buffers right away
+        UnloadMeshBuffers(mesh);
+    }
+    ReserveMeshArenaRange(arena, mesh, &layout);
+    if(mesh->arena == NULL){
+        return;
+    }
+    UploadInterleavedMesh(mesh, mesh->vertices, mesh->normals);
+    UploadArenaIndices(mesh);
+    if(firstUpload && mesh->boneMatrices && mesh->boneCount){
+        mesh->boneMatrixBuffer = GenStorageBuffer(mesh->boneMatrices, sizeof(Matrix) * mesh->boneCount);
+    }
+}
+
+void UnloadMesh(Mesh mesh){
+    if(mesh.arena != NULL){
+        MeshArenaFree(mesh.arena, mesh.arenaAllocation);
+    }
+    UnloadMeshBuffers(&mesh);
+    if(mesh.boneMatrixBuffer != NULL){
+        UnloadBuffer(mesh.boneMatrixBuffer);
+    }
+    RL_FREE(mesh.vertices);
+    RL_FREE(mesh.texcoords);
+    RL_FREE(mesh.texcoords2);
+    RL_FREE(mesh.normals);
+    RL_FREE(mesh.tangents);
+    RL_FREE(mesh.colors);
+    RL_FREE(mesh.indices);
+    RL_FREE(mesh.animVertices);
+    RL_FREE(mesh.animNormals);
+    RL_FREE(mesh.boneIds);
+    RL_FREE(mesh.boneWeights);
+    RL_FREE(mesh.boneMatrices);
+}
+
 void UploadMesh(Mesh *mesh, bool dynamic){
+    if(mesh->arena != NULL){
+        UploadMeshToArena(mesh->arena, mesh);
+        return;
+    }
+    #if MESH_ARENA_STATIC_MESHES == 1
+    if(!dynamic && mesh->vbos == NULL && mesh->boneWeights == NULL){
+        UploadMeshToArena(GetDefaultMeshArena(), mesh);
+        return;
+    }
+    #endif
+    #if MESH_PACKED_VERTICES == 1
+    const bool firstUpload = (mesh->vbos == NULL);
+    UploadInterleavedMesh(mesh, mesh->vertices, mesh->normals);
+    if(mesh->indices){
+        if(firstUpload){
+            mesh->ibo = GenIndexBuffer(mesh->indices, mesh->triangleCount * 3 * sizeof(uint32_t));
+        }else{
+            BufferData(mesh->ibo, mesh->indices, mesh->triangleCount * 3 * sizeof(uint32_t));
+        }
+    }
+    if(firstUpload && mesh->boneMatrices && mesh->boneCount){
+        mesh->boneMatrixBuffer = GenStorageBuffer(mesh->boneMatrices, sizeof(Matrix) * mesh->boneCount);
+    }
+    #else
     if(mesh->colors == NULL){
         mesh->colors = (uint8_t*)RL_CALLOC(mesh->vertexCount, sizeof(RGBA8Color));
         for(size_t i = 0;i < mesh->vertexCount * 4;i++){
@@ -109,19 +412,33 @@ void UploadMesh(Mesh *mesh, bool dynamic){
             BufferData(mesh->ibo, mesh->indices, mesh->triangleCount * 3 * sizeof(uint32_t));
         }
     }
+    #endif
+}
+// Offset draw into the arena's shared buffers, which stay bound from one arena mesh to the next
+static void DrawArenaMesh(Mesh mesh, uint32_t instances, uint32_t firstInstance){
+    const MeshArenaAllocation* allocation = mesh.arena->allocations + mesh.arenaAllocation;
+    const uint32_t baseVertex = (uint32_t)(allocation->vertexOffset / allocation->stride);
+    if(allocation->indexCount > 0){
+        DrawArraysIndexedRange(RL_TRIANGLES, mesh.arena->indexBuffer, allocation->firstIndex, allocation->indexCount, (int32_t)baseVertex, instances, firstInstance);
+    }else{
+        DrawArraysRange(RL_TRIANGLES, baseVertex, mesh.vertexCount, instances, firstInstance);
+    }
 }
 DescribedBuffer* trfBuffer = NULL;
 RGAPI void DrawMeshInstanced(Mesh mesh, Material material, const Matrix* transforms, int instances){
+    FlushMeshSkinning();
     if(trfBuffer && trfBuffer->buffer){
         BufferData(trfBuffer, transforms, instances * sizeof(Matrix));
     }else{
         trfBuffer = GenStorageBuffer(transforms, instances * sizeof(Matrix));
     }
 
-    SetShaderStorageBuffer(GetActiveShader(), GetUniformLocation(GetActiveShader(), RL_DEFAULT_SHADER_UNIFORM_NAME_INSTANCE_TX), trfBuffer);
-    SetTexture(GetUniformLocation(GetActiveShader(), RL_DEFAULT_SHADER_SAMPLER2D_NAME_TEXTURE0), material.maps[MATERIAL_MAP_DIFFUSE].texture);
+    SetShaderStorageBuffer(GetActiveShader(), GetUniformLocationByHandle(GetActiveShader(), RGDefaultUniform_InstanceTransform), trfBuffer);
+    SetTexture(GetUniformLocationByHandle(GetActiveShader(), RGDefaultUniform_Texture0), material.maps[MATERIAL_MAP_DIFFUSE].texture);
     BindShaderVertexArray(GetActiveShader(), mesh.vao);
-    if(mesh.ibo){
+    if(mesh.arena){
+        DrawArenaMesh(mesh, instances, 0);
+    }else if(mesh.ibo){
         DrawArraysIndexedInstanced(RL_TRIANGLES, *mesh.ibo, mesh.triangleCount * 3, instances);
     }else{
         DrawArraysInstanced(RL_TRIANGLES, mesh.vertexCount, instances);
@@ -186,16 +503,183 @@ RGAPI void DrawModelEx(Model model, Vector3 position, Vector3 rotationAxis, floa
     }
 }
 
+typedef struct MeshInstancingCommand{
+    Shader shader;
+    Mesh mesh;
+    Texture texture;
+    uint32_t sequence; // Submission order, keeps the sort stable
+    Matrix transform;
+}MeshInstancingCommand;
+
+// Transforms of all groups go into one storage buffer, a group draws its range of it through firstInstance.
+// Blocks append to the buffer during a frame, since every write lands before the frame's commands are submitted.
+static struct{
+    bool active;
+    MeshInstancingCommand* commands;
+    uint32_t commandCount;
+    uint32_t commandCapacity;
+    Matrix* transforms;
+    DescribedBuffer* pool;
+    uint32_t poolCapacity;
+    uint32_t poolHead;
+    uint64_t poolFrame;
+    MeshInstancingStats lastStats;
+}g_meshInstancing;
+
+static int compareMeshInstancingCommands(const void* a, const void* b){
+    const MeshInstancingCommand* x = (const MeshInstancingCommand*)a;
+    const MeshInstancingCommand* y = (const MeshInstancingCommand*)b;
+    if(x->shader.id != y->shader.id) return x->shader.id < y->shader.id ? -1 : 1;
+    if(x->mesh.vao != y->mesh.vao) return (uintptr_t)x->mesh.vao < (uintptr_t)y->mesh.vao ? -1 : 1;
+    if(x->mesh.arenaAllocation != y->mesh.arenaAllocation) return x->mesh.arenaAllocation < y->mesh.arenaAllocation ? -1 : 1;
+    if(x->texture.id != y->texture.id) return x->texture.id < y->texture.id ? -1 : 1;
+    return x->sequence < y->sequence ? -1 : (x->sequence > y->sequence);
+}
+
+static bool sameMeshInstancingGroup(const MeshInstancingCommand* x, const MeshInstancingCommand* y){
+    return x->shader.id == y->shader.id && x->mesh.vao == y->mesh.vao &&
+           x->mesh.arenaAllocation == y->mesh.arenaAllocation && x->texture.id == y->texture.id;
+}
+
+static void recordMeshInstance(Mesh mesh, Material material, Matrix transform){
+    if(g_meshInstancing.commandCount == g_meshInstancing.commandCapacity){
+        const uint32_t capacity = g_meshInstancing.commandCapacity ? g_meshInstancing.commandCapacity * 2 : 256;
+        MeshInstancingCommand* commands = (MeshInstancingCommand*)RL_REALLOC(g_meshInstancing.commands, capacity * sizeof(MeshInstancingCommand));
+        Matrix* transforms = (Matrix*)RL_REALLOC(g_meshInstancing.transforms, capacity * sizeof(Matrix));
+        if(commands) g_meshInstancing.commands = commands;
+        if(transforms) g_meshInstancing.transforms = transforms;
+        if(commands == NULL || transforms == NULL){
+            TRACELOG(LOG_ERROR, "Failed to grow the mesh instancing storage, dropping a DrawMesh call");
+            return;
+        }
+        g_meshInstancing.commandCapacity = capacity;
+    }
+    MeshInstancingCommand* command = g_meshInstancing.commands + g_meshInstancing.commandCount;
+    command->shader = GetActiveShader();
+    command->mesh = mesh;
+    command->texture = material.maps[MATERIAL_MAP_DIFFUSE].texture;
+    command->sequence = g_meshInstancing.commandCount++;
+    command->transform = transform;
+}
+
+// Reserves count transforms in the pool. A replaced buffer stays alive for the draws already recorded from it
+static uint32_t reserveMeshInstancingTransforms(uint32_t count){
+    if(g_meshInstancing.poolFrame != GetFrameCount()){
+        g_meshInstancing.poolFrame = GetFrameCount();
+        g_meshInstancing.poolHead = 0;
+    }
+    if(g_meshInstancing.pool == NULL || g_meshInstancing.poolHead + count > g_meshInstancing.poolCapacity){
+        uint32_t capacity = g_meshInstancing.poolCapacity ? g_meshInstancing.poolCapacity : MESH_INSTANCING_INITIAL_TRANSFORMS;
+        while(capacity < count){
+            capacity *= 2;
+        }
+        if(g_meshInstancing.pool){
+            UnloadBuffer(g_meshInstancing.pool);
+        }
+        g_meshInstancing.pool = GenStorageBuffer(NULL, (size_t)capacity * sizeof(Matrix));
+        g_meshInstancing.poolCapacity = capacity;
+        g_meshInstancing.poolHead = 0;
+    }
+    const uint32_t first = g_meshInstancing.poolHead;
+    g_meshInstancing.poolHead += count;
+    return first;
+}
+
+RGAPI void BeginMeshInstancing(){
+    if(g_meshInstancing.active){
+        TRACELOG(LOG_WARNING, "BeginMeshInstancing called while already recording");
+        return;
+    }
+    g_meshInstancing.active = true;
+    g_meshInstancing.commandCount = 0;
+    g_meshInstancing.lastStats = CLITERAL(MeshInstancingStats){0};
+}
+
+RGAPI void EndMeshInstancing(){
+    if(!g_meshInstancing.active){
+        TRACELOG(LOG_WARNING, "EndMeshInstancing called without BeginMeshInstancing");
+        return;
+    }
+    g_meshInstancing.active = false;
+    const uint32_t count = g_meshInstancing.commandCount;
+    g_meshInstancing.lastStats.recordedDraws = count;
+    if(count == 0)return;
+
+    FlushMeshSkinning();
+    qsort(g_meshInstancing.commands, count, sizeof(MeshInstancingCommand), compareMeshInstancingCommands);
+    for(uint32_t i = 0;i < count;i++){
+        g_meshInstancing.transforms[i] = g_meshInstancing.commands[i].transform;
+    }
+    const uint32_t poolOffset = reserveMeshInstancingTransforms(count);
+    BufferSubData(g_meshInstancing.pool, (uint64_t)poolOffset * sizeof(Matrix), g_meshInstancing.transforms, (size_t)count * sizeof(Matrix));
+
+    const Shader originalShader = GetActiveShader();
+    uint32_t emitted = 0;
+    for(uint32_t i = 0;i < count;){
+        const MeshInstancingCommand* first = g_meshInstancing.commands + i;
+        uint32_t end = i + 1;
+        while(end < count && sameMeshInstancingGroup(first, g_meshInstancing.commands + end)){
+            ++end;
+        }
+        if(GetActiveShader().id != first->shader.id){
+            BeginShaderMode(first->shader);
+        }
+        const Shader shader = GetActiveShader();
+        const Mesh mesh = first->mesh;
+        const uint32_t instances = end - i;
+        SetShaderStorageBuffer(shader, GetUniformLocationByHandle(shader, RGDefaultUniform_InstanceTransform), g_meshInstancing.pool);
+        SetTexture(GetUniformLocationByHandle(shader, RGDefaultUniform_Texture0), first->texture);
+        BindShaderVertexArray(shader, mesh.vao);
+        if(mesh.arena){
+            DrawArenaMesh(mesh, instances, poolOffset + i);
+        }else if(mesh.ibo){
+            DrawArraysIndexedRange(RL_TRIANGLES, mesh.ibo, 0, mesh.triangleCount * 3, 0, instances, poolOffset + i);
+        }else{
+            DrawArraysRange(RL_TRIANGLES, 0, mesh.vertexCount, instances, poolOffset + i);
+        }
+        ++emitted;
+        i = end;
+    }
+    if(GetActiveShader().id != originalShader.id){
+        BeginShaderMode(originalShader);
+    }
+    g_meshInstancing.lastStats.emittedDrawCalls = emitted;
+}
+
+RGAPI MeshInstancingStats GetMeshInstancingStats(){
+    return g_meshInstancing.lastStats;
+}
+
 RGAPI void DrawMesh(Mesh mesh, Material material, Matrix transform){
+    FlushMeshSkinning();
+    if(g_meshInstancing.active){
+        recordMeshInstance(mesh, material, transform);
+        return;
+    }
     SetStorageBufferData(3, &transform, sizeof(Matrix));
-    SetTexture(GetUniformLocation(GetActiveShader(), RL_DEFAULT_SHADER_SAMPLER2D_NAME_TEXTURE0), material.maps[MATERIAL_MAP_DIFFUSE].texture);
+    SetTexture(GetUniformLocationByHandle(GetActiveShader(), RGDefaultUniform_Texture0), material.maps[MATERIAL_MAP_DIFFUSE].texture);
     BindShaderVertexArray(GetActiveShader(), mesh.vao);
-    if(mesh.ibo){
+    if(mesh.arena){
+        DrawArenaMesh(mesh, 1, 0);
+    }else if(mesh.ibo){
         DrawArraysIndexed(RL_TRIANGLES, *mesh.ibo, mesh.triangleCount * 3);
     }else{
         DrawArrays(RL_TRIANGLES, mesh.vertexCount);
     }
 }
+RGAPI BoundingBox GetMeshBoundingBox(Mesh mesh){
+    BoundingBox box = {0};
+    if(mesh.vertices == NULL || mesh.vertexCount == 0){
+        return box;
+    }
+    box.min = box.max = CLITERAL(Vector3){mesh.vertices[0], mesh.vertices[1], mesh.vertices[2]};
+    for(int i = 1;i < mesh.vertexCount;i++){
+        const float* v = mesh.vertices + 3 * i;
+        box.min = CLITERAL(Vector3){fminf(box.min.x, v[0]), fminf(box.min.y, v[1]), fminf(box.min.z, v[2])};
+        box.max = CLITERAL(Vector3){fmaxf(box.max.x, v[0]), fmaxf(box.max.y, v[1]), fmaxf(box.max.z, v[2])};
+    }
+    return box;
+}
 void ProcessMaterialsOBJ(Material *materials, tinyobj_material_t *mats, int materialCount, const char* directory){
     // Init model mats
     for (int m = 0; m < materialCount; m++){
@@ -1780,11 +2264,19 @@ void UpdateModelAnimationBones(Model model, ModelAnimation anim, int frame)
 
 // at least 2x speed up vs the old method
 // Update model animated vertex data (positions and normals) for a given frame
-// NOTE: Updated data is uploaded to GPU
+// NOTE: Updated data is uploaded to GPU, meshes that can be are skinned there (see MESH_GPU_SKINNING)
 void UpdateModelAnimation(Model model, ModelAnimation anim, int frame)
 {
     UpdateModelAnimationBones(model,anim,frame);
 
+    // Normals are transformed by the inverse transpose of their bone matrix, computed once per bone
+    int maxBoneCount = 0;
+    for (int m = 0; m < model.meshCount; m++)
+    {
+        if (model.meshes[m].boneCount > maxBoneCount) maxBoneCount = model.meshes[m].boneCount;
+    }
+    Matrix *normalMatrices = (maxBoneCount > 0) ? (Matrix *)RL_MALLOC(maxBoneCount*sizeof(Matrix)) : NULL;
+
     for (int m = 0; m < model.meshCount; m++)
     {
         Mesh mesh = model.meshes[m];
@@ -1797,7 +2289,17 @@ void UpdateModelAnimation(Model model, ModelAnimation anim, int frame)
         const int vValues = mesh.vertexCount*3;
 
         // Skip if missing bone data, causes segfault without on some models
-        if ((mesh.boneWeights == NULL) || (mesh.boneIds == NULL)) continue;
+        if ((mesh.boneWeights == NULL) || (mesh.boneIds == NULL) || (mesh.boneMatrices == NULL)) continue;
+
+        for (int boneIndex = 0; boneIndex < mesh.boneCount; boneIndex++)
+        {
+            normalMatrices[boneIndex] = MatrixTranspose(MatrixInvert(mesh.boneMatrices[boneIndex]));
+        }
+        if (CanSkinMeshOnGPU(&mesh))
+        {
+            UpdateSkinnedMeshBones(&model.meshes[m], mesh.boneMatrices, normalMatrices);
+            continue;
+        }
 
         for (int vCounter = 0; vCounter < vValues; vCounter += 3)
         {
@@ -1815,7 +2317,7 @@ void UpdateModelAnimation(Model model, ModelAnimation anim, int frame)
             for (int j = 0; j < 4; j++, boneCounter++)
             {
                 boneWeight = mesh.boneWeights[boneCounter];
-                boneId = mesh.boneIds[boneCounter];
+                boneId = (int)MeshBoneId(&mesh, boneCounter);
 
                 // Early stop when no transformation will be applied
                 if (boneWeight == 0.0f) continue;
@@ -1831,7 +2333,7 @@ void UpdateModelAnimation(Model model, ModelAnimation anim, int frame)
                 if ((mesh.normals != NULL) && (mesh.animNormals != NULL ))
                 {
                     animNormal = CLITERAL(Vector3){ mesh.normals[vCounter], mesh.normals[vCounter + 1], mesh.normals[vCounter + 2] };
-                    animNormal = Vector3Transform(animNormal, MatrixTranspose(MatrixInvert(model.meshes[m].boneMatrices[boneId])));
+                    animNormal = Vector3Transform(animNormal, normalMatrices[boneId]);
                     mesh.animNormals[vCounter] += animNormal.x*boneWeight;
                     mesh.animNormals[vCounter + 1] += animNormal.y*boneWeight;
                     mesh.animNormals[vCounter + 2] += animNormal.z*boneWeight;
@@ -1841,10 +2343,19 @@ void UpdateModelAnimation(Model model, ModelAnimation anim, int frame)
 
         if (updated)
         {
-            BufferData((mesh.vbos[0]), mesh.animVertices, mesh.vertexCount * 3 * sizeof(float)); // Update vertex position
-            if (mesh.normals != NULL) BufferData((mesh.vbos[2]), mesh.animNormals, mesh.vertexCount * 3 * sizeof(float)); // Update vertex normals
+            if (mesh.arena != NULL || MESH_PACKED_VERTICES == 1)
+            {
+                // The original mesh, not the copy: a changed layout moves its arena range
+                UploadInterleavedMesh(&model.meshes[m], mesh.animVertices, (mesh.normals != NULL) ? mesh.animNormals : NULL);
+            }
+            else
+            {
+                BufferData((mesh.vbos[0]), mesh.animVertices, mesh.vertexCount * 3 * sizeof(float)); // Update vertex position
+                if (mesh.normals != NULL) BufferData((mesh.vbos[2]), mesh.animNormals, mesh.vertexCount * 3 * sizeof(float)); // Update vertex normals
+            }
         }
     }
+    RL_FREE(normalMatrices);
 }
 // Load model animations from file
 ModelAnimation *LoadModelAnimations(const char *fileName, int *animCount){
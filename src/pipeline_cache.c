@@ -0,0 +1,308 @@
+// begin file src/pipeline_cache.c
+// Render pipeline warm-up. A shader's pipelines are created lazily the first time it is drawn with a new
+// ModifiablePipelineState (primitive type, settings, vertex layout), which stalls that frame.
+// PrewarmShaderVariants creates them ahead of time, optionally on a background thread, and the states
+// created during a run can be saved with SavePipelineStates and prewarmed on the next launch.
+
+#include <raygpu.h>
+#include <stdio.h>
+#include "internal_include/internals.h"
+#include "internal_include/renderstate.h"
+#include "internal_include/rg_thread.h"
+
+#define PIPELINE_STATES_MAGIC 0x53504752u // "RGPS"
+#define PIPELINE_STATES_VERSION 1u
+
+typedef struct PipelineJob{
+    uint32_t shaderID;
+    ModifiablePipelineState state;
+    // Copies, the ShaderImpl array may be reallocated while the job is in flight. The job holds a reference
+    // on each native object until it is retired, so unloading the shader meanwhile does not free them
+    DescribedShaderModule shaderModule;
+    DescribedBindGroupLayout bglayout;
+    DescribedPipelineLayout layout;
+    WGPURenderPipeline pipeline;
+    bool done;
+}PipelineJob;
+
+typedef struct RecordedPipelineState{
+    uint64_t sourceHash;
+    ModifiablePipelineState state;
+}RecordedPipelineState;
+
+DEFINE_VECTOR_IW(static inline, PipelineJob*, PipelineJobVector)
+DEFINE_VECTOR_IW(static inline, RecordedPipelineState, RecordedPipelineStateVector)
+
+typedef struct PipelineWarmupState{
+    PipelineJobVector pending;           // Jobs not yet moved into their shader's pipeline cache
+    RecordedPipelineStateVector created; // Every state a pipeline was created for in this run
+    RecordedPipelineStateVector loaded;  // States from LoadPipelineStates, prewarmed when a matching shader loads
+    bool workerStarted;
+    rg_queue jobs;
+    rg_thread worker;
+    rg_mutex doneMutex;
+    rg_cond doneCond;
+}PipelineWarmupState;
+
+static PipelineWarmupState g_pipelineWarmup;
+
+static bool containsState(const RecordedPipelineStateVector* states, uint64_t sourceHash, const ModifiablePipelineState* state){
+    for(size_t i = 0;i < states->size;i++){
+        if(states->data[i].sourceHash == sourceHash && ModifiablePipelineState_eq(states->data[i].state, *state)){
+            return true;
+        }
+    }
+    return false;
+}
+
+static void recordState(uint64_t sourceHash, const ModifiablePipelineState* state){
+    if(!containsState(&g_pipelineWarmup.created, sourceHash, state)){
+        RecordedPipelineState recorded = {sourceHash, ModifiablePipelineState_copy(*state)};
+        RecordedPipelineStateVector_push_back(&g_pipelineWarmup.created, recorded);
+    }
+}
+
+static void insertPipeline(ShaderImpl* impl, const ModifiablePipelineState* state, WGPURenderPipeline pipeline){
+    // The map takes its own reference
+    PipelineHashMap_put(&impl->pipelineCache, *state, pipeline);
+    wgpuRenderPipelineRelease(pipeline);
+    recordState(impl->shaderModule.sourceHash, state);
+}
+
+#if PIPELINE_BACKGROUND_CREATION == 1 && RG_HAS_THREADS == 1
+static void pipelineWorkerMain(void* arg){
+    (void)arg;
+    PipelineJob* job;
+    while((job = (PipelineJob*)rg_queue_pop(&g_pipelineWarmup.jobs)) != NULL){
+        WGPURenderPipeline pipeline = createSingleRenderPipe(&job->state, &job->shaderModule, &job->bglayout, &job->layout);
+        rg_mutex_lock(&g_pipelineWarmup.doneMutex);
+        job->pipeline = pipeline;
+        job->done = true;
+        rg_cond_broadcast(&g_pipelineWarmup.doneCond);
+        rg_mutex_unlock(&g_pipelineWarmup.doneMutex);
+    }
+}
+
+static void stopPipelineWorker(){
+    rg_queue_close(&g_pipelineWarmup.jobs);
+    rg_thread_join(g_pipelineWarmup.worker);
+}
+
+static bool startPipelineWorker(){
+    if(g_pipelineWarmup.workerStarted){
+        return true;
+    }
+    rg_queue_init(&g_pipelineWarmup.jobs, 64);
+    rg_mutex_init(&g_pipelineWarmup.doneMutex);
+    rg_cond_init(&g_pipelineWarmup.doneCond);
+    if(!rg_thread_create(&g_pipelineWarmup.worker, pipelineWorkerMain, NULL)){
+        TRACELOG(LOG_WARNING, "Failed to start the pipeline creation thread, prewarming synchronously");
+        rg_queue_destroy(&g_pipelineWarmup.jobs);
+        return false;
+    }
+    g_pipelineWarmup.workerStarted = true;
+    atexit(stopPipelineWorker);
+    return true;
+}
+#endif
+
+static void referenceJobObjects(PipelineJob* job, bool acquire){
+    for(uint32_t i = 0;i < RGShaderStageEnum_EnumCount;i++){
+        WGPUShaderModule module = (WGPUShaderModule)job->shaderModule.stages[i].module;
+        if(module == NULL)continue;
+        // Stages commonly share one module, count it once
+        bool seen = false;
+        for(uint32_t j = 0;j < i;j++){
+            seen |= job->shaderModule.stages[j].module == job->shaderModule.stages[i].module;
+        }
+        if(seen)continue;
+        if(acquire)wgpuShaderModuleAddRef(module);
+        else wgpuShaderModuleRelease(module);
+    }
+    if(acquire){
+        wgpuBindGroupLayoutAddRef((WGPUBindGroupLayout)job->bglayout.layout);
+        wgpuPipelineLayoutAddRef(job->layout.layout);
+    }
+    else{
+        wgpuBindGroupLayoutRelease((WGPUBindGroupLayout)job->bglayout.layout);
+        wgpuPipelineLayoutRelease(job->layout.layout);
+    }
+}
+
+// Moves a finished job into its shader's cache. Must hold doneMutex.
+static WGPURenderPipeline retireJob(size_t index){
+    PipelineJob* job = g_pipelineWarmup.pending.data[index];
+    WGPURenderPipeline pipeline = job->pipeline;
+    ShaderImpl* impl = GetShaderImplByID(job->shaderID);
+    WGPURenderPipeline* existing = PipelineHashMap_get(&impl->pipelineCache, job->state);
+    if(existing){
+        wgpuRenderPipelineRelease(pipeline);
+        pipeline = *existing;
+    }
+    else{
+        insertPipeline(impl, &job->state, pipeline);
+    }
+    referenceJobObjects(job, false);
+    ModifiablePipelineState_free(job->state);
+    RL_FREE(job);
+    g_pipelineWarmup.pending.data[index] = g_pipelineWarmup.pending.data[--g_pipelineWarmup.pending.size];
+    return pipeline;
+}
+
+static int findPendingJob(uint32_t shaderID, const ModifiablePipelineState* state){
+    for(size_t i = 0;i < g_pipelineWarmup.pending.size;i++){
+        PipelineJob* job = g_pipelineWarmup.pending.data[i];
+        if(job->shaderID == shaderID && ModifiablePipelineState_eq(job->state, *state)){
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+void PollPipelineCreation(){
+    if(g_pipelineWarmup.pending.size == 0){
+        return;
+    }
+    rg_mutex_lock(&g_pipelineWarmup.doneMutex);
+    for(size_t i = g_pipelineWarmup.pending.size;i > 0;i--){
+        if(g_pipelineWarmup.pending.data[i - 1]->done){
+            retireJob(i - 1);
+        }
+    }
+    rg_mutex_unlock(&g_pipelineWarmup.doneMutex);
+}
+
+WGPURenderPipeline GetOrCreateRenderPipeline(uint32_t shaderID){
+    ShaderImpl* impl = GetShaderImplByID(shaderID);
+    WGPURenderPipeline* cached = PipelineHashMap_get(&impl->pipelineCache, impl->state);
+    if(cached){
+        return *cached;
+    }
+    const int pendingIndex = findPendingJob(shaderID, &impl->state);
+    if(pendingIndex >= 0){
+        // Still being created in the background, waiting is cheaper than building it twice
+        rg_mutex_lock(&g_pipelineWarmup.doneMutex);
+        while(!g_pipelineWarmup.pending.data[pendingIndex]->done){
+            rg_cond_wait(&g_pipelineWarmup.doneCond, &g_pipelineWarmup.doneMutex);
+        }
+        WGPURenderPipeline pipeline = retireJob(pendingIndex);
+        rg_mutex_unlock(&g_pipelineWarmup.doneMutex);
+        return pipeline;
+    }
+    WGPURenderPipeline pipeline = createSingleRenderPipe(&impl->state, &impl->shaderModule, &impl->bglayout, &impl->layout);
+    insertPipeline(impl, &impl->state, pipeline);
+    return pipeline;
+}
+
+static void prewarmState(uint32_t shaderID, const ModifiablePipelineState* state){
+    ShaderImpl* impl = GetShaderImplByID(shaderID);
+    if(PipelineHashMap_get(&impl->pipelineCache, *state) != NULL || findPendingJob(shaderID, state) >= 0){
+        return;
+    }
+    #if PIPELINE_BACKGROUND_CREATION == 1 && RG_HAS_THREADS == 1
+    if(startPipelineWorker()){
+        PipelineJob* job = callocnew(PipelineJob);
+        job->shaderID = shaderID;
+        job->state = ModifiablePipelineState_copy(*state);
+        job->shaderModule = impl->shaderModule;
+        job->bglayout = impl->bglayout;
+        job->layout = impl->layout;
+        referenceJobObjects(job, true);
+        PipelineJobVector_push_back(&g_pipelineWarmup.pending, job);
+        rg_queue_push(&g_pipelineWarmup.jobs, job);
+        return;
+    }
+    #endif
+    insertPipeline(impl, state, createSingleRenderPipe(state, &impl->shaderModule, &impl->bglayout, &impl->layout));
+}
+
+void PrewarmShaderVariants(Shader shader, const RenderSettings* settings, const PrimitiveType* primitiveTypes, uint32_t count){
+    ModifiablePipelineState state = GetShaderImpl(shader)->state;
+    for(uint32_t i = 0;i < count;i++){
+        state.settings = settings[i];
+        state.primitiveType = primitiveTypes[i];
+        prewarmState(shader.id, &state);
+    }
+}
+
+void PrewarmRecordedPipelineStates(Shader shader){
+    const uint64_t sourceHash = GetShaderImpl(shader)->shaderModule.sourceHash;
+    for(size_t i = 0;i < g_pipelineWarmup.loaded.size;i++){
+        if(g_pipelineWarmup.loaded.data[i].sourceHash == sourceHash){
+            prewarmState(shader.id, &g_pipelineWarmup.loaded.data[i].state);
+        }
+    }
+}
+
+static uint32_t pipelineStatesLayout(){
+    return (uint32_t)(sizeof(RenderSettings) | (sizeof(ColorAttachmentState) << 10) | (sizeof(AttributeAndResidence) << 20));
+}
+
+typedef struct PipelineStatesHeader{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t layout;
+    uint32_t count;
+}PipelineStatesHeader;
+
+bool SavePipelineStates(const char* path){
+    FILE* file = fopen(path, "wb");
+    if(file == NULL){
+        TRACELOG(LOG_WARNING, "Could not open %s for writing pipeline states", path);
+        return false;
+    }
+    const PipelineStatesHeader header = {PIPELINE_STATES_MAGIC, PIPELINE_STATES_VERSION, pipelineStatesLayout(), (uint32_t)g_pipelineWarmup.created.size};
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1;
+    for(size_t i = 0;ok && i < g_pipelineWarmup.created.size;i++){
+        const RecordedPipelineState* rs = g_pipelineWarmup.created.data + i;
+        const uint32_t primitiveType = (uint32_t)rs->state.primitiveType;
+        ok = fwrite(&rs->sourceHash, sizeof(rs->sourceHash), 1, file) == 1 &&
+             fwrite(&primitiveType, sizeof(primitiveType), 1, file) == 1 &&
+             fwrite(&rs->state.settings, sizeof(RenderSettings), 1, file) == 1 &&
+             fwrite(&rs->state.colorAttachmentState, sizeof(ColorAttachmentState), 1, file) == 1 &&
+             fwrite(&rs->state.vertexAttributeCount, sizeof(uint32_t), 1, file) == 1 &&
+             fwrite(rs->state.vertexAttributes, sizeof(AttributeAndResidence), rs->state.vertexAttributeCount, file) == rs->state.vertexAttributeCount;
+    }
+    ok = (fclose(file) == 0) && ok;
+    if(!ok){
+        TRACELOG(LOG_WARNING, "Failed writing pipeline states to %s", path);
+    }
+    return ok;
+}
+
+bool LoadPipelineStates(const char* path){
+    FILE* file = fopen(path, "rb");
+    if(file == NULL){
+        return false;
+    }
+    PipelineStatesHeader header;
+    bool ok = fread(&header, sizeof(header), 1, file) == 1 && header.magic == PIPELINE_STATES_MAGIC &&
+              header.version == PIPELINE_STATES_VERSION && header.layout == pipelineStatesLayout();
+    for(uint32_t i = 0;ok && i < header.count;i++){
+        RecordedPipelineState rs = {0};
+        uint32_t primitiveType;
+        ok = fread(&rs.sourceHash, sizeof(rs.sourceHash), 1, file) == 1 &&
+             fread(&primitiveType, sizeof(primitiveType), 1, file) == 1 &&
+             fread(&rs.state.settings, sizeof(RenderSettings), 1, file) == 1 &&
+             fread(&rs.state.colorAttachmentState, sizeof(ColorAttachmentState), 1, file) == 1 &&
+             fread(&rs.state.vertexAttributeCount, sizeof(uint32_t), 1, file) == 1 &&
+             rs.state.vertexAttributeCount <= MAX_VERTEX_ATTRIBUTES;
+        if(!ok)break;
+        rs.state.primitiveType = (PrimitiveType)primitiveType;
+        rs.state.vertexAttributes = (AttributeAndResidence*)RL_CALLOC(rs.state.vertexAttributeCount ? rs.state.vertexAttributeCount : 1, sizeof(AttributeAndResidence));
+        ok = fread(rs.state.vertexAttributes, sizeof(AttributeAndResidence), rs.state.vertexAttributeCount, file) == rs.state.vertexAttributeCount;
+        if(ok && !containsState(&g_pipelineWarmup.loaded, rs.sourceHash, &rs.state)){
+            RecordedPipelineStateVector_push_back(&g_pipelineWarmup.loaded, rs);
+        }
+        else{
+            ModifiablePipelineState_free(rs.state);
+        }
+    }
+    fclose(file);
+    if(!ok){
+        TRACELOG(LOG_WARNING, "Pipeline state file %s is corrupt or outdated, ignoring the rest of it", path);
+    }
+    return ok;
+}
+
+// end file src/pipeline_cache.c
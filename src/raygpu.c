@@ -46,8 +46,10 @@
     #define DrawTextEx w__DrawTextEx
     #define ShowCursor w__ShowCursor
     #define AdapterType w__AdapterType
+    #define CloseWindow w__CloseWindow
     #include <windows.h>
     #include <synchapi.h>
+    #undef CloseWindow
     #undef AdapterType
     #undef ShowCursor
     #undef LoadImage
@@ -98,6 +100,7 @@ void ToggleFullscreenImpl(cwoid);
 #ifdef __EMSCRIPTEN__
 #endif  // __EMSCRIPTEN__
 #include "internal_include/renderstate.h"
+#include "internal_include/rg_thread.h"
 
 VLAStack g_vlastack = {0};
 renderstate g_renderstate = {0};
@@ -142,14 +145,67 @@ void detectShaderLanguage(ShaderSources* sourcesPointer){
     }
 }
 
+typedef struct GIFFrame{
+    uint8_t* data;
+    uint32_t width, height;
+    size_t rowStrideInBytes;
+    bool bgra;
+}GIFFrame;
+
 typedef struct GIFRecordState{
     uint64_t delayInCentiseconds;
     uint64_t lastFrameTimestamp;
     MsfGifState msf_state;
     uint64_t numberOfFrames;
     bool recording;
+    bool begun;            // msf_gif_begin is deferred to the first frame, whose size is only known then
+    bool threaded;
+    rg_queue frames;       // Read back frames, waiting to be encoded by the worker
+    rg_thread encoder;
 }GIFRecordState;
 
+GIFRecordState* LoadGIFRecordState(){
+    return callocnew(GIFRecordState);
+}
+
+// Palettization and LZW compression are by far the most expensive part, they run on the encoder thread
+static void encodeGIFFrame(GIFRecordState* grst, GIFFrame* frame){
+    if(!grst->begun){
+        msf_gif_begin(&grst->msf_state, frame->width, frame->height);
+        grst->begun = true;
+    }
+    msf_gif_bgra_flag = frame->bgra;
+    msf_gif_frame(&grst->msf_state, frame->data, grst->delayInCentiseconds, 8, frame->rowStrideInBytes);
+    ++grst->numberOfFrames;
+    RL_FREE(frame->data);
+    RL_FREE(frame);
+}
+
+static void gifEncoderMain(void* arg){
+    GIFRecordState* grst = (GIFRecordState*)arg;
+    GIFFrame* frame;
+    while((frame = (GIFFrame*)rg_queue_pop(&grst->frames)) != NULL){
+        encodeGIFFrame(grst, frame);
+    }
+}
+
+static void onGIFReadback(Image image, void* userdata){
+    GIFRecordState* grst = (GIFRecordState*)userdata;
+    if(image.data == NULL || !grst->recording)return;
+    GIFFrame* frame = callocnew(GIFFrame);
+    const size_t size = image.rowStrideInBytes * image.height;
+    frame->data = (uint8_t*)RL_MALLOC(size);
+    memcpy(frame->data, image.data, size);
+    frame->width = image.width;
+    frame->height = image.height;
+    frame->rowStrideInBytes = image.rowStrideInBytes;
+    frame->bgra = image.format == PIXELFORMAT_UNCOMPRESSED_B8G8R8A8 || image.format == PIXELFORMAT_UNCOMPRESSED_B8G8R8A8_SRGB;
+    if(grst->threaded)
+        rg_queue_push(&grst->frames, frame);
+    else
+        encodeGIFFrame(grst, frame);
+}
+
 void startRecording(GIFRecordState* grst, uint64_t delayInCentiseconds){
     if(grst->recording){
         TRACELOG(LOG_WARNING, "Already recording");
@@ -158,29 +214,37 @@ void startRecording(GIFRecordState* grst, uint64_t delayInCentiseconds){
     else{
         grst->numberOfFrames = 0;
     }
-    msf_gif_bgra_flag = true;
     grst->msf_state = CLITERAL(MsfGifState){0};
+    grst->begun = false;
     grst->delayInCentiseconds = delayInCentiseconds;
-    msf_gif_begin(&grst->msf_state, GetScreenWidth(), GetScreenHeight());
+    grst->threaded = false;
+    #if RG_HAS_THREADS == 1
+    rg_queue_init(&grst->frames, 4);
+    grst->threaded = rg_thread_create(&grst->encoder, gifEncoderMain, grst);
+    if(!grst->threaded){
+        TRACELOG(LOG_WARNING, "Failed to start the GIF encoder thread, encoding on the main thread");
+        rg_queue_destroy(&grst->frames);
+    }
+    #endif
     grst->recording = true;
 }
 
-void addScreenshot(GIFRecordState* grst, WGPUTexture tex){
-    //#ifdef __EMSCRIPTEN__
-    //if(grst->numberOfFrames > 0)
-    //    msf_gif_frame(&grst->msf_state, (uint8_t*)fbLoad.data, grst->delayInCentiseconds, 8, fbLoad.rowStrideInBytes);
-    //#endif
+void addScreenshot(GIFRecordState* grst, Texture tex){
     grst->lastFrameTimestamp = NanoTime();
-    Image fb = LoadImageFromTextureEx(tex, 0);
-    ImageFormat(&fb, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
-    //#ifndef __EMSCRIPTEN__
-    msf_gif_frame(&grst->msf_state, (uint8_t*)fb.data, grst->delayInCentiseconds, 8, fb.rowStrideInBytes);
-    //#endif
-    UnloadImage(fb);
-    ++grst->numberOfFrames;
+    if(!RequestTextureReadback(tex, 0, onGIFReadback, grst)){
+        FlushReadbacks();
+        RequestTextureReadback(tex, 0, onGIFReadback, grst);
+    }
 }
 
 void endRecording(GIFRecordState* grst, const char* filename){
+    FlushReadbacks();
+    if(grst->threaded){
+        rg_queue_close(&grst->frames);
+        rg_thread_join(grst->encoder);
+        rg_queue_destroy(&grst->frames);
+        grst->threaded = false;
+    }
     MsfGifResult result = msf_gif_end(&grst->msf_state);
     
     if (result.data) {
@@ -229,9 +293,16 @@ void endRecording(GIFRecordState* grst, const char* filename){
     // Optionally clear the GIFRecordState structure
     memset(grst, 0, sizeof(GIFRecordState));
 }
+#if RENDERBATCH_COMPACT_VERTICES == 1
+vertex nextvertex;
+#else
 Vector2 nextuv;
 Vector3 nextnormal;
 Vector4 nextcol;
+#if RENDERBATCH_TEXTURE_ARRAY == 1
+uint32_t nexttexindex;
+#endif
+#endif
 vertex* vboptr = 0;
 vertex* vboptr_base = 0;
 #if SUPPORT_VULKAN_BACKEND == 1
@@ -243,6 +314,39 @@ PrimitiveType current_drawmode;
 //DescribedBuffer vbomap;
 
 #if RAYGPU_NO_INLINE_FUNCTIONS == 1
+#if RENDERBATCH_COMPACT_VERTICES == 1
+void rlColor4f(float r, float g, float b, float alpha){
+    nextvertex.col[0] = rlPackUnorm8(r);
+    nextvertex.col[1] = rlPackUnorm8(g);
+    nextvertex.col[2] = rlPackUnorm8(b);
+    nextvertex.col[3] = rlPackUnorm8(alpha);
+}
+void rlColor4ub(uint8_t r, uint8_t g, uint8_t b, uint8_t a){
+    nextvertex.col[0] = r;
+    nextvertex.col[1] = g;
+    nextvertex.col[2] = b;
+    nextvertex.col[3] = a;
+}
+void rlTexCoord2f(float u, float v){
+    nextvertex.uv[0] = rlPackUnorm16(u);
+    nextvertex.uv[1] = rlPackUnorm16(v);
+}
+void rlNormal3f(float x, float y, float z){
+    nextvertex.normal[0] = rlPackSnorm8(x);
+    nextvertex.normal[1] = rlPackSnorm8(y);
+    nextvertex.normal[2] = rlPackSnorm8(z);
+}
+void rlVertex3f(float x, float y, float z){
+    nextvertex.pos = CLITERAL(Vector3){x, y, z};
+    *(vboptr++) = nextvertex;
+    if(UNLIKELY(vboptr - vboptr_base >= (ptrdiff_t)RENDERBATCH_SIZE)){
+        drawCurrentBatch();
+    }
+}
+void rlVertex2f(float x, float y){
+    rlVertex3f(x, y, 0);
+}
+#else
 void rlColor4f(float r, float g, float b, float alpha){
     nextcol.x = r;
     nextcol.y = g;
@@ -255,9 +359,6 @@ void rlColor4ub(uint8_t r, uint8_t g, uint8_t b, uint8_t a){
     nextcol.z = ((float)((int)b)) / 255.0f;
     nextcol.w = ((float)((int)a)) / 255.0f;
 }
-void rlColor3f(float r, float g, float b){
-    rlColor4f(r, g, b, 1.0f);
-}
 
 void rlTexCoord2f(float u, float v){
     nextuv.x = u;
@@ -265,7 +366,7 @@ void rlTexCoord2f(float u, float v){
 }
 
 void rlVertex2f(float x, float y){
-    *(vboptr++) = CLITERAL(vertex){{x, y, 0}, nextuv, nextnormal, nextcol};
+    *(vboptr++) = CLITERAL(vertex){{x, y, 0}, nextuv, nextnormal, nextcol RL_NEXT_TEXINDEX};
     if(UNLIKELY(vboptr - vboptr_base >= (ptrdiff_t)RENDERBATCH_SIZE)){
         drawCurrentBatch();
     }
@@ -276,16 +377,35 @@ void rlNormal3f(float x, float y, float z){
     nextnormal.z = z;
 }
 void rlVertex3f(float x, float y, float z){
-    *(vboptr++) = CLITERAL(vertex){{x, y, z}, nextuv, nextnormal, nextcol};
+    *(vboptr++) = CLITERAL(vertex){{x, y, z}, nextuv, nextnormal, nextcol RL_NEXT_TEXINDEX};
     if(UNLIKELY(vboptr - vboptr_base >= (ptrdiff_t)RENDERBATCH_SIZE)){
         drawCurrentBatch();
     }
 }
 #endif
+void rlColor3f(float r, float g, float b){
+    rlColor4f(r, g, b, 1.0f);
+}
+#endif
+RGAPI void rlTextureIndex(uint32_t layer){
+    #if RENDERBATCH_TEXTURE_ARRAY == 1
+    #if RENDERBATCH_COMPACT_VERTICES == 1
+    nextvertex.texIndex = layer;
+    #else
+    nexttexindex = layer;
+    #endif
+    #else
+    (void)layer;
+    #endif
+}
 RGAPI VertexArray* LoadVertexArray(){
     VertexArray* ret = callocnew(VertexArray);
     return ret;
 }
+RGAPI void UnloadVertexArray(VertexArray* array){
+    VertexArray_Destroy(array);
+    RL_FREE(array);
+}
 RGAPI void VertexAttribPointer(VertexArray* array, DescribedBuffer* buffer, uint32_t attribLocation, RGVertexFormat format, uint32_t offset, RGVertexStepMode stepmode){
     VertexArray_add(array, buffer, attribLocation, format, offset, stepmode);
 }
@@ -293,9 +413,18 @@ RGAPI void BindVertexArray(VertexArray* va){
     BindShaderVertexArray(GetActiveShader(), va);
 }
 
+static void setShaderVertexAttributes(ShaderImpl* impl, const VertexArray* va){
+    if(impl->ownedVertexAttributes){
+        // Pipeline caches and jobs hold their own copies of the state
+        RL_FREE(impl->ownedVertexAttributes);
+        impl->ownedVertexAttributes = NULL;
+    }
+    impl->state.vertexAttributes = va->attributes;
+    impl->state.vertexAttributeCount = va->attributes_count;
+}
+
 RGAPI void BindShaderVertexArray(Shader shader, VertexArray* va){
-    GetShaderImpl(shader)->state.vertexAttributes = va->attributes;
-    GetShaderImpl(shader)->state.vertexAttributeCount = va->attributes_count;
+    setShaderVertexAttributes(GetShaderImpl(shader), va);
 
     for(unsigned i = 0; i < va->buffers_count; i++){
         bool shouldBind = false;
@@ -315,7 +444,7 @@ RGAPI void BindShaderVertexArray(Shader shader, VertexArray* va){
 
         if(shouldBind){
             const BufferEntry* bufferPair = va->buffers + i;
-            RenderPassSetVertexBuffer(GetActiveRenderPass(), i, bufferPair->buffer, 0);
+            RenderPassSetVertexBuffer(GetActiveRenderPass(), i, bufferPair->buffer, bufferPair->offset);
         } else {
             TRACELOG(LOG_DEBUG, "Buffer slot %u not bound (no enabled attributes use it).", i);
         }
@@ -367,6 +496,51 @@ RGAPI void DrawArraysInstanced(PrimitiveType drawMode, uint32_t vertexCount, uin
     
     RenderPassDraw(GetActiveRenderPass(), vertexCount, instanceCount, 0, 0);
 }
+// Draw a range of shared vertex and index buffers, as laid out by a MeshArena
+RGAPI void DrawArraysIndexedRange(PrimitiveType drawMode, DescribedBuffer* indexBuffer, uint32_t firstIndex, uint32_t indexCount, int32_t baseVertex, uint32_t instanceCount, uint32_t firstInstance){
+    Shader activeShader = GetActiveShader();
+    ShaderImpl* activeShaderImpl = GetShaderImpl(activeShader);
+    BindShader(activeShader, drawMode);
+
+    if(activeShaderImpl->bindGroup.needsUpdate){
+        RenderPassSetBindGroup(GetActiveRenderPass(), 0, &activeShaderImpl->bindGroup);
+    }
+    RenderPassSetIndexBuffer(GetActiveRenderPass(), indexBuffer, IndexFormat_Uint32, 0);
+    RenderPassDrawIndexed(GetActiveRenderPass(), indexCount, instanceCount, firstIndex, baseVertex, firstInstance);
+}
+RGAPI void DrawArraysRange(PrimitiveType drawMode, uint32_t firstVertex, uint32_t vertexCount, uint32_t instanceCount, uint32_t firstInstance){
+    Shader activeShader = GetActiveShader();
+    ShaderImpl* activeShaderImpl = GetShaderImpl(activeShader);
+    BindShader(activeShader, drawMode);
+
+    if(activeShaderImpl->bindGroup.needsUpdate){
+        RenderPassSetBindGroup(GetActiveRenderPass(), 0, &activeShaderImpl->bindGroup);
+    }
+    RenderPassDraw(GetActiveRenderPass(), vertexCount, instanceCount, firstVertex, firstInstance);
+}
+// The arguments are read from indirectBuffer on the GPU, laid out like the parameters of DrawArraysRange
+RGAPI void DrawArraysIndirect(PrimitiveType drawMode, DescribedBuffer* indirectBuffer, uint64_t indirectOffset){
+    Shader activeShader = GetActiveShader();
+    ShaderImpl* activeShaderImpl = GetShaderImpl(activeShader);
+    BindShader(activeShader, drawMode);
+
+    if(activeShaderImpl->bindGroup.needsUpdate){
+        RenderPassSetBindGroup(GetActiveRenderPass(), 0, &activeShaderImpl->bindGroup);
+    }
+    RenderPassDrawIndirect(GetActiveRenderPass(), indirectBuffer, indirectOffset);
+}
+// Like DrawArraysIndirect, with the arguments of DrawArraysIndexedRange
+RGAPI void DrawArraysIndexedIndirect(PrimitiveType drawMode, DescribedBuffer* indexBuffer, DescribedBuffer* indirectBuffer, uint64_t indirectOffset){
+    Shader activeShader = GetActiveShader();
+    ShaderImpl* activeShaderImpl = GetShaderImpl(activeShader);
+    BindShader(activeShader, drawMode);
+
+    if(activeShaderImpl->bindGroup.needsUpdate){
+        RenderPassSetBindGroup(GetActiveRenderPass(), 0, &activeShaderImpl->bindGroup);
+    }
+    RenderPassSetIndexBuffer(GetActiveRenderPass(), indexBuffer, IndexFormat_Uint32, 0);
+    RenderPassDrawIndexedIndirect(GetActiveRenderPass(), indirectBuffer, indirectOffset);
+}
 
 RGAPI Texture GetDepthTexture(){
     return RenderTexture_stack_cpeek(&g_renderstate.renderTargetStack)->texture;
@@ -375,27 +549,49 @@ RGAPI Texture GetMultisampleColorTarget(){
     return RenderTexture_stack_cpeek(&g_renderstate.renderTargetStack)->colorMultisample;
 }
 
+static uint32_t texture0Location(Shader shader){
+    uint32_t texture0loc = GetShaderImpl(shader)->defaultLocations[RGDefaultUniform_Texture0];
+    return texture0loc == LOCATION_NOT_FOUND ? 1 : texture0loc;
+}
+
+static void recordDeferredBatch(size_t vertexCount){
+    Deferred2DState* state = &g_renderstate.deferred2D;
+    Shader activeShader = GetActiveShader();
+    Deferred2DCommand command = {
+        .layer = state->layer,
+        .shader = activeShader,
+        .mode = current_drawmode,
+        .texture = (current_drawmode != RL_LINES) ? GetShaderImpl(activeShader)->bindGroup.entries[texture0Location(activeShader)].textureView
+                 : g_renderstate.textureArrayMode ? g_renderstate.whitePixelArray.view : g_renderstate.whitePixel.view,
+        .sequence = (uint32_t)state->commands.size,
+        .firstVertex = (uint32_t)state->vertices.size,
+        .vertexCount = (uint32_t)vertexCount,
+    };
+    const size_t required = state->vertices.size + vertexCount;
+    if(required > state->vertices.capacity && VertexVector_reserve(&state->vertices, required + (required >> 1)) != 0){
+        TRACELOG(LOG_ERROR, "Failed to grow the deferred 2D vertex storage, dropping %u vertices", (unsigned)vertexCount);
+        return;
+    }
+    memcpy(state->vertices.data + state->vertices.size, vboptr_base, vertexCount * sizeof(vertex));
+    state->vertices.size += vertexCount;
+    Deferred2DCommandVector_push_back(&state->commands, command);
+    state->lastStats.recordedVertices += (uint32_t)vertexCount;
+}
+
 RGAPI void drawCurrentBatch(){
     size_t vertexCount = vboptr - vboptr_base;
     if(vertexCount == 0)return;
-    #if SUPPORT_VULKAN_BACKEND == 8
-    DescribedBuffer* vbo = UpdateVulkanRenderbatch();
-    constexpr bool allocated_via_pool = false;
-    #else
-    DescribedBuffer* vbo = NULL;
-    bool allocated_via_pool = false;
-    if(vertexCount < VERTEX_BUFFER_CACHE_SIZE && !DescribedBufferVector_empty(&g_renderstate.smallBufferPool)){
-        allocated_via_pool = true;
-        vbo = g_renderstate.smallBufferPool.data[g_renderstate.smallBufferPool.size - 1];
-        DescribedBufferVector_pop_back(&g_renderstate.smallBufferPool);
-        wgpuQueueWriteBuffer(GetQueue(), (WGPUBuffer)vbo->buffer, 0, vboptr_base, vertexCount * sizeof(vertex));
-    }
-    else{
-        vbo = GenVertexBuffer(vboptr_base, vertexCount * sizeof(vertex));
+    if(g_renderstate.deferred2D.active){
+        recordDeferredBatch(vertexCount);
+        vboptr = vboptr_base;
+        return;
     }
-    #endif
+    // Streamed into this frame's vertex ring, the flush only records an offset
+    uint64_t vboOffset = 0;
+    DescribedBuffer* vbo = VertexStreamPush(vboptr_base, vertexCount * sizeof(vertex), &vboOffset);
 
     renderBatchVAO->buffers[0].buffer = vbo;
+    renderBatchVAO->buffers[0].offset = vboOffset;
     SetStorageBuffer(3, g_renderstate.identityMatrix);
     Shader activeShader = GetActiveShader();
     ShaderImpl* activeShaderImpl = GetShaderImpl(activeShader);
@@ -404,7 +600,8 @@ RGAPI void drawCurrentBatch(){
         case RL_LINES:{
 
             //TODO: Line texturing is currently disable in all DrawLine... functions
-            SetTexture(1, g_renderstate.whitePixel);
+            if(!g_renderstate.textureArrayMode)
+                SetTexture(1, g_renderstate.whitePixel);
             BindShaderVertexArray(activeShader, renderBatchVAO);
             BindShader(activeShader, RL_LINES);
             DrawArrays(RL_LINES, vertexCount);
@@ -425,10 +622,12 @@ RGAPI void drawCurrentBatch(){
         } break;
         case RL_QUADS:{
             const size_t quadCount = vertexCount / 4;
-            if(g_renderstate.quadindicesCache->size < 6 * quadCount * sizeof(uint32_t)){
-                uint32_t* indices = (uint32_t*)RL_CALLOC(6 * quadCount, sizeof(uint32_t));
+            // Created on the first quad flush, large enough for a full batch
+            if(g_renderstate.quadindicesCache == NULL || g_renderstate.quadindicesCache->size < 6 * quadCount * sizeof(uint32_t)){
+                const size_t indexedQuads = quadCount > RENDERBATCH_SIZE / 4 ? quadCount : RENDERBATCH_SIZE / 4;
+                uint32_t* indices = (uint32_t*)RL_CALLOC(6 * indexedQuads, sizeof(uint32_t));
                 if(indices){
-                    for(size_t i = 0;i < quadCount;i++){
+                    for(size_t i = 0;i < indexedQuads;i++){
                         indices[i * 6 + 0] = (i * 4 + 0);
                         indices[i * 6 + 1] = (i * 4 + 1);
                         indices[i * 6 + 2] = (i * 4 + 3);
@@ -436,11 +635,16 @@ RGAPI void drawCurrentBatch(){
                         indices[i * 6 + 4] = (i * 4 + 2);
                         indices[i * 6 + 5] = (i * 4 + 3);
                     }
-                    BufferData(g_renderstate.quadindicesCache, indices, 6 * quadCount * sizeof(uint32_t));
+                    if(g_renderstate.quadindicesCache == NULL){
+                        g_renderstate.quadindicesCache = GenIndexBuffer(indices, 6 * indexedQuads * sizeof(uint32_t));
+                    }else{
+                        BufferData(g_renderstate.quadindicesCache, indices, 6 * indexedQuads * sizeof(uint32_t));
+                    }
                     RL_FREE(indices);
                 }
                 else{
                     TRACELOG(LOG_ERROR, "Failed to allocated space for index buffer");
+                    break;
                 }
             }
             const DescribedBuffer* ibuf = g_renderstate.quadindicesCache;
@@ -451,16 +655,163 @@ RGAPI void drawCurrentBatch(){
         } break;
         default:break;
     }
-    if(!allocated_via_pool){
-        #if SUPPORT_VULKAN_BACKEND == 8
-        PushUsedBuffer(vbo->buffer);
-        #endif
-        UnloadBuffer(vbo);
+    vboptr = vboptr_base;
+}
+
+static int compareDeferred2DSubmission(const void* a, const void* b){
+    const Deferred2DCommand* x = (const Deferred2DCommand*)a;
+    const Deferred2DCommand* y = (const Deferred2DCommand*)b;
+    if(x->layer != y->layer) return x->layer < y->layer ? -1 : 1;
+    return x->sequence < y->sequence ? -1 : (x->sequence > y->sequence);
+}
+
+static int compareDeferred2DCommands(const void* a, const void* b){
+    const Deferred2DCommand* x = (const Deferred2DCommand*)a;
+    const Deferred2DCommand* y = (const Deferred2DCommand*)b;
+    if(x->layer != y->layer) return x->layer < y->layer ? -1 : 1;
+    if(x->shader.id != y->shader.id) return x->shader.id < y->shader.id ? -1 : 1;
+    if(x->mode != y->mode) return x->mode < y->mode ? -1 : 1;
+    if(x->textureOrder != y->textureOrder) return x->textureOrder < y->textureOrder ? -1 : 1;
+    return x->sequence < y->sequence ? -1 : (x->sequence > y->sequence);
+}
+
+// Textures are ordered by their first use within the layer rather than by handle, so the output is deterministic
+static void assignDeferred2DTextureOrder(Deferred2DState* state){
+    qsort(state->commands.data, state->commands.size, sizeof(Deferred2DCommand), compareDeferred2DSubmission);
+    uint32_t nextOrder = 0;
+    for(size_t i = 0;i < state->commands.size;i++){
+        Deferred2DCommand* command = state->commands.data + i;
+        if(i == 0 || command->layer != command[-1].layer){
+            ++state->layerRuns;
+            nextOrder = 0;
+        }
+        Deferred2DTextureSlot* slot = Deferred2DTextureOrderMap_get(&state->textureOrder, command->texture);
+        if(slot == NULL || slot->layerRun != state->layerRuns){
+            Deferred2DTextureSlot fresh = {.layerRun = state->layerRuns, .order = nextOrder++};
+            Deferred2DTextureOrderMap_put(&state->textureOrder, command->texture, fresh);
+            command->textureOrder = fresh.order;
+        }else{
+            command->textureOrder = slot->order;
+        }
     }
-    else{
-        DescribedBufferVector_push_back(&g_renderstate.smallBufferRecyclingBin, vbo);
+}
+
+RGAPI void BeginDeferred2D(){
+    Deferred2DState* state = &g_renderstate.deferred2D;
+    if(state->active){
+        TRACELOG(LOG_WARNING, "BeginDeferred2D called while already recording");
+        return;
     }
-    vboptr = vboptr_base;
+    drawCurrentBatch();
+    state->active = true;
+    state->layer = 0;
+    // Entries of destroyed views are never removed, bound the map by starting over
+    if(state->textureOrder.current_size > 1024){
+        Deferred2DTextureOrderMap_free(&state->textureOrder);
+    }
+    Deferred2DCommandVector_clear(&state->commands);
+    VertexVector_clear(&state->vertices);
+    state->lastStats = CLITERAL(Deferred2DStats){0};
+}
+
+RGAPI void SetDeferred2DLayer(int layer){
+    if(g_renderstate.deferred2D.layer == layer)return;
+    drawCurrentBatch();
+    g_renderstate.deferred2D.layer = layer;
+}
+
+// Sorts and draws the recorded commands, the caller clears state->active first so drawCurrentBatch submits
+static void replayDeferred2D(Deferred2DState* state){
+    state->lastStats.recordedBatches += (uint32_t)state->commands.size;
+    if(state->commands.size == 0)return;
+
+    assignDeferred2DTextureOrder(state);
+    qsort(state->commands.data, state->commands.size, sizeof(Deferred2DCommand), compareDeferred2DCommands);
+
+    const Shader originalShader = GetActiveShader();
+    const PrimitiveType originalMode = current_drawmode;
+    const WGPUTextureView originalTexture = GetShaderImpl(originalShader)->bindGroup.entries[texture0Location(originalShader)].textureView;
+    uint32_t emitted = 0;
+
+    for(size_t i = 0;i < state->commands.size;){
+        const Deferred2DCommand* first = state->commands.data + i;
+        // Consecutive commands sharing shader, primitive and texture collapse into one draw,
+        // strips cannot be concatenated
+        size_t end = i + 1;
+        if(first->mode != RL_TRIANGLE_STRIP){
+            while(end < state->commands.size &&
+                  state->commands.data[end].shader.id == first->shader.id &&
+                  state->commands.data[end].mode == first->mode &&
+                  state->commands.data[end].texture == first->texture){
+                ++end;
+            }
+        }
+        if(GetActiveShader().id != first->shader.id){
+            BeginShaderMode(first->shader);
+        }
+        Shader activeShader = GetActiveShader();
+        SetBindgroupTextureView(&GetShaderImpl(activeShader)->bindGroup, texture0Location(activeShader), first->texture);
+        current_drawmode = first->mode;
+        for(size_t c = i;c < end;c++){
+            const vertex* src = state->vertices.data + state->commands.data[c].firstVertex;
+            size_t remaining = state->commands.data[c].vertexCount;
+            while(remaining > 0){
+                size_t space = RENDERBATCH_SIZE - (size_t)(vboptr - vboptr_base);
+                size_t n = remaining < space ? remaining : space;
+                memcpy(vboptr, src, n * sizeof(vertex));
+                vboptr += n;
+                src += n;
+                remaining -= n;
+                if(vboptr - vboptr_base >= (ptrdiff_t)RENDERBATCH_SIZE){
+                    drawCurrentBatch();
+                    ++emitted;
+                }
+            }
+        }
+        if(vboptr != vboptr_base){
+            drawCurrentBatch();
+            ++emitted;
+        }
+        i = end;
+    }
+
+    if(GetActiveShader().id != originalShader.id){
+        if(originalShader.id == g_renderstate.defaultShader.id)
+            EndShaderMode();
+        else
+            BeginShaderMode(originalShader);
+    }
+    SetBindgroupTextureView(&GetShaderImpl(originalShader)->bindGroup, texture0Location(originalShader), originalTexture);
+    current_drawmode = originalMode;
+    state->lastStats.emittedDrawCalls += emitted;
+    Deferred2DCommandVector_clear(&state->commands);
+    VertexVector_clear(&state->vertices);
+}
+
+RGAPI void EndDeferred2D(){
+    Deferred2DState* state = &g_renderstate.deferred2D;
+    if(!state->active){
+        TRACELOG(LOG_WARNING, "EndDeferred2D called without BeginDeferred2D");
+        return;
+    }
+    drawCurrentBatch();
+    state->active = false;
+    replayDeferred2D(state);
+}
+
+// Camera, blend, viewport and render target changes are not part of a recorded command,
+// so they draw everything recorded so far and recording continues afterwards
+static void flushDeferred2D(){
+    Deferred2DState* state = &g_renderstate.deferred2D;
+    if(!state->active)return;
+    drawCurrentBatch();
+    state->active = false;
+    replayDeferred2D(state);
+    state->active = true;
+}
+
+RGAPI Deferred2DStats GetDeferred2DStats(){
+    return g_renderstate.deferred2D.lastStats;
 }
 
 void LoadIdentity(void) {
@@ -496,11 +847,8 @@ void adaptRenderPass(DescribedRenderpass* drp, const ModifiablePipelineState* se
 void FillReflectionInfo(DescribedShaderModule* module){
 
 }
-DescribedShaderModule LoadShaderModuleWGSL(ShaderSources sources) {
-    
-    DescribedShaderModule ret = {0};
-    #if SUPPORT_WGPU_BACKEND == 1 || SUPPORT_WGPU_BACKEND == 0
-
+#if SUPPORT_WGPU_BACKEND == 1 || SUPPORT_WGPU_BACKEND == 0
+static void createModulesWGSL(ShaderSources sources, DescribedShaderModule* ret){
     rassert(sources.language == sourceTypeWGSL, "Source language must be wgsl for this function");
     
     for(uint32_t i = 0;i < sources.sourceCount;i++){
@@ -523,36 +871,62 @@ DescribedShaderModule LoadShaderModuleWGSL(ShaderSources sources) {
         
         for(uint32_t i = 0;i < RGShaderStageEnum_EnumCount;++i){
             if(((uint32_t)(sourceStageMask)) & (1u << i)){
-                ret.stages[i].module = module;
-            }
-        }
-        
-        EntryPointSet entryPoints = getEntryPointsWGSL((const char*)sources.sources[i].data);
-        for(uint32_t i = 0;i < RGShaderStageEnum_EnumCount;i++){
-            //rassert(entryPoints[i].second.size() < 15, "Entrypoint name must be shorter than 15 characters");
-            if(entryPoints.names[i][0] == '\0'){
-                continue;
-            }
-            char* dest = ret.reflectionInfo.ep[i].name;
-            memcpy(dest, entryPoints.names[i], MAX_SHADER_ENTRYPOINT_NAME_LENGTH + 1);
-            if(dest[MAX_SHADER_ENTRYPOINT_NAME_LENGTH] != '\0'){
-                printf("%s\n", ret.reflectionInfo.ep[i].name);
+                ret->stages[i].module = module;
             }
-            assert(dest[MAX_SHADER_ENTRYPOINT_NAME_LENGTH] == '\0');
-            dest[MAX_SHADER_ENTRYPOINT_NAME_LENGTH] = '\0';
         }
     }
-    ret.reflectionInfo.attributes = getAttributesWGSL(sources);
-    ret.reflectionInfo.uniforms = getBindingsWGSL(sources);
-    #elif SUPPORT_VULKAN_BACKEND == 1 && SUPPORT_WGSL_PARSER == 1
-    ShaderSources spirvSources = wgsl_to_spirv(sources);
-    ret = LoadShaderModuleSPIRV(spirvSources);
+}
+#endif
+
+DescribedShaderModule LoadShaderModuleWGSL(ShaderSources sources) {
     
-    ret.reflectionInfo.uniforms = callocnew(StringToUniformMap);
-    ret.reflectionInfo.attributes = CLITERAL(InOutAttributeInfo){0};
-    ret.reflectionInfo.uniforms = getBindings(sources);
-    ret.reflectionInfo.attributes = getAttributesWGSL(sources);
+    DescribedShaderModule ret = {0};
+    ShaderSources cachedSpirv = {0};
+    ShaderReflectionInfo cachedReflection = {0};
+    const bool cached = ShaderCacheLoad(sources, &cachedSpirv, &cachedReflection);
+    #if SUPPORT_WGPU_BACKEND == 1 || SUPPORT_WGPU_BACKEND == 0
+    createModulesWGSL(sources, &ret);
+    if(cached){
+        ret.reflectionInfo = cachedReflection;
+    }
+    else{
+        ret.reflectionInfo = getReflectionInfoWGSL(sources);
+        // WGSL is consumed natively here, only the reflection is worth caching
+        ShaderCacheStore(sources, CLITERAL(ShaderSources){0}, &ret.reflectionInfo);
+    }
+    #elif SUPPORT_VULKAN_BACKEND == 1 && SUPPORT_WGSL_PARSER == 1
+    if(cached){
+        ret = LoadShaderModuleSPIRVReflected(cachedSpirv, &cachedReflection);
+    }
+    else{
+        ShaderSources spirvSources = wgsl_to_spirv(sources);
+        ret = LoadShaderModuleSPIRV(spirvSources);
+        ShaderReflectionInfo reflection = getReflectionInfoWGSL(sources);
+        ret.reflectionInfo.uniforms = reflection.uniforms;
+        ret.reflectionInfo.attributes = reflection.attributes;
+        ShaderCacheStore(sources, spirvSources, &ret.reflectionInfo);
+    }
     #endif
+    ShaderCacheFreeSources(&cachedSpirv);
+    ret.sourceHash = ShaderSourcesHash(sources);
+    return ret;
+}
+
+// Device objects only: SPIR-V (if the backend needs it) and reflection were produced beforehand, e.g. by LoadShadersBatch
+DescribedShaderModule LoadShaderModulePrepared(ShaderSources sources, ShaderSources spirv, ShaderReflectionInfo reflection){
+    DescribedShaderModule ret = {0};
+    if(spirv.sourceCount > 0){
+        ret = LoadShaderModuleSPIRVReflected(spirv, &reflection);
+    }
+    else{
+        #if SUPPORT_WGPU_BACKEND == 1 || SUPPORT_WGPU_BACKEND == 0
+        createModulesWGSL(sources, &ret);
+        ret.reflectionInfo = reflection;
+        #else
+        TRACELOG(LOG_ERROR, "This backend requires SPIR-V for every shader module");
+        #endif
+    }
+    ret.sourceHash = ShaderSourcesHash(sources);
     return ret;
 }
 
@@ -615,7 +989,7 @@ RGAPI void BeginShaderMode(Shader shader){
         BeginRenderpass();
     }
     g_renderstate.activeShader = shader;
-    uint32_t location = GetUniformLocation(shader, RL_DEFAULT_SHADER_UNIFORM_NAME_PROJECTION_VIEW);
+    uint32_t location = GetUniformLocationByHandle(shader, RGDefaultUniform_ProjectionView);
     if(location != LOCATION_NOT_FOUND){
         SetUniformBufferData(location, &MatrixBufferPair_stack_peek(&g_renderstate.matrixStack)->matrix, sizeof(Matrix));
     }
@@ -638,6 +1012,7 @@ RGAPI void DisableDepthTest(cwoid){
     g_renderstate.currentSettings.depthTest = 0;
 }
 RGAPI void BeginBlendMode(rlBlendMode blendMode) {
+    flushDeferred2D();
     // Get a reference to the blend state part of the current settings
     RGBlendState* blendState = &g_renderstate.currentSettings.blendState;
     
@@ -819,6 +1194,7 @@ RGAPI void rlOrtho(double left, double right, double bottom, double top, double
 }
 
 RGAPI void rlViewport(int x, int y, int width, int height){
+    flushDeferred2D();
     DescribedRenderpass* pass = GetActiveRenderPass();
     if (pass && pass->rpEncoder) {
         wgpuRenderPassEncoderSetViewport(pass->rpEncoder, (float)x, (float)y, (float)width, (float)height, 0.0f, 1.0f);
@@ -868,7 +1244,7 @@ RGAPI void rlPopMatrix(void) {
 
         MatrixBufferPair* newTop = MatrixBufferPair_stack_peek(&g_renderstate.matrixStack);
         if (newTop != NULL) {
-            uint32_t location = GetUniformLocation(GetActiveShader(), RL_DEFAULT_SHADER_UNIFORM_NAME_PROJECTION_VIEW);
+            uint32_t location = GetUniformLocationByHandle(GetActiveShader(), RGDefaultUniform_ProjectionView);
             if (location != LOCATION_NOT_FOUND) {
                 SetUniformBufferData(location, &newTop->matrix, sizeof(Matrix));
             }
@@ -878,24 +1254,28 @@ RGAPI void rlPopMatrix(void) {
     }
 }
 RGAPI void EndBlendMode(void){
+    flushDeferred2D();
     g_renderstate.currentSettings.blendState = GetDefaultSettings().blendState;
 }
 RGAPI void BeginMode2D(Camera2D camera){
+    flushDeferred2D();
     drawCurrentBatch();
     Matrix mat = GetCameraMatrix2D(camera);
     mat = MatrixMultiply(ScreenMatrix(g_renderstate.renderExtentX, g_renderstate.renderExtentY), mat);
     PushMatrix();
     SetMatrix(mat);
-    uint32_t uniformLoc = GetUniformLocation(GetActiveShader(), RL_DEFAULT_SHADER_UNIFORM_NAME_PROJECTION_VIEW);
+    uint32_t uniformLoc = GetUniformLocationByHandle(GetActiveShader(), RGDefaultUniform_ProjectionView);
     SetUniformBufferData(uniformLoc, &mat, sizeof(Matrix));
 }
 RGAPI void EndMode2D(){
+    flushDeferred2D();
     drawCurrentBatch();
     PopMatrix();
     //g_renderstate.activeScreenMatrix = ScreenMatrix(g_renderstate.renderExtentX, g_renderstate.renderExtentY);
-    SetUniformBufferData(GetUniformLocation(GetActiveShader(), RL_DEFAULT_SHADER_UNIFORM_NAME_PROJECTION_VIEW), GetMatrixPtr(), sizeof(Matrix));
+    SetUniformBufferData(GetUniformLocationByHandle(GetActiveShader(), RGDefaultUniform_ProjectionView), GetMatrixPtr(), sizeof(Matrix));
 }
 RGAPI void BeginMode3D(Camera3D camera){
+    flushDeferred2D();
     drawCurrentBatch();
     Matrix mat = GetCameraMatrix3D(camera, (float)(g_renderstate.renderExtentX) / g_renderstate.renderExtentY);
     //g_renderstate.activeScreenMatrix = mat;
@@ -904,6 +1284,7 @@ RGAPI void BeginMode3D(Camera3D camera){
     SetUniformBufferData(0, &mat, sizeof(Matrix));
 }
 RGAPI void EndMode3D(){
+    flushDeferred2D();
     drawCurrentBatch();
     
     //g_renderstate.activeScreenMatrix = ScreenMatrix(g_renderstate.renderExtentX, g_renderstate.renderExtentY);
@@ -1095,7 +1476,7 @@ RGAPI void BeginDrawing(){
     SetUniformBufferData(0, GetMatrixPtr(), sizeof(Matrix));
     
     if(IsKeyPressed(KEY_F2) && (IsKeyDown(KEY_LEFT_CONTROL) || IsKeyDown(KEY_RIGHT_CONTROL) || true)){
-        if(g_renderstate.grst->recording){
+        if(g_renderstate.grst != NULL && g_renderstate.grst->recording){
             EndGIFRecording();
         }
         else{
@@ -1114,67 +1495,22 @@ RGAPI void EndDrawing(){
     if(g_renderstate.activeRenderpass){    
         EndRenderpassEx(g_renderstate.activeRenderpass);
     }
-    if(g_renderstate.windowFlags & FLAG_STDOUT_TO_FFMPEG){
-        Image img = LoadImageFromTextureEx((WGPUTexture)GetActiveColorTarget(), 0);
-        if (img.format != PIXELFORMAT_UNCOMPRESSED_B8G8R8A8 && img.format != PIXELFORMAT_UNCOMPRESSED_R8G8B8A8) {
-            // Handle unsupported formats or convert as necessary
-            fprintf(stderr, "Unsupported pixel format for FFmpeg export.\n");
-            // You might want to convert the image to a supported format here
-            // For simplicity, we'll skip exporting in this case
-            return;
-        }
-        ImageFormat(&img, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
-
-        // Calculate the total size of the image data to write
-        size_t totalSize = img.rowStrideInBytes * img.height;
-
-        // Write the image data to stdout (FFmpeg should be reading from stdin)
-        size_t fmtsize = GetPixelSizeInBytes(img.format);
-        char offset[1];
-        //fwrite(offset, 1, 1, stdout);
-        for(size_t i = 0;i < img.height;i++){
-            unsigned char* dptr = (unsigned char*)(img.data) + i * img.rowStrideInBytes;
-            //for(uint32_t r = 0;r < img.width;r++){
-            //    RGBA8Color c = reinterpret_cast<RGBA8Color*>(dptr)[r];
-            //    std::cerr << (int)c.a << "\n";
-            //    reinterpret_cast<RGBA8Color*>(dptr)[r] = RGBA8Color{c.a, c.b, c.g, c.r};
-            //}
-            size_t bytesWritten = fwrite(dptr, 1, img.width * fmtsize, stdout);
-        }
-
-        // Flush stdout to ensure all data is sent to FFmpeg promptly
-        fflush(stdout);
-        UnloadImage(img);
+    PollReadbacks();
+    if(IsFrameCaptureActive()){
+        CaptureFrame(RenderTexture_stack_cpeek(&g_renderstate.renderTargetStack)->texture, g_renderstate.frameBufferFormat);
     }
-    if(g_renderstate.grst->recording){
+    if(g_renderstate.grst != NULL && g_renderstate.grst->recording){
         uint64_t stmp = NanoTime();
         if(stmp - g_renderstate.grst->lastFrameTimestamp > g_renderstate.grst->delayInCentiseconds * 10000000ull){
             RenderTexture_stack_peek(&g_renderstate.renderTargetStack)->texture.format = g_renderstate.frameBufferFormat;
-            
-            Texture fbCopy = LoadTextureEx(
-                RenderTexture_stack_cpeek(&g_renderstate.renderTargetStack)->texture.width,
-                RenderTexture_stack_cpeek(&g_renderstate.renderTargetStack)->texture.height,
-                g_renderstate.frameBufferFormat,
-                false
-            );
-            BeginComputepass();
-            ComputepassEndOnlyComputing();
-            CopyTextureToTexture(RenderTexture_stack_cpeek(&g_renderstate.renderTargetStack)->texture, fbCopy);
-            EndComputepass();
-            BeginRenderpass();
-            int recordingTextX = GetScreenWidth() - MeasureText("Recording", 30);
-            DrawText("Recording", recordingTextX, 5, 30, CLITERAL(Color){255,40,40,255});
-            EndRenderpass();
-            addScreenshot(g_renderstate.grst, (WGPUTexture)fbCopy.id);
-            UnloadTexture(fbCopy);
+            // The readback copy is submitted before the overlay below, so it never shows up in the GIF
+            addScreenshot(g_renderstate.grst, RenderTexture_stack_cpeek(&g_renderstate.renderTargetStack)->texture);
             g_renderstate.grst->lastFrameTimestamp = stmp;
         }
-        else{
-            BeginRenderpass();
-            int recordingTextX = GetScreenWidth() - MeasureText("Recording", 30);
-            DrawText("Recording", recordingTextX, 5, 30, CLITERAL(Color){255,40,40,255});
-            EndRenderpass();
-        }
+        BeginRenderpass();
+        int recordingTextX = GetScreenWidth() - MeasureText("Recording", 30);
+        DrawText("Recording", recordingTextX, 5, 30, CLITERAL(Color){255,40,40,255});
+        EndRenderpass();
         
         
     }
@@ -1191,12 +1527,6 @@ RGAPI void EndDrawing(){
     else{
         DummySubmitOnQueue();
     }
-    DescribedBufferVector* from = &g_renderstate.smallBufferRecyclingBin;
-    DescribedBufferVector* to   = &g_renderstate.smallBufferPool;
-    for(size_t i = 0;i < DescribedBufferVector_size(from);i++){
-        DescribedBufferVector_push_back(to, *DescribedBufferVector_get(from, i));
-    }
-    DescribedBufferVector_clear(from);
 
     window_input_state* ipstate = &CreatedWindowMap_get(&g_renderstate.createdSubwindows, g_renderstate.window)->input_state;
     
@@ -1227,15 +1557,22 @@ RGAPI void EndDrawing(){
     uint64_t beginframe_stmp = g_renderstate.last_timestamps[(g_renderstate.total_frames - 1) % 64];
     ++g_renderstate.total_frames;
     g_renderstate.last_timestamps[g_renderstate.total_frames % 64] = (int64_t)NanoTime();
+    BindGroupCacheEndFrame();
+    PollPipelineCreation();
+    StreamingRingsEndFrame();
     uint64_t elapsed = NanoTime() - beginframe_stmp;
     if(elapsed & (1ull << 63))return;
     NanoWait(nanosecondsPerFrame - elapsed);
     RenderTexture_stack_pop(&g_renderstate.renderTargetStack);
 }
 void StartGIFRecording(){
+    if(g_renderstate.grst == NULL){
+        g_renderstate.grst = LoadGIFRecordState();
+    }
     startRecording(g_renderstate.grst, 4);
 }
 void EndGIFRecording(){
+    if(g_renderstate.grst == NULL)return;
     #ifndef __EMSCRIPTEN__
     if(!g_renderstate.grst->recording)return;
     char buf[32] = {0};
@@ -1262,7 +1599,10 @@ void rlBegin(PrimitiveType mode){
         //BeginRenderpassEx(&g_renderstate.renderpass);
     }
     if(mode == RL_LINES){ //TODO: Fix this, why is this required? Check core_msaa and comment this out to trigger a bug
-        SetTexture(1, g_renderstate.whitePixel);
+        if(g_renderstate.textureArrayMode)
+            rlTextureIndex(RL_TEXTURE_INDEX_NONE);
+        else
+            SetTexture(1, g_renderstate.whitePixel);
     }
     current_drawmode = mode;
 }
@@ -1894,7 +2234,8 @@ Shader LoadShaderSingleSource(const char* shaderSource){
     src->data = shaderSource;
     src->sizeInBytes = strlen(shaderSource);
     src->stageMask = WGPUShaderStage_Vertex | WGPUShaderStage_Fragment;
-    StringToUniformMap* bindings = getBindings(sources);
+    DescribedShaderModule module = LoadShaderModuleWGSL(sources);
+    StringToUniformMap* bindings = module.reflectionInfo.uniforms;
     for(size_t i = 0; i < bindings->current_capacity;i++){
         StringToUniformMap_kv_pair* kvp = bindings->table + i;
         if(kvp->key.length != 0){
@@ -1909,7 +2250,7 @@ Shader LoadShaderSingleSource(const char* shaderSource){
     //memcpy(test.name, testname, strlen(testname) + 1);
     //ResourceTypeDescriptor* rtd = StringToUniformMap_get(bindings, test);
     
-    InOutAttributeInfo attribs = getAttributes(sources);
+    InOutAttributeInfo attribs = module.reflectionInfo.attributes;
     
     AttributeAndResidence allAttribsInOneBuffer[MAX_VERTEX_ATTRIBUTES];
     const uint32_t attributeCount = attribs.vertexAttributeCount;
@@ -1930,20 +2271,9 @@ Shader LoadShaderSingleSource(const char* shaderSource){
         };
         offset += attributeSize(format);
     }
-    ResourceTypeDescriptor* values = (ResourceTypeDescriptor*)RL_CALLOC(bindings->current_size, sizeof(ResourceTypeDescriptor));
-    uint32_t insertIndex = 0;
-    for(uint32_t i = 0;i < bindings->current_capacity;i++){
-        if(bindings->table[i].key.length != 0){
-            values[insertIndex++] = bindings->table[i].value;
-        }
-    }
-    
-    quickSort_ResourceTypeDescriptor(values, values + bindings->current_size);
-    DescribedShaderModule module = LoadShaderModuleWGSL(sources);
-    if(module.reflectionInfo.uniforms == NULL){
-        module.reflectionInfo.uniforms = bindings;
-    }
-    Shader ret = LoadPipelineFromModule(module, allAttribsInOneBuffer, attributeCount, values, insertIndex, GetDefaultSettings());
+    uint32_t uniformCount = 0;
+    ResourceTypeDescriptor* values = flattenUniformMap(bindings, &uniformCount);
+    Shader ret = LoadPipelineFromModule(module, allAttribsInOneBuffer, attributeCount, values, uniformCount, GetDefaultSettings());
     
     RL_FREE(values);
     //StringToUniformMap_free(bindings);
@@ -1976,23 +2306,94 @@ Shader rlLoadShaderCode(const char* vertexCode, const char* fragmentCode){
 uint32_t rlGetShaderIdDefault(){
     return DefaultShader().id;
 }
-RGAPI uint32_t GetUniformLocation(Shader shader, const char* uniformName){
-    ShaderImpl* impl = GetShaderImpl(shader);
+static BindingIdentifier uniformIdentifier(const char* uniformName){
     BindingIdentifier identifier = {
         .length = (uint32_t)strlen(uniformName)
     };
     rassert(identifier.length <= MAX_BINDING_NAME_LENGTH, "Identifier too long");
     memcpy(identifier.name, uniformName, identifier.length < MAX_BINDING_NAME_LENGTH ? identifier.length : MAX_BINDING_NAME_LENGTH);
+    return identifier;
+}
+static uint32_t lookupUniformLocation(const ShaderImpl* impl, BindingIdentifier identifier){
     const ResourceTypeDescriptor* desc = StringToUniformMap_get(impl->shaderModule.reflectionInfo.uniforms, identifier);
     return desc ? desc->location : LOCATION_NOT_FOUND;
 }
+RGAPI uint32_t GetUniformLocation(Shader shader, const char* uniformName){
+    return lookupUniformLocation(GetShaderImpl(shader), uniformIdentifier(uniformName));
+}
+
+static inline uint32_t copyUniformNameHandle(const uint32_t handle){return handle;}
+static inline void deleteUniformNameHandle(const uint32_t handle){}
+RG_DEFINE_GENERIC_HASH_MAP(static inline, UniformNameMap, BindingIdentifier, uint32_t, hashBindingIdentifier, hashBindingCompare, CLITERAL(BindingIdentifier){0}, copyBindingIdentifier, copyUniformNameHandle, deleteBindingIdentifier, deleteUniformNameHandle)
+DEFINE_VECTOR_IW(static inline, BindingIdentifier, BindingIdentifierVector)
+
+// Same order as RGDefaultUniform
+static const char* const defaultUniformNames[RGDefaultUniform_EnumCount] = {
+    RL_DEFAULT_SHADER_SAMPLER2D_NAME_TEXTURE0,
+    RL_DEFAULT_SHADER_SAMPLER2D_NAME_TEXTURE1,
+    RL_DEFAULT_SHADER_SAMPLER2D_NAME_TEXTURE2,
+    RL_DEFAULT_SHADER_UNIFORM_NAME_PROJECTION_VIEW,
+    RL_DEFAULT_SHADER_UNIFORM_NAME_INSTANCE_TX,
+    RL_DEFAULT_SHADER_UNIFORM_NAME_MVP,
+    RL_DEFAULT_SHADER_UNIFORM_NAME_VIEW,
+    RL_DEFAULT_SHADER_UNIFORM_NAME_PROJECTION,
+    RL_DEFAULT_SHADER_UNIFORM_NAME_MODEL,
+    RL_DEFAULT_SHADER_UNIFORM_NAME_NORMAL,
+    RL_DEFAULT_SHADER_UNIFORM_NAME_COLOR,
+    RL_DEFAULT_SHADER_UNIFORM_NAME_BONE_MATRICES,
+};
+static UniformNameMap g_uniformNameHandles;
+static BindingIdentifierVector g_uniformNames; // Handle -> name
+#define LOCATION_UNRESOLVED 0xFFFFFFFFu
+
+RGAPI UniformNameHandle GetUniformNameHandle(const char* uniformName){
+    if(g_uniformNames.size == 0){
+        UniformNameMap_init(&g_uniformNameHandles);
+        for(uint32_t i = 0;i < RGDefaultUniform_EnumCount;i++){
+            const BindingIdentifier identifier = uniformIdentifier(defaultUniformNames[i]);
+            UniformNameMap_put(&g_uniformNameHandles, identifier, i);
+            BindingIdentifierVector_push_back(&g_uniformNames, identifier);
+        }
+    }
+    const BindingIdentifier identifier = uniformIdentifier(uniformName);
+    const uint32_t* existing = UniformNameMap_get(&g_uniformNameHandles, identifier);
+    if(existing){
+        return *existing;
+    }
+    const UniformNameHandle handle = (UniformNameHandle)g_uniformNames.size;
+    UniformNameMap_put(&g_uniformNameHandles, identifier, handle);
+    BindingIdentifierVector_push_back(&g_uniformNames, identifier);
+    return handle;
+}
+
+void ResolveDefaultUniformLocations(ShaderImpl* impl){
+    for(uint32_t i = 0;i < RGDefaultUniform_EnumCount;i++){
+        impl->defaultLocations[i] = lookupUniformLocation(impl, uniformIdentifier(defaultUniformNames[i]));
+    }
+}
+
+RGAPI uint32_t GetUniformLocationByHandle(Shader shader, UniformNameHandle name){
+    ShaderImpl* impl = GetShaderImpl(shader);
+    if(name < RGDefaultUniform_EnumCount){
+        return impl->defaultLocations[name];
+    }
+    rassert(name < g_uniformNames.size, "Invalid uniform name handle %u", name);
+    const uint32_t index = name - RGDefaultUniform_EnumCount;
+    if(index >= impl->namedLocationCount){
+        const uint32_t newCount = (uint32_t)g_uniformNames.size - RGDefaultUniform_EnumCount;
+        impl->namedLocations = (uint32_t*)RL_REALLOC(impl->namedLocations, newCount * sizeof(uint32_t));
+        for(uint32_t i = impl->namedLocationCount;i < newCount;i++){
+            impl->namedLocations[i] = LOCATION_UNRESOLVED;
+        }
+        impl->namedLocationCount = newCount;
+    }
+    if(impl->namedLocations[index] == LOCATION_UNRESOLVED){
+        impl->namedLocations[index] = lookupUniformLocation(impl, g_uniformNames.data[name]);
+    }
+    return impl->namedLocations[index];
+}
 RGAPI uint32_t GetComputeShaderLocation(DescribedComputePipeline* shader, const char* uniformName){
-    BindingIdentifier identifier = {
-        .length = (uint32_t)strlen(uniformName)
-    };
-    rassert(identifier.length <= MAX_BINDING_NAME_LENGTH, "Identifier too short");
-    memcpy(identifier.name, uniformName, identifier.length < MAX_BINDING_NAME_LENGTH ? identifier.length : MAX_BINDING_NAME_LENGTH);
-    const ResourceTypeDescriptor* desc = StringToUniformMap_get(shader->shaderModule.reflectionInfo.uniforms, identifier);
+    const ResourceTypeDescriptor* desc = StringToUniformMap_get(shader->shaderModule.reflectionInfo.uniforms, uniformIdentifier(uniformName));
     return desc ? desc->location : LOCATION_NOT_FOUND;
 }
 
@@ -2082,6 +2483,7 @@ Texture3D LoadTexture3DEx(uint32_t width, uint32_t height, uint32_t depth, Pixel
 
 
 WGPUBindGroup UpdateAndGetNativeBindGroup(DescribedBindGroup* bg){
+    RefreshDynamicUploads(bg);
     if(bg->needsUpdate){
         UpdateBindGroup(bg);
         bg->needsUpdate = false;
@@ -2097,9 +2499,7 @@ const char* copyString(const char* str){
 }
 
 void PrepareShader(Shader shader, VertexArray* va){
-    ShaderImpl* impl = GetShaderImpl(shader);
-    impl->state.vertexAttributes = va->attributes;
-    impl->state.vertexAttributeCount = va->attributes_count;
+    setShaderVertexAttributes(GetShaderImpl(shader), va);
 }
 
 const char mipmapComputerSource[] =
@@ -2553,14 +2953,94 @@ void SaveImage(Image img_in, const char* filepath){
     UnloadImage(img);
 }
 
+#if RENDERBATCH_TEXTURE_ARRAY == 1
+static uint32_t textureArrayLayerOf(Texture tex){
+    const Texture2DArray* array = &g_renderstate.activeTextureArray;
+    for(uint32_t i = 0;i < array->layerCount;i++){
+        if(array->layerAliases[i] == tex.view){
+            return i;
+        }
+    }
+    return RL_TEXTURE_INDEX_NONE;
+}
+
+// Unaliased textures (e.g. the default font) are drawn through the default shader until an aliased one is used again
+static void suspendTextureArrayMode(){
+    drawCurrentBatch();
+    g_renderstate.textureArrayMode = false;
+    g_renderstate.textureArraySuspended = true;
+    EndShaderMode();
+}
+
+static void resumeTextureArrayMode(){
+    drawCurrentBatch();
+    BeginShaderMode(g_renderstate.textureArrayShader);
+    g_renderstate.textureArraySuspended = false;
+    g_renderstate.textureArrayMode = true;
+}
+#endif
+
+RGAPI void BeginTextureArrayMode(Texture2DArray array){
+    #if RENDERBATCH_TEXTURE_ARRAY == 1
+    if(!g_renderstate.textureArrayShaderLoaded){
+        ShaderBatchResult loaded;
+        if(!LoadBuiltinShader(BuiltinShader_TextureArray, &loaded)){
+            TRACELOG(LOG_ERROR, "Texture array shader failed to load: %s", loaded.diagnostics);
+            return;
+        }
+        g_renderstate.textureArrayShader = loaded.shader;
+        SetShaderSampler(g_renderstate.textureArrayShader, 2, g_renderstate.defaultSampler);
+        // Lines bind the white pixel in place of the texture, the array shader needs it as a one layer array
+        const uint8_t white[4] = {255, 255, 255, 255};
+        g_renderstate.whitePixelArray = LoadTextureArray(1, 1, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+        UpdateTextureArrayLayer(g_renderstate.whitePixelArray, 0, white);
+        g_renderstate.textureArrayShaderLoaded = true;
+    }
+    BeginShaderMode(g_renderstate.textureArrayShader);
+    Shader shader = g_renderstate.textureArrayShader;
+    SetBindgroupTextureView(&GetShaderImpl(shader)->bindGroup, texture0Location(shader), array.view);
+    g_renderstate.activeTextureArray = array;
+    g_renderstate.textureArrayMode = true;
+    g_renderstate.textureArraySuspended = false;
+    rlTextureIndex(RL_TEXTURE_INDEX_NONE);
+    #else
+    (void)array;
+    TRACELOG(LOG_ERROR, "BeginTextureArrayMode requires RENDERBATCH_TEXTURE_ARRAY");
+    #endif
+}
+
+RGAPI void EndTextureArrayMode(){
+    if(!g_renderstate.textureArrayMode && !g_renderstate.textureArraySuspended)return;
+    drawCurrentBatch();
+    g_renderstate.textureArrayMode = false;
+    g_renderstate.textureArraySuspended = false;
+    EndShaderMode();
+}
+
 void UseTexture(Texture tex){
     Shader activeShader = GetActiveShader();
     ShaderImpl* activeShaderImpl = GetShaderImpl(activeShader);
-    uint32_t texture0loc = GetUniformLocation(activeShader, RL_DEFAULT_SHADER_SAMPLER2D_NAME_TEXTURE0);
-    if(texture0loc == LOCATION_NOT_FOUND){
-        texture0loc = 1;
-        //return;
+    #if RENDERBATCH_TEXTURE_ARRAY == 1
+    if(g_renderstate.textureArrayMode){
+        const uint32_t layer = textureArrayLayerOf(tex);
+        if(layer != RL_TEXTURE_INDEX_NONE || tex.view == g_renderstate.whitePixel.view){
+            rlTextureIndex(layer);
+            return;
+        }
+        suspendTextureArrayMode();
+        activeShader = GetActiveShader();
+        activeShaderImpl = GetShaderImpl(activeShader);
+    }
+    else if(g_renderstate.textureArraySuspended){
+        const uint32_t layer = textureArrayLayerOf(tex);
+        if(layer != RL_TEXTURE_INDEX_NONE){
+            resumeTextureArrayMode();
+            rlTextureIndex(layer);
+            return;
+        }
     }
+    #endif
+    uint32_t texture0loc = texture0Location(activeShader);
     if(activeShaderImpl->bindGroup.entries[texture0loc].textureView == tex.view)return;
     drawCurrentBatch();
     SetTexture(texture0loc, tex);
@@ -2613,7 +3093,7 @@ void BeginTextureAndPipelineMode(RenderTexture rtex, Shader pl){
     SetMatrix(mat);
 
     g_renderstate.activeShader = pl;
-    uint32_t location = GetUniformLocation(g_renderstate.activeShader, RL_DEFAULT_SHADER_UNIFORM_NAME_PROJECTION_VIEW);
+    uint32_t location = GetUniformLocationByHandle(g_renderstate.activeShader, RGDefaultUniform_ProjectionView);
     if(location != LOCATION_NOT_FOUND){
         SetUniformBufferData(location, &MatrixBufferPair_stack_cpeek(&g_renderstate.matrixStack)->matrix, sizeof(Matrix));
     }
@@ -2621,6 +3101,7 @@ void BeginTextureAndPipelineMode(RenderTexture rtex, Shader pl){
 }
 
 void BeginTextureMode(RenderTexture rtex){
+    flushDeferred2D();
     if(g_renderstate.activeRenderpass){
         EndRenderpass();
     }
@@ -2636,6 +3117,7 @@ void BeginTextureMode(RenderTexture rtex){
 }
 
 void EndTextureAndPipelineMode(){
+    flushDeferred2D();
     drawCurrentBatch();
     EndRenderpassPro(GetActiveRenderPass(), true);
     RenderTexture_stack_pop(&g_renderstate.renderTargetStack);
@@ -2651,6 +3133,7 @@ void EndTextureAndPipelineMode(){
 }
 
 void EndTextureMode(){
+    flushDeferred2D();
     drawCurrentBatch();
     EndRenderpassPro(GetActiveRenderPass(), true);
     RenderTexture_stack_pop(&g_renderstate.renderTargetStack);
@@ -2750,6 +3233,7 @@ EntryPointSet                                           getEntryPointsWGSL_Tint
 InOutAttributeInfo                                      getAttributesWGSL       (ShaderSources sources);
 StringToUniformMap*                                     getBindingsWGSL         (ShaderSources sources);
 EntryPointSet                                           getEntryPointsWGSL      (const char* shaderSourceWGSL);
+ShaderReflectionInfo                                    getReflectionInfoWGSL_Simple(ShaderSources sources);
 
 InOutAttributeInfo getAttributesWGSL(ShaderSources sources) {
 #if defined(SUPPORT_TINT_WGSL_PARSER) && (SUPPORT_TINT_WGSL_PARSER == 1)
@@ -2775,6 +3259,25 @@ EntryPointSet getEntryPointsWGSL(const char* shaderSourceWGSL) {
 #endif
 }
 
+ShaderReflectionInfo getReflectionInfoWGSL(ShaderSources sources) {
+#if defined(SUPPORT_TINT_WGSL_PARSER) && (SUPPORT_TINT_WGSL_PARSER == 1)
+    ShaderReflectionInfo info = {0};
+    for(uint32_t i = 0;i < sources.sourceCount;i++){
+        EntryPointSet eps = getEntryPointsWGSL_Tint((const char*)sources.sources[i].data);
+        for(uint32_t stage = 0;stage < RGShaderStageEnum_EnumCount;stage++){
+            if(eps.names[stage][0] == '\0')continue;
+            info.ep[stage].stage = (RGShaderStageEnum)stage;
+            strncpy(info.ep[stage].name, eps.names[stage], sizeof(info.ep[stage].name) - 1);
+        }
+    }
+    info.attributes = getAttributesWGSL_Tint(sources);
+    info.uniforms = getBindingsWGSL_Tint(sources);
+    return info;
+#else
+    return getReflectionInfoWGSL_Simple(sources);
+#endif
+}
+
 
 InOutAttributeInfo getAttributes(ShaderSources sources){
     
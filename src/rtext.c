@@ -138,8 +138,9 @@ bool isGpuReady = true;
 
 #if defined(SUPPORT_DEFAULT_FONT)
 // Default font provided by raylib
-// NOTE: Default font is loaded on InitWindow() and disposed on CloseWindow() [module: core]
+// NOTE: Default font is loaded on first use by GetFontDefault() and disposed on CloseWindow() [module: core]
 static Font defaultFont = { 0 };
+static bool defaultFontLoaded = false;
 #endif
 
 //----------------------------------------------------------------------------------
@@ -213,6 +214,7 @@ bool IsFileExtension(const char *fileName, const char *ext)
 // Load raylib default font
 extern void LoadFontDefault(void)
 {
+    defaultFontLoaded = true;
     int dsize = 0;
     int deflsize = 0;
     uint8_t *telegrama_render_dump = calloc(100000, 1);
@@ -376,16 +378,21 @@ extern void LoadFontDefault(void)
 // Unload raylib default font
 extern void UnloadFontDefault(void)
 {
+    if (!defaultFontLoaded) return;
     for (int i = 0; i < defaultFont.glyphCount; i++) UnloadImage(defaultFont.glyphs[i].image);
     if (isGpuReady) UnloadTexture(defaultFont.texture);
     free(defaultFont.glyphs);
     free(defaultFont.recs);
+    defaultFont = (Font){ 0 };
+    defaultFontLoaded = false;
 }
 #endif      // SUPPORT_DEFAULT_FONT
 // Get the default font, useful to be used with extended parameters
 Font GetFontDefault()
 {
 #if defined(SUPPORT_DEFAULT_FONT)
+    // Applications that never draw text don't pay for decoding and uploading the atlas
+    if (!defaultFontLoaded) LoadFontDefault();
     return defaultFont;
 #else
     Font font = { 0 };
@@ -1032,7 +1039,11 @@ void UnloadFontData(GlyphInfo *glyphs, int glyphCount)
 void UnloadFont(Font font)
 {
     // NOTE: Make sure font is not default font (fallback)
+#if defined(SUPPORT_DEFAULT_FONT)
+    if (font.texture.id != defaultFont.texture.id)
+#else
     if (font.texture.id != GetFontDefault().texture.id)
+#endif
     {
         UnloadFontData(font.glyphs, font.glyphCount);
         if (isGpuReady) UnloadTexture(font.texture);
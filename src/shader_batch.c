@@ -0,0 +1,295 @@
+// begin file src/shader_batch.c
+// Batched shader loading. The CPU side of every shader (GLSL -> SPIR-V, WGSL lowering, reflection and the
+// on-disk shader cache) runs on a pool of worker threads. Shader modules and pipelines are then created
+// on the calling thread in input order, since not every backend allows concurrent device object creation.
+
+#include <raygpu.h>
+#include <string.h>
+#include <stdio.h>
+#include "internal_include/internals.h"
+#include "internal_include/rg_thread.h"
+
+typedef struct ShaderBatchItem{
+    ShaderSources sources;
+    ShaderSources spirv;             // Empty when the backend consumes the sources natively
+    ShaderReflectionInfo reflection;
+    bool prepared;
+}ShaderBatchItem;
+
+typedef struct ShaderBatchWork{
+    ShaderBatchItem* items;
+    ShaderBatchResult* results;
+    uint32_t count;
+    uint32_t next;
+    rg_mutex mutex;
+}ShaderBatchWork;
+
+static const char* shaderStageName(uint32_t stage){
+    switch(stage){
+        case RGShaderStageEnum_Vertex: return "vertex";
+        case RGShaderStageEnum_Fragment: return "fragment";
+        case RGShaderStageEnum_Compute: return "compute";
+        default: return "unknown";
+    }
+}
+
+static uint32_t combinedStageMask(ShaderSources sources){
+    uint32_t mask = 0;
+    for(uint32_t i = 0;i < sources.sourceCount;i++){
+        mask |= (uint32_t)sources.sources[i].stageMask;
+    }
+    return mask;
+}
+
+static void freeReflection(ShaderReflectionInfo* reflection){
+    if(reflection->uniforms){
+        StringToUniformMap_free(reflection->uniforms);
+        RL_FREE(reflection->uniforms);
+        reflection->uniforms = NULL;
+    }
+}
+
+#if SUPPORT_GLSL_PARSER == 1
+// Stored with the cache entry, so that creating the module from a hit does not run SPIRV-Reflect again
+static void reflectEntryPointsSPIRV(ShaderSources spirv, ShaderReflectionInfo* reflection){
+    for(uint32_t i = 0;i < spirv.sourceCount;i++){
+        const EntryPointSet eps = getEntryPointsSPIRV((const uint32_t*)spirv.sources[i].data, spirv.sources[i].sizeInBytes / sizeof(uint32_t));
+        for(uint32_t stage = 0;stage < RGShaderStageEnum_EnumCount;stage++){
+            if(eps.names[stage][0] != '\0' && strlen(eps.names[stage]) < sizeof(reflection->ep[stage].name)){
+                reflection->ep[stage].stage = (RGShaderStageEnum)stage;
+                strcpy(reflection->ep[stage].name, eps.names[stage]);
+            }
+        }
+    }
+}
+#endif
+
+// Everything that only touches memory, safe to run on any thread. When knownReflection is given it is
+// returned in *reflection instead of reflecting the sources again, the caller keeps ownership of it.
+bool PrepareShaderSources(ShaderSources* sourcesInOut, const ShaderReflectionInfo* knownReflection, ShaderSources* spirv, ShaderReflectionInfo* reflection, ShaderBatchResult* result){
+    char* diag = result->diagnostics;
+    const size_t diagSize = sizeof(result->diagnostics);
+    if(sourcesInOut->sourceCount == 0 || sourcesInOut->sourceCount > RGShaderStageEnum_EnumCount){
+        snprintf(diag, diagSize, "Invalid source count %u", sourcesInOut->sourceCount);
+        return false;
+    }
+    for(uint32_t i = 0;i < sourcesInOut->sourceCount;i++){
+        if(sourcesInOut->sources[i].data == NULL || sourcesInOut->sources[i].sizeInBytes == 0){
+            snprintf(diag, diagSize, "Source %u is empty", i);
+            return false;
+        }
+    }
+    if(sourcesInOut->language == sourceTypeUnknown){
+        detectShaderLanguage(sourcesInOut);
+        if(sourcesInOut->language == sourceTypeUnknown){
+            snprintf(diag, diagSize, "Shader language not detectable: GLSL requires #version, WGSL a @binding or @location token");
+            return false;
+        }
+    }
+    ShaderSources sources = *sourcesInOut;
+
+    if(sources.language == sourceTypeSPIRV){
+        for(uint32_t i = 0;i < sources.sourceCount;i++){
+            if(sources.sources[i].sizeInBytes % sizeof(uint32_t) != 0 || *(const uint32_t*)sources.sources[i].data != 0x07230203){
+                snprintf(diag, diagSize, "Source %u is not a SPIR-V module", i);
+                return false;
+            }
+        }
+        if(knownReflection){
+            *reflection = *knownReflection;
+            return true;
+        }
+        reflection->uniforms = getBindingsSPIRV(sources);
+        reflection->attributes = getAttributesSPIRV(sources);
+        return true;
+    }
+    if(ShaderCacheLoad(sources, spirv, reflection)){
+        if(knownReflection){
+            freeReflection(reflection);
+            *reflection = *knownReflection;
+        }
+        return true;
+    }
+
+    switch(sources.language){
+        case sourceTypeGLSL:
+        #if SUPPORT_GLSL_PARSER == 1
+        if(!glsl_to_spirv_checked(sources, spirv, diag, diagSize)){
+            return false;
+        }
+        if(knownReflection){
+            *reflection = *knownReflection;
+            break;
+        }
+        reflection->uniforms = getBindingsGLSL(sources);
+        reflection->attributes = getAttributesGLSL(sources);
+        reflectEntryPointsSPIRV(*spirv, reflection);
+        break;
+        #else
+        snprintf(diag, diagSize, "Library was built without GLSL support, recompile with SUPPORT_GLSL_PARSER=1");
+        return false;
+        #endif
+        case sourceTypeWGSL:
+        #if SUPPORT_WGSL_PARSER == 1
+        *reflection = knownReflection ? *knownReflection : getReflectionInfoWGSL(sources);
+        for(uint32_t stage = 0;stage < RGShaderStageEnum_EnumCount;stage++){
+            if((combinedStageMask(sources) & (1u << stage)) && reflection->ep[stage].name[0] == '\0'){
+                snprintf(diag, diagSize, "No @%s entry point found", shaderStageName(stage));
+                if(!knownReflection)freeReflection(reflection);
+                return false;
+            }
+        }
+        #if !(SUPPORT_WGPU_BACKEND == 1 || SUPPORT_WGPU_BACKEND == 0) && SUPPORT_VULKAN_BACKEND == 1
+        *spirv = wgsl_to_spirv(sources);
+        for(uint32_t i = 0;i < spirv->sourceCount;i++){
+            if(spirv->sources[i].sizeInBytes == 0){
+                snprintf(diag, diagSize, "WGSL to SPIR-V translation failed for source %u", i);
+                ShaderCacheFreeSources(spirv);
+                if(!knownReflection)freeReflection(reflection);
+                return false;
+            }
+        }
+        #endif
+        break;
+        #else
+        snprintf(diag, diagSize, "Library was built without WGSL support, recompile with SUPPORT_WGSL_PARSER=1");
+        return false;
+        #endif
+        default:
+        snprintf(diag, diagSize, "Unsupported shader language %d", (int)sources.language);
+        return false;
+    }
+    ShaderCacheStore(sources, *spirv, reflection);
+    return true;
+}
+
+static void shaderBatchWorker(void* arg){
+    ShaderBatchWork* work = (ShaderBatchWork*)arg;
+    for(;;){
+        rg_mutex_lock(&work->mutex);
+        const uint32_t index = work->next < work->count ? work->next++ : work->count;
+        rg_mutex_unlock(&work->mutex);
+        if(index == work->count){
+            return;
+        }
+        ShaderBatchItem* item = work->items + index;
+        item->prepared = PrepareShaderSources(&item->sources, NULL, &item->spirv, &item->reflection, work->results + index);
+    }
+}
+
+// Device objects for sources prepared by PrepareShaderSources, the module takes the reflection
+bool CreateShaderFromPrepared(ShaderSources sources, ShaderSources spirv, ShaderReflectionInfo reflection, ShaderBatchResult* result){
+    if(sources.language == sourceTypeSPIRV){
+        spirv = sources;
+    }
+    DescribedShaderModule module = LoadShaderModulePrepared(sources, spirv, reflection);
+    const uint32_t stageMask = combinedStageMask(sources);
+    for(uint32_t stage = 0;stage < RGShaderStageEnum_EnumCount;stage++){
+        if((stageMask & (1u << stage)) && module.stages[stage].module == NULL){
+            snprintf(result->diagnostics, sizeof(result->diagnostics), "Device rejected the %s shader module", shaderStageName(stage));
+            return false;
+        }
+    }
+
+    uint32_t uniformCount = 0;
+    ResourceTypeDescriptor* uniforms = flattenUniformMap(module.reflectionInfo.uniforms, &uniformCount);
+    if(stageMask & (1u << RGShaderStageEnum_Compute)){
+        result->computePipeline = LoadComputePipelineFromModule(module, uniforms, uniformCount);
+    }
+    else{
+        // Ordered by location and packed into one buffer, like the single shader loaders
+        ReflectionVertexAttribute sorted[MAX_VERTEX_ATTRIBUTES];
+        const uint32_t attributeCount = module.reflectionInfo.attributes.vertexAttributeCount;
+        for(uint32_t i = 0;i < attributeCount;i++){
+            uint32_t j = i;
+            for(;j > 0 && sorted[j - 1].location > module.reflectionInfo.attributes.vertexAttributes[i].location;j--){
+                sorted[j] = sorted[j - 1];
+            }
+            sorted[j] = module.reflectionInfo.attributes.vertexAttributes[i];
+        }
+        AttributeAndResidence attributes[MAX_VERTEX_ATTRIBUTES];
+        uint32_t offset = 0;
+        for(uint32_t i = 0;i < attributeCount;i++){
+            attributes[i] = CLITERAL(AttributeAndResidence){
+                .attr = {
+                    .format = sorted[i].format,
+                    .offset = offset,
+                    .shaderLocation = sorted[i].location
+                },
+                .bufferSlot = 0,
+                .stepMode = RGVertexStepMode_Vertex,
+                .enabled = true
+            };
+            offset += attributeSize(sorted[i].format);
+        }
+        result->shader = LoadPipelineFromModule(module, attributes, attributeCount, uniforms, uniformCount, GetDefaultSettings());
+    }
+    RL_FREE(uniforms);
+    return true;
+}
+
+uint32_t LoadShadersBatch(const ShaderSources* sources, uint32_t count, ShaderBatchResult* results){
+    if(count == 0){
+        return 0;
+    }
+    ShaderBatchWork work = {
+        .items = (ShaderBatchItem*)RL_CALLOC(count, sizeof(ShaderBatchItem)),
+        .results = results,
+        .count = count,
+    };
+    for(uint32_t i = 0;i < count;i++){
+        work.items[i].sources = sources[i];
+        results[i] = CLITERAL(ShaderBatchResult){0};
+    }
+
+    // Lazy global initialization must not race between the workers
+    ShaderCacheEnabled();
+    #if SUPPORT_GLSL_PARSER == 1
+    glsl_initialize_process();
+    #endif
+
+    unsigned threadCount = rg_hardware_concurrency();
+    if(SHADER_BATCH_MAX_THREADS > 0 && threadCount > SHADER_BATCH_MAX_THREADS){
+        threadCount = SHADER_BATCH_MAX_THREADS;
+    }
+    if(threadCount > count){
+        threadCount = count;
+    }
+    rg_mutex_init(&work.mutex);
+    rg_thread threads[64];
+    uint32_t started = 0;
+    // The calling thread works too, so one fewer thread is spawned
+    while(RG_HAS_THREADS && started + 1 < threadCount && started < sizeof(threads) / sizeof(threads[0])){
+        if(!rg_thread_create(threads + started, shaderBatchWorker, &work)){
+            break;
+        }
+        ++started;
+    }
+    shaderBatchWorker(&work);
+    for(uint32_t i = 0;i < started;i++){
+        rg_thread_join(threads[i]);
+    }
+    rg_mutex_destroy(&work.mutex);
+
+    uint32_t successCount = 0;
+    for(uint32_t i = 0;i < count;i++){
+        ShaderBatchItem* item = work.items + i;
+        if(item->prepared){
+            results[i].success = CreateShaderFromPrepared(item->sources, item->spirv, item->reflection, results + i);
+        }
+        if(results[i].success){
+            ++successCount;
+        }
+        else{
+            TRACELOG(LOG_WARNING, "Batched shader %u failed to load: %s", i, results[i].diagnostics);
+            // On success the module owns the reflection
+            freeReflection(&item->reflection);
+        }
+        ShaderCacheFreeSources(&item->spirv);
+    }
+    RL_FREE(work.items);
+    TRACELOG(LOG_INFO, "Loaded %u of %u shaders in batch using %u threads", successCount, count, started + 1);
+    return successCount;
+}
+
+// end file src/shader_batch.c
@@ -0,0 +1,237 @@
+// begin file src/shader_cache.c
+// Content-addressed on-disk cache of shader compilation results.
+// Every entry is keyed by a hash over the source language, compiler version, stage masks and source bytes and stores
+// the SPIR-V words (if the backend needs them) together with the reflection info, so a cache hit
+// skips glslang / the WGSL frontend as well as the reflection parsers.
+
+#include <raygpu.h>
+#include <string.h>
+#include <stdio.h>
+#include "internal_include/internals.h"
+#include "internal_include/c_fs_utils.h"
+#if defined(_WIN32)
+    #include <direct.h>
+    #include <process.h>
+    #define rg_mkdir(path) _mkdir(path)
+    #define rg_getpid() _getpid()
+#else
+    #include <sys/types.h>
+    #define rg_mkdir(path) mkdir(path, 0755)
+    #define rg_getpid() getpid()
+#endif
+
+#define SHADER_CACHE_MAGIC 0x43534752u // "RGSC"
+#define SHADER_CACHE_VERSION 1u
+
+typedef struct ShaderCacheHeader{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t layout;       // Changes whenever one of the serialized structs changes size
+    uint32_t sourceCount;  // Number of SPIR-V stages that follow
+    uint64_t key;
+    uint64_t sourceBytes;  // Guards against hash collisions together with key
+}ShaderCacheHeader;
+
+static char g_shaderCacheDirectory[CFS_MAX_PATH];
+static bool g_shaderCacheConfigured = false;
+
+void SetShaderCacheDirectory(const char* directory){
+    g_shaderCacheConfigured = true;
+    g_shaderCacheDirectory[0] = '\0';
+    if(directory == NULL || directory[0] == '\0'){
+        return;
+    }
+    if(strlen(directory) + 32 >= sizeof(g_shaderCacheDirectory)){
+        TRACELOG(LOG_WARNING, "Shader cache directory path too long, shader cache disabled");
+        return;
+    }
+    if(!cfs_is_directory(directory) && rg_mkdir(directory) != 0){
+        TRACELOG(LOG_WARNING, "Could not create shader cache directory %s, shader cache disabled", directory);
+        return;
+    }
+    strcpy(g_shaderCacheDirectory, directory);
+}
+
+// The cache is off unless SetShaderCacheDirectory was called or RAYGPU_SHADER_CACHE_DIR is set.
+// The first call resolves the environment variable, so call it once before using the cache from several threads.
+bool ShaderCacheEnabled(){
+    if(!g_shaderCacheConfigured){
+        SetShaderCacheDirectory(getenv("RAYGPU_SHADER_CACHE_DIR"));
+    }
+    return g_shaderCacheDirectory[0] != '\0';
+}
+
+static uint64_t fnv1a(uint64_t h, const void* data, size_t size){
+    const uint8_t* bytes = (const uint8_t*)data;
+    for(size_t i = 0;i < size;i++){
+        h ^= bytes[i];
+        h *= 0x100000001b3ull;
+    }
+    return h;
+}
+
+static uint64_t shaderCacheKey(ShaderSources sources, uint64_t* sourceBytes){
+    uint64_t h = 0xcbf29ce484222325ull;
+    #if SUPPORT_VULKAN_BACKEND == 1
+    const uint32_t backend = 1;
+    #else
+    const uint32_t backend = 0;
+    #endif
+    h = fnv1a(h, &backend, sizeof(backend));
+    h = fnv1a(h, &sources.language, sizeof(sources.language));
+    #if SUPPORT_GLSL_PARSER == 1
+    // A glslang update can change the SPIR-V as well as the reflection
+    if(sources.language == sourceTypeGLSL){
+        const uint32_t compilerVersion = glsl_compiler_version();
+        h = fnv1a(h, &compilerVersion, sizeof(compilerVersion));
+    }
+    #endif
+    *sourceBytes = 0;
+    for(uint32_t i = 0;i < sources.sourceCount;i++){
+        const uint32_t stageMask = (uint32_t)sources.sources[i].stageMask;
+        h = fnv1a(h, &stageMask, sizeof(stageMask));
+        h = fnv1a(h, &sources.sources[i].sizeInBytes, sizeof(uint32_t));
+        h = fnv1a(h, sources.sources[i].data, sources.sources[i].sizeInBytes);
+        *sourceBytes += sources.sources[i].sizeInBytes;
+    }
+    return h;
+}
+
+static uint32_t shaderCacheLayout(){
+    const size_t sizes[4] = {sizeof(ShaderEntryPoint), sizeof(InOutAttributeInfo), sizeof(BindingIdentifier), sizeof(ResourceTypeDescriptor)};
+    return (uint32_t)fnv1a(0xcbf29ce484222325ull, sizes, sizeof(sizes));
+}
+
+uint64_t ShaderSourcesHash(ShaderSources sources){
+    uint64_t sourceBytes;
+    return shaderCacheKey(sources, &sourceBytes);
+}
+
+static void shaderCachePath(char* dest, uint64_t key){
+    snprintf(dest, CFS_MAX_PATH, "%s%c%016llx.rgsc", g_shaderCacheDirectory, CFS_PATH_SEPARATOR, (unsigned long long)key);
+}
+
+bool ShaderCacheLoad(ShaderSources sources, ShaderSources* spirvOut, ShaderReflectionInfo* reflectionOut){
+    if(!ShaderCacheEnabled()){
+        return false;
+    }
+    uint64_t sourceBytes;
+    const uint64_t key = shaderCacheKey(sources, &sourceBytes);
+    char path[CFS_MAX_PATH];
+    shaderCachePath(path, key);
+    FILE* file = fopen(path, "rb");
+    if(file == NULL){
+        return false;
+    }
+
+    ShaderSources spirv = {0};
+    ShaderReflectionInfo reflection = {0};
+    ShaderCacheHeader header;
+    bool ok = fread(&header, sizeof(header), 1, file) == 1 && header.magic == SHADER_CACHE_MAGIC &&
+              header.version == SHADER_CACHE_VERSION && header.layout == shaderCacheLayout() &&
+              header.key == key && header.sourceBytes == sourceBytes && header.sourceCount <= RGShaderStageEnum_EnumCount;
+
+    spirv.language = sourceTypeSPIRV;
+    for(uint32_t i = 0;ok && i < header.sourceCount;i++){
+        uint32_t stageAndSize[2];
+        ok = fread(stageAndSize, sizeof(stageAndSize), 1, file) == 1 && stageAndSize[1] % sizeof(uint32_t) == 0;
+        if(!ok)break;
+        void* words = RL_MALLOC(stageAndSize[1]);
+        spirv.sources[i].data = words;
+        spirv.sources[i].stageMask = (RGShaderStage)stageAndSize[0];
+        spirv.sources[i].sizeInBytes = stageAndSize[1];
+        spirv.sourceCount = i + 1;
+        ok = fread(words, 1, stageAndSize[1], file) == stageAndSize[1];
+    }
+
+    uint32_t uniformCount = 0;
+    ok = ok && fread(reflection.ep, sizeof(reflection.ep), 1, file) == 1;
+    ok = ok && fread(&reflection.attributes, sizeof(reflection.attributes), 1, file) == 1;
+    ok = ok && fread(&uniformCount, sizeof(uniformCount), 1, file) == 1;
+    if(ok){
+        reflection.uniforms = callocnew(StringToUniformMap);
+        StringToUniformMap_init(reflection.uniforms);
+        for(uint32_t i = 0;ok && i < uniformCount;i++){
+            StringToUniformMap_kv_pair kv;
+            ok = fread(&kv.key, sizeof(kv.key), 1, file) == 1 && fread(&kv.value, sizeof(kv.value), 1, file) == 1;
+            if(ok){
+                StringToUniformMap_put(reflection.uniforms, kv.key, kv.value);
+            }
+        }
+    }
+    fclose(file);
+
+    if(!ok){
+        TRACELOG(LOG_WARNING, "Discarding corrupt or outdated shader cache entry %s", path);
+        ShaderCacheFreeSources(&spirv);
+        if(reflection.uniforms){
+            StringToUniformMap_free(reflection.uniforms);
+            RL_FREE(reflection.uniforms);
+        }
+        remove(path);
+        return false;
+    }
+    *spirvOut = spirv;
+    *reflectionOut = reflection;
+    return true;
+}
+
+void ShaderCacheStore(ShaderSources sources, ShaderSources spirv, const ShaderReflectionInfo* reflection){
+    if(!ShaderCacheEnabled()){
+        return;
+    }
+    ShaderCacheHeader header = {
+        .magic = SHADER_CACHE_MAGIC,
+        .version = SHADER_CACHE_VERSION,
+        .layout = shaderCacheLayout(),
+        .sourceCount = spirv.sourceCount,
+    };
+    header.key = shaderCacheKey(sources, &header.sourceBytes);
+    char path[CFS_MAX_PATH];
+    char tempPath[CFS_MAX_PATH];
+    shaderCachePath(path, header.key);
+    // Written under a unique name and renamed, so concurrent processes never observe a partial entry.
+    // The stack address tells apart threads of the same process storing the same key.
+    snprintf(tempPath, sizeof(tempPath), "%s.%d.%p.tmp", path, (int)rg_getpid(), (void*)&header);
+
+    FILE* file = fopen(tempPath, "wb");
+    if(file == NULL){
+        return;
+    }
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1;
+    for(uint32_t i = 0;ok && i < spirv.sourceCount;i++){
+        const uint32_t stageAndSize[2] = {(uint32_t)spirv.sources[i].stageMask, spirv.sources[i].sizeInBytes};
+        ok = fwrite(stageAndSize, sizeof(stageAndSize), 1, file) == 1 &&
+             fwrite(spirv.sources[i].data, 1, spirv.sources[i].sizeInBytes, file) == spirv.sources[i].sizeInBytes;
+    }
+    const uint32_t uniformCount = reflection->uniforms ? (uint32_t)reflection->uniforms->current_size : 0;
+    ok = ok && fwrite(reflection->ep, sizeof(reflection->ep), 1, file) == 1;
+    ok = ok && fwrite(&reflection->attributes, sizeof(reflection->attributes), 1, file) == 1;
+    ok = ok && fwrite(&uniformCount, sizeof(uniformCount), 1, file) == 1;
+    for(uint32_t i = 0;ok && uniformCount && i < reflection->uniforms->current_capacity;i++){
+        const StringToUniformMap_kv_pair* kv = reflection->uniforms->table + i;
+        if(kv->key.length != 0){
+            ok = fwrite(&kv->key, sizeof(kv->key), 1, file) == 1 && fwrite(&kv->value, sizeof(kv->value), 1, file) == 1;
+        }
+    }
+    ok = (fclose(file) == 0) && ok;
+    if(ok){
+        #if defined(_WIN32)
+        remove(path);
+        #endif
+        ok = rename(tempPath, path) == 0;
+    }
+    if(!ok){
+        remove(tempPath);
+    }
+}
+
+void ShaderCacheFreeSources(ShaderSources* spirv){
+    for(uint32_t i = 0;i < spirv->sourceCount;i++){
+        RL_FREE((void*)spirv->sources[i].data);
+        spirv->sources[i].data = NULL;
+    }
+    spirv->sourceCount = 0;
+}
+
+// end file src/shader_cache.c
@@ -0,0 +1,523 @@
+// begin file src/shader_permutation.c
+// Shader permutations. One annotated GLSL or WGSL source contains #if/#ifdef/#ifndef/#elif/#else/#endif blocks over
+// a list of named features, a ShaderPermutationKey selects a combination of them. Variants are expanded and compiled
+// on first request and cached in a table that all variants of the source share. Features whose blocks only toggle
+// code inside function bodies cannot change bindings, attributes or entry points, so variants that differ only in
+// such features share one reflection.
+//
+// Directives whose condition mentions anything other than the registered features, defined(), !, &&, ||,
+// parentheses, 0 and 1 are left in the source untouched for the shader compiler (e.g. GLSL's own preprocessor).
+
+#include <raygpu.h>
+#include <string.h>
+#include <stdio.h>
+#include "internal_include/internals.h"
+
+#define PERMUTATION_MAX_NESTING 32
+
+static inline uint64_t hashPermutationKey(const uint64_t key){return hash_bytes(&key, sizeof(key));}
+static inline bool comparePermutationKey(const uint64_t a, const uint64_t b){return a == b;}
+static inline uint64_t copyPermutationKey(const uint64_t key){return key;}
+static inline void deletePermutationKey(const uint64_t key){}
+static inline uint32_t copyVariantID(const uint32_t id){return id;}
+static inline void deleteVariantID(const uint32_t id){}
+static inline ShaderReflectionInfo copyVariantReflection(const ShaderReflectionInfo reflection){return reflection;}
+static inline void deleteVariantReflection(const ShaderReflectionInfo reflection){}
+RG_DEFINE_GENERIC_HASH_MAP(static inline, PermutationVariantMap, uint64_t, uint32_t, hashPermutationKey, comparePermutationKey, 0, copyPermutationKey, copyVariantID, deletePermutationKey, deleteVariantID)
+RG_DEFINE_GENERIC_HASH_MAP(static inline, PermutationReflectionMap, uint64_t, ShaderReflectionInfo, hashPermutationKey, comparePermutationKey, 0, copyPermutationKey, copyVariantReflection, deletePermutationKey, deleteVariantReflection)
+
+// 0 is the empty key of the maps, keys have at most 63 bits
+#define PERMUTATION_MAP_KEY(key) (((uint64_t)(key) << 1) | 1u)
+#define PERMUTATION_FAILED_VARIANT 0xFFFFFFFFu
+
+struct ShaderPermutationTable{
+    ShaderSources sources;                  // Owned copy of the annotated sources
+    char featureNames[MAX_SHADER_PERMUTATION_FEATURES][MAX_SHADER_FEATURE_NAME_LENGTH + 1];
+    uint32_t featureCount;
+    ShaderPermutationKey interfaceMask;     // Features with blocks outside of function bodies
+    PermutationVariantMap variants;         // Key -> shader id, PERMUTATION_FAILED_VARIANT if it did not compile
+    PermutationReflectionMap reflections;   // Key & interfaceMask -> reflection shared by those variants
+};
+
+typedef enum PermutationDirective{
+    PermutationDirective_None,
+    PermutationDirective_If,
+    PermutationDirective_Ifdef,
+    PermutationDirective_Ifndef,
+    PermutationDirective_Elif,
+    PermutationDirective_Else,
+    PermutationDirective_Endif,
+}PermutationDirective;
+
+static bool isIdentifierChar(char c){
+    return c == '_' || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9');
+}
+
+// Classifies the line [line, end) and returns the start of the condition in *condition
+static PermutationDirective parseDirective(const char* line, const char* end, const char** condition){
+    while(line < end && (*line == ' ' || *line == '\t'))++line;
+    if(line == end || *line != '#')return PermutationDirective_None;
+    ++line;
+    while(line < end && (*line == ' ' || *line == '\t'))++line;
+    const char* word = line;
+    while(line < end && isIdentifierChar(*line))++line;
+    const size_t length = (size_t)(line - word);
+    *condition = line;
+    #define PERMUTATION_WORD_IS(literal) (length == sizeof(literal) - 1 && strncmp(word, literal, length) == 0)
+    if(PERMUTATION_WORD_IS("if"))return PermutationDirective_If;
+    if(PERMUTATION_WORD_IS("ifdef"))return PermutationDirective_Ifdef;
+    if(PERMUTATION_WORD_IS("ifndef"))return PermutationDirective_Ifndef;
+    if(PERMUTATION_WORD_IS("elif"))return PermutationDirective_Elif;
+    if(PERMUTATION_WORD_IS("else"))return PermutationDirective_Else;
+    if(PERMUTATION_WORD_IS("endif"))return PermutationDirective_Endif;
+    #undef PERMUTATION_WORD_IS
+    return PermutationDirective_None;
+}
+
+typedef struct ConditionParser{
+    const char* cursor;
+    const char* end;
+    const ShaderPermutationTable* table;
+    ShaderPermutationKey key;
+    ShaderPermutationKey used;  // Features the condition mentions
+    bool owned;                 // False once anything but registered features shows up
+}ConditionParser;
+
+static void skipConditionSpace(ConditionParser* cp){
+    while(cp->cursor < cp->end && (*cp->cursor == ' ' || *cp->cursor == '\t' || *cp->cursor == '\r'))++cp->cursor;
+}
+
+static bool parseFeature(ConditionParser* cp){
+    skipConditionSpace(cp);
+    const char* word = cp->cursor;
+    while(cp->cursor < cp->end && isIdentifierChar(*cp->cursor))++cp->cursor;
+    const size_t length = (size_t)(cp->cursor - word);
+    for(uint32_t i = 0;length && i < cp->table->featureCount;i++){
+        if(strlen(cp->table->featureNames[i]) == length && strncmp(cp->table->featureNames[i], word, length) == 0){
+            cp->used |= (ShaderPermutationKey)1 << i;
+            return (cp->key >> i) & 1;
+        }
+    }
+    cp->owned = false;
+    return false;
+}
+
+static bool parseConditionOr(ConditionParser* cp);
+
+static bool parseConditionUnary(ConditionParser* cp){
+    skipConditionSpace(cp);
+    if(cp->cursor == cp->end){
+        cp->owned = false;
+        return false;
+    }
+    if(*cp->cursor == '!'){
+        ++cp->cursor;
+        return !parseConditionUnary(cp);
+    }
+    if(*cp->cursor == '('){
+        ++cp->cursor;
+        const bool value = parseConditionOr(cp);
+        skipConditionSpace(cp);
+        if(cp->cursor < cp->end && *cp->cursor == ')')++cp->cursor;
+        else cp->owned = false;
+        return value;
+    }
+    if((*cp->cursor == '0' || *cp->cursor == '1') && (cp->cursor + 1 == cp->end || !isIdentifierChar(cp->cursor[1]))){
+        return *cp->cursor++ == '1';
+    }
+    if(cp->end - cp->cursor >= 7 && strncmp(cp->cursor, "defined", 7) == 0 && (cp->cursor + 7 == cp->end || !isIdentifierChar(cp->cursor[7]))){
+        cp->cursor += 7;
+        skipConditionSpace(cp);
+        const bool parenthesized = cp->cursor < cp->end && *cp->cursor == '(';
+        if(parenthesized)++cp->cursor;
+        const bool value = parseFeature(cp);
+        skipConditionSpace(cp);
+        if(parenthesized){
+            if(cp->cursor < cp->end && *cp->cursor == ')')++cp->cursor;
+            else cp->owned = false;
+        }
+        return value;
+    }
+    return parseFeature(cp);
+}
+
+static bool parseConditionAnd(ConditionParser* cp){
+    bool value = parseConditionUnary(cp);
+    for(;;){
+        skipConditionSpace(cp);
+        if(cp->end - cp->cursor < 2 || strncmp(cp->cursor, "&&", 2) != 0)return value;
+        cp->cursor += 2;
+        value = parseConditionUnary(cp) && value;
+    }
+}
+
+static bool parseConditionOr(ConditionParser* cp){
+    bool value = parseConditionAnd(cp);
+    for(;;){
+        skipConditionSpace(cp);
+        if(cp->end - cp->cursor < 2 || strncmp(cp->cursor, "||", 2) != 0)return value;
+        cp->cursor += 2;
+        value = parseConditionAnd(cp) || value;
+    }
+}
+
+// Whether the feature condition of the directive holds for key, cp->owned tells whether it is a feature condition at all
+static bool evaluateCondition(ConditionParser* cp, const ShaderPermutationTable* table, ShaderPermutationKey key, PermutationDirective directive, const char* condition, const char* end){
+    *cp = CLITERAL(ConditionParser){.cursor = condition, .end = end, .table = table, .key = key, .owned = true};
+    bool value;
+    if(directive == PermutationDirective_Ifdef || directive == PermutationDirective_Ifndef){
+        value = parseFeature(cp);
+        if(directive == PermutationDirective_Ifndef)value = !value;
+    }
+    else{
+        value = parseConditionOr(cp);
+    }
+    skipConditionSpace(cp);
+    if(cp->cursor < cp->end && !(cp->end - cp->cursor >= 2 && cp->cursor[0] == '/' && cp->cursor[1] == '/')){
+        cp->owned = false;
+    }
+    return value;
+}
+
+typedef struct PermutationBlock{
+    bool owned;          // Evaluated here, otherwise the directives are passed through
+    bool parentActive;
+    bool taken;          // One branch of the chain was already selected
+    bool bodyOnly;       // Analysis: every branch starts and ends inside the same function body
+    int depth;           // Analysis: brace depth at the opening directive
+    ShaderPermutationKey used;
+}PermutationBlock;
+
+// Expands the variant for key into a new string. Lines of disabled blocks and consumed directives become empty
+// lines so that compiler diagnostics keep their line numbers.
+static char* expandPermutation(const ShaderPermutationTable* table, const char* source, size_t size, ShaderPermutationKey key, char* diag, size_t diagSize){
+    char* out = (char*)RL_MALLOC(size + 1);
+    size_t outSize = 0;
+    PermutationBlock blocks[PERMUTATION_MAX_NESTING];
+    int blockCount = 0;
+    bool active = true;
+    uint32_t lineNumber = 1;
+    for(const char* line = source;line < source + size;lineNumber++){
+        const char* end = (const char*)memchr(line, '\n', (size_t)(source + size - line));
+        const char* next = end ? end + 1 : source + size;
+        if(end == NULL)end = source + size;
+        const char* condition = NULL;
+        const PermutationDirective directive = parseDirective(line, end, &condition);
+        bool emit = active;
+        if(directive == PermutationDirective_If || directive == PermutationDirective_Ifdef || directive == PermutationDirective_Ifndef){
+            if(blockCount == PERMUTATION_MAX_NESTING){
+                snprintf(diag, diagSize, "Line %u: conditionals nested deeper than %d", lineNumber, PERMUTATION_MAX_NESTING);
+                RL_FREE(out);
+                return NULL;
+            }
+            ConditionParser cp;
+            const bool value = evaluateCondition(&cp, table, key, directive, condition, end);
+            PermutationBlock* block = blocks + blockCount++;
+            *block = CLITERAL(PermutationBlock){.owned = cp.owned, .parentActive = active, .taken = value};
+            if(block->owned){
+                active = active && block->taken;
+                emit = false;
+            }
+        }
+        else if(directive == PermutationDirective_Elif || directive == PermutationDirective_Else || directive == PermutationDirective_Endif){
+            if(blockCount == 0){
+                snprintf(diag, diagSize, "Line %u: #%s without #if", lineNumber, directive == PermutationDirective_Endif ? "endif" : directive == PermutationDirective_Else ? "else" : "elif");
+                RL_FREE(out);
+                return NULL;
+            }
+            PermutationBlock* block = blocks + blockCount - 1;
+            if(block->owned){
+                emit = false;
+                if(directive == PermutationDirective_Endif){
+                    active = block->parentActive;
+                    --blockCount;
+                }
+                else{
+                    bool value = true;
+                    if(directive == PermutationDirective_Elif){
+                        ConditionParser cp;
+                        value = evaluateCondition(&cp, table, key, directive, condition, end);
+                        if(!cp.owned){
+                            snprintf(diag, diagSize, "Line %u: #elif condition must only use shader features", lineNumber);
+                            RL_FREE(out);
+                            return NULL;
+                        }
+                    }
+                    active = block->parentActive && !block->taken && value;
+                    block->taken = block->taken || value;
+                }
+            }
+            else if(directive == PermutationDirective_Endif){
+                --blockCount;
+            }
+        }
+        if(emit){
+            memcpy(out + outSize, line, (size_t)(next - line));
+            outSize += (size_t)(next - line);
+        }
+        else if(next > end){
+            out[outSize++] = '\n';
+        }
+        line = next;
+    }
+    if(blockCount != 0){
+        snprintf(diag, diagSize, "Unterminated #if at end of source");
+        RL_FREE(out);
+        return NULL;
+    }
+    out[outSize] = '\0';
+    return out;
+}
+
+// Finds the features that can change the shader interface: those controlling any block that does not start and end
+// inside one function body. Braces are counted over all branches, anything unbalanced marks every feature.
+static ShaderPermutationKey analyzePermutationInterface(const ShaderPermutationTable* table, const char* source, size_t size){
+    const ShaderPermutationKey all = ((ShaderPermutationKey)1 << table->featureCount) - 1;
+    ShaderPermutationKey mask = 0;
+    PermutationBlock blocks[PERMUTATION_MAX_NESTING];
+    int blockCount = 0;
+    int depth = 0;
+    bool inBody = false;            // The outermost open brace belongs to a function
+    bool declarationHasParen = false;
+    bool declarationIsBlock = false; // struct, uniform or buffer block
+    bool inComment = false;
+    for(const char* line = source;line < source + size;){
+        const char* end = (const char*)memchr(line, '\n', (size_t)(source + size - line));
+        const char* next = end ? end + 1 : source + size;
+        if(end == NULL)end = source + size;
+        const char* condition = NULL;
+        const PermutationDirective directive = parseDirective(line, end, &condition);
+        if(!inComment && directive != PermutationDirective_None){
+            const bool here = depth > 0 && inBody;
+            if(directive == PermutationDirective_If || directive == PermutationDirective_Ifdef || directive == PermutationDirective_Ifndef){
+                if(blockCount == PERMUTATION_MAX_NESTING)return all;
+                ConditionParser cp;
+                evaluateCondition(&cp, table, 0, directive, condition, end);
+                blocks[blockCount++] = CLITERAL(PermutationBlock){.owned = cp.owned, .bodyOnly = here, .depth = depth, .used = cp.used};
+            }
+            else{
+                if(blockCount == 0)return all;
+                PermutationBlock* block = blocks + blockCount - 1;
+                if(directive == PermutationDirective_Elif){
+                    ConditionParser cp;
+                    evaluateCondition(&cp, table, 0, directive, condition, end);
+                    block->used |= cp.used;
+                }
+                if(block->owned && block->depth != depth)return all;
+                block->bodyOnly = block->bodyOnly && here;
+                if(directive == PermutationDirective_Endif){
+                    if(block->owned && !block->bodyOnly)mask |= block->used;
+                    --blockCount;
+                }
+            }
+            line = next;
+            continue;
+        }
+        for(const char* c = line;c < end;c++){
+            if(inComment){
+                if(c + 1 < end && c[0] == '*' && c[1] == '/'){
+                    inComment = false;
+                    ++c;
+                }
+                continue;
+            }
+            if(c + 1 < end && c[0] == '/' && c[1] == '/')break;
+            if(c + 1 < end && c[0] == '/' && c[1] == '*'){
+                inComment = true;
+                ++c;
+                continue;
+            }
+            if(isIdentifierChar(*c) && (c == line || !isIdentifierChar(c[-1]))){
+                const char* word = c;
+                while(c + 1 < end && isIdentifierChar(c[1]))++c;
+                const size_t length = (size_t)(c - word + 1);
+                if(depth == 0 && ((length == 6 && (strncmp(word, "struct", 6) == 0 || strncmp(word, "buffer", 6) == 0)) || (length == 7 && strncmp(word, "uniform", 7) == 0))){
+                    declarationIsBlock = true;
+                }
+                continue;
+            }
+            switch(*c){
+                case '(':
+                    if(depth == 0)declarationHasParen = true;
+                    break;
+                case '{':
+                    if(depth == 0)inBody = declarationHasParen && !declarationIsBlock;
+                    ++depth;
+                    break;
+                case '}':
+                    if(--depth < 0)return all;
+                    if(depth == 0)declarationHasParen = declarationIsBlock = inBody = false;
+                    break;
+                case ';':
+                    if(depth == 0)declarationHasParen = declarationIsBlock = false;
+                    break;
+                default: break;
+            }
+        }
+        line = next;
+    }
+    if(blockCount != 0 || depth != 0)return all;
+    return mask;
+}
+
+// Fills a temporary table for the test hooks below
+static bool initPermutationTable(ShaderPermutationTable* table, const char* const* featureNames, uint32_t featureCount){
+    if(featureCount > MAX_SHADER_PERMUTATION_FEATURES)return false;
+    for(uint32_t i = 0;i < featureCount;i++){
+        if(strlen(featureNames[i]) > MAX_SHADER_FEATURE_NAME_LENGTH)return false;
+        strcpy(table->featureNames[i], featureNames[i]);
+    }
+    table->featureCount = featureCount;
+    return true;
+}
+
+RGAPI char* ExpandShaderPermutationSource(const char* const* featureNames, uint32_t featureCount, const char* source, ShaderPermutationKey key, char* diag, size_t diagSize){
+    ShaderPermutationTable table = {0};
+    if(!initPermutationTable(&table, featureNames, featureCount)){
+        snprintf(diag, diagSize, "Invalid feature list");
+        return NULL;
+    }
+    return expandPermutation(&table, source, strlen(source), key, diag, diagSize);
+}
+
+RGAPI ShaderPermutationKey AnalyzeShaderPermutationInterface(const char* const* featureNames, uint32_t featureCount, const char* source){
+    ShaderPermutationTable table = {0};
+    if(!initPermutationTable(&table, featureNames, featureCount))return 0;
+    return analyzePermutationInterface(&table, source, strlen(source));
+}
+
+static bool loadPermutationVariant(ShaderPermutationTable* table, ShaderPermutationKey key, Shader* shaderOut, ShaderBatchResult* result){
+    ShaderSources variant = table->sources;
+    bool ok = true;
+    for(uint32_t i = 0;i < variant.sourceCount;i++){
+        variant.sources[i].data = NULL;
+    }
+    for(uint32_t i = 0;ok && i < variant.sourceCount;i++){
+        char* text = expandPermutation(table, (const char*)table->sources.sources[i].data, table->sources.sources[i].sizeInBytes, key, result->diagnostics, sizeof(result->diagnostics));
+        variant.sources[i].data = text;
+        variant.sources[i].sizeInBytes = text ? (uint32_t)strlen(text) : 0;
+        ok = text != NULL;
+    }
+    if(ok){
+        const uint64_t reflectionKey = PERMUTATION_MAP_KEY(key & table->interfaceMask);
+        const ShaderReflectionInfo* shared = PermutationReflectionMap_get(&table->reflections, reflectionKey);
+        ShaderSources spirv = {0};
+        ShaderReflectionInfo reflection = {0};
+        ok = PrepareShaderSources(&variant, shared, &spirv, &reflection, result);
+        if(ok){
+            ok = CreateShaderFromPrepared(variant, spirv, reflection, result);
+            if(ok && shared == NULL){
+                PermutationReflectionMap_put(&table->reflections, reflectionKey, reflection);
+            }
+            else if(!ok && shared == NULL && reflection.uniforms){
+                StringToUniformMap_free(reflection.uniforms);
+                RL_FREE(reflection.uniforms);
+            }
+            ShaderCacheFreeSources(&spirv);
+        }
+    }
+    for(uint32_t i = 0;i < variant.sourceCount;i++){
+        RL_FREE((void*)variant.sources[i].data);
+    }
+    if(ok){
+        *shaderOut = result->shader;
+        ShaderImpl* impl = GetShaderImpl(result->shader);
+        impl->permutations = table;
+        impl->permutationKey = key;
+    }
+    PermutationVariantMap_put(&table->variants, PERMUTATION_MAP_KEY(key), ok ? result->shader.id : PERMUTATION_FAILED_VARIANT);
+    return ok;
+}
+
+Shader LoadShaderPermutations(ShaderSources sources, const char* const* featureNames, uint32_t featureCount){
+    if(featureCount > MAX_SHADER_PERMUTATION_FEATURES){
+        TRACELOG(LOG_ERROR, "Shader permutations support at most %d features, got %u", MAX_SHADER_PERMUTATION_FEATURES, featureCount);
+        return CLITERAL(Shader){.id = SHADER_ID_INVALID};
+    }
+    if(sources.language == sourceTypeUnknown){
+        detectShaderLanguage(&sources);
+    }
+    if(sources.language != sourceTypeGLSL && sources.language != sourceTypeWGSL){
+        TRACELOG(LOG_ERROR, "Shader permutations require GLSL or WGSL sources");
+        return CLITERAL(Shader){.id = SHADER_ID_INVALID};
+    }
+    for(uint32_t i = 0;i < sources.sourceCount;i++){
+        if(sources.sources[i].stageMask & RGShaderStage_Compute){
+            TRACELOG(LOG_ERROR, "Shader permutations only support vertex and fragment shaders");
+            return CLITERAL(Shader){.id = SHADER_ID_INVALID};
+        }
+    }
+    ShaderPermutationTable* table = callocnew(ShaderPermutationTable);
+    for(uint32_t i = 0;i < featureCount;i++){
+        if(strlen(featureNames[i]) > MAX_SHADER_FEATURE_NAME_LENGTH){
+            TRACELOG(LOG_ERROR, "Shader feature name %s is longer than %d characters", featureNames[i], MAX_SHADER_FEATURE_NAME_LENGTH);
+            RL_FREE(table);
+            return CLITERAL(Shader){.id = SHADER_ID_INVALID};
+        }
+        strcpy(table->featureNames[i], featureNames[i]);
+    }
+    table->featureCount = featureCount;
+    table->sources = sources;
+    for(uint32_t i = 0;i < sources.sourceCount;i++){
+        char* copy = (char*)RL_MALLOC(sources.sources[i].sizeInBytes + 1);
+        memcpy(copy, sources.sources[i].data, sources.sources[i].sizeInBytes);
+        copy[sources.sources[i].sizeInBytes] = '\0';
+        table->sources.sources[i].data = copy;
+        table->interfaceMask |= analyzePermutationInterface(table, copy, sources.sources[i].sizeInBytes);
+    }
+    PermutationVariantMap_init(&table->variants);
+    PermutationReflectionMap_init(&table->reflections);
+
+    Shader base = {0};
+    ShaderBatchResult result = {0};
+    if(!loadPermutationVariant(table, 0, &base, &result)){
+        TRACELOG(LOG_WARNING, "Shader permutations failed to load: %s", result.diagnostics);
+        for(uint32_t i = 0;i < table->sources.sourceCount;i++){
+            RL_FREE((void*)table->sources.sources[i].data);
+        }
+        PermutationVariantMap_free(&table->variants);
+        PermutationReflectionMap_free(&table->reflections);
+        RL_FREE(table);
+        return CLITERAL(Shader){.id = SHADER_ID_INVALID};
+    }
+    uint32_t interfaceFeatures = 0;
+    for(uint32_t i = 0;i < featureCount;i++){
+        interfaceFeatures += (table->interfaceMask >> i) & 1;
+    }
+    TRACELOG(LOG_INFO, "Loaded shader permutations with %u features, %u of which change the shader interface", featureCount, interfaceFeatures);
+    return base;
+}
+
+ShaderPermutationKey GetShaderFeatureKey(Shader shader, const char* featureName){
+    if(shader.id == SHADER_ID_INVALID)return 0;
+    const ShaderPermutationTable* table = GetShaderImpl(shader)->permutations;
+    for(uint32_t i = 0;table && i < table->featureCount;i++){
+        if(strcmp(table->featureNames[i], featureName) == 0){
+            return (ShaderPermutationKey)1 << i;
+        }
+    }
+    TRACELOG(LOG_WARNING, "Shader %u has no feature %s", shader.id, featureName);
+    return 0;
+}
+
+Shader GetShaderPermutation(Shader shader, ShaderPermutationKey key){
+    if(shader.id == SHADER_ID_INVALID)return shader;
+    ShaderPermutationTable* table = GetShaderImpl(shader)->permutations;
+    if(table == NULL){
+        TRACELOG(LOG_WARNING, "Shader %u was not loaded with LoadShaderPermutations", shader.id);
+        return shader;
+    }
+    key &= ((ShaderPermutationKey)1 << table->featureCount) - 1;
+    const uint32_t* existing = PermutationVariantMap_get(&table->variants, PERMUTATION_MAP_KEY(key));
+    if(existing){
+        return *existing == PERMUTATION_FAILED_VARIANT ? CLITERAL(Shader){.id = SHADER_ID_INVALID} : CLITERAL(Shader){.id = *existing};
+    }
+    Shader variant = {.id = SHADER_ID_INVALID};
+    ShaderBatchResult result = {0};
+    if(!loadPermutationVariant(table, key, &variant, &result)){
+        TRACELOG(LOG_WARNING, "Shader permutation 0x%llx failed to load: %s", (unsigned long long)key, result.diagnostics);
+    }
+    return variant;
+}
+
+// end file src/shader_permutation.c
@@ -0,0 +1,191 @@
+// BEGIN FILE wgsl_arena.h
+// Bump allocator and string hash map shared by the parser and the resolver.
+// Everything allocated from an arena is released at once by wgsl_arena_free.
+#ifndef WGSL_ARENA_H
+#define WGSL_ARENA_H
+
+#include "wgsl_parser.h"
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifndef WGSL_ARENA_BLOCK_SIZE
+#define WGSL_ARENA_BLOCK_SIZE (64 * 1024)
+#endif
+#define WGSL_ARENA_ALIGN 16
+
+typedef struct WgslArenaBlock {
+    struct WgslArenaBlock *next;
+    size_t used;
+    size_t size;
+} WgslArenaBlock;
+
+typedef struct WgslArena {
+    WgslArenaBlock *head;
+} WgslArena;
+
+#define WGSL_ARENA_HEADER ((sizeof(WgslArenaBlock) + WGSL_ARENA_ALIGN - 1) & ~(size_t)(WGSL_ARENA_ALIGN - 1))
+
+static inline size_t wgsl_arena_round(size_t size) { return (size + WGSL_ARENA_ALIGN - 1) & ~(size_t)(WGSL_ARENA_ALIGN - 1); }
+static inline char *wgsl_arena_payload(WgslArenaBlock *b) { return (char *)b + WGSL_ARENA_HEADER; }
+
+/* Not zeroed unless NODE_MALLOC zeroes */
+static inline void *wgsl_arena_alloc(WgslArena *A, size_t size) {
+    size = wgsl_arena_round(size ? size : 1);
+    WgslArenaBlock *b = A->head;
+    if (b && b->used + size <= b->size) {
+        void *p = wgsl_arena_payload(b) + b->used;
+        b->used += size;
+        return p;
+    }
+    /* Large requests get a dedicated block behind the current one, so its free space stays usable */
+    const int dedicated = b && size > WGSL_ARENA_BLOCK_SIZE / 4;
+    const size_t cap = size > WGSL_ARENA_BLOCK_SIZE ? size : WGSL_ARENA_BLOCK_SIZE;
+    WgslArenaBlock *nb = (WgslArenaBlock *)NODE_MALLOC(WGSL_ARENA_HEADER + (dedicated ? size : cap));
+    if (!nb)
+        return NULL;
+    nb->used = size;
+    nb->size = dedicated ? size : cap;
+    if (dedicated) {
+        nb->next = b->next;
+        b->next = nb;
+    } else {
+        nb->next = b;
+        A->head = nb;
+    }
+    return wgsl_arena_payload(nb);
+}
+
+/* Grows the most recent allocation in place when possible, otherwise copies */
+static inline void *wgsl_arena_grow(WgslArena *A, void *old, size_t old_size, size_t new_size) {
+    WgslArenaBlock *b = A->head;
+    if (old && b) {
+        const size_t old_rounded = wgsl_arena_round(old_size ? old_size : 1);
+        char *end = wgsl_arena_payload(b) + b->used;
+        if ((char *)old + old_rounded == end && b->used - old_rounded + wgsl_arena_round(new_size) <= b->size) {
+            b->used = b->used - old_rounded + wgsl_arena_round(new_size);
+            return old;
+        }
+    }
+    void *p = wgsl_arena_alloc(A, new_size);
+    if (p && old && old_size)
+        memcpy(p, old, old_size < new_size ? old_size : new_size);
+    return p;
+}
+
+static inline void wgsl_arena_free(WgslArena *A) {
+    WgslArenaBlock *b = A->head;
+    while (b) {
+        WgslArenaBlock *next = b->next;
+        NODE_FREE(b);
+        b = next;
+    }
+    A->head = NULL;
+}
+
+static inline uint32_t wgsl_hash_str(const char *s, size_t n) {
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < n; i++) {
+        h ^= (unsigned char)s[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+/* Open addressing map from string to int. Keys are not copied, except by wgsl_intern. */
+typedef struct WgslNameMap {
+    const char **keys;
+    uint32_t *hashes;
+    int *values;
+    int cap; /* power of two */
+    int count;
+} WgslNameMap;
+
+static inline int wgsl_name_map_slot(const WgslNameMap *M, const char *s, size_t n, uint32_t h) {
+    int i = (int)(h & (uint32_t)(M->cap - 1));
+    for (;;) {
+        const char *k = M->keys[i];
+        if (!k)
+            return i;
+        if (M->hashes[i] == h && (k == s || (strncmp(k, s, n) == 0 && k[n] == '\0')))
+            return i;
+        i = (i + 1) & (M->cap - 1);
+    }
+}
+
+static inline int wgsl_name_map_reserve(WgslArena *A, WgslNameMap *M) {
+    if ((M->count + 1) * 2 <= M->cap)
+        return 1;
+    const int new_cap = M->cap ? M->cap * 2 : 64;
+    WgslNameMap N;
+    N.cap = new_cap;
+    N.count = M->count;
+    N.keys = (const char **)wgsl_arena_alloc(A, sizeof(*N.keys) * (size_t)new_cap);
+    N.hashes = (uint32_t *)wgsl_arena_alloc(A, sizeof(*N.hashes) * (size_t)new_cap);
+    N.values = (int *)wgsl_arena_alloc(A, sizeof(*N.values) * (size_t)new_cap);
+    if (!N.keys || !N.hashes || !N.values)
+        return 0;
+    memset((void *)N.keys, 0, sizeof(*N.keys) * (size_t)new_cap);
+    for (int i = 0; i < M->cap; i++) {
+        if (!M->keys[i])
+            continue;
+        int j = (int)(M->hashes[i] & (uint32_t)(new_cap - 1));
+        while (N.keys[j])
+            j = (j + 1) & (new_cap - 1);
+        N.keys[j] = M->keys[i];
+        N.hashes[j] = M->hashes[i];
+        N.values[j] = M->values[i];
+    }
+    *M = N;
+    return 1;
+}
+
+static inline int wgsl_name_map_get(const WgslNameMap *M, const char *key, int fallback) {
+    if (!key || M->cap == 0)
+        return fallback;
+    const size_t n = strlen(key);
+    const int i = wgsl_name_map_slot(M, key, n, wgsl_hash_str(key, n));
+    return M->keys[i] ? M->values[i] : fallback;
+}
+
+/* Overwrites an existing value unless keep_existing is set */
+static inline void wgsl_name_map_put(WgslArena *A, WgslNameMap *M, const char *key, int value, int keep_existing) {
+    if (!key || !wgsl_name_map_reserve(A, M))
+        return;
+    const size_t n = strlen(key);
+    const uint32_t h = wgsl_hash_str(key, n);
+    const int i = wgsl_name_map_slot(M, key, n, h);
+    if (M->keys[i]) {
+        if (!keep_existing)
+            M->values[i] = value;
+        return;
+    }
+    M->keys[i] = key;
+    M->hashes[i] = h;
+    M->values[i] = value;
+    M->count++;
+}
+
+/* Returns the one arena copy of s[0..n), so equal identifiers share a pointer */
+static inline const char *wgsl_intern(WgslArena *A, WgslNameMap *M, const char *s, size_t n) {
+    if (!wgsl_name_map_reserve(A, M))
+        return NULL;
+    const uint32_t h = wgsl_hash_str(s, n);
+    const int i = wgsl_name_map_slot(M, s, n, h);
+    if (M->keys[i])
+        return M->keys[i];
+    char *copy = (char *)wgsl_arena_alloc(A, n + 1);
+    if (!copy)
+        return NULL;
+    memcpy(copy, s, n);
+    copy[n] = '\0';
+    M->keys[i] = copy;
+    M->hashes[i] = h;
+    M->values[i] = 0;
+    M->count++;
+    return copy;
+}
+
+#endif
+// END FILE wgsl_arena.h
@@ -1,37 +1,12 @@
 // BEGIN FILE wgsl_parser.c
 #include "wgsl_parser.h"
+#include "wgsl_arena.h"
 #include <ctype.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
-static char *wgsl_strndup(const char *s, size_t n) {
-    char *r = (char *)NODE_MALLOC(n + 1);
-    if (!r)
-        return NULL;
-    memcpy(r, s, n);
-    r[n] = '\0';
-    return r;
-}
-static char *wgsl_strdup(const char *s) { return wgsl_strndup(s, s ? strlen(s) : 0); }
-static void *grow_ptr_array(void *p, int needed, int *cap, size_t elem) {
-    if (needed <= *cap)
-        return p;
-    int nc = (*cap == 0) ? 4 : (*cap * 2);
-    while (nc < needed)
-        nc *= 2;
-    void *np = NODE_REALLOC(p, (size_t)nc * elem);
-    if (!np)
-        return p;
-    *cap = nc;
-    return np;
-}
-static void vec_push_node(WgslAstNode ***arr, int *count, int *cap, WgslAstNode *v) {
-    *arr = (WgslAstNode **)grow_ptr_array(*arr, *count + 1, cap, sizeof(WgslAstNode *));
-    (*arr)[(*count)++] = v;
-}
-
 typedef enum TokenType {
     TOK_EOF = 0,
     TOK_IDENT,
@@ -65,6 +40,10 @@ typedef enum TokenType {
     TOK_MINUSMINUS,
     TOK_BANG,
     TOK_TILDE,
+    TOK_AMP,
+    TOK_PIPE,
+    TOK_CARET,
+    TOK_PERCENT,
     TOK_QMARK,
     TOK_STRUCT,
     TOK_FN,
@@ -264,6 +243,18 @@ static Token lx_next(Lexer *L) {
     case '~':
         lx_advance(L);
         return make_token(L, TOK_TILDE, s, 1, false);
+    case '&':
+        lx_advance(L);
+        return make_token(L, TOK_AMP, s, 1, false);
+    case '|':
+        lx_advance(L);
+        return make_token(L, TOK_PIPE, s, 1, false);
+    case '^':
+        lx_advance(L);
+        return make_token(L, TOK_CARET, s, 1, false);
+    case '%':
+        lx_advance(L);
+        return make_token(L, TOK_PERCENT, s, 1, false);
     case '?':
         lx_advance(L);
         return make_token(L, TOK_QMARK, s, 1, false);
@@ -361,12 +352,64 @@ static Token lx_next(Lexer *L) {
     return make_token(L, TOK_EOF, s, 0, false);
 }
 
+typedef struct ListEntry {
+    WgslAstNode *node;
+    int tag;
+} ListEntry;
+
 typedef struct Parser {
     Lexer L;
     Token cur;
-    bool had_error;
+    int error_count;
+    WgslArena arena;     /* Owns every node, child array and string of the tree */
+    WgslNameMap strings; /* Interned identifiers, lexemes and operators */
+    ListEntry *list;     /* Scratch stack for child lists under construction */
+    int list_count, list_cap;
 } Parser;
 
+static char *intern(Parser *P, const char *s, size_t n) { return (char *)wgsl_intern(&P->arena, &P->strings, s, n); }
+static char *intern_cstr(Parser *P, const char *s) { return intern(P, s, strlen(s)); }
+static char *intern_tok(Parser *P, const Token *t) { return intern(P, t->start, (size_t)t->length); }
+
+/* Child lists are pushed onto one scratch stack while parsing (nested lists end before their parent
+   continues) and copied into the arena with their final size, so no array is ever reallocated. */
+static void list_push(Parser *P, WgslAstNode *n, int tag) {
+    if (P->list_count >= P->list_cap) {
+        int nc = P->list_cap ? P->list_cap * 2 : 64;
+        ListEntry *nl = (ListEntry *)NODE_REALLOC(P->list, sizeof(ListEntry) * (size_t)nc);
+        if (!nl)
+            return;
+        P->list = nl;
+        P->list_cap = nc;
+    }
+    P->list[P->list_count].node = n;
+    P->list[P->list_count].tag = tag;
+    P->list_count++;
+}
+static WgslAstNode **list_collect(Parser *P, int base, int tag, int *out_count) {
+    int n = 0;
+    for (int i = base; i < P->list_count; i++)
+        if (P->list[i].tag == tag)
+            n++;
+    *out_count = 0;
+    if (n == 0)
+        return NULL;
+    WgslAstNode **arr = (WgslAstNode **)wgsl_arena_alloc(&P->arena, sizeof(WgslAstNode *) * (size_t)n);
+    if (!arr)
+        return NULL;
+    int k = 0;
+    for (int i = base; i < P->list_count; i++)
+        if (P->list[i].tag == tag)
+            arr[k++] = P->list[i].node;
+    *out_count = n;
+    return arr;
+}
+static WgslAstNode **list_take(Parser *P, int base, int *out_count) {
+    WgslAstNode **arr = list_collect(P, base, 0, out_count);
+    P->list_count = base;
+    return arr;
+}
+
 static void advance(Parser *P) { P->cur = lx_next(&P->L); }
 static bool check(Parser *P, TokenType t) { return P->cur.type == t; }
 static bool match(Parser *P, TokenType t) {
@@ -378,14 +421,14 @@ static bool match(Parser *P, TokenType t) {
 }
 static void parse_error(Parser *P, const char *msg) {
     fprintf(stderr, "[wgsl-parser] error at %d:%d: %s\n", P->cur.line, P->cur.col, msg);
-    P->had_error = true;
+    P->error_count++;
 }
 static void expect(Parser *P, TokenType t, const char *msg) {
     if (!match(P, t))
         parse_error(P, msg);
 }
 static WgslAstNode *new_node(Parser *P, WgslNodeType k) {
-    WgslAstNode *n = NODE_ALLOC(WgslAstNode);
+    WgslAstNode *n = (WgslAstNode *)wgsl_arena_alloc(&P->arena, sizeof(WgslAstNode));
     if (!n)
         return NULL;
     memset(n, 0, sizeof(*n));
@@ -396,18 +439,18 @@ static WgslAstNode *new_node(Parser *P, WgslNodeType k) {
 }
 static WgslAstNode *new_ident(Parser *P, const Token *t) {
     WgslAstNode *n = new_node(P, WGSL_NODE_IDENT);
-    n->ident.name = wgsl_strndup(t->start, (size_t)t->length);
+    n->ident.name = intern_tok(P, t);
     return n;
 }
 static WgslAstNode *new_literal(Parser *P, const Token *t) {
     WgslAstNode *n = new_node(P, WGSL_NODE_LITERAL);
-    n->literal.lexeme = wgsl_strndup(t->start, (size_t)t->length);
+    n->literal.lexeme = intern_tok(P, t);
     n->literal.kind = t->is_float ? WGSL_LIT_FLOAT : WGSL_LIT_INT;
     return n;
 }
-static WgslAstNode *new_type(Parser *P, const char *name) {
+static WgslAstNode *new_type(Parser *P, const Token *name) {
     WgslAstNode *n = new_node(P, WGSL_NODE_TYPE);
-    n->type_node.name = wgsl_strdup(name);
+    n->type_node.name = intern_tok(P, name);
     return n;
 }
 
@@ -427,8 +470,12 @@ static WgslAstNode *parse_assignment(Parser *P);
 static WgslAstNode *parse_conditional(Parser *P);
 static WgslAstNode *parse_logical_or(Parser *P);
 static WgslAstNode *parse_logical_and(Parser *P);
+static WgslAstNode *parse_bitwise_or(Parser *P);
+static WgslAstNode *parse_bitwise_xor(Parser *P);
+static WgslAstNode *parse_bitwise_and(Parser *P);
 static WgslAstNode *parse_equality(Parser *P);
 static WgslAstNode *parse_relational(Parser *P);
+static WgslAstNode *parse_shift(Parser *P);
 static WgslAstNode *parse_additive(Parser *P);
 static WgslAstNode *parse_multiplicative(Parser *P);
 static WgslAstNode *parse_unary(Parser *P);
@@ -440,15 +487,15 @@ static WgslAstNode *parse_while_stmt(Parser *P);
 static WgslAstNode *parse_for_stmt(Parser *P);
 
 static int parse_attribute_list(Parser *P, WgslAstNode ***out) {
-    int cap = 0, count = 0;
-    WgslAstNode **list = NULL;
+    const int base = P->list_count;
+    int count = 0;
     while (match(P, TOK_AT)) {
         WgslAstNode *a = parse_attribute(P);
         if (!a)
             break;
-        vec_push_node(&list, &count, &cap, a);
+        list_push(P, a, 0);
     }
-    *out = list;
+    *out = list_take(P, base, &count);
     return count;
 }
 
@@ -460,42 +507,37 @@ static WgslAstNode *parse_attribute(Parser *P) {
     Token name = P->cur;
     advance(P);
     WgslAstNode *A = new_node(P, WGSL_NODE_ATTRIBUTE);
-    A->attribute.name = wgsl_strndup(name.start, (size_t)name.length);
-    int cap = 0, count = 0;
-    WgslAstNode **args = NULL;
+    A->attribute.name = intern_tok(P, &name);
+    const int base = P->list_count;
     if (match(P, TOK_LPAREN)) {
         if (!check(P, TOK_RPAREN)) {
             WgslAstNode *e = parse_expr(P);
             if (e)
-                vec_push_node(&args, &count, &cap, e);
+                list_push(P, e, 0);
             while (match(P, TOK_COMMA)) {
                 WgslAstNode *e2 = parse_expr(P);
                 if (e2)
-                    vec_push_node(&args, &count, &cap, e2);
+                    list_push(P, e2, 0);
             }
         }
         expect(P, TOK_RPAREN, "expected ')'");
     }
-    A->attribute.arg_count = count;
-    A->attribute.args = args;
+    A->attribute.args = list_take(P, base, &A->attribute.arg_count);
     return A;
 }
 
 static WgslAstNode *parse_type_after_name(Parser *P, const Token *name_tok) {
-    char *tname = wgsl_strndup(name_tok->start, (size_t)name_tok->length);
-    WgslAstNode *T = new_type(P, tname);
-    NODE_FREE(tname);
+    WgslAstNode *T = new_type(P, name_tok);
 
     if (!match(P, TOK_LT))
         return T;
 
-    int tcap = 0, tcount = 0;
-    WgslAstNode **targs = NULL;
-    int ecap = 0, ecount = 0;
-    WgslAstNode **eargs = NULL;
+    /* Type and expression arguments share the scratch stack, tagged 0 and 1 */
+    const int base = P->list_count;
 
     int first = 1;
     while (!check(P, TOK_GT) && !check(P, TOK_EOF)) {
+        const char *before = P->cur.start;
         if (!first)
             expect(P, TOK_COMMA, "expected ','");
         first = 0;
@@ -504,20 +546,22 @@ static WgslAstNode *parse_type_after_name(Parser *P, const Token *name_tok) {
         if (check(P, TOK_IDENT)) {
             WgslAstNode *t = parse_type_node(P);
             if (t)
-                vec_push_node(&targs, &tcount, &tcap, t);
+                list_push(P, t, 0);
         } else {
-            /* Fallback: expression argument (e.g., array<T, N>). */
-            WgslAstNode *ex = parse_expr(P);
+            /* Fallback: expression argument (e.g., array<T, N>). Parsed above the relational level, so the
+               closing '>' is not taken for a comparison */
+            WgslAstNode *ex = parse_shift(P);
             if (ex)
-                vec_push_node(&eargs, &ecount, &ecap, ex);
+                list_push(P, ex, 1);
         }
+        if (P->cur.start == before)
+            break;
     }
     expect(P, TOK_GT, "expected '>'");
 
-    T->type_node.type_arg_count = tcount;
-    T->type_node.type_args = targs;
-    T->type_node.expr_arg_count = ecount;
-    T->type_node.expr_args = eargs;
+    T->type_node.type_args = list_collect(P, base, 0, &T->type_node.type_arg_count);
+    T->type_node.expr_args = list_collect(P, base, 1, &T->type_node.expr_arg_count);
+    P->list_count = base;
     return T;
 }
 
@@ -540,12 +584,11 @@ static WgslAstNode *parse_struct(Parser *P, WgslAstNode **opt_attrs, int attr_co
     Token name = P->cur;
     advance(P);
     WgslAstNode *S = new_node(P, WGSL_NODE_STRUCT);
-    S->struct_decl.name = wgsl_strndup(name.start, (size_t)name.length);
+    S->struct_decl.name = intern_tok(P, &name);
     S->struct_decl.attr_count = attr_count;
     S->struct_decl.attrs = opt_attrs;
     expect(P, TOK_LBRACE, "expected '{'");
-    int cap = 0, count = 0;
-    WgslAstNode **fields = NULL;
+    const int base = P->list_count;
     while (!check(P, TOK_RBRACE) && !check(P, TOK_EOF)) {
         WgslAstNode **attrs = NULL;
         int acount = parse_attribute_list(P, &attrs);
@@ -559,16 +602,15 @@ static WgslAstNode *parse_struct(Parser *P, WgslAstNode **opt_attrs, int attr_co
         WgslAstNode *ftype = parse_type_node(P);
         skip_optional_comma(P);
         WgslAstNode *F = new_node(P, WGSL_NODE_STRUCT_FIELD);
-        F->struct_field.name = wgsl_strndup(fname.start, (size_t)fname.length);
+        F->struct_field.name = intern_tok(P, &fname);
         F->struct_field.type = ftype;
         F->struct_field.attr_count = acount;
         F->struct_field.attrs = attrs;
-        vec_push_node(&fields, &count, &cap, F);
+        list_push(P, F, 0);
     }
     expect(P, TOK_RBRACE, "expected '}'");
     expect(P, TOK_SEMI, "expected ';'");
-    S->struct_decl.field_count = count;
-    S->struct_decl.fields = fields;
+    S->struct_decl.fields = list_take(P, base, &S->struct_decl.field_count);
     return S;
 }
 
@@ -581,14 +623,14 @@ static WgslAstNode *parse_global_var(Parser *P, WgslAstNode **attrs, int attr_co
             parse_error(P, "expected identifier inside '<>'");
         Token firstTok = P->cur;
         advance(P);
-        char *first = wgsl_strndup(firstTok.start, (size_t)firstTok.length);
+        char *first = intern_tok(P, &firstTok);
         char *second = NULL;
         if (match(P, TOK_COMMA)) {
             if (!check(P, TOK_IDENT))
                 parse_error(P, "expected identifier after ','");
             Token secondTok = P->cur;
             advance(P);
-            second = wgsl_strndup(secondTok.start, (size_t)secondTok.length);
+            second = intern_tok(P, &secondTok);
         }
         expect(P, TOK_GT, "expected '>'");
         int first_access = (!strcmp(first, "read") || !strcmp(first, "write") || !strcmp(first, "read_write"));
@@ -608,15 +650,10 @@ static WgslAstNode *parse_global_var(Parser *P, WgslAstNode **attrs, int attr_co
         }
         if (first_addr) {
             addr_space = first;
-            if (second)
-                NODE_FREE(second);
         } else if (second && second_addr) {
             addr_space = second;
-            NODE_FREE(first);
         } else {
             addr_space = first;
-            if (second)
-                NODE_FREE(second);
         }
     }
     if (!check(P, TOK_IDENT)) {
@@ -634,9 +671,9 @@ static WgslAstNode *parse_global_var(Parser *P, WgslAstNode **attrs, int attr_co
     G->global_var.address_space = addr_space;
     if(access_text_cache[0] != '\0'){
         access_text_cache[31] = '\0';
-        G->global_var.access_modifier = wgsl_strdup(access_text_cache);
+        G->global_var.access_modifier = intern_cstr(P, access_text_cache);
     }
-    G->global_var.name = wgsl_strndup(name.start, (size_t)name.length);
+    G->global_var.name = intern_tok(P, &name);
     G->global_var.type = T;
     return G;
 }
@@ -655,7 +692,7 @@ static WgslAstNode *parse_param(Parser *P) {
     WgslAstNode *Par = new_node(P, WGSL_NODE_PARAM);
     Par->param.attr_count = acount;
     Par->param.attrs = attrs;
-    Par->param.name = wgsl_strndup(name.start, (size_t)name.length);
+    Par->param.name = intern_tok(P, &name);
     Par->param.type = T;
     return Par;
 }
@@ -669,19 +706,20 @@ static WgslAstNode *parse_function(Parser *P, WgslAstNode **attrs, int attr_coun
     Token name = P->cur;
     advance(P);
     expect(P, TOK_LPAREN, "expected '('");
-    int pcap = 0, pcount = 0;
-    WgslAstNode **params = NULL;
+    const int base = P->list_count;
     if (!check(P, TOK_RPAREN)) {
         WgslAstNode *par = parse_param(P);
         if (par)
-            vec_push_node(&params, &pcount, &pcap, par);
+            list_push(P, par, 0);
         while (match(P, TOK_COMMA)) {
             WgslAstNode *par2 = parse_param(P);
             if (par2)
-                vec_push_node(&params, &pcount, &pcap, par2);
+                list_push(P, par2, 0);
         }
     }
     expect(P, TOK_RPAREN, "expected ')'");
+    int pcount = 0;
+    WgslAstNode **params = list_take(P, base, &pcount);
     WgslAstNode **ret_attrs = NULL;
     int ret_acount = 0;
     WgslAstNode *ret_type = NULL;
@@ -693,7 +731,7 @@ static WgslAstNode *parse_function(Parser *P, WgslAstNode **attrs, int attr_coun
     WgslAstNode *F = new_node(P, WGSL_NODE_FUNCTION);
     F->function.attr_count = attr_count;
     F->function.attrs = attrs;
-    F->function.name = wgsl_strndup(name.start, (size_t)name.length);
+    F->function.name = intern_tok(P, &name);
     F->function.param_count = pcount;
     F->function.params = params;
     F->function.ret_attr_count = ret_acount;
@@ -706,16 +744,20 @@ static WgslAstNode *parse_function(Parser *P, WgslAstNode **attrs, int attr_coun
 static WgslAstNode *parse_block(Parser *P) {
     expect(P, TOK_LBRACE, "expected '{'");
     WgslAstNode *B = new_node(P, WGSL_NODE_BLOCK);
-    int cap = 0, count = 0;
-    WgslAstNode **stmts = NULL;
+    const int base = P->list_count;
     while (!check(P, TOK_RBRACE) && !check(P, TOK_EOF)) {
+        const char *before = P->cur.start;
         WgslAstNode *s = parse_statement(P);
         if (s)
-            vec_push_node(&stmts, &count, &cap, s);
+            list_push(P, s, 0);
+        /* A statement that consumed nothing would be parsed again forever, skip the offending token */
+        if (P->cur.start == before) {
+            parse_error(P, "unexpected token in statement");
+            advance(P);
+        }
     }
     expect(P, TOK_RBRACE, "expected '}'");
-    B->block.stmt_count = count;
-    B->block.stmts = stmts;
+    B->block.stmts = list_take(P, base, &B->block.stmt_count);
     return B;
 }
 
@@ -806,7 +848,7 @@ static WgslAstNode *parse_statement(Parser *P) {
             init = parse_expr(P);
         expect(P, TOK_SEMI, "expected ';'");
         WgslAstNode *V = new_node(P, WGSL_NODE_VAR_DECL);
-        V->var_decl.name = wgsl_strndup(name.start, (size_t)name.length);
+        V->var_decl.name = intern_tok(P, &name);
         V->var_decl.type = type;
         V->var_decl.init = init;
         return V;
@@ -827,7 +869,7 @@ static WgslAstNode *parse_statement(Parser *P) {
         WgslAstNode *init = parse_expr(P);
         expect(P, TOK_SEMI, "expected ';'");
         WgslAstNode *V = new_node(P, WGSL_NODE_VAR_DECL);
-        V->var_decl.name = wgsl_strndup(name.start, (size_t)name.length);
+        V->var_decl.name = intern_tok(P, &name);
         V->var_decl.type = type;
         V->var_decl.init = init;
         return V;
@@ -883,7 +925,7 @@ static WgslAstNode *parse_logical_or(Parser *P) {
     while (match(P, TOK_OROR)) {
         WgslAstNode *right = parse_logical_and(P);
         WgslAstNode *B = new_node(P, WGSL_NODE_BINARY);
-        B->binary.op = wgsl_strdup("||");
+        B->binary.op = intern_cstr(P, "||");
         B->binary.left = left;
         B->binary.right = right;
         left = B;
@@ -891,12 +933,20 @@ static WgslAstNode *parse_logical_or(Parser *P) {
     return left;
 }
 
+static WgslAstNode *new_binary(Parser *P, const char *op, WgslAstNode *left, WgslAstNode *right) {
+    WgslAstNode *B = new_node(P, WGSL_NODE_BINARY);
+    B->binary.op = intern_cstr(P, op);
+    B->binary.left = left;
+    B->binary.right = right;
+    return B;
+}
+
 static WgslAstNode *parse_logical_and(Parser *P) {
-    WgslAstNode *left = parse_equality(P);
+    WgslAstNode *left = parse_bitwise_or(P);
     while (match(P, TOK_ANDAND)) {
-        WgslAstNode *right = parse_equality(P);
+        WgslAstNode *right = parse_bitwise_or(P);
         WgslAstNode *B = new_node(P, WGSL_NODE_BINARY);
-        B->binary.op = wgsl_strdup("&&");
+        B->binary.op = intern_cstr(P, "&&");
         B->binary.left = left;
         B->binary.right = right;
         left = B;
@@ -904,13 +954,34 @@ static WgslAstNode *parse_logical_and(Parser *P) {
     return left;
 }
 
+static WgslAstNode *parse_bitwise_or(Parser *P) {
+    WgslAstNode *left = parse_bitwise_xor(P);
+    while (match(P, TOK_PIPE))
+        left = new_binary(P, "|", left, parse_bitwise_xor(P));
+    return left;
+}
+
+static WgslAstNode *parse_bitwise_xor(Parser *P) {
+    WgslAstNode *left = parse_bitwise_and(P);
+    while (match(P, TOK_CARET))
+        left = new_binary(P, "^", left, parse_bitwise_and(P));
+    return left;
+}
+
+static WgslAstNode *parse_bitwise_and(Parser *P) {
+    WgslAstNode *left = parse_equality(P);
+    while (match(P, TOK_AMP))
+        left = new_binary(P, "&", left, parse_equality(P));
+    return left;
+}
+
 static WgslAstNode *parse_equality(Parser *P) {
     WgslAstNode *left = parse_relational(P);
     for (;;) {
         if (match(P, TOK_EQEQ)) {
             WgslAstNode *r = parse_relational(P);
             WgslAstNode *B = new_node(P, WGSL_NODE_BINARY);
-            B->binary.op = wgsl_strdup("==");
+            B->binary.op = intern_cstr(P, "==");
             B->binary.left = left;
             B->binary.right = r;
             left = B;
@@ -919,7 +990,7 @@ static WgslAstNode *parse_equality(Parser *P) {
         if (match(P, TOK_NEQ)) {
             WgslAstNode *r = parse_relational(P);
             WgslAstNode *B = new_node(P, WGSL_NODE_BINARY);
-            B->binary.op = wgsl_strdup("!=");
+            B->binary.op = intern_cstr(P, "!=");
             B->binary.left = left;
             B->binary.right = r;
             left = B;
@@ -931,39 +1002,39 @@ static WgslAstNode *parse_equality(Parser *P) {
 }
 
 static WgslAstNode *parse_relational(Parser *P) {
-    WgslAstNode *left = parse_additive(P);
+    WgslAstNode *left = parse_shift(P);
     for (;;) {
         if (match(P, TOK_LT)) {
-            WgslAstNode *r = parse_additive(P);
+            WgslAstNode *r = parse_shift(P);
             WgslAstNode *B = new_node(P, WGSL_NODE_BINARY);
-            B->binary.op = wgsl_strdup("<");
+            B->binary.op = intern_cstr(P, "<");
             B->binary.left = left;
             B->binary.right = r;
             left = B;
             continue;
         }
         if (match(P, TOK_GT)) {
-            WgslAstNode *r = parse_additive(P);
+            WgslAstNode *r = parse_shift(P);
             WgslAstNode *B = new_node(P, WGSL_NODE_BINARY);
-            B->binary.op = wgsl_strdup(">");
+            B->binary.op = intern_cstr(P, ">");
             B->binary.left = left;
             B->binary.right = r;
             left = B;
             continue;
         }
         if (match(P, TOK_LE)) {
-            WgslAstNode *r = parse_additive(P);
+            WgslAstNode *r = parse_shift(P);
             WgslAstNode *B = new_node(P, WGSL_NODE_BINARY);
-            B->binary.op = wgsl_strdup("<=");
+            B->binary.op = intern_cstr(P, "<=");
             B->binary.left = left;
             B->binary.right = r;
             left = B;
             continue;
         }
         if (match(P, TOK_GE)) {
-            WgslAstNode *r = parse_additive(P);
+            WgslAstNode *r = parse_shift(P);
             WgslAstNode *B = new_node(P, WGSL_NODE_BINARY);
-            B->binary.op = wgsl_strdup(">=");
+            B->binary.op = intern_cstr(P, ">=");
             B->binary.left = left;
             B->binary.right = r;
             left = B;
@@ -974,13 +1045,31 @@ static WgslAstNode *parse_relational(Parser *P) {
     return left;
 }
 
+/* '<<' and '>>' are lexed as two adjacent '<' or '>' tokens, which keeps nested template lists like
+   array<vec4<f32>> intact */
+static bool at_shift(Parser *P, TokenType t) { return check(P, t) && P->cur.start[1] == P->cur.start[0]; }
+
+static WgslAstNode *parse_shift(Parser *P) {
+    WgslAstNode *left = parse_additive(P);
+    for (;;) {
+        const char *op = at_shift(P, TOK_LT) ? "<<" : at_shift(P, TOK_GT) ? ">>" : NULL;
+        if (!op)
+            break;
+        const TokenType t = P->cur.type;
+        advance(P);
+        expect(P, t, "expected shift operator");
+        left = new_binary(P, op, left, parse_additive(P));
+    }
+    return left;
+}
+
 static WgslAstNode *parse_additive(Parser *P) {
     WgslAstNode *left = parse_multiplicative(P);
     for (;;) {
         if (match(P, TOK_PLUS)) {
             WgslAstNode *r = parse_multiplicative(P);
             WgslAstNode *B = new_node(P, WGSL_NODE_BINARY);
-            B->binary.op = wgsl_strdup("+");
+            B->binary.op = intern_cstr(P, "+");
             B->binary.left = left;
             B->binary.right = r;
             left = B;
@@ -989,7 +1078,7 @@ static WgslAstNode *parse_additive(Parser *P) {
         if (match(P, TOK_MINUS)) {
             WgslAstNode *r = parse_multiplicative(P);
             WgslAstNode *B = new_node(P, WGSL_NODE_BINARY);
-            B->binary.op = wgsl_strdup("-");
+            B->binary.op = intern_cstr(P, "-");
             B->binary.left = left;
             B->binary.right = r;
             left = B;
@@ -1006,7 +1095,7 @@ static WgslAstNode *parse_multiplicative(Parser *P) {
         if (match(P, TOK_STAR)) {
             WgslAstNode *r = parse_unary(P);
             WgslAstNode *B = new_node(P, WGSL_NODE_BINARY);
-            B->binary.op = wgsl_strdup("*");
+            B->binary.op = intern_cstr(P, "*");
             B->binary.left = left;
             B->binary.right = r;
             left = B;
@@ -1015,12 +1104,16 @@ static WgslAstNode *parse_multiplicative(Parser *P) {
         if (match(P, TOK_SLASH)) {
             WgslAstNode *r = parse_unary(P);
             WgslAstNode *B = new_node(P, WGSL_NODE_BINARY);
-            B->binary.op = wgsl_strdup("/");
+            B->binary.op = intern_cstr(P, "/");
             B->binary.left = left;
             B->binary.right = r;
             left = B;
             continue;
         }
+        if (match(P, TOK_PERCENT)) {
+            left = new_binary(P, "%", left, parse_unary(P));
+            continue;
+        }
         break;
     }
     return left;
@@ -1030,7 +1123,7 @@ static WgslAstNode *parse_unary(Parser *P) {
     if (match(P, TOK_PLUSPLUS)) {
         WgslAstNode *e = parse_unary(P);
         WgslAstNode *U = new_node(P, WGSL_NODE_UNARY);
-        U->unary.op = wgsl_strdup("++");
+        U->unary.op = intern_cstr(P, "++");
         U->unary.is_postfix = 0;
         U->unary.expr = e;
         return U;
@@ -1038,7 +1131,7 @@ static WgslAstNode *parse_unary(Parser *P) {
     if (match(P, TOK_MINUSMINUS)) {
         WgslAstNode *e = parse_unary(P);
         WgslAstNode *U = new_node(P, WGSL_NODE_UNARY);
-        U->unary.op = wgsl_strdup("--");
+        U->unary.op = intern_cstr(P, "--");
         U->unary.is_postfix = 0;
         U->unary.expr = e;
         return U;
@@ -1046,7 +1139,7 @@ static WgslAstNode *parse_unary(Parser *P) {
     if (match(P, TOK_PLUS)) {
         WgslAstNode *e = parse_unary(P);
         WgslAstNode *U = new_node(P, WGSL_NODE_UNARY);
-        U->unary.op = wgsl_strdup("+");
+        U->unary.op = intern_cstr(P, "+");
         U->unary.is_postfix = 0;
         U->unary.expr = e;
         return U;
@@ -1054,7 +1147,7 @@ static WgslAstNode *parse_unary(Parser *P) {
     if (match(P, TOK_MINUS)) {
         WgslAstNode *e = parse_unary(P);
         WgslAstNode *U = new_node(P, WGSL_NODE_UNARY);
-        U->unary.op = wgsl_strdup("-");
+        U->unary.op = intern_cstr(P, "-");
         U->unary.is_postfix = 0;
         U->unary.expr = e;
         return U;
@@ -1062,7 +1155,7 @@ static WgslAstNode *parse_unary(Parser *P) {
     if (match(P, TOK_BANG)) {
         WgslAstNode *e = parse_unary(P);
         WgslAstNode *U = new_node(P, WGSL_NODE_UNARY);
-        U->unary.op = wgsl_strdup("!");
+        U->unary.op = intern_cstr(P, "!");
         U->unary.is_postfix = 0;
         U->unary.expr = e;
         return U;
@@ -1070,7 +1163,24 @@ static WgslAstNode *parse_unary(Parser *P) {
     if (match(P, TOK_TILDE)) {
         WgslAstNode *e = parse_unary(P);
         WgslAstNode *U = new_node(P, WGSL_NODE_UNARY);
-        U->unary.op = wgsl_strdup("~");
+        U->unary.op = intern_cstr(P, "~");
+        U->unary.is_postfix = 0;
+        U->unary.expr = e;
+        return U;
+    }
+    // Address-of and indirection, e.g. atomicAdd(&counter, 1u)
+    if (match(P, TOK_AMP)) {
+        WgslAstNode *e = parse_unary(P);
+        WgslAstNode *U = new_node(P, WGSL_NODE_UNARY);
+        U->unary.op = intern_cstr(P, "&");
+        U->unary.is_postfix = 0;
+        U->unary.expr = e;
+        return U;
+    }
+    if (match(P, TOK_STAR)) {
+        WgslAstNode *e = parse_unary(P);
+        WgslAstNode *U = new_node(P, WGSL_NODE_UNARY);
+        U->unary.op = intern_cstr(P, "*");
         U->unary.is_postfix = 0;
         U->unary.expr = e;
         return U;
@@ -1082,23 +1192,21 @@ static WgslAstNode *parse_postfix(Parser *P) {
     WgslAstNode *expr = parse_primary(P);
     for (;;) {
         if (match(P, TOK_LPAREN)) {
-            int cap = 0, count = 0;
-            WgslAstNode **args = NULL;
+            const int base = P->list_count;
             if (!check(P, TOK_RPAREN)) {
                 WgslAstNode *a = parse_expr(P);
                 if (a)
-                    vec_push_node(&args, &count, &cap, a);
+                    list_push(P, a, 0);
                 while (match(P, TOK_COMMA)) {
                     WgslAstNode *a2 = parse_expr(P);
                     if (a2)
-                        vec_push_node(&args, &count, &cap, a2);
+                        list_push(P, a2, 0);
                 }
             }
             expect(P, TOK_RPAREN, "expected ')'");
             WgslAstNode *C = new_node(P, WGSL_NODE_CALL);
             C->call.callee = expr;
-            C->call.arg_count = count;
-            C->call.args = args;
+            C->call.args = list_take(P, base, &C->call.arg_count);
             expr = C;
             continue;
         }
@@ -1120,13 +1228,13 @@ static WgslAstNode *parse_postfix(Parser *P) {
             advance(P);
             WgslAstNode *M = new_node(P, WGSL_NODE_MEMBER);
             M->member.object = expr;
-            M->member.member = wgsl_strndup(mem.start, (size_t)mem.length);
+            M->member.member = intern_tok(P, &mem);
             expr = M;
             continue;
         }
         if (match(P, TOK_PLUSPLUS)) {
             WgslAstNode *U = new_node(P, WGSL_NODE_UNARY);
-            U->unary.op = wgsl_strdup("++");
+            U->unary.op = intern_cstr(P, "++");
             U->unary.is_postfix = 1;
             U->unary.expr = expr;
             expr = U;
@@ -1134,7 +1242,7 @@ static WgslAstNode *parse_postfix(Parser *P) {
         }
         if (match(P, TOK_MINUSMINUS)) {
             WgslAstNode *U = new_node(P, WGSL_NODE_UNARY);
-            U->unary.op = wgsl_strdup("--");
+            U->unary.op = intern_cstr(P, "--");
             U->unary.is_postfix = 1;
             U->unary.expr = expr;
             expr = U;
@@ -1203,15 +1311,6 @@ static WgslAstNode *parse_primary(Parser *P) {
 
 static void skip_optional_comma(Parser *P) { match(P, TOK_COMMA); }
 
-static void discard_attrs(WgslAstNode **attrs, int count) {
-    if (!attrs)
-        return;
-    extern void wgsl_free_ast(WgslAstNode *);
-    for (int i = 0; i < count; ++i)
-        wgsl_free_ast(attrs[i]);
-    NODE_FREE(attrs);
-}
-
 static WgslAstNode *parse_const_decl(Parser *P) {
     expect(P, TOK_CONST, "expected 'const'");
     if (!check(P, TOK_IDENT)) {
@@ -1228,7 +1327,7 @@ static WgslAstNode *parse_const_decl(Parser *P) {
     WgslAstNode *init = parse_expr(P);
     expect(P, TOK_SEMI, "expected ';'");
     WgslAstNode *V = new_node(P, WGSL_NODE_VAR_DECL);
-    V->var_decl.name = wgsl_strndup(name.start, (size_t)name.length);
+    V->var_decl.name = intern_tok(P, &name);
     V->var_decl.type = type;
     V->var_decl.init = init;
     return V;
@@ -1250,7 +1349,7 @@ static WgslAstNode *parse_override_decl(Parser *P) {
         init = parse_expr(P);
     expect(P, TOK_SEMI, "expected ';'");
     WgslAstNode *V = new_node(P, WGSL_NODE_VAR_DECL);
-    V->var_decl.name = wgsl_strndup(name.start, (size_t)name.length);
+    V->var_decl.name = intern_tok(P, &name);
     V->var_decl.type = type;
     V->var_decl.init = init;
     return V;
@@ -1265,35 +1364,31 @@ static WgslAstNode *parse_decl_or_stmt(Parser *P) {
         return parse_global_var(P, attrs, acount);
     if (check(P, TOK_FN))
         return parse_function(P, attrs, acount);
-    if (check(P, TOK_CONST)) {
-        if (acount)
-            discard_attrs(attrs, acount);
+    /* Attributes on const/override are dropped, the arena reclaims them with the tree */
+    if (check(P, TOK_CONST))
         return parse_const_decl(P);
-    }
-    if (check(P, TOK_OVERRIDE)) {
-        if (acount)
-            discard_attrs(attrs, acount);
+    if (check(P, TOK_OVERRIDE))
         return parse_override_decl(P);
-    }
     parse_error(P, "expected 'struct', 'var', 'fn', 'const', or 'override' at top level");
-    if (acount)
-        discard_attrs(attrs, acount);
     return NULL;
 }
 
 static WgslAstNode *parse_program(Parser *P) {
     WgslAstNode *root = new_node(P, WGSL_NODE_PROGRAM);
-    int cap = 0, count = 0;
-    WgslAstNode **decls = NULL;
+    const int base = P->list_count;
     while (!check(P, TOK_EOF)) {
+        const char *before = P->cur.start;
         WgslAstNode *d = parse_decl_or_stmt(P);
         if (d)
-            vec_push_node(&decls, &count, &cap, d);
+            list_push(P, d, 0);
         else
             break;
+        if (P->cur.start == before) {
+            parse_error(P, "unexpected token at top level");
+            advance(P);
+        }
     }
-    root->program.decl_count = count;
-    root->program.decls = decls;
+    root->program.decls = list_take(P, base, &root->program.decl_count);
     return root;
 }
 
@@ -1306,183 +1401,25 @@ WgslAstNode *wgsl_parse(const char *source) {
     P.L.col = 1;
     advance(&P);
     WgslAstNode *ast = parse_program(&P);
+    NODE_FREE(P.list);
+    /* The arena descriptor lives in the arena itself and is copied in after its own allocation */
+    WgslArena *home = ast ? (WgslArena *)wgsl_arena_alloc(&P.arena, sizeof(WgslArena)) : NULL;
+    if (!home) {
+        wgsl_arena_free(&P.arena);
+        return NULL;
+    }
+    *home = P.arena;
+    ast->program.arena = home;
+    ast->program.error_count = P.error_count;
     return ast;
 }
 
-static void free_node(WgslAstNode *n);
-
-static void free_node_list(WgslAstNode **list, int count) {
-    if (!list)
+void wgsl_free_ast(WgslAstNode *node) {
+    if (!node || node->type != WGSL_NODE_PROGRAM || !node->program.arena)
         return;
-    for (int i = 0; i < count; ++i)
-        free_node(list[i]);
-    NODE_FREE(list);
-}
-static void free_string(char *s) {
-    if (s)
-        NODE_FREE(s);
-}
-static void free_attribute(Attribute *a) {
-    free_string(a->name);
-    free_node_list(a->args, a->arg_count);
-}
-static void free_type(TypeNode *t) {
-    free_string(t->name);
-    free_node_list(t->type_args, t->type_arg_count);
-    free_node_list(t->expr_args, t->expr_arg_count);
+    WgslArena arena = *(WgslArena *)node->program.arena;
+    wgsl_arena_free(&arena);
 }
-static void free_struct_field(StructField *f) {
-    free_node_list(f->attrs, f->attr_count);
-    free_string(f->name);
-    free_node(f->type);
-}
-static void free_struct_decl(StructDecl *s) {
-    free_node_list(s->attrs, s->attr_count);
-    free_string(s->name);
-    free_node_list(s->fields, s->field_count);
-}
-static void free_global_var(GlobalVar *g) {
-    free_node_list(g->attrs, g->attr_count);
-    free_string(g->address_space);
-    free_string(g->name);
-    free_node(g->type);
-}
-static void free_param(Param *p) {
-    free_node_list(p->attrs, p->attr_count);
-    free_string(p->name);
-    free_node(p->type);
-}
-static void free_block(Block *b) { free_node_list(b->stmts, b->stmt_count); }
-static void free_var_decl(VarDecl *v) {
-    free_string(v->name);
-    free_node(v->type);
-    free_node(v->init);
-}
-static void free_function(Function *f) {
-    free_node_list(f->attrs, f->attr_count);
-    free_string(f->name);
-    free_node_list(f->params, f->param_count);
-    free_node_list(f->ret_attrs, f->ret_attr_count);
-    free_node(f->return_type);
-    free_node(f->body);
-}
-static void free_binary(Binary *b) {
-    free_string(b->op);
-    free_node(b->left);
-    free_node(b->right);
-}
-static void free_call(Call *c) {
-    free_node(c->callee);
-    free_node_list(c->args, c->arg_count);
-}
-static void free_member(Member *m) {
-    free_node(m->object);
-    free_string(m->member);
-}
-static void free_index(Index *i) {
-    free_node(i->object);
-    free_node(i->index);
-}
-static void free_unary(Unary *u) {
-    free_string(u->op);
-    free_node(u->expr);
-}
-static void free_ternary(Ternary *t) {
-    free_node(t->cond);
-    free_node(t->then_expr);
-    free_node(t->else_expr);
-}
-
-static void free_node(WgslAstNode *n) {
-    if (!n)
-        return;
-    switch (n->type) {
-    case WGSL_NODE_PROGRAM:
-        free_node_list(n->program.decls, n->program.decl_count);
-        break;
-    case WGSL_NODE_ATTRIBUTE:
-        free_attribute(&n->attribute);
-        break;
-    case WGSL_NODE_TYPE:
-        free_type(&n->type_node);
-        break;
-    case WGSL_NODE_STRUCT:
-        free_struct_decl(&n->struct_decl);
-        break;
-    case WGSL_NODE_STRUCT_FIELD:
-        free_struct_field(&n->struct_field);
-        break;
-    case WGSL_NODE_GLOBAL_VAR:
-        free_global_var(&n->global_var);
-        break;
-    case WGSL_NODE_FUNCTION:
-        free_function(&n->function);
-        break;
-    case WGSL_NODE_PARAM:
-        free_param(&n->param);
-        break;
-    case WGSL_NODE_BLOCK:
-        free_block(&n->block);
-        break;
-    case WGSL_NODE_VAR_DECL:
-        free_var_decl(&n->var_decl);
-        break;
-    case WGSL_NODE_RETURN:
-        free_node(n->return_stmt.expr);
-        break;
-    case WGSL_NODE_EXPR_STMT:
-        free_node(n->expr_stmt.expr);
-        break;
-    case WGSL_NODE_IDENT:
-        free_string(n->ident.name);
-        break;
-    case WGSL_NODE_LITERAL:
-        free_string(n->literal.lexeme);
-        break;
-    case WGSL_NODE_BINARY:
-        free_binary(&n->binary);
-        break;
-    case WGSL_NODE_ASSIGN:
-        free_node(n->assign.lhs);
-        free_node(n->assign.rhs);
-        break;
-    case WGSL_NODE_CALL:
-        free_call(&n->call);
-        break;
-    case WGSL_NODE_MEMBER:
-        free_member(&n->member);
-        break;
-    case WGSL_NODE_INDEX:
-        free_index(&n->index);
-        break;
-    case WGSL_NODE_IF:
-        free_node(n->if_stmt.cond);
-        free_node(n->if_stmt.then_branch);
-        free_node(n->if_stmt.else_branch);
-        break;
-    case WGSL_NODE_WHILE:
-        free_node(n->while_stmt.cond);
-        free_node(n->while_stmt.body);
-        break;
-    case WGSL_NODE_FOR:
-        free_node(n->for_stmt.init);
-        free_node(n->for_stmt.cond);
-        free_node(n->for_stmt.cont);
-        free_node(n->for_stmt.body);
-        break;
-    case WGSL_NODE_UNARY:
-        free_unary(&n->unary);
-        break;
-    case WGSL_NODE_TERNARY:
-        free_ternary(&n->ternary);
-        break;
-    default:
-        break;
-    }
-    NODE_FREE(n);
-}
-
-void wgsl_free_ast(WgslAstNode *node) { free_node(node); }
 
 const char *wgsl_node_type_name(WgslNodeType t) {
     switch (t) {
@@ -195,6 +195,8 @@ typedef struct Ternary {
 typedef struct Program {
     int decl_count;
     WgslAstNode **decls;
+    void *arena; /* Owns all nodes, arrays and strings of the tree */
+    int error_count; /* Syntax errors reported while parsing, the tree is best effort if nonzero */
 } Program;
 
 typedef struct WgslAstNode {
@@ -229,7 +231,9 @@ typedef struct WgslAstNode {
     };
 } WgslAstNode;
 
+/* Strings in the tree are interned: equal identifiers share one pointer and must not be modified */
 WgslAstNode *wgsl_parse(const char *source);
+/* Releases the whole tree, only the PROGRAM node returned by wgsl_parse can be freed */
 void wgsl_free_ast(WgslAstNode *node);
 const char *wgsl_node_type_name(WgslNodeType t);
 void wgsl_debug_print(const WgslAstNode *node, int indent);
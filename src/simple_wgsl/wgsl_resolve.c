@@ -1,6 +1,7 @@
 /* wgsl_resolve.c */
 
 #include "wgsl_resolve.h"
+#include "wgsl_arena.h"
 #include <ctype.h>
 #include <stdlib.h>
 #include <string.h>
@@ -8,16 +9,8 @@
 typedef struct {
     const char* name;
     int id;
-} NameId;
-typedef struct {
-    NameId* items;
-    int count;
-    int cap;
-} Scope;
-typedef struct {
-    const char* name;
-    const WgslAstNode* node;
-} NamedNode;
+    int prev; /* binding visible under the same name before this one, or -1 */
+} ScopeBinding;
 typedef struct {
     const WgslAstNode* ident;
     int id;
@@ -29,12 +22,14 @@ typedef struct {
     int direct_syms_count, direct_syms_cap;
     int* direct_syms; /* symbol ids (1-based) */
     int calls_count, calls_cap;
-    const char** calls; /* callee names */
+    int* calls; /* callee indices into fn_infos */
     int is_entry;
     WgslStage stage;
 } FnInfo;
 
+/* The resolver lives in its own arena together with every table it builds */
 struct WgslResolver {
+    WgslArena arena;
     const WgslAstNode* program;
 
     WgslSymbolInfo* symbols;
@@ -42,18 +37,26 @@ struct WgslResolver {
 
     IdentBind* refmap;
     int ref_count, ref_cap;
+    int* ref_slots; /* open addressing index over refmap by node pointer, holds refmap index + 1 */
+    int ref_slot_cap;
 
-    NamedNode* structs;
-    int struct_count, struct_cap;
-
-    NamedNode* functions;
-    int fn_decl_count, fn_decl_cap;
+    WgslNameMap structs;   /* name -> index into program decls */
+    WgslNameMap functions; /* name -> index into fn_infos */
 
     FnInfo* fn_infos;
-    int fn_info_count, fn_info_cap;
+    int fn_info_count;
 
-    Scope* scopes;
+    /* Scopes are a stack of bindings with marks, visible maps each name to its innermost binding */
+    ScopeBinding* bindings;
+    int binding_count, binding_cap;
+    int* scope_marks;
     int scope_count, scope_cap;
+    WgslNameMap visible;
+
+    /* Dedup markers for the function currently being walked, hold its fn_infos index + 1 */
+    int* sym_mark;
+    int sym_mark_count;
+    int* call_mark;
 };
 
 /* basic utils */
@@ -72,48 +75,52 @@ static void vec_grow(void** ptr, int* cap, size_t elsz) {
         *ptr = p;
     }
 }
+/* vec_grow for tables owned by the resolver arena */
+static void resolver_grow(WgslResolver* r, void** ptr, int* cap, size_t elsz) {
+    int new_cap = *cap ? *cap * 2 : 8;
+    void* p = wgsl_arena_grow(&r->arena, *ptr, (size_t)*cap * elsz, (size_t)new_cap * elsz);
+    if (!p) return;
+    *cap = new_cap;
+    *ptr = p;
+}
 
 /* scopes */
 static void scope_push(WgslResolver* r) {
     if (r->scope_count >= r->scope_cap)
-        vec_grow((void**)&r->scopes, &r->scope_cap, sizeof(Scope));
+        resolver_grow(r, (void**)&r->scope_marks, &r->scope_cap, sizeof(int));
     if (r->scope_count >= r->scope_cap) return; /* allocation failed */
-    r->scopes[r->scope_count].items = NULL;
-    r->scopes[r->scope_count].count = 0;
-    r->scopes[r->scope_count].cap = 0;
-    r->scope_count++;
+    r->scope_marks[r->scope_count++] = r->binding_count;
 }
 static void scope_pop(WgslResolver* r) {
     if (r->scope_count == 0)
         return;
-    Scope* s = &r->scopes[r->scope_count - 1];
-    NODE_FREE(s->items);
-    r->scope_count--;
+    const int mark = r->scope_marks[--r->scope_count];
+    while (r->binding_count > mark) {
+        const ScopeBinding* b = &r->bindings[--r->binding_count];
+        wgsl_name_map_put(&r->arena, &r->visible, b->name, b->prev, 0);
+    }
 }
 static void scope_put(WgslResolver* r, const char* name, int id) {
-    if (r->scope_count <= 0) return;
-    Scope* s = &r->scopes[r->scope_count - 1];
-    if (s->count >= s->cap)
-        vec_grow((void**)&s->items, &s->cap, sizeof(NameId));
-    if (s->count >= s->cap) return; /* allocation failed */
-    s->items[s->count].name = name;
-    s->items[s->count].id = id;
-    s->count++;
+    if (r->scope_count <= 0 || !name) return;
+    if (r->binding_count >= r->binding_cap)
+        resolver_grow(r, (void**)&r->bindings, &r->binding_cap, sizeof(ScopeBinding));
+    if (r->binding_count >= r->binding_cap) return; /* allocation failed */
+    ScopeBinding* b = &r->bindings[r->binding_count];
+    b->name = name;
+    b->id = id;
+    b->prev = wgsl_name_map_get(&r->visible, name, -1);
+    wgsl_name_map_put(&r->arena, &r->visible, name, r->binding_count, 0);
+    r->binding_count++;
 }
 static int scope_get(const WgslResolver* r, const char* name) {
-    for (int si = r->scope_count - 1; si >= 0; si--) {
-        const Scope* s = &r->scopes[si];
-        for (int i = s->count - 1; i >= 0; i--)
-            if (str_eq(s->items[i].name, name))
-                return s->items[i].id;
-    }
-    return -1;
+    const int i = wgsl_name_map_get(&r->visible, name, -1);
+    return i >= 0 ? r->bindings[i].id : -1;
 }
 
 /* symbols */
 static void add_symbol(WgslResolver* r, WgslSymbolInfo s) {
     if (r->sym_count >= r->sym_cap)
-        vec_grow((void**)&r->symbols, &r->sym_cap, sizeof(WgslSymbolInfo));
+        resolver_grow(r, (void**)&r->symbols, &r->sym_cap, sizeof(WgslSymbolInfo));
     if (r->sym_count >= r->sym_cap) return; /* allocation failed */
     r->symbols[r->sym_count++] = s;
 }
@@ -122,7 +129,7 @@ static void bind_ident(WgslResolver* r, const WgslAstNode* ident, int id) {
     if (!ident || ident->type != WGSL_NODE_IDENT)
         return;
     if (r->ref_count >= r->ref_cap)
-        vec_grow((void**)&r->refmap, &r->ref_cap, sizeof(IdentBind));
+        resolver_grow(r, (void**)&r->refmap, &r->ref_cap, sizeof(IdentBind));
     if (r->ref_count >= r->ref_cap) return; /* allocation failed */
     r->refmap[r->ref_count].ident = ident;
     r->refmap[r->ref_count].id = id;
@@ -194,77 +201,39 @@ static int parse_int_lexeme(const char* s) {
 static int attr_first_arg_int(const WgslAstNode* a) { return parse_int_lexeme(attr_first_arg_string(a)); }
 
 /* lookups */
-static const WgslAstNode* find_function(const WgslAstNode* program, const char* name) {
-    if (!program || program->type != WGSL_NODE_PROGRAM)
-        return NULL;
-    for (int i = 0; i < program->program.decl_count; i++) {
-        const WgslAstNode* n = program->program.decls[i];
-        if (n && n->type == WGSL_NODE_FUNCTION && n->function.name && str_eq(n->function.name, name))
-            return n;
-    }
-    return NULL;
-}
-static void add_struct(WgslResolver* r, const char* name, const WgslAstNode* node) {
-    if (!name)
-        return;
-    if (r->struct_count >= r->struct_cap)
-        vec_grow((void**)&r->structs, &r->struct_cap, sizeof(NamedNode));
-    if (r->struct_count >= r->struct_cap) return; /* allocation failed */
-    r->structs[r->struct_count].name = name;
-    r->structs[r->struct_count].node = node;
-    r->struct_count++;
+static const WgslAstNode* find_function(const WgslResolver* r, const char* name) {
+    const int i = wgsl_name_map_get(&r->functions, name, -1);
+    return i >= 0 ? r->fn_infos[i].fn : NULL;
 }
 static const WgslAstNode* get_struct(const WgslResolver* r, const char* name) {
-    for (int i = 0; i < r->struct_count; i++)
-        if (str_eq(r->structs[i].name, name))
-            return r->structs[i].node;
-    return NULL;
+    const int i = wgsl_name_map_get(&r->structs, name, -1);
+    return i >= 0 ? r->program->program.decls[i] : NULL;
 }
-static void add_function_decl(WgslResolver* r, const char* name, const WgslAstNode* node) {
-    if (!name)
+static void record_fn_ref(WgslResolver* r, FnInfo* fi, int sym_id) {
+    if (!fi || sym_id <= 0 || sym_id >= r->sym_mark_count)
         return;
-    if (r->fn_decl_count >= r->fn_decl_cap)
-        vec_grow((void**)&r->functions, &r->fn_decl_cap, sizeof(NamedNode));
-    if (r->fn_decl_count >= r->fn_decl_cap) return; /* allocation failed */
-    r->functions[r->fn_decl_count].name = name;
-    r->functions[r->fn_decl_count].node = node;
-    r->fn_decl_count++;
-}
-static FnInfo* ensure_fn_info(WgslResolver* r, const WgslAstNode* fn) {
-    for (int i = 0; i < r->fn_info_count; i++)
-        if (r->fn_infos[i].fn == fn)
-            return &r->fn_infos[i];
-    if (r->fn_info_count >= r->fn_info_cap)
-        vec_grow((void**)&r->fn_infos, &r->fn_info_cap, sizeof(FnInfo));
-    if (r->fn_info_count >= r->fn_info_cap) return NULL; /* allocation failed */
-    FnInfo* fi = &r->fn_infos[r->fn_info_count++];
-    memset(fi, 0, sizeof(*fi));
-    fi->fn = fn;
-    fi->name = fn->function.name;
-    fi->stage = WGSL_STAGE_UNKNOWN;
-    return fi;
-}
-static void record_fn_ref(FnInfo* fi, int sym_id) {
-    if (!fi || sym_id <= 0)
+    const int mark = (int)(fi - r->fn_infos) + 1;
+    if (r->sym_mark[sym_id] == mark)
         return;
-    for (int i = 0; i < fi->direct_syms_count; i++)
-        if (fi->direct_syms[i] == sym_id)
-            return;
     if (fi->direct_syms_count >= fi->direct_syms_cap)
-        vec_grow((void**)&fi->direct_syms, &fi->direct_syms_cap, sizeof(int));
+        resolver_grow(r, (void**)&fi->direct_syms, &fi->direct_syms_cap, sizeof(int));
     if (fi->direct_syms_count >= fi->direct_syms_cap) return; /* allocation failed */
+    r->sym_mark[sym_id] = mark;
     fi->direct_syms[fi->direct_syms_count++] = sym_id;
 }
-static void record_fn_call(FnInfo* fi, const char* name) {
+/* Calls to builtins and undeclared functions are not recorded */
+static void record_fn_call(WgslResolver* r, FnInfo* fi, const char* name) {
     if (!fi || !name)
         return;
-    for (int i = 0; i < fi->calls_count; i++)
-        if (str_eq(fi->calls[i], name))
-            return;
+    const int callee = wgsl_name_map_get(&r->functions, name, -1);
+    const int mark = (int)(fi - r->fn_infos) + 1;
+    if (callee < 0 || r->call_mark[callee] == mark)
+        return;
     if (fi->calls_count >= fi->calls_cap)
-        vec_grow((void**)&fi->calls, &fi->calls_cap, sizeof(char*));
+        resolver_grow(r, (void**)&fi->calls, &fi->calls_cap, sizeof(int));
     if (fi->calls_count >= fi->calls_cap) return; /* allocation failed */
-    fi->calls[fi->calls_count++] = name;
+    r->call_mark[callee] = mark;
+    fi->calls[fi->calls_count++] = callee;
 }
 
 /* numeric helpers from types */
@@ -436,12 +405,12 @@ static void walk_expr(WgslResolver* r, FnInfo* fi, const WgslAstNode* e) {
         if (id >= 0) {
             bind_ident(r, e, id);
             if (fi && id > 0 && id <= r->sym_count && r->symbols[id - 1].kind == WGSL_SYM_GLOBAL)
-                record_fn_ref(fi, id);
+                record_fn_ref(r, fi, id);
         }
     } break;
     case WGSL_NODE_CALL: {
         if (e->call.callee && e->call.callee->type == WGSL_NODE_IDENT)
-            record_fn_call(fi, e->call.callee->ident.name);
+            record_fn_call(r, fi, e->call.callee->ident.name);
         else
             walk_expr(r, fi, e->call.callee);
         for (int i = 0; i < e->call.arg_count; i++)
@@ -594,23 +563,72 @@ static void declare_param(WgslResolver* r, const WgslAstNode* fn, const WgslAstN
     scope_put(r, s.name, s.id);
 }
 
+/* ident binding index */
+static uint32_t ptr_hash(const void* p) {
+    uint64_t x = (uint64_t)(uintptr_t)p;
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdull;
+    x ^= x >> 33;
+    return (uint32_t)x;
+}
+static void index_refs(WgslResolver* r) {
+    int cap = 16;
+    while (cap < r->ref_count * 2)
+        cap *= 2;
+    int* slots = (int*)wgsl_arena_alloc(&r->arena, sizeof(int) * (size_t)cap);
+    if (!slots) return; /* queries fall back to a linear scan */
+    memset(slots, 0, sizeof(int) * (size_t)cap);
+    for (int i = 0; i < r->ref_count; i++) {
+        int h = (int)(ptr_hash(r->refmap[i].ident) & (uint32_t)(cap - 1));
+        while (slots[h] && r->refmap[slots[h] - 1].ident != r->refmap[i].ident)
+            h = (h + 1) & (cap - 1);
+        if (!slots[h])
+            slots[h] = i + 1;
+    }
+    r->ref_slots = slots;
+    r->ref_slot_cap = cap;
+}
+
 /* build */
 WgslResolver* wgsl_resolver_build(const WgslAstNode* program) {
     if (!program || program->type != WGSL_NODE_PROGRAM)
         return NULL;
-    WgslResolver* r = (WgslResolver*)NODE_ALLOC(WgslResolver);
+    WgslArena arena = {0};
+    WgslResolver* r = (WgslResolver*)wgsl_arena_alloc(&arena, sizeof(WgslResolver));
     if (!r) return NULL;
+    memset(r, 0, sizeof(*r));
+    r->arena = arena;
     r->program = program;
     scope_push(r);
 
+    int fn_count = 0;
+    for (int i = 0; i < program->program.decl_count; i++)
+        if (program->program.decls[i] && program->program.decls[i]->type == WGSL_NODE_FUNCTION)
+            fn_count++;
+    r->fn_infos = (FnInfo*)wgsl_arena_alloc(&r->arena, sizeof(FnInfo) * (size_t)fn_count);
+    r->call_mark = (int*)wgsl_arena_alloc(&r->arena, sizeof(int) * (size_t)fn_count);
+    if (!r->fn_infos || !r->call_mark) {
+        wgsl_resolver_free(r);
+        return NULL;
+    }
+    memset(r->fn_infos, 0, sizeof(FnInfo) * (size_t)fn_count);
+    memset(r->call_mark, 0, sizeof(int) * (size_t)fn_count);
+
+    /* The first declaration of a name wins, as with the former linear lookups */
     for (int i = 0; i < program->program.decl_count; i++) {
         const WgslAstNode* d = program->program.decls[i];
         if (!d)
             continue;
         if (d->type == WGSL_NODE_STRUCT)
-            add_struct(r, d->struct_decl.name, d);
-        if (d->type == WGSL_NODE_FUNCTION && d->function.name)
-            add_function_decl(r, d->function.name, d);
+            wgsl_name_map_put(&r->arena, &r->structs, d->struct_decl.name, i, 1);
+        if (d->type == WGSL_NODE_FUNCTION) {
+            FnInfo* fi = &r->fn_infos[r->fn_info_count];
+            fi->fn = d;
+            fi->name = d->function.name;
+            fi->stage = WGSL_STAGE_UNKNOWN;
+            wgsl_name_map_put(&r->arena, &r->functions, d->function.name, r->fn_info_count, 1);
+            r->fn_info_count++;
+        }
     }
     for (int i = 0; i < program->program.decl_count; i++) {
         const WgslAstNode* d = program->program.decls[i];
@@ -621,7 +639,16 @@ WgslResolver* wgsl_resolver_build(const WgslAstNode* program) {
         if (d->type == WGSL_NODE_VAR_DECL && d->var_decl.name)
             declare_global_from_vardecl(r, d);
     }
-    for (int i = 0; i < program->program.decl_count; i++) {
+    /* Functions only record globals, which are all declared by now */
+    r->sym_mark_count = r->sym_count + 1;
+    r->sym_mark = (int*)wgsl_arena_alloc(&r->arena, sizeof(int) * (size_t)r->sym_mark_count);
+    if (!r->sym_mark) {
+        wgsl_resolver_free(r);
+        return NULL;
+    }
+    memset(r->sym_mark, 0, sizeof(int) * (size_t)r->sym_mark_count);
+
+    for (int i = 0, f = 0; i < program->program.decl_count; i++) {
         const WgslAstNode* d = program->program.decls[i];
         if (!d || d->type != WGSL_NODE_FUNCTION)
             continue;
@@ -631,14 +658,13 @@ WgslResolver* wgsl_resolver_build(const WgslAstNode* program) {
             if (prm && prm->type == WGSL_NODE_PARAM && prm->param.name)
                 declare_param(r, d, prm);
         }
-        FnInfo* fi = ensure_fn_info(r, d);
-        if (fi) {
-            fi->stage = detect_stage(d);
-            fi->is_entry = (fi->stage != WGSL_STAGE_UNKNOWN);
-        }
+        FnInfo* fi = &r->fn_infos[f++];
+        fi->stage = detect_stage(d);
+        fi->is_entry = (fi->stage != WGSL_STAGE_UNKNOWN);
         walk_stmt(r, d, fi, d->function.body);
         scope_pop(r);
     }
+    index_refs(r);
     return r;
 }
 
@@ -646,21 +672,8 @@ WgslResolver* wgsl_resolver_build(const WgslAstNode* program) {
 void wgsl_resolver_free(WgslResolver* r) {
     if (!r)
         return;
-    for (int i = 0; i < r->scope_count; i++)
-        NODE_FREE(r->scopes[i].items);
-    NODE_FREE(r->scopes);
-    NODE_FREE(r->symbols);
-    NODE_FREE(r->refmap);
-    NODE_FREE(r->structs);
-    NODE_FREE(r->functions);
-    if (r->fn_infos) {
-        for (int i = 0; i < r->fn_info_count; i++) {
-            NODE_FREE(r->fn_infos[i].direct_syms);
-            NODE_FREE(r->fn_infos[i].calls);
-        }
-    }
-    NODE_FREE(r->fn_infos);
-    NODE_FREE(r);
+    WgslArena arena = r->arena;
+    wgsl_arena_free(&arena);
 }
 
 /* copies */
@@ -746,6 +759,13 @@ const WgslSymbolInfo* wgsl_resolver_binding_vars(const WgslResolver* r, int* out
 int wgsl_resolver_ident_symbol_id(const WgslResolver* r, const WgslAstNode* ident_node) {
     if (!r || !ident_node)
         return -1;
+    if (r->ref_slots) {
+        int h = (int)(ptr_hash(ident_node) & (uint32_t)(r->ref_slot_cap - 1));
+        for (; r->ref_slots[h]; h = (h + 1) & (r->ref_slot_cap - 1))
+            if (r->refmap[r->ref_slots[h] - 1].ident == ident_node)
+                return r->refmap[r->ref_slots[h] - 1].id;
+        return -1;
+    }
     for (int i = 0; i < r->ref_count; i++)
         if (r->refmap[i].ident == ident_node)
             return r->refmap[i].id;
@@ -758,7 +778,7 @@ int wgsl_resolver_vertex_inputs(const WgslResolver* r, const char* vertex_entry_
         *out_slots = NULL;
     if (!r || !vertex_entry_name || !out_slots)
         return 0;
-    const WgslAstNode* fn = find_function(r->program, vertex_entry_name);
+    const WgslAstNode* fn = find_function(r, vertex_entry_name);
     if (!fn || detect_stage(fn) != WGSL_STAGE_VERTEX)
         return 0;
     WgslVertexSlot* arr = NULL;
@@ -859,35 +879,24 @@ const WgslResolverEntrypoint* wgsl_resolver_entrypoints(const WgslResolver* r, i
 
 /* transitive refs */
 static const FnInfo* find_fninfo_by_name(const WgslResolver* r, const char* name) {
-    for (int i = 0; i < r->fn_info_count; i++)
-        if (str_eq(r->fn_infos[i].name, name))
-            return &r->fn_infos[i];
-    return NULL;
+    const int i = wgsl_name_map_get(&r->functions, name, -1);
+    return i >= 0 ? &r->fn_infos[i] : NULL;
 }
 static void dfs_collect(const WgslResolver* r, const FnInfo* fi, char* visited_fn, char* keep_sym) {
     if (!fi)
         return;
-    int self_idx = -1;
-    for (int j = 0; j < r->fn_info_count; j++)
-        if (r->fn_infos[j].fn == fi->fn) {
-            self_idx = j;
-            break;
-        }
-    if (self_idx >= 0 && visited_fn[self_idx])
+    const int self_idx = (int)(fi - r->fn_infos);
+    if (visited_fn[self_idx])
         return;
-    if (self_idx >= 0)
-        visited_fn[self_idx] = 1;
+    visited_fn[self_idx] = 1;
 
     for (int i = 0; i < fi->direct_syms_count; i++) {
         int id = fi->direct_syms[i];
         if (id > 0 && id <= r->sym_count && r->symbols[id - 1].kind == WGSL_SYM_GLOBAL)
             keep_sym[id] = 1;
     }
-    for (int c = 0; c < fi->calls_count; c++) {
-        const FnInfo* callee = find_fninfo_by_name(r, fi->calls[c]);
-        if (callee)
-            dfs_collect(r, callee, visited_fn, keep_sym);
-    }
+    for (int c = 0; c < fi->calls_count; c++)
+        dfs_collect(r, &r->fn_infos[fi->calls[c]], visited_fn, keep_sym);
 }
 static const WgslSymbolInfo* entrypoint_syms(const WgslResolver* r, const char* entry_name, int only_binding, int* out_count) {
     if (out_count)
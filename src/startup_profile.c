@@ -0,0 +1,88 @@
+// begin file src/startup_profile.c
+// Timestamps of the InitWindow phases: backend and device creation, surface setup and the
+// resources every application needs. Exported as trace event JSON for chrome://tracing or Perfetto.
+
+#include <raygpu.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "internal_include/internals.h"
+
+static StartupPhase g_startupPhases[MAX_STARTUP_PHASES];
+static uint32_t g_startupPhaseCount = 0;
+static uint32_t g_openPhases[MAX_STARTUP_PHASES];
+static uint32_t g_openPhaseCount = 0;
+static uint32_t g_droppedDepth = 0; // Phases begun while the table was full, always the innermost open ones
+
+void ResetStartupPhases(cwoid){
+    g_startupPhaseCount = 0;
+    g_openPhaseCount = 0;
+    g_droppedDepth = 0;
+}
+
+void BeginStartupPhase(const char* name){
+    if(g_startupPhaseCount == MAX_STARTUP_PHASES){
+        ++g_droppedDepth;
+        return;
+    }
+    StartupPhase* phase = g_startupPhases + g_startupPhaseCount;
+    phase->name = name;
+    phase->depth = g_openPhaseCount;
+    phase->durationNanos = 0;
+    g_openPhases[g_openPhaseCount++] = g_startupPhaseCount++;
+    phase->beginNanos = NanoTime();
+}
+
+void EndStartupPhase(cwoid){
+    const uint64_t now = NanoTime();
+    if(g_droppedDepth > 0){
+        --g_droppedDepth;
+        return;
+    }
+    if(g_openPhaseCount == 0){
+        return;
+    }
+    StartupPhase* phase = g_startupPhases + g_openPhases[--g_openPhaseCount];
+    phase->durationNanos = now - phase->beginNanos;
+}
+
+const StartupPhase* GetStartupPhases(uint32_t* count){
+    *count = g_startupPhaseCount;
+    return g_startupPhases;
+}
+
+bool ExportStartupTrace(const char* fileName){
+    FILE* file = fopen(fileName, "w");
+    if(file == NULL){
+        TRACELOG(LOG_WARNING, "Could not open %s for the startup trace", fileName);
+        return false;
+    }
+    const uint64_t origin = g_startupPhaseCount ? g_startupPhases[0].beginNanos : 0;
+    fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    for(uint32_t i = 0;i < g_startupPhaseCount;i++){
+        const StartupPhase* phase = g_startupPhases + i;
+        fprintf(file, "%s\n  {\"name\":\"%s\",\"cat\":\"startup\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"dur\":%.3f}",
+            i ? "," : "", phase->name, (double)(phase->beginNanos - origin) / 1000.0, (double)phase->durationNanos / 1000.0);
+    }
+    fprintf(file, "\n]}\n");
+    return fclose(file) == 0;
+}
+
+// Closes the outermost phase, logs the breakdown and writes $RAYGPU_STARTUP_TRACE if set
+void FinishStartupProfile(cwoid){
+    while(g_openPhaseCount > 0 || g_droppedDepth > 0){
+        EndStartupPhase();
+    }
+    for(uint32_t i = 0;i < g_startupPhaseCount;i++){
+        const StartupPhase* phase = g_startupPhases + i;
+        TRACELOG(LOG_DEBUG, "%*s%s: %.2f ms", (int)(2 * phase->depth), "", phase->name, (double)phase->durationNanos / 1e6);
+    }
+    if(g_startupPhaseCount > 0){
+        TRACELOG(LOG_INFO, "%s took %.2f ms", g_startupPhases[0].name, (double)g_startupPhases[0].durationNanos / 1e6);
+    }
+    const char* traceFile = getenv("RAYGPU_STARTUP_TRACE");
+    if(traceFile != NULL && traceFile[0] != '\0' && ExportStartupTrace(traceFile)){
+        TRACELOG(LOG_INFO, "Wrote startup trace to %s", traceFile);
+    }
+}
+
+// end file src/startup_profile.c
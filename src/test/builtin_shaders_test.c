@@ -0,0 +1,45 @@
+#include <stdio.h>
+#include <assert.h>
+#include <raygpu.h>
+#include "../internal_include/internals.h"
+
+// Fails when a built-in shader source changed without rebuilding the raygpu_builtin_shaders target
+static void test_embedded_up_to_date(void){
+    for(uint32_t id = 0;id < BuiltinShader_EnumCount;id++){
+        const ShaderSources sources = GetBuiltinShaderSources((BuiltinShaderID)id);
+        const ShaderSources wgslSources = GetBuiltinShaderWGSLSources((BuiltinShaderID)id);
+        if(sources.sourceCount == 0){
+            continue;
+        }
+        if(g_builtinShaderData[id].sourceHash != BuiltinShaderSourceHash(sources)){
+            printf("%s: embedded data is outdated\n", g_builtinShaderData[id].name);
+            assert(0);
+        }
+        if(g_builtinShaderWGSLData[id].sourceHash != BuiltinShaderSourceHash(wgslSources)){
+            printf("%s: embedded WGSL reflection is outdated\n", g_builtinShaderWGSLData[id].name);
+            assert(0);
+        }
+    }
+    printf("test_embedded_up_to_date passed\n");
+}
+
+// Builds without a shader parser load these from SPIR-V, InitWindow and GenTextureMipmaps need them
+static void test_spirv_present(void){
+    const BuiltinShaderID required[] = {BuiltinShader_Default, BuiltinShader_Mipmap};
+    for(uint32_t i = 0;i < sizeof(required) / sizeof(required[0]);i++){
+        const BuiltinShaderData* data = g_builtinShaderData + required[i];
+        assert(data->spirvCount > 0);
+        for(uint32_t s = 0;s < data->spirvCount;s++){
+            assert(data->spirv[s].sizeInBytes % sizeof(uint32_t) == 0);
+            assert(*(const uint32_t*)data->spirv[s].data == 0x07230203);
+        }
+    }
+    printf("test_spirv_present passed\n");
+}
+
+int main(void){
+    test_embedded_up_to_date();
+    test_spirv_present();
+    printf("All built-in shader tests passed\n");
+    return 0;
+}
@@ -0,0 +1,122 @@
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <raygpu.h>
+#include "../internal_include/internals.h"
+#include "../internal_include/c_fs_utils.h"
+
+#define TEST_CACHE_DIRECTORY "shader_cache_test_dir"
+
+static const char vertexSource[] = "@vertex fn vs_main() -> @builtin(position) vec4f { return vec4f(0.0); }";
+static const char fragmentSource[] = "@fragment fn fs_main() -> @location(0) vec4f { return vec4f(1.0); }";
+static const uint32_t vertexWords[] = {0x07230203, 0x00010000, 1, 2, 3};
+static const uint32_t fragmentWords[] = {0x07230203, 0x00010000, 4, 5, 6, 7};
+
+static ShaderSources testSources(void){
+    ShaderSources sources = {0};
+    sources.language = sourceTypeWGSL;
+    sources.sourceCount = 2;
+    sources.sources[0] = CLITERAL(ShaderStageSource){vertexSource, sizeof(vertexSource) - 1, RGShaderStage_Vertex};
+    sources.sources[1] = CLITERAL(ShaderStageSource){fragmentSource, sizeof(fragmentSource) - 1, RGShaderStage_Fragment};
+    return sources;
+}
+
+static BindingIdentifier bindingName(const char* name){
+    BindingIdentifier identifier = {0};
+    identifier.length = (uint32_t)strlen(name);
+    memcpy(identifier.name, name, identifier.length);
+    return identifier;
+}
+
+static void cachePath(char* dest, ShaderSources sources){
+    snprintf(dest, CFS_MAX_PATH, "%s%c%016llx.rgsc", TEST_CACHE_DIRECTORY, CFS_PATH_SEPARATOR, (unsigned long long)ShaderSourcesHash(sources));
+}
+
+static void test_roundtrip(void){
+    const ShaderSources sources = testSources();
+    ShaderSources spirv = {0};
+    spirv.language = sourceTypeSPIRV;
+    spirv.sourceCount = 2;
+    spirv.sources[0] = CLITERAL(ShaderStageSource){vertexWords, sizeof(vertexWords), RGShaderStage_Vertex};
+    spirv.sources[1] = CLITERAL(ShaderStageSource){fragmentWords, sizeof(fragmentWords), RGShaderStage_Fragment};
+
+    ShaderReflectionInfo reflection = {0};
+    reflection.ep[RGShaderStageEnum_Vertex] = CLITERAL(ShaderEntryPoint){RGShaderStageEnum_Vertex, "vs_main"};
+    reflection.ep[RGShaderStageEnum_Fragment] = CLITERAL(ShaderEntryPoint){RGShaderStageEnum_Fragment, "fs_main"};
+    reflection.attributes.vertexAttributeCount = 2;
+    strcpy(reflection.attributes.vertexAttributes[0].name, "position");
+    reflection.attributes.vertexAttributes[0].location = 0;
+    strcpy(reflection.attributes.vertexAttributes[1].name, "color");
+    reflection.attributes.vertexAttributes[1].location = 3;
+    reflection.attributes.attachmentCount = 1;
+    reflection.attributes.attachments[0].number_of_components = 4;
+    reflection.uniforms = callocnew(StringToUniformMap);
+    StringToUniformMap_init(reflection.uniforms);
+    StringToUniformMap_put(reflection.uniforms, bindingName("Perspective_View"), CLITERAL(ResourceTypeDescriptor){.type = uniform_buffer, .minBindingSize = 64, .location = 0, .visibility = RGShaderStage_Vertex});
+    StringToUniformMap_put(reflection.uniforms, bindingName("texture0"), CLITERAL(ResourceTypeDescriptor){.type = texture2d, .location = 1, .visibility = RGShaderStage_Fragment});
+
+    ShaderCacheStore(sources, spirv, &reflection);
+
+    ShaderSources loadedSpirv = {0};
+    ShaderReflectionInfo loaded = {0};
+    assert(ShaderCacheLoad(sources, &loadedSpirv, &loaded));
+    assert(loadedSpirv.language == sourceTypeSPIRV && loadedSpirv.sourceCount == 2);
+    for(uint32_t i = 0;i < 2;i++){
+        assert(loadedSpirv.sources[i].stageMask == spirv.sources[i].stageMask);
+        assert(loadedSpirv.sources[i].sizeInBytes == spirv.sources[i].sizeInBytes);
+        assert(memcmp(loadedSpirv.sources[i].data, spirv.sources[i].data, spirv.sources[i].sizeInBytes) == 0);
+    }
+    // The entry points come back too, a hit must not need SPIRV-Reflect to find them
+    assert(memcmp(loaded.ep, reflection.ep, sizeof(reflection.ep)) == 0);
+    assert(memcmp(&loaded.attributes, &reflection.attributes, sizeof(reflection.attributes)) == 0);
+    assert(loaded.uniforms && loaded.uniforms->current_size == 2);
+    const ResourceTypeDescriptor* perspective = StringToUniformMap_get(loaded.uniforms, bindingName("Perspective_View"));
+    const ResourceTypeDescriptor* texture = StringToUniformMap_get(loaded.uniforms, bindingName("texture0"));
+    assert(perspective && perspective->type == uniform_buffer && perspective->minBindingSize == 64 && perspective->location == 0);
+    assert(texture && texture->type == texture2d && texture->location == 1 && texture->visibility == RGShaderStage_Fragment);
+
+    ShaderCacheFreeSources(&loadedSpirv);
+    StringToUniformMap_free(loaded.uniforms);
+    RL_FREE(loaded.uniforms);
+    StringToUniformMap_free(reflection.uniforms);
+    RL_FREE(reflection.uniforms);
+    printf("test_roundtrip passed\n");
+}
+
+static void test_miss_on_changed_source(void){
+    ShaderSources sources = testSources();
+    const char changed[] = "@vertex fn vs_main() -> @builtin(position) vec4f { return vec4f(1.0); }";
+    sources.sources[0].data = changed;
+    ShaderSources spirv = {0};
+    ShaderReflectionInfo reflection = {0};
+    assert(!ShaderCacheLoad(sources, &spirv, &reflection));
+    printf("test_miss_on_changed_source passed\n");
+}
+
+static void test_corrupt_entry_is_discarded(void){
+    const ShaderSources sources = testSources();
+    char path[CFS_MAX_PATH];
+    cachePath(path, sources);
+    FILE* file = fopen(path, "r+b");
+    assert(file);
+    const uint32_t garbage = 0xdeadbeef;
+    fwrite(&garbage, sizeof(garbage), 1, file);
+    fclose(file);
+
+    ShaderSources spirv = {0};
+    ShaderReflectionInfo reflection = {0};
+    assert(!ShaderCacheLoad(sources, &spirv, &reflection));
+    assert(fopen(path, "rb") == NULL);
+    printf("test_corrupt_entry_is_discarded passed\n");
+}
+
+int main(void){
+    SetShaderCacheDirectory(TEST_CACHE_DIRECTORY);
+    assert(ShaderCacheEnabled());
+    test_roundtrip();
+    test_miss_on_changed_source();
+    test_corrupt_entry_is_discarded();
+    remove(TEST_CACHE_DIRECTORY);
+    printf("All shader cache tests passed\n");
+    return 0;
+}
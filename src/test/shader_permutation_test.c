@@ -0,0 +1,129 @@
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <raygpu.h>
+#include "../internal_include/internals.h"
+
+static const char* const features[] = {"FOG", "SKINNING", "NORMAL_MAP", "SHADOWS"};
+#define FEATURE_COUNT 4
+#define FOG        (1u << 0)
+#define SKINNING   (1u << 1)
+#define NORMAL_MAP (1u << 2)
+#define SHADOWS    (1u << 3)
+
+static void expect_expansion(const char* source, ShaderPermutationKey key, const char* expected){
+    char diag[256] = {0};
+    char* out = ExpandShaderPermutationSource(features, FEATURE_COUNT, source, key, diag, sizeof(diag));
+    if(out == NULL || strcmp(out, expected) != 0){
+        printf("key 0x%llx\nexpected:\n%s\ngot:\n%s\n%s\n", (unsigned long long)key, expected, out ? out : "(null)", diag);
+        assert(0);
+    }
+    RL_FREE(out);
+}
+
+static void test_nested_if_ifdef(void){
+    const char* source =
+        "a\n"
+        "#ifdef FOG\n"
+        "fog\n"
+        "#if SKINNING && !NORMAL_MAP\n"
+        "skin\n"
+        "#elif NORMAL_MAP\n"
+        "normal\n"
+        "#else\n"
+        "plain\n"
+        "#endif\n"
+        "#endif\n"
+        "b\n";
+    // Disabled lines and consumed directives stay as empty lines so that diagnostics keep their line numbers
+    expect_expansion(source, 0, "a\n\n\n\n\n\n\n\n\n\n\nb\n");
+    expect_expansion(source, FOG, "a\n\nfog\n\n\n\n\n\nplain\n\n\nb\n");
+    expect_expansion(source, FOG | SKINNING, "a\n\nfog\n\nskin\n\n\n\n\n\n\nb\n");
+    expect_expansion(source, FOG | SKINNING | NORMAL_MAP, "a\n\nfog\n\n\n\nnormal\n\n\n\n\nb\n");
+    // The inner block must stay off while its parent is off
+    expect_expansion(source, SKINNING | NORMAL_MAP, "a\n\n\n\n\n\n\n\n\n\n\nb\n");
+    printf("test_nested_if_ifdef passed\n");
+}
+
+static void test_ifndef_and_foreign_directives(void){
+    const char* source =
+        "#ifndef SHADOWS\n"
+        "#ifdef GL_ES\n"
+        "precision\n"
+        "#endif\n"
+        "#else\n"
+        "shadow\n"
+        "#endif\n";
+    // GL_ES is not a feature, its directives are left for the shader compiler
+    expect_expansion(source, 0, "\n#ifdef GL_ES\nprecision\n#endif\n\n\n\n");
+    expect_expansion(source, SHADOWS, "\n\n\n\n\nshadow\n\n");
+    printf("test_ifndef_and_foreign_directives passed\n");
+}
+
+static void test_unbalanced(void){
+    char diag[256] = {0};
+    assert(ExpandShaderPermutationSource(features, FEATURE_COUNT, "#if FOG\na\n", 0, diag, sizeof(diag)) == NULL);
+    assert(ExpandShaderPermutationSource(features, FEATURE_COUNT, "a\n#endif\n", 0, diag, sizeof(diag)) == NULL);
+    printf("test_unbalanced passed\n");
+}
+
+static void test_interface_mask(void){
+    const char* glsl =
+        "#version 450\n"
+        "#ifdef SKINNING\n"
+        "layout(location = 3) in vec4 boneWeights;\n"
+        "#endif\n"
+        "layout(binding = 0) uniform Block {\n"
+        "    mat4 mvp;\n"
+        "#if SHADOWS\n"
+        "    mat4 lightMatrix;\n"
+        "#endif\n"
+        "};\n"
+        "void main(){\n"
+        "    vec4 color = vec4(1);\n"
+        "#if FOG\n"
+        "    color.rgb *= 0.5;\n"
+        "    if(color.a > 0.0){\n"
+        "        color.a = 1.0;\n"
+        "    }\n"
+        "#endif\n"
+        "}\n";
+    // FOG only toggles code inside main, variants that differ in it share one reflection
+    assert(AnalyzeShaderPermutationInterface(features, FEATURE_COUNT, glsl) == (SKINNING | SHADOWS));
+
+    const char* wgsl =
+        "struct VertexOut {\n"
+        "    @builtin(position) position: vec4f,\n"
+        "#if NORMAL_MAP\n"
+        "    @location(1) tangent: vec3f,\n"
+        "#endif\n"
+        "};\n"
+        "@fragment fn fs_main(in: VertexOut) -> @location(0) vec4f {\n"
+        "#ifdef FOG\n"
+        "    return vec4f(0.5);\n"
+        "#else\n"
+        "    return vec4f(1.0);\n"
+        "#endif\n"
+        "}\n";
+    assert(AnalyzeShaderPermutationInterface(features, FEATURE_COUNT, wgsl) == NORMAL_MAP);
+
+    // A block that opens a brace it does not close cannot be attributed to one body, every feature counts
+    const char* unbalanced =
+        "void main(){\n"
+        "#if FOG\n"
+        "    if(true){\n"
+        "#endif\n"
+        "    }\n"
+        "}\n";
+    assert(AnalyzeShaderPermutationInterface(features, FEATURE_COUNT, unbalanced) == (FOG | SKINNING | NORMAL_MAP | SHADOWS));
+    printf("test_interface_mask passed\n");
+}
+
+int main(void){
+    test_nested_if_ifdef();
+    test_ifndef_and_foreign_directives();
+    test_unbalanced();
+    test_interface_mask();
+    printf("All shader permutation tests passed\n");
+    return 0;
+}
@@ -0,0 +1,90 @@
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include "../simple_wgsl/wgsl_parser.h"
+
+// Returns the initializer of the first statement in the body of the first function
+static WgslAstNode* first_init(WgslAstNode* program){
+    assert(program && program->type == WGSL_NODE_PROGRAM);
+    for(int i = 0;i < program->program.decl_count;i++){
+        WgslAstNode* d = program->program.decls[i];
+        if(d->type != WGSL_NODE_FUNCTION) continue;
+        WgslAstNode* body = d->function.body;
+        assert(body && body->block.stmt_count >= 1);
+        WgslAstNode* s = body->block.stmts[0];
+        assert(s->type == WGSL_NODE_VAR_DECL);
+        return s->var_decl.init;
+    }
+    assert(0 && "no function");
+    return NULL;
+}
+
+static void expect_binary(const WgslAstNode* n, const char* op){
+    assert(n && n->type == WGSL_NODE_BINARY);
+    if(strcmp(n->binary.op, op) != 0){
+        printf("expected '%s', got '%s'\n", op, n->binary.op);
+        assert(0);
+    }
+}
+
+// '&' used to be lexed without any binary rule, which left the statement loop without progress
+static void test_bitwise_and(void){
+    WgslAstNode* ast = wgsl_parse("fn f() { let a = (x & 1) / 2.0; }");
+    WgslAstNode* init = first_init(ast);
+    expect_binary(init, "/");
+    expect_binary(init->binary.left, "&");
+    wgsl_free_ast(ast);
+    printf("test_bitwise_and passed\n");
+}
+
+static void test_shift_and_mask(void){
+    WgslAstNode* ast = wgsl_parse(
+        "struct VIn { @location(0) color: u32, };\n"
+        "fn f(in: VIn) -> f32 { let r = f32((in.color >> 24) & 0xff) / 255.0; return r; }");
+    WgslAstNode* init = first_init(ast);
+    assert(init->type == WGSL_NODE_BINARY);
+    WgslAstNode* call = init->binary.left;
+    assert(call->type == WGSL_NODE_CALL && call->call.arg_count == 1);
+    WgslAstNode* mask = call->call.args[0];
+    expect_binary(mask, "&");
+    expect_binary(mask->binary.left, ">>");
+    wgsl_free_ast(ast);
+    printf("test_shift_and_mask passed\n");
+}
+
+static void test_precedence(void){
+    WgslAstNode* ast = wgsl_parse("fn f() { let a = b | c ^ d & e << 2u; }");
+    WgslAstNode* init = first_init(ast);
+    expect_binary(init, "|");
+    expect_binary(init->binary.right, "^");
+    expect_binary(init->binary.right->binary.right, "&");
+    expect_binary(init->binary.right->binary.right->binary.right, "<<");
+    wgsl_free_ast(ast);
+
+    // Comparisons stay below shifts, and nested template lists still close with '>>'
+    ast = wgsl_parse("fn f() { var m: array<vec4<f32>, 2>; let a = x < y << 1; }");
+    WgslAstNode* body = ast->program.decls[0]->function.body;
+    assert(body->block.stmt_count == 2);
+    init = body->block.stmts[1]->var_decl.init;
+    expect_binary(init, "<");
+    expect_binary(init->binary.right, "<<");
+    wgsl_free_ast(ast);
+    printf("test_precedence passed\n");
+}
+
+// Garbage inside a block must not stall the parser
+static void test_recovers_from_bad_statement(void){
+    WgslAstNode* ast = wgsl_parse("fn f() { ) ; let a = 1; }\nfn g() { }");
+    assert(ast);
+    wgsl_free_ast(ast);
+    printf("test_recovers_from_bad_statement passed\n");
+}
+
+int main(void){
+    test_bitwise_and();
+    test_shift_and_mask();
+    test_precedence();
+    test_recovers_from_bad_statement();
+    printf("All wgsl parser tests passed\n");
+    return 0;
+}
@@ -0,0 +1,171 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "../simple_wgsl/wgsl_parser.h"
+#include "../simple_wgsl/wgsl_resolve.h"
+
+// Parses and resolves every WGSL source of the repository: the files in resources/ and the shaders
+// embedded as C string literals. usage: wgsl_roundtrip_test [repository root]
+#ifndef RAYGPU_SOURCE_DIR
+#define RAYGPU_SOURCE_DIR "."
+#endif
+
+typedef struct EmbeddedSource{
+    const char* file;
+    const char* name;
+}EmbeddedSource;
+
+static const char* const wgslFiles[] = {
+    "resources/base.wgsl",
+    "resources/simple_shader.wgsl",
+    "resources/simple_compute.wgsl",
+};
+
+static const EmbeddedSource embeddedSources[] = {
+    {"src/InitWindow.c", "shaderSource"},
+    {"src/InitWindow.c", "textureArrayShaderSource"},
+    {"src/raygpu.c", "mipmapComputerSource"},
+    {"src/backend_wgpu.c", "mipmapComputerSource2"},
+    {"src/indirect_scene.c", "indirectCullComputeSource"},
+    {"src/mesh_skinning.c", "meshSkinningComputeSource"},
+};
+
+static char* readFile(const char* root, const char* path){
+    char full[1024];
+    snprintf(full, sizeof(full), "%s/%s", root, path);
+    FILE* f = fopen(full, "rb");
+    if(f == NULL){
+        printf("cannot open %s\n", full);
+        return NULL;
+    }
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    char* data = (char*)malloc((size_t)size + 1);
+    size_t read = fread(data, 1, (size_t)size, f);
+    data[read] = '\0';
+    fclose(f);
+    return data;
+}
+
+// Concatenates the string literals that initialize `const char name[] =`, up to the terminating ';'
+static char* extractLiteral(const char* code, const char* name){
+    char pattern[128];
+    snprintf(pattern, sizeof(pattern), "const char %s[] =", name);
+    const char* p = strstr(code, pattern);
+    if(p == NULL)return NULL;
+    p += strlen(pattern);
+    char* out = (char*)malloc(strlen(p) + 1);
+    size_t n = 0;
+    while(*p && *p != ';'){
+        if(p[0] == '/' && p[1] == '/'){
+            while(*p && *p != '\n')++p;
+            continue;
+        }
+        if(*p != '"'){
+            ++p;
+            continue;
+        }
+        for(++p;*p && *p != '"';++p){
+            if(*p == '\\'){
+                ++p;
+                out[n++] = *p == 'n' ? '\n' : *p == 't' ? '\t' : *p;
+            }
+            else{
+                out[n++] = *p;
+            }
+        }
+        if(*p)++p;
+    }
+    out[n] = '\0';
+    return out;
+}
+
+static int checkSource(const char* label, const char* source){
+    WgslAstNode* ast = wgsl_parse(source);
+    if(ast == NULL || ast->program.error_count != 0 || ast->program.decl_count == 0){
+        printf("%s: parse failed (%d errors)\n", label, ast ? ast->program.error_count : -1);
+        if(ast)wgsl_free_ast(ast);
+        return 1;
+    }
+    WgslResolver* R = wgsl_resolver_build(ast);
+    assert(R);
+    int failures = 0;
+
+    int epCount = 0;
+    const WgslResolverEntrypoint* eps = wgsl_resolver_entrypoints(R, &epCount);
+    if(epCount == 0){
+        printf("%s: no entry points\n", label);
+        ++failures;
+    }
+
+    int bindingCount = 0;
+    const WgslSymbolInfo* bindings = wgsl_resolver_binding_vars(R, &bindingCount);
+    for(int i = 0;i < bindingCount;i++){
+        if(!bindings[i].has_group || !bindings[i].has_binding){
+            printf("%s: %s lost its @group/@binding\n", label, bindings[i].name);
+            ++failures;
+        }
+    }
+    // Every binding an entry point uses must be one of the module's bindings
+    for(int e = 0;e < epCount;e++){
+        if(eps[e].function_node == NULL || eps[e].stage == WGSL_STAGE_UNKNOWN){
+            printf("%s: entry point %s unresolved\n", label, eps[e].name);
+            ++failures;
+            continue;
+        }
+        int used = 0;
+        const WgslSymbolInfo* epBindings = wgsl_resolver_entrypoint_binding_vars(R, eps[e].name, &used);
+        for(int i = 0;i < used;i++){
+            int found = 0;
+            for(int j = 0;j < bindingCount;j++){
+                found |= bindings[j].group_index == epBindings[i].group_index && bindings[j].binding_index == epBindings[i].binding_index;
+            }
+            if(!found){
+                printf("%s: %s uses unknown binding %s\n", label, eps[e].name, epBindings[i].name);
+                ++failures;
+            }
+        }
+        wgsl_resolve_free((void*)epBindings);
+    }
+    wgsl_resolve_free((void*)bindings);
+    wgsl_resolve_free((void*)eps);
+    wgsl_resolver_free(R);
+    wgsl_free_ast(ast);
+    printf("%s: %s (%d entry points, %d bindings)\n", label, failures ? "FAILED" : "ok", epCount, bindingCount);
+    return failures;
+}
+
+int main(int argc, char** argv){
+    const char* root = argc > 1 ? argv[1] : RAYGPU_SOURCE_DIR;
+    int failures = 0;
+    for(size_t i = 0;i < sizeof(wgslFiles) / sizeof(wgslFiles[0]);i++){
+        char* source = readFile(root, wgslFiles[i]);
+        if(source == NULL){
+            ++failures;
+            continue;
+        }
+        failures += checkSource(wgslFiles[i], source);
+        free(source);
+    }
+    for(size_t i = 0;i < sizeof(embeddedSources) / sizeof(embeddedSources[0]);i++){
+        char* code = readFile(root, embeddedSources[i].file);
+        char* source = code ? extractLiteral(code, embeddedSources[i].name) : NULL;
+        if(source == NULL){
+            printf("%s: %s not found\n", embeddedSources[i].file, embeddedSources[i].name);
+            ++failures;
+        }
+        else{
+            failures += checkSource(embeddedSources[i].name, source);
+        }
+        free(source);
+        free(code);
+    }
+    if(failures){
+        printf("%d WGSL round-trip failures\n", failures);
+        return 1;
+    }
+    printf("All WGSL sources parse and resolve\n");
+    return 0;
+}
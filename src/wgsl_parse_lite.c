@@ -7,6 +7,7 @@
 InOutAttributeInfo                                      getAttributesWGSL_Simple(ShaderSources sources);
 StringToUniformMap*                                     getBindingsWGSL_Simple  (ShaderSources sources);
 EntryPointSet                                           getEntryPointsWGSL_Simple(const char* shaderSourceWGSL);
+ShaderReflectionInfo                                    getReflectionInfoWGSL_Simple(ShaderSources sources);
 
 InOutAttributeInfo                                      getAttributesWGSL_Tint  (ShaderSources sources);
 StringToUniformMap*                                     getBindingsWGSL_Tint    (ShaderSources sources);
@@ -135,45 +136,21 @@ static inline SW_ParsedTextureMeta sw_parse_texture_typenode(const WgslAstNode*
     return m;
 }
 
-EntryPointSet getEntryPointsWGSL_Simple(const char* shaderSourceWGSL) {
-    EntryPointSet eps = {0};
-    if (!shaderSourceWGSL) return eps;
-
-    WgslAstNode* ast = wgsl_parse(shaderSourceWGSL);
-    if (!ast) return eps;
-
-    WgslResolver* R = wgsl_resolver_build(ast);
-    if (!R) { wgsl_free_ast(ast); return eps; }
-
+static void sw_collect_entrypoints(WgslResolver* R, EntryPointSet* eps) {
     int n = 0;
     const WgslResolverEntrypoint* arr = wgsl_resolver_entrypoints(R, &n);
-    uint32_t insertIndex = 0;
     for (int i = 0; i < n; ++i) {
-        char* insert = eps.names[sw_to_stage_enum(arr[i].stage)];
+        char* insert = eps->names[sw_to_stage_enum(arr[i].stage)];
         assert(strlen(arr[i].name) < MAX_SHADER_ENTRYPOINT_NAME_LENGTH);
         if(arr[i].name && strlen(arr[i].name) < MAX_SHADER_ENTRYPOINT_NAME_LENGTH){
             memcpy(insert, arr[i].name, strlen(arr[i].name));
         }
     }
-
     wgsl_resolve_free((void*)arr);
-    wgsl_resolver_free(R);
-    wgsl_free_ast(ast);
-    return eps;
 }
 
-InOutAttributeInfo getAttributesWGSL_Simple(ShaderSources sources) {
-    InOutAttributeInfo info = {0};
-    if (sources.sourceCount == 0 || sources.sources[0].data == NULL) return info;
-
-    const char* src = (const char*)sources.sources[0].data;
-
-    WgslAstNode* ast = wgsl_parse(src);
-    if (!ast) return info;
-
-    WgslResolver* R = wgsl_resolver_build(ast);
-    if (!R) { wgsl_free_ast(ast); return info; }
-
+// Returns false if the module has no vertex entry point
+static bool sw_collect_attributes(WgslResolver* R, InOutAttributeInfo* info) {
     int ep_count = 0;
     const WgslResolverEntrypoint* eps = wgsl_resolver_entrypoints(R, &ep_count);
 
@@ -185,9 +162,9 @@ InOutAttributeInfo getAttributesWGSL_Simple(ShaderSources sources) {
     if (vertex_name) {
         WgslVertexSlot* slots = NULL;
         int slot_count = wgsl_resolver_vertex_inputs(R, vertex_name, &slots);
-        info.vertexAttributeCount = (uint32_t)slot_count;
+        info->vertexAttributeCount = (uint32_t)slot_count;
         for (int i = 0; i < slot_count && i < (int)MAX_VERTEX_ATTRIBUTES; ++i) {
-            ReflectionVertexAttribute* out = &info.vertexAttributes[i];
+            ReflectionVertexAttribute* out = &info->vertexAttributes[i];
             out->location = (uint32_t)slots[i].location;
             out->format   = sw_vf_from_numeric(slots[i].component_count, slots[i].numeric_type);
             out->name[0]  = '\0';
@@ -196,34 +173,12 @@ InOutAttributeInfo getAttributesWGSL_Simple(ShaderSources sources) {
     }
 
     wgsl_resolve_free((void*)eps);
-    wgsl_resolver_free(R);
-    wgsl_free_ast(ast);
-    return info;
+    return vertex_name != NULL;
 }
 
-StringToUniformMap* getBindingsWGSL_Simple(ShaderSources sources) {
-    StringToUniformMap* out = NULL;
-    if (sources.sourceCount == 0 || sources.sources[0].data == NULL){
-        return out;
-    }
-    out = callocnew(StringToUniformMap);
-    StringToUniformMap_init(out);
-    const char* src = (const char*)sources.sources[0].data;
-
-    WgslAstNode* ast = wgsl_parse(src);
-    if (!ast){
-        return out;
-    }
-
-    WgslResolver* R = wgsl_resolver_build(ast);
-    if (!R) {
-        wgsl_free_ast(ast);
-        return out;
-    }
-
+static void sw_collect_bindings(WgslResolver* R, StringToUniformMap* out) {
     int n = 0;
     const WgslSymbolInfo* syms = wgsl_resolver_binding_vars(R, &n);
-
     for (int i = 0; i < n; ++i) {
         const WgslSymbolInfo* s = syms + i;
         if (!s->name || !s->decl_node || s->decl_node->type != WGSL_NODE_GLOBAL_VAR) continue;
@@ -294,11 +249,105 @@ StringToUniformMap* getBindingsWGSL_Simple(ShaderSources sources) {
     }
 
     wgsl_resolve_free((void*)syms);
+}
+
+EntryPointSet getEntryPointsWGSL_Simple(const char* shaderSourceWGSL) {
+    EntryPointSet eps = {0};
+    if (!shaderSourceWGSL) return eps;
+
+    WgslAstNode* ast = wgsl_parse(shaderSourceWGSL);
+    if (!ast) return eps;
+
+    WgslResolver* R = wgsl_resolver_build(ast);
+    if (!R) { wgsl_free_ast(ast); return eps; }
+
+    sw_collect_entrypoints(R, &eps);
+
+    wgsl_resolver_free(R);
+    wgsl_free_ast(ast);
+    return eps;
+}
+
+InOutAttributeInfo getAttributesWGSL_Simple(ShaderSources sources) {
+    InOutAttributeInfo info = {0};
+    if (sources.sourceCount == 0 || sources.sources[0].data == NULL) return info;
+
+    const char* src = (const char*)sources.sources[0].data;
+
+    WgslAstNode* ast = wgsl_parse(src);
+    if (!ast) return info;
+
+    WgslResolver* R = wgsl_resolver_build(ast);
+    if (!R) { wgsl_free_ast(ast); return info; }
+
+    sw_collect_attributes(R, &info);
+
+    wgsl_resolver_free(R);
+    wgsl_free_ast(ast);
+    return info;
+}
+
+StringToUniformMap* getBindingsWGSL_Simple(ShaderSources sources) {
+    StringToUniformMap* out = NULL;
+    if (sources.sourceCount == 0 || sources.sources[0].data == NULL){
+        return out;
+    }
+    out = callocnew(StringToUniformMap);
+    StringToUniformMap_init(out);
+    const char* src = (const char*)sources.sources[0].data;
+
+    WgslAstNode* ast = wgsl_parse(src);
+    if (!ast){
+        return out;
+    }
+
+    WgslResolver* R = wgsl_resolver_build(ast);
+    if (!R) {
+        wgsl_free_ast(ast);
+        return out;
+    }
+
+    sw_collect_bindings(R, out);
+
     wgsl_resolver_free(R);
     wgsl_free_ast(ast);
     return out;
 }
 
+// Entry points, vertex inputs and bindings from a single parse of every source
+ShaderReflectionInfo getReflectionInfoWGSL_Simple(ShaderSources sources) {
+    ShaderReflectionInfo info = {0};
+    info.uniforms = callocnew(StringToUniformMap);
+    StringToUniformMap_init(info.uniforms);
+    bool haveAttributes = false;
+
+    for (uint32_t i = 0; i < sources.sourceCount; i++) {
+        if (sources.sources[i].data == NULL) continue;
+        WgslAstNode* ast = wgsl_parse((const char*)sources.sources[i].data);
+        if (!ast) continue;
+        WgslResolver* R = wgsl_resolver_build(ast);
+        if (!R) { wgsl_free_ast(ast); continue; }
+
+        EntryPointSet eps = {0};
+        sw_collect_entrypoints(R, &eps);
+        for (uint32_t stage = 0; stage < RGShaderStageEnum_EnumCount; stage++) {
+            if (eps.names[stage][0] == '\0') continue;
+            ShaderEntryPoint* ep = &info.ep[stage];
+            ep->stage = (RGShaderStageEnum)stage;
+            rassert(strlen(eps.names[stage]) < sizeof(ep->name), "Entry point name %s too long", eps.names[stage]);
+            strncpy(ep->name, eps.names[stage], sizeof(ep->name) - 1);
+        }
+        if (!haveAttributes) {
+            haveAttributes = sw_collect_attributes(R, &info.attributes);
+        }
+        sw_collect_bindings(R, info.uniforms);
+
+        wgsl_resolver_free(R);
+        wgsl_free_ast(ast);
+    }
+    return info;
+}
+
 #endif // simple backend
 
 
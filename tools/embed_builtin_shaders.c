@@ -0,0 +1,143 @@
+// begin file tools/embed_builtin_shaders.c
+// Writes src/builtin_shaders_embedded.c: SPIR-V and reflection of every built-in shader, and the reflection
+// of their WGSL forms, so the library never compiles them at runtime. Run through the raygpu_builtin_shaders
+// target whenever one of the sources returned by GetBuiltinShaderSources or GetBuiltinShaderWGSLSources changes.
+//
+// usage: embed_builtin_shaders <output.c>
+
+#include <raygpu.h>
+#include <stdio.h>
+#include <string.h>
+#include "../src/internal_include/internals.h"
+
+static const char* const builtinNames[BuiltinShader_EnumCount] = {"default", "texture_array", "mipmap", "indirect_cull", "mesh_skinning"};
+
+static void writeWords(FILE* out, const char* name, const ShaderStageSource* source){
+    const uint32_t* words = (const uint32_t*)source->data;
+    const uint32_t wordCount = source->sizeInBytes / sizeof(uint32_t);
+    fprintf(out, "static const uint32_t %s[] = {", name);
+    for(uint32_t i = 0;i < wordCount;i++){
+        fprintf(out, "%s0x%08x,", (i % 8 == 0) ? "\n    " : " ", words[i]);
+    }
+    fprintf(out, "\n};\n");
+}
+
+// name is the built-in's name, label the one its arrays and macro are written under
+static void writeShader(FILE* out, const char* name, const char* label, ShaderSources sources, bool withSPIRV){
+    ShaderSources spirv = {0};
+    ShaderReflectionInfo reflection = {0};
+    ShaderBatchResult result = {0};
+    if(sources.sourceCount == 0 || !PrepareShaderSources(&sources, NULL, &spirv, &reflection, &result)){
+        // Left empty, the library compiles this shader at runtime
+        fprintf(stderr, "embed_builtin_shaders: %s not embedded: %s\n", label, sources.sourceCount ? result.diagnostics : "not part of this build");
+        fprintf(out, "#define builtin_%s_data {.name = \"%s\"}\n\n", label, name);
+        return;
+    }
+    if(!withSPIRV){
+        ShaderCacheFreeSources(&spirv);
+    }
+
+    for(uint32_t i = 0;i < spirv.sourceCount;i++){
+        char arrayName[64];
+        snprintf(arrayName, sizeof(arrayName), "builtin_%s_spirv%u", label, i);
+        writeWords(out, arrayName, spirv.sources + i);
+    }
+    uint32_t uniformCount = 0;
+    ResourceTypeDescriptor* flat = flattenUniformMap(reflection.uniforms, &uniformCount);
+    if(uniformCount > 0){
+        fprintf(out, "static const BuiltinShaderUniform builtin_%s_uniforms[] = {\n", label);
+        for(uint32_t i = 0;i < uniformCount;i++){
+            // flattenUniformMap drops the names, look them up by location
+            const char* uniformName = "";
+            for(uint32_t j = 0;j < reflection.uniforms->current_capacity;j++){
+                if(reflection.uniforms->table[j].key.length != 0 && reflection.uniforms->table[j].value.location == flat[i].location){
+                    uniformName = reflection.uniforms->table[j].key.name;
+                }
+            }
+            fprintf(out, "    {\"%s\", {.type = (uniform_type)%u, .minBindingSize = %u, .location = %u, .access = (access_type)%u, .fstype = (format_or_sample_type)%u, .visibility = 0x%x}},\n",
+                uniformName, (unsigned)flat[i].type, flat[i].minBindingSize, flat[i].location, (unsigned)flat[i].access, (unsigned)flat[i].fstype, (unsigned)flat[i].visibility);
+        }
+        fprintf(out, "};\n");
+    }
+
+    fprintf(out, "#define builtin_%s_data { \\\n", label);
+    fprintf(out, "    .name = \"%s\", \\\n", name);
+    fprintf(out, "    .sourceHash = 0x%016llxull, \\\n", (unsigned long long)BuiltinShaderSourceHash(sources));
+    fprintf(out, "    .spirvCount = %u, \\\n", spirv.sourceCount);
+    for(uint32_t i = 0;i < spirv.sourceCount;i++){
+        fprintf(out, "    .spirv[%u] = {builtin_%s_spirv%u, sizeof(builtin_%s_spirv%u), 0x%x}, \\\n",
+            i, label, i, label, i, (unsigned)spirv.sources[i].stageMask);
+    }
+    for(uint32_t stage = 0;stage < RGShaderStageEnum_EnumCount;stage++){
+        if(reflection.ep[stage].name[0] != '\0'){
+            fprintf(out, "    .ep[%u] = {(RGShaderStageEnum)%u, \"%s\"}, \\\n", stage, (unsigned)reflection.ep[stage].stage, reflection.ep[stage].name);
+        }
+    }
+    const InOutAttributeInfo* attributes = &reflection.attributes;
+    if(attributes->vertexAttributeCount > 0){
+        fprintf(out, "    .attributes.vertexAttributeCount = %u, \\\n    .attributes.vertexAttributes = {", attributes->vertexAttributeCount);
+        for(uint32_t i = 0;i < attributes->vertexAttributeCount;i++){
+            fprintf(out, "%s{\"%s\", (RGVertexFormat)0x%x, %u}", i ? ", " : "", attributes->vertexAttributes[i].name,
+                (unsigned)attributes->vertexAttributes[i].format, attributes->vertexAttributes[i].location);
+        }
+        fprintf(out, "}, \\\n");
+    }
+    if(attributes->attachmentCount > 0){
+        fprintf(out, "    .attributes.attachmentCount = %u, \\\n    .attributes.attachments = {", attributes->attachmentCount);
+        for(uint32_t i = 0;i < attributes->attachmentCount;i++){
+            fprintf(out, "%s{%u, (format_or_sample_type)%u}", i ? ", " : "", attributes->attachments[i].number_of_components, (unsigned)attributes->attachments[i].type);
+        }
+        fprintf(out, "}, \\\n");
+    }
+    if(uniformCount > 0){
+        fprintf(out, "    .uniformCount = %u, \\\n", uniformCount);
+        fprintf(out, "    .uniforms = builtin_%s_uniforms, \\\n", label);
+    }
+    fprintf(out, "}\n\n");
+    RL_FREE(flat);
+    ShaderCacheFreeSources(&spirv);
+}
+
+int main(int argc, char** argv){
+    if(argc != 2){
+        fprintf(stderr, "usage: %s <output.c>\n", argv[0]);
+        return 1;
+    }
+    FILE* out = fopen(argv[1], "w");
+    if(out == NULL){
+        fprintf(stderr, "embed_builtin_shaders: cannot open %s\n", argv[1]);
+        return 1;
+    }
+    // Embedded data must not depend on a user's shader cache
+    SetShaderCacheDirectory(NULL);
+    fprintf(out, "// begin file src/builtin_shaders_embedded.c\n");
+    fprintf(out, "// Generated by tools/embed_builtin_shaders.c, do not edit. See src/builtin_shaders.c\n\n");
+    fprintf(out, "#include <raygpu.h>\n#include \"internal_include/internals.h\"\n\n");
+    for(uint32_t id = 0;id < BuiltinShader_EnumCount;id++){
+        const char* name = builtinNames[id];
+        char wgslLabel[64];
+        snprintf(wgslLabel, sizeof(wgslLabel), "%s_wgsl", name);
+        const ShaderSources sources = GetBuiltinShaderSources((BuiltinShaderID)id);
+        const ShaderSources wgslSources = GetBuiltinShaderWGSLSources((BuiltinShaderID)id);
+        writeShader(out, name, name, sources, true);
+        if(wgslSources.sourceCount != 0 && BuiltinShaderSourceHash(wgslSources) == BuiltinShaderSourceHash(sources)){
+            // Written in WGSL to begin with, the loader ignores the SPIR-V of this table
+            fprintf(out, "#define builtin_%s_data builtin_%s_data\n\n", wgslLabel, name);
+        }else{
+            writeShader(out, name, wgslLabel, wgslSources, false);
+        }
+    }
+    fprintf(out, "const BuiltinShaderData g_builtinShaderData[BuiltinShader_EnumCount] = {\n");
+    for(uint32_t id = 0;id < BuiltinShader_EnumCount;id++){
+        fprintf(out, "    builtin_%s_data,\n", builtinNames[id]);
+    }
+    fprintf(out, "};\n\n");
+    fprintf(out, "const BuiltinShaderData g_builtinShaderWGSLData[BuiltinShader_EnumCount] = {\n");
+    for(uint32_t id = 0;id < BuiltinShader_EnumCount;id++){
+        fprintf(out, "    builtin_%s_wgsl_data,\n", builtinNames[id]);
+    }
+    fprintf(out, "};\n\n// end file src/builtin_shaders_embedded.c\n");
+    return fclose(out) == 0 ? 0 : 1;
+}
+
+// end file tools/embed_builtin_shaders.c